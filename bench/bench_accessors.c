@@ -0,0 +1,70 @@
+// bench_accessors.c — per-element MemOffset getters vs. the bulk copies
+// (DependentVariableCopyDoubleValues and friends) over large components.
+//
+//   make bench && build/bin/bench_accessors
+//
+// Each line reads the same run of 8M values both ways, contiguous and with
+// a stride, and reports nanoseconds per value.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static const char *type_name(OCNumberType type) {
+    switch (type) {
+        case kOCNumberSInt16Type: return "int16";
+        case kOCNumberFloat32Type: return "float32";
+        case kOCNumberFloat64Type: return "float64";
+        case kOCNumberComplex128Type: return "complex128";
+        default: return "?";
+    }
+}
+static void bench_type(OCNumberType type, OCIndex n) {
+    DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"), type, n, NULL);
+    double *out = malloc((size_t)n * sizeof(double));
+    if (!dv || !out) {
+        if (dv) OCRelease(dv);
+        free(out);
+        return;
+    }
+    uint8_t *bytes =
+        OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+    size_t width = OCNumberTypeSize(type);
+    for (size_t i = 0; i < (size_t)n * width; ++i) bytes[i] = (uint8_t)(i * 131u >> 3);
+    const OCIndex strides[] = {1, 4};
+    for (size_t s = 0; s < sizeof(strides) / sizeof(strides[0]); ++s) {
+        OCIndex stride = strides[s], count = n / stride;
+        double sink = 0;
+        double t0 = now_seconds();
+        for (OCIndex i = 0; i < count; ++i)
+            out[i] = DependentVariableGetDoubleValueAtMemOffset(dv, 0, i * stride);
+        double perElement = now_seconds() - t0;
+        sink += out[count - 1];
+        t0 = now_seconds();
+        DependentVariableCopyDoubleValues(dv, 0, 0, stride, count, out);
+        double bulk = now_seconds() - t0;
+        sink += out[count - 1];
+        t0 = now_seconds();
+        DependentVariableCopyDoubleValuesForPart(dv, 0, 0, stride, count, kSIMagnitudePart, out);
+        double magnitude = now_seconds() - t0;
+        sink += out[count - 1];
+        printf("%-10s stride %ld: getter %6.2f ns, bulk %5.2f ns (x%.1f), |bulk| %5.2f ns  (%g)\n",
+               type_name(type), (long)stride, perElement * 1e9 / count, bulk * 1e9 / count,
+               bulk > 0 ? perElement / bulk : 0.0, magnitude * 1e9 / count, sink);
+    }
+    free(out);
+    OCRelease(dv);
+}
+int main(void) {
+    const OCIndex n = 8 << 20;
+    const OCNumberType types[] = {kOCNumberSInt16Type, kOCNumberFloat32Type, kOCNumberFloat64Type,
+                                  kOCNumberComplex128Type};
+    printf("convert kernel %d\n", (int)RMNConvertGetKernel());
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) bench_type(types[t], n);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// bench_base64.c — base64 throughput: OCTypes codec vs RMNBase64 kernels.
+//
+//   make bench && build/bin/bench_base64 [megabytes]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static void report(const char *label, size_t bytes, double seconds, int reps) {
+    printf("  %-22s %9.1f MB/s\n", label, (double)bytes * reps / seconds / 1e6);
+}
+int main(int argc, char **argv) {
+    size_t mb = argc > 1 ? (size_t)atol(argv[1]) : 16;
+    size_t n = mb << 20;
+    const int reps = 5;
+    uint8_t *bytes = malloc(n);
+    char *text = malloc(RMNBase64EncodedLength(n) + 1);
+    uint8_t *back = malloc(n);
+    if (!bytes || !text || !back) return 1;
+    srand(42);
+    for (size_t i = 0; i < n; ++i) bytes[i] = (uint8_t)rand();
+
+    printf("base64, %zu MiB component, %d reps\n", mb, reps);
+    // current OCTypes path
+    OCDataRef data = OCDataCreate(bytes, (OCIndex)n);
+    double t0 = now_seconds();
+    OCStringRef b64 = NULL;
+    for (int r = 0; r < reps; ++r) {
+        if (b64) OCRelease(b64);
+        b64 = OCDataCreateBase64EncodedString(data, OCBase64EncodingOptionsNone);
+    }
+    report("encode OCTypes", n, now_seconds() - t0, reps);
+    t0 = now_seconds();
+    for (int r = 0; r < reps; ++r) {
+        OCDataRef d = OCDataCreateFromBase64EncodedString(b64);
+        OCRelease(d);
+    }
+    report("decode OCTypes", n, now_seconds() - t0, reps);
+    OCRelease(b64);
+    OCRelease(data);
+
+    static const struct {
+        RMNBase64Kernel kernel;
+        const char *name;
+    } kernels[] = {{kRMNBase64KernelScalar, "scalar"},
+                   {kRMNBase64KernelSSE41, "sse4.1"},
+                   {kRMNBase64KernelAVX2, "avx2"}};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!RMNBase64SetKernel(kernels[k].kernel)) continue;
+        char label[64];
+        size_t len = 0;
+        t0 = now_seconds();
+        for (int r = 0; r < reps; ++r) len = RMNBase64Encode(bytes, n, text);
+        snprintf(label, sizeof(label), "encode RMNBase64 %s", kernels[k].name);
+        report(label, n, now_seconds() - t0, reps);
+        t0 = now_seconds();
+        bool ok = true;
+        for (int r = 0; r < reps; ++r) ok &= RMNBase64Decode(text, len, back, NULL);
+        snprintf(label, sizeof(label), "decode RMNBase64 %s", kernels[k].name);
+        report(label, n, now_seconds() - t0, reps);
+        if (!ok || memcmp(bytes, back, n) != 0) {
+            fprintf(stderr, "round trip mismatch with %s kernel\n", kernels[k].name);
+            return 1;
+        }
+    }
+    RMNBase64SetKernel(kRMNBase64KernelAuto);
+    free(bytes);
+    free(text);
+    free(back);
+    return 0;
+}
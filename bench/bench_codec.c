@@ -0,0 +1,113 @@
+// bench_codec.c — compressed encodings: ratio vs. throughput on CSDM test files.
+//
+//   make bench && CSDM_TEST_ROOT=tests/CSDM-TestFiles-1.0 build/bin/bench_codec [file.csdf ...]
+//
+// Every component of every dependent variable is encoded and decoded with
+// each codec compiled into this build, with and without the byte shuffle.
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static const char *kDefaultFiles[] = {
+    "NMR/blochDecay/blochDecay_base64.csdf",
+    "NMR/satrec/satRec.csdf",
+    "NMR/PASS/PASS.csdf",
+    "EPR/AmanitaMuscaria_base64.csdf",
+    "GC/cinnamon_base64.csdf",
+    "ir/caffeine_base64.csdf",
+    "UV-vis/benzeneVapour_base64.csdf",
+    "image/raccoon_image.csdf",
+    "correlatedDataset/forecast/NCEI.csdfe",
+};
+static const char *kEncodings[] = {"deflate", "shuffle+deflate", "zstd", "shuffle+zstd",
+                                   "lz4", "shuffle+lz4"};
+static void bench_file(const char *path, const char *dir) {
+    OCStringRef err = NULL;
+    DatasetRef ds = DatasetCreateWithImport(path, dir, &err);
+    if (!ds) {
+        fprintf(stderr, "skip %s: %s\n", path, err ? OCStringGetCString(err) : "import failed");
+        if (err) OCRelease(err);
+        return;
+    }
+    printf("%s\n", path);
+    const int reps = 3;
+    for (size_t e = 0; e < sizeof(kEncodings) / sizeof(kEncodings[0]); ++e) {
+        RMNCodec codec = kRMNCodecNone;
+        bool shuffle = false;
+        RMNCodecParseEncoding(kEncodings[e], &codec, &shuffle);
+        if (!RMNCodecIsAvailable(codec)) continue;
+        size_t raw = 0, packed = 0;
+        double encodeSeconds = 0, decodeSeconds = 0;
+        bool ok = true;
+        for (OCIndex d = 0; d < DatasetGetDependentVariableCount(ds); ++d) {
+            DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, d);
+            size_t width = RMNCodecShuffleWidth(DependentVariableGetElementType(dv));
+            for (OCIndex c = 0; c < DependentVariableGetComponentCount(dv); ++c) {
+                OCDataRef blob = DependentVariableGetComponentAtIndex(dv, c);
+                const uint8_t *bytes = OCDataGetBytesPtr(blob);
+                size_t length = (size_t)OCDataGetLength(blob);
+                RMNCodecBuffer buf = {0};
+                double t0 = now_seconds();
+                for (int r = 0; r < reps; ++r) {
+                    buf.length = 0;
+                    ok &= RMNCodecEncode(codec, shuffle, width, bytes, length,
+                                         RMNCodecBufferSink, &buf);
+                }
+                encodeSeconds += now_seconds() - t0;
+                uint8_t *back = malloc(length ? length : 1);
+                t0 = now_seconds();
+                for (int r = 0; r < reps; ++r)
+                    ok &= back && RMNCodecDecode(codec, shuffle, width, buf.bytes, buf.length,
+                                                 back, length, NULL);
+                decodeSeconds += now_seconds() - t0;
+                ok &= back && memcmp(back, bytes, length) == 0;
+                raw += length;
+                packed += buf.length;
+                free(back);
+                free(buf.bytes);
+            }
+        }
+        if (!ok) fprintf(stderr, "round trip mismatch with %s\n", kEncodings[e]);
+        printf("  %-16s ratio %6.2f  encode %8.1f MB/s  decode %8.1f MB/s\n", kEncodings[e],
+               packed ? (double)raw / (double)packed : 0.0,
+               encodeSeconds > 0 ? (double)raw * reps / encodeSeconds / 1e6 : 0.0,
+               decodeSeconds > 0 ? (double)raw * reps / decodeSeconds / 1e6 : 0.0);
+    }
+    OCRelease(ds);
+}
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            char dir[PATH_MAX];
+            snprintf(dir, sizeof(dir), "%s", argv[i]);
+            char *slash = strrchr(dir, '/');
+            if (slash)
+                *slash = '\0';
+            else
+                strcpy(dir, ".");
+            bench_file(argv[i], dir);
+        }
+        return 0;
+    }
+    const char *root = getenv("CSDM_TEST_ROOT");
+    if (!root) {
+        fprintf(stderr, "set CSDM_TEST_ROOT or pass CSDM files\n");
+        return 0;
+    }
+    for (size_t f = 0; f < sizeof(kDefaultFiles) / sizeof(kDefaultFiles[0]); ++f) {
+        char path[PATH_MAX], dir[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", root, kDefaultFiles[f]);
+        snprintf(dir, sizeof(dir), "%s", path);
+        *strrchr(dir, '/') = '\0';
+        bench_file(path, dir);
+    }
+    return 0;
+}
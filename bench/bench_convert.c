@@ -0,0 +1,51 @@
+// bench_convert.c — DependentVariableSetElementType throughput for each
+// RMNConvert kernel on common element type changes.
+//
+//   make bench && build/bin/bench_convert
+//
+// Each pair converts a 16M-element component there and back, so every run
+// starts from the same data.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+int main(void) {
+    const OCIndex n = 16 << 20;
+    const struct {
+        OCNumberType from, to;
+        const char *name;
+    } pairs[] = {
+        {kOCNumberSInt16Type, kOCNumberFloat32Type, "int16 <-> float32"},
+        {kOCNumberComplex64Type, kOCNumberComplex128Type, "complex64 <-> complex128"},
+        {kOCNumberFloat64Type, kOCNumberFloat32Type, "float64 <-> float32"},
+        {kOCNumberSInt64Type, kOCNumberFloat64Type, "int64 <-> float64"},
+    };
+    const char *kernelNames[] = {"scalar", "avx2", "avx512"};
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); ++p) {
+        DependentVariableRef dv =
+            DependentVariableCreateDefault(STR("scalar"), pairs[p].from, n, NULL);
+        if (!dv) return 1;
+        printf("%-26s", pairs[p].name);
+        for (int k = kRMNConvertKernelScalar; k <= kRMNConvertKernelAVX512; ++k) {
+            if (!RMNConvertSetKernel((RMNConvertKernel)k)) continue;
+            const int reps = 5;
+            double t0 = now_seconds();
+            for (int r = 0; r < reps; ++r) {
+                DependentVariableSetElementType(dv, pairs[p].to);
+                DependentVariableSetElementType(dv, pairs[p].from);
+            }
+            double dt = (now_seconds() - t0) / (2 * reps);
+            printf("  %s %6.2f ms", kernelNames[k], dt * 1e3);
+        }
+        printf("\n");
+        OCRelease(dv);
+    }
+    RMNConvertSetKernel(kRMNConvertKernelAuto);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// bench_decimal.c — "none" encoding number text: printf/strtod vs RMNDecimal.
+//
+//   make bench && build/bin/bench_decimal [millions of values]
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static void report(const char *label, size_t count, double seconds, size_t chars) {
+    printf("  %-26s %8.1f Mvalues/s  %5.1f chars/value\n", label, (double)count / seconds / 1e6,
+           (double)chars / (double)count);
+}
+// what the export used before RMNDecimal: cJSON's %1.15g, checked, else %1.17g
+static size_t format_printf(double d, char *buf) {
+    int len = snprintf(buf, kRMNDecimalMaxLength, "%1.15g", d);
+    double test = 0.0;
+    if (sscanf(buf, "%lg", &test) != 1 || test != d)
+        len = snprintf(buf, kRMNDecimalMaxLength, "%1.17g", d);
+    return (size_t)len;
+}
+int main(int argc, char **argv) {
+    size_t n = (argc > 1 ? (size_t)atol(argv[1]) : 2) * 1000000;
+    double *values = malloc(n * sizeof(double));
+    if (!values) return 1;
+    // measured-signal-like doubles, plus the float32 samples common in CSDM files
+    srand(42);
+    for (size_t i = 0; i < n; ++i) {
+        double v = sin(0.001 * (double)i) * 1e3 + (double)rand() / RAND_MAX;
+        values[i] = (i & 1) ? (double)(float)v : v;
+    }
+    printf("number text, %zu values\n", n);
+    char buf[kRMNDecimalMaxLength];
+    size_t chars = 0;
+    double t0 = now_seconds();
+    for (size_t i = 0; i < n; ++i) chars += format_printf(values[i], buf);
+    report("format printf %1.15g/17g", n, now_seconds() - t0, chars);
+    chars = 0;
+    size_t mismatches = 0;
+    t0 = now_seconds();
+    for (size_t i = 0; i < n; ++i) chars += RMNDecimalFormatDouble(values[i], buf);
+    report("format RMNDecimal", n, now_seconds() - t0, chars);
+    for (size_t i = 0; i < n; ++i) {
+        RMNDecimalFormatDouble(values[i], buf);
+        if (strtod(buf, NULL) != values[i]) mismatches++;
+    }
+    // parse the shortest text back, as the "none" import does
+    char *text = malloc(n * kRMNDecimalMaxLength);
+    size_t *offsets = malloc((n + 1) * sizeof(size_t));
+    if (!text || !offsets) return 1;
+    offsets[0] = 0;
+    for (size_t i = 0; i < n; ++i)
+        offsets[i + 1] = offsets[i] + RMNDecimalFormatDouble(values[i], text + offsets[i]) + 1;
+    double sum = 0.0;
+    t0 = now_seconds();
+    for (size_t i = 0; i < n; ++i) sum += strtod(text + offsets[i], NULL);
+    report("parse strtod", n, now_seconds() - t0, offsets[n] - n);
+    double check = 0.0;
+    t0 = now_seconds();
+    for (size_t i = 0; i < n; ++i) {
+        double v = 0.0;
+        RMNDecimalParseDouble(text + offsets[i], text + offsets[i + 1] - 1, &v);
+        check += v;
+    }
+    report("parse RMNDecimal", n, now_seconds() - t0, offsets[n] - n);
+    if (check != sum) mismatches++;
+    if (mismatches) fprintf(stderr, "%zu values did not round trip\n", mismatches);
+    free(offsets);
+    free(text);
+    free(values);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+// bench_elementwise.c — in-place DependentVariable arithmetic (scaling,
+// conjugation, absolute value, DV-with-DV sums and products) for each
+// kernel, on one thread and threaded.
+//
+//   make bench && build/bin/bench_elementwise
+//
+// Each operation runs over a 16M-element component; scaling alternates the
+// factor and its inverse so the values stay finite.  The binary cases use a
+// second component of the same size, in float32 for the converted sum.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+enum { kScale, kScaleComplex, kConjugate, kAbsolute, kAdd, kAddFloat32, kMultiply };
+static double time_op(int op, OCNumberType type, OCIndex n) {
+    DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"), type, n, NULL);
+    DependentVariableRef operand = DependentVariableCreateDefault(
+        STR("scalar"), op == kAddFloat32 ? kOCNumberFloat32Type : type, n, NULL);
+    if (!dv || !operand) {
+        if (dv) OCRelease(dv);
+        if (operand) OCRelease(operand);
+        return 0;
+    }
+    uint8_t *bytes =
+        OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+    size_t length = (size_t)n * OCNumberTypeSize(type);
+    for (size_t i = 0; i < length; ++i) bytes[i] = (uint8_t)(i * 131u >> 3) & 0x3f;
+    const int reps = 6;
+    double t0 = now_seconds();
+    for (int r = 0; r < reps; ++r) {
+        switch (op) {
+            case kScale:
+                DependentVariableMultiplyValuesByDimensionlessRealConstant(dv, -1, r & 1 ? 0.5 : 2.0);
+                break;
+            case kScaleComplex:
+                DependentVariableMultiplyValuesByDimensionlessComplexConstant(dv, -1, r & 1 ? -I : I);
+                break;
+            case kConjugate:
+                DependentVariableConjugate(dv, -1);
+                break;
+            case kAbsolute:
+                // the first call narrows complex types; time the same work every rep
+                RMNElementwiseAbsolute(type, bytes, (size_t)n);
+                break;
+            case kAdd:
+            case kAddFloat32:
+                if (r & 1)
+                    DependentVariableSubtract(dv, operand, NULL);
+                else
+                    DependentVariableAdd(dv, operand, NULL);
+                break;
+            case kMultiply:
+                DependentVariableMultiply(dv, operand, NULL);
+                break;
+        }
+    }
+    double dt = (now_seconds() - t0) / reps;
+    OCRelease(operand);
+    OCRelease(dv);
+    return dt * 1e9 / (double)n;
+}
+int main(void) {
+    const OCIndex n = 16 << 20;
+    const struct {
+        int op;
+        OCNumberType type;
+        const char *name;
+    } cases[] = {
+        {kScale, kOCNumberFloat32Type, "scale float32"},
+        {kScale, kOCNumberFloat64Type, "scale float64"},
+        {kScale, kOCNumberSInt16Type, "scale int16"},
+        {kScaleComplex, kOCNumberComplex64Type, "scale complex64 by i"},
+        {kScaleComplex, kOCNumberComplex128Type, "scale complex128 by i"},
+        {kConjugate, kOCNumberComplex128Type, "conjugate complex128"},
+        {kAbsolute, kOCNumberComplex64Type, "abs complex64"},
+        {kAbsolute, kOCNumberComplex128Type, "abs complex128"},
+        {kAdd, kOCNumberFloat64Type, "add float64"},
+        {kAddFloat32, kOCNumberFloat64Type, "add float32 to float64"},
+        {kAdd, kOCNumberSInt16Type, "add int16"},
+        {kMultiply, kOCNumberComplex64Type, "multiply complex64"},
+    };
+    const char *kernelNames[] = {"scalar", "avx2", "avx512"};
+    printf("%zu processors, threaded from %zu elements (ns per element)\n",
+           RMNParallelProcessorCount(), RMNElementwiseGetParallelThreshold());
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        printf("%-24s", cases[c].name);
+        for (int k = kRMNConvertKernelScalar; k <= kRMNConvertKernelAVX512; ++k) {
+            if (!RMNConvertSetKernel((RMNConvertKernel)k)) continue;
+            RMNElementwiseSetParallelThreshold(SIZE_MAX);
+            double single = time_op(cases[c].op, cases[c].type, n);
+            RMNElementwiseSetParallelThreshold(0);
+            double threaded = time_op(cases[c].op, cases[c].type, n);
+            printf("  %s %5.2f / %5.2f", kernelNames[k], single, threaded);
+        }
+        printf("\n");
+    }
+    RMNConvertSetKernel(kRMNConvertKernelAuto);
+    return 0;
+}
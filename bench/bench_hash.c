@@ -0,0 +1,136 @@
+// bench_hash.c — RMNHashXXH3 and RMNHashCRC32C throughput, DatasetExport
+// with duplicated external blobs, and the cost of verifying blob checksums
+// on import.
+//
+//   make bench && build/bin/bench_hash
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static void bench_throughput(void) {
+    const size_t sizes[] = {64, 1024, 64 * 1024, 16 << 20};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t n = sizes[s];
+        uint8_t *bytes = malloc(n);
+        if (!bytes) return;
+        for (size_t i = 0; i < n; ++i) bytes[i] = (uint8_t)(i * 131u + 7u);
+        size_t reps = ((size_t)256 << 20) / n;
+        uint64_t sink = 0;
+        double t0 = now_seconds();
+        for (size_t r = 0; r < reps; ++r) sink ^= RMNHashXXH3(bytes, n);
+        double dt = now_seconds() - t0;
+        printf("xxh3   %9zu B   %7.2f GB/s   (%016llx)\n", n, (double)n * reps / dt / 1e9,
+               (unsigned long long)sink);
+        uint32_t crc = 0;
+        t0 = now_seconds();
+        for (size_t r = 0; r < reps; ++r) crc ^= RMNHashCRC32C(0, bytes, n);
+        dt = now_seconds() - t0;
+        printf("crc32c %9zu B   %7.2f GB/s   (%08lx)\n", n, (double)n * reps / dt / 1e9,
+               (unsigned long)crc);
+        free(bytes);
+    }
+}
+/// `copies` external DVs holding the same `n` doubles, as left by copying a
+/// dataset's variables and editing only their metadata.
+static DatasetRef make_dataset(OCIndex n, int copies) {
+    OCMutableArrayRef dims = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(copies, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    SILinearDimensionRef dim =
+        SILinearDimensionCreateMinimal(kSIQuantityDimensionless, n, increment, NULL, NULL);
+    OCArrayAppendValue(dims, dim);
+    for (int v = 0; v < copies; ++v) {
+        DependentVariableRef dv =
+            DependentVariableCreateDefault(STR("scalar"), kOCNumberFloat64Type, n, NULL);
+        double *values = (double *)OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        for (OCIndex i = 0; i < n; ++i) values[i] = 0.5 * (double)i;
+        char url[64];
+        snprintf(url, sizeof(url), "file:bench_hash_%d.data", v);
+        OCStringRef u = OCStringCreateWithCString(url);
+        DependentVariableSetType(dv, STR("external"));
+        DependentVariableSetComponentsURL(dv, u);
+        OCRelease(u);
+        OCArrayAppendValue(dvs, dv);
+        OCRelease(dv);
+    }
+    DatasetRef ds = DatasetCreateMinimal(dims, dvs, NULL);
+    OCRelease(dim);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    return ds;
+}
+static void bench_export(void) {
+    const OCIndex n = 4 << 20;  // 32 MiB per variable
+    const int copies = 8;
+    DatasetRef ds = make_dataset(n, copies);
+    if (!ds) return;
+    OCStringRef err = NULL;
+    const int reps = 5;
+    double t0 = now_seconds();
+    for (int r = 0; r < reps; ++r) {
+        if (!DatasetExport(ds, "tmp/bench_hash.csdfe", "tmp", &err)) {
+            fprintf(stderr, "export failed: %s\n", err ? OCStringGetCString(err) : "?");
+            if (err) OCRelease(err);
+            break;
+        }
+    }
+    double dt = (now_seconds() - t0) / reps;
+    printf("export %d identical 32 MiB variables: %.1f ms (one blob written)\n", copies, dt * 1e3);
+    OCRelease(ds);
+}
+/// Import time of distinct external blobs, exported with and without
+/// recorded checksums.
+static void bench_import_checksums(void) {
+    const OCIndex n = 4 << 20;
+    const int copies = 8;
+    DatasetRef ds = make_dataset(n, copies);
+    if (!ds) return;
+    for (int v = 0; v < copies; ++v) {
+        // distinct values, so every variable gets its own blob
+        double *values = (double *)OCDataGetMutableBytes((OCMutableDataRef)
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, v), 0));
+        values[0] = (double)v;
+    }
+    OCStringRef err = NULL;
+    double seconds[2] = {0, 0};
+    const int reps = 5;
+    for (int checked = 0; checked < 2; ++checked) {
+        DatasetSetBlobChecksums(checked != 0);
+        if (!DatasetExport(ds, "tmp/bench_crc.csdfe", "tmp", &err)) {
+            fprintf(stderr, "export failed: %s\n", err ? OCStringGetCString(err) : "?");
+            if (err) OCRelease(err);
+            break;
+        }
+        double t0 = now_seconds();
+        for (int r = 0; r < reps; ++r) {
+            DatasetRef back = DatasetCreateWithImport("tmp/bench_crc.csdfe", "tmp", &err);
+            if (!back) {
+                fprintf(stderr, "import failed: %s\n", err ? OCStringGetCString(err) : "?");
+                if (err) OCRelease(err);
+                break;
+            }
+            OCRelease(back);
+        }
+        seconds[checked] = (now_seconds() - t0) / reps;
+    }
+    DatasetSetBlobChecksums(false);
+    printf("import %d x 32 MiB: %.1f ms plain, %.1f ms verified (%+.1f%%)\n", copies,
+           seconds[0] * 1e3, seconds[1] * 1e3,
+           seconds[0] > 0 ? 100.0 * (seconds[1] - seconds[0]) / seconds[0] : 0.0);
+    OCRelease(ds);
+}
+int main(void) {
+    bench_throughput();
+    bench_export();
+    bench_import_checksums();
+    return 0;
+}
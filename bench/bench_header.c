@@ -0,0 +1,79 @@
+// bench_header.c — metadata-only scan vs. full import, per CSDM test file.
+//
+//   make bench && CSDM_TEST_ROOT=tests/CSDM-TestFiles-1.0 build/bin/bench_header [file.csdf ...]
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static const char *kDefaultFiles[] = {
+    "NMR/blochDecay/blochDecay_base64.csdf",
+    "NMR/satrec/satRec_none.csdf",
+    "image/raccoon_image.csdf",
+    "sparse/iglu_2d.csdf",
+    "vector/wind_velocity/NCEP_Global_none.csdf",
+    "correlatedDataset/forecast/NCEI.csdfe",
+};
+static void bench_file(const char *path, const char *dir) {
+    const int reps = 20;
+    OCStringRef err = NULL;
+    double t0 = now_seconds();
+    for (int r = 0; r < reps; ++r) {
+        DatasetRef ds = DatasetCreateWithImport(path, dir, &err);
+        if (!ds) {
+            fprintf(stderr, "skip %s: %s\n", path, err ? OCStringGetCString(err) : "import failed");
+            if (err) OCRelease(err);
+            return;
+        }
+        OCRelease(ds);
+    }
+    double import = (now_seconds() - t0) / reps;
+    t0 = now_seconds();
+    for (int r = 0; r < reps; ++r) {
+        OCDictionaryRef header = DatasetCopyHeaderFromFile(path, &err);
+        if (!header) {
+            fprintf(stderr, "skip %s: %s\n", path, err ? OCStringGetCString(err) : "scan failed");
+            if (err) OCRelease(err);
+            return;
+        }
+        OCRelease(header);
+    }
+    double scan = (now_seconds() - t0) / reps;
+    printf("%s\n  import %10.1f us   header %8.1f us   (%.0fx)\n", path, import * 1e6, scan * 1e6,
+           scan > 0 ? import / scan : 0.0);
+}
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            char dir[PATH_MAX];
+            snprintf(dir, sizeof(dir), "%s", argv[i]);
+            char *slash = strrchr(dir, '/');
+            if (slash)
+                *slash = '\0';
+            else
+                strcpy(dir, ".");
+            bench_file(argv[i], dir);
+        }
+        return 0;
+    }
+    const char *root = getenv("CSDM_TEST_ROOT");
+    if (!root) {
+        fprintf(stderr, "set CSDM_TEST_ROOT or pass CSDM files\n");
+        return 0;
+    }
+    for (size_t f = 0; f < sizeof(kDefaultFiles) / sizeof(kDefaultFiles[0]); ++f) {
+        char path[PATH_MAX], dir[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", root, kDefaultFiles[f]);
+        snprintf(dir, sizeof(dir), "%s", path);
+        *strrchr(dir, '/') = '\0';
+        bench_file(path, dir);
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+// bench_none_decode.c — "none" components from OCNumber lists: per-element
+// appends vs. the bulk fill in DependentVariableCreateFromDictionary.
+//
+//   make bench && CSDM_TEST_ROOT=tests/CSDM-TestFiles-1.0 build/bin/bench_none_decode [file.csdf ...]
+//
+// Each dependent variable is turned back into its "none" dictionary and
+// rebuilt repeatedly; the append loop is what the decoder did before.
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+static const char *kDefaultFiles[] = {
+    "NMR/satrec/satRec_none.csdf",
+    "GC/cinnamon_none.csdf",
+    "UV-vis/benzeneVapour_none.csdf",
+    "ir/caffeine_none.csdf",
+    "vector/electric_field/electric_field_none.csdf",
+    "vector/wind_velocity/NCEP_Global_none.csdf",
+};
+// the former decoder: one OCDataAppendBytes per value, type switch inside
+static OCDataRef append_decode(OCArrayRef numList, OCNumberType type) {
+    OCIndex n = OCArrayGetCount(numList);
+    OCMutableDataRef data = OCDataCreateMutable(0);
+    for (OCIndex j = 0; j < n; ++j) {
+        double v = 0;
+        OCNumberTryGetDouble(OCArrayGetValueAtIndex(numList, j), &v);
+        switch (type) {
+            case kOCNumberSInt32Type: {
+                int32_t i32 = (int32_t)v;
+                OCDataAppendBytes(data, (uint8_t const *)&i32, sizeof(i32));
+                break;
+            }
+            case kOCNumberFloat32Type:
+            case kOCNumberComplex64Type: {
+                float f = (float)v;
+                OCDataAppendBytes(data, (uint8_t const *)&f, sizeof(f));
+                break;
+            }
+            case kOCNumberFloat64Type:
+            case kOCNumberComplex128Type:
+                OCDataAppendBytes(data, (uint8_t const *)&v, sizeof(v));
+                break;
+            default: {
+                int64_t i64 = (int64_t)v;
+                OCDataAppendBytes(data, (uint8_t const *)&i64, sizeof(i64));
+                break;
+            }
+        }
+    }
+    return data;
+}
+static void bench_file(const char *path, const char *dir) {
+    OCStringRef err = NULL;
+    DatasetRef ds = DatasetCreateWithImport(path, dir, &err);
+    if (!ds) {
+        fprintf(stderr, "skip %s: %s\n", path, err ? OCStringGetCString(err) : "import failed");
+        if (err) OCRelease(err);
+        return;
+    }
+    OCArrayRef dvs = DatasetGetDependentVariables(ds);
+    for (OCIndex d = 0; d < OCArrayGetCount(dvs); ++d) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, d);
+        DependentVariableSetEncoding(dv, STR(kDependentVariableEncodingValueNone));
+        OCDictionaryRef dict = DependentVariableCopyAsDictionary(dv);
+        if (!dict) continue;
+        OCArrayRef comps = OCDictionaryGetValue(dict, STR(kDependentVariableComponentsKey));
+        OCNumberType type = DependentVariableGetElementType(dv);
+        size_t values = 0;
+        for (OCIndex c = 0; c < OCArrayGetCount(comps); ++c)
+            values += (size_t)OCArrayGetCount(OCArrayGetValueAtIndex(comps, c));
+        int reps = values ? (int)(4000000 / values) + 1 : 1;
+        double t0 = now_seconds();
+        for (int r = 0; r < reps; ++r)
+            for (OCIndex c = 0; c < OCArrayGetCount(comps); ++c)
+                OCRelease(append_decode(OCArrayGetValueAtIndex(comps, c), type));
+        double append = now_seconds() - t0;
+        t0 = now_seconds();
+        for (int r = 0; r < reps; ++r) {
+            DependentVariableRef copy = DependentVariableCreateFromDictionary(dict, NULL);
+            if (copy) OCRelease(copy);
+        }
+        double bulk = now_seconds() - t0;
+        printf("%s dv[%ld] %zu values\n", path, (long)d, values);
+        printf("  %-26s %8.1f Mvalues/s\n", "append per element", values * reps / append / 1e6);
+        printf("  %-26s %8.1f Mvalues/s  (whole DV)\n", "bulk fill", values * reps / bulk / 1e6);
+        OCRelease(dict);
+    }
+    OCRelease(ds);
+}
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) {
+            char dir[PATH_MAX];
+            snprintf(dir, sizeof(dir), "%s", argv[i]);
+            char *slash = strrchr(dir, '/');
+            if (slash)
+                *slash = '\0';
+            else
+                strcpy(dir, ".");
+            bench_file(argv[i], dir);
+        }
+        return 0;
+    }
+    const char *root = getenv("CSDM_TEST_ROOT");
+    if (!root) {
+        fprintf(stderr, "set CSDM_TEST_ROOT or pass CSDM files\n");
+        return 0;
+    }
+    for (size_t f = 0; f < sizeof(kDefaultFiles) / sizeof(kDefaultFiles[0]); ++f) {
+        char path[PATH_MAX], dir[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", root, kDefaultFiles[f]);
+        snprintf(dir, sizeof(dir), "%s", path);
+        *strrchr(dir, '/') = '\0';
+        bench_file(path, dir);
+    }
+    return 0;
+}
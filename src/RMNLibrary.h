@@ -70,11 +70,23 @@ typedef struct impl_Dataset *DatasetRef;
 
 // Utility headers
 #include "utils/RMNGridUtils.h"
+#include "utils/RMNBase64.h"
+#include "utils/RMNJSONScan.h"
+#include "utils/RMNDecimal.h"
+#include "utils/RMNParallel.h"
+#include "utils/RMNChunkedLayout.h"
+#include "utils/RMNCodec.h"
+#include "utils/RMNContainer.h"
+#include "utils/RMNAsyncIO.h"
+#include "utils/RMNHash.h"
+#include "utils/RMNConvert.h"
+#include "utils/RMNElementwise.h"
 
 // Import/Export headers
 #include "importers/JCAMP.h"
 #include "importers/Tecmag.h"
 #include "importers/Image.h"
+#include "importers/BatchConvert.h"
 
 // Spectroscopy headers
 #include "spectroscopy/NMRSpectroscopy.h"
@@ -4,6 +4,7 @@
 #include <errno.h>
 #include <libgen.h>
 #include <limits.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -12,10 +13,16 @@
 #include "../RMNLibrary.h"
 #if defined(_WIN32)
 #include <direct.h>
+#include <io.h>
+#include <process.h>
 #define MKDIR(path) _mkdir(path)
+#define getpid _getpid
 #define PATH_SEPARATOR '\\'
 #else
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/types.h>
+#include <unistd.h>
 #define MKDIR(path) mkdir(path, 0755)
 #define PATH_SEPARATOR '/'
 #endif
@@ -36,6 +43,9 @@
 #define kDatasetFocusKey "focus"
 #define kDatasetPreviousFocusKey "previous_focus"
 #define kDatasetMetadataKey "application"
+#define kDatasetBlobWriteBufferSize (1 << 20)
+#define kDatasetAsyncIODepth 64  // transfers in flight for io_uring batches
+#define kDatasetChecksumBlockSize ((size_t)4 << 20)  // CRC-32C block of an external blob
 #pragma region Type Registration
 static OCTypeID kDatasetID = kOCNotATypeID;
 struct impl_Dataset {
@@ -439,7 +449,14 @@ DatasetRef DatasetCreateMinimal(
     );
 }
 
-OCDictionaryRef DatasetCopyAsDictionary(DatasetRef ds) {
+/// Whether an export writes `dv` as a blob named by its components_url;
+/// an external DV without one is written inline like an internal DV.
+static bool impl_ExportsExternally(DependentVariableRef dv) {
+    return DependentVariableShouldSerializeExternally(dv) && DependentVariableGetComponentsURL(dv);
+}
+static OCDictionaryRef impl_DatasetCopyAsDictionary(DatasetRef ds,
+                                                    OCArrayRef dvPlaceholders,
+                                                    OCStringRef *outError) {
     if (!ds) return NULL;
     OCMutableDictionaryRef dict = OCDictionaryCreateMutable(0);
     if (!dict) return NULL;
@@ -515,12 +532,46 @@ OCDictionaryRef DatasetCopyAsDictionary(DatasetRef ds) {
         OCMutableArrayRef dvs_arr = OCArrayCreateMutable(m, &kOCTypeArrayCallBacks);
         for (OCIndex i = 0; i < m; ++i) {
             DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(ds->dependentVariables, i);
+            if (dvPlaceholders) {
+                // Same dictionary as the internal copy below, without duplicating
+                // the components: payloads are streamed in by the caller.  External
+                // DVs keep their type and components_url; their blobs are separate.
+                OCDictionaryRef ddv = DependentVariableCopyAsDictionaryWithPlaceholders(
+                    dv, (OCArrayRef)OCArrayGetValueAtIndex(dvPlaceholders, i));
+                if (ddv && !impl_ExportsExternally(dv)) {
+                    OCDictionarySetValue((OCMutableDictionaryRef)ddv,
+                                         STR(kDependentVariableTypeKey),
+                                         STR(kDependentVariableComponentTypeValueInternal));
+                    OCDictionaryRemoveValue((OCMutableDictionaryRef)ddv,
+                                            STR(kDependentVariableComponentsURLKey));
+                }
+                if (!ddv) {
+                    if (outError)
+                        *outError = OCStringCreateWithFormat(
+                            STR("Failed to serialize dependent variable %ld"), (long)i);
+                    OCRelease(dvs_arr);
+                    OCRelease(dict);
+                    return NULL;
+                }
+                OCArrayAppendValue(dvs_arr, ddv);
+                OCRelease(ddv);
+                continue;
+            }
             DependentVariableRef copy = DependentVariableCreateCopy(dv);
             DependentVariableSetType(copy, STR("internal"));
             OCDictionaryRef ddv = DependentVariableCopyAsDictionary(copy);
+            OCRelease(copy);
+            if (!ddv) {
+                // e.g. a component that cannot be base64-encoded or compressed
+                if (outError)
+                    *outError = OCStringCreateWithFormat(
+                        STR("Failed to encode the components of dependent variable %ld"), (long)i);
+                OCRelease(dvs_arr);
+                OCRelease(dict);
+                return NULL;
+            }
             OCArrayAppendValue(dvs_arr, ddv);
             OCRelease(ddv);
-            OCRelease(copy);
         }
         OCDictionarySetValue(dict,
                              STR(kDatasetDependentVariablesKey),
@@ -552,6 +603,9 @@ OCDictionaryRef DatasetCopyAsDictionary(DatasetRef ds) {
     }
     return (OCDictionaryRef)dict;
 }
+OCDictionaryRef DatasetCopyAsDictionary(DatasetRef ds) {
+    return impl_DatasetCopyAsDictionary(ds, NULL, NULL);
+}
 DatasetRef DatasetCreateFromDictionary(OCDictionaryRef dict, OCStringRef *outError) {
     if (outError) *outError = NULL;
     if (!dict) {
@@ -938,7 +992,12 @@ static OCDictionaryRef DatasetDictionaryCreateFromJSON(cJSON *json,
     return dict;
 }
 // ————— DatasetCreateFromJSON —————
-DatasetRef DatasetCreateFromJSON(cJSON *root, OCStringRef *outError) {
+/// decodedComponents (optional): one OCArray of OCData per dependent-variable
+/// object, as produced by impl_DatasetExtractInlineComponents(); non-empty
+/// entries replace that DV's (stripped) "components".
+static DatasetRef impl_DatasetCreateFromJSON(cJSON *root,
+                                             OCArrayRef decodedComponents,
+                                             OCStringRef *outError) {
     if (outError) *outError = NULL;
     // Must have valid JSON object
     if (!root) {
@@ -951,6 +1010,19 @@ DatasetRef DatasetCreateFromJSON(cJSON *root, OCStringRef *outError) {
         // outError already set by DatasetDictionaryCreateFromJSON
         return NULL;
     }
+    // Step 1a: hand over components that were decoded straight from the text
+    if (decodedComponents) {
+        OCArrayRef dvDicts = OCDictionaryGetValue(dict, STR(kDatasetDependentVariablesKey));
+        OCIndex n = dvDicts ? OCArrayGetCount(dvDicts) : 0;
+        if (n > OCArrayGetCount(decodedComponents)) n = OCArrayGetCount(decodedComponents);
+        for (OCIndex i = 0; i < n; ++i) {
+            OCArrayRef comps = OCArrayGetValueAtIndex(decodedComponents, i);
+            if (OCArrayGetCount(comps) == 0) continue;
+            OCMutableDictionaryRef dvDict =
+                (OCMutableDictionaryRef)OCArrayGetValueAtIndex(dvDicts, i);
+            OCDictionarySetValue(dvDict, STR(kDependentVariableComponentsKey), comps);
+        }
+    }
     // Step 2: Build the Dataset from the dictionary
     DatasetRef ds = DatasetCreateFromDictionary(dict, outError);
     OCRelease(dict);
@@ -964,8 +1036,36 @@ DatasetRef DatasetCreateFromJSON(cJSON *root, OCStringRef *outError) {
     }
     return ds;
 }
+DatasetRef DatasetCreateFromJSON(cJSON *root, OCStringRef *outError) {
+    return impl_DatasetCreateFromJSON(root, NULL, outError);
+}
 #pragma endregion Creators
 #pragma region Export/Import
+// worker threads for blob I/O and base64 coding; 1 keeps everything serial
+static OCIndex gDatasetIOWorkerCount = 1;
+void DatasetSetIOWorkerCount(OCIndex workers) {
+    gDatasetIOWorkerCount = workers < 0 ? 1 : workers;
+}
+OCIndex DatasetGetIOWorkerCount(void) {
+    return gDatasetIOWorkerCount == 0 ? (OCIndex)RMNParallelProcessorCount()
+                                      : gDatasetIOWorkerCount;
+}
+// how DatasetExport() puts its files in place
+static DatasetExportMode gDatasetExportMode = kDatasetExportDirect;
+void DatasetSetExportMode(DatasetExportMode mode) {
+    gDatasetExportMode = mode;
+}
+DatasetExportMode DatasetGetExportMode(void) {
+    return gDatasetExportMode;
+}
+// record CRC-32C of external blobs on export
+static bool gDatasetBlobChecksums = false;
+void DatasetSetBlobChecksums(bool enabled) {
+    gDatasetBlobChecksums = enabled;
+}
+bool DatasetGetBlobChecksums(void) {
+    return gDatasetBlobChecksums;
+}
 /// Helper: parse a components_url and extract the relative path
 /// For URLs like "file:./path/to/file", returns "./path/to/file"
 /// For non-file URLs or plain paths, returns the input unchanged
@@ -1054,6 +1154,52 @@ static uint8_t *read_file_bytes(const char *path, size_t *out_len) {
     if (out_len) *out_len = len;
     return buf;
 }
+/// Helper: map a whole file read-only (private, copy-on-write) so callers can
+/// copy slices straight out of the page cache without an intermediate heap
+/// buffer.  Callers still copy every byte they keep, and each page is
+/// faulted in as that copy touches it.  Falls back to
+/// read_file_bytes() where mmap is unavailable or the file is empty.
+/// Release the result with unmap_file_bytes(), passing back *out_mapped.
+static uint8_t *map_file_bytes(const char *path, size_t *out_len, bool *out_mapped) {
+    if (out_len) *out_len = 0;
+    if (out_mapped) *out_mapped = false;
+    if (!path) return NULL;
+#if !defined(_WIN32)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    size_t len = (size_t)st.st_size;
+    if (len > 0) {
+        void *p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);  // the mapping holds its own reference to the file
+        if (p != MAP_FAILED) {
+#if defined(MADV_SEQUENTIAL)
+            madvise(p, len, MADV_SEQUENTIAL);
+#endif
+            if (out_len) *out_len = len;
+            if (out_mapped) *out_mapped = true;
+            return (uint8_t *)p;
+        }
+    } else {
+        close(fd);
+    }
+#endif
+    return read_file_bytes(path, out_len);
+}
+static void unmap_file_bytes(uint8_t *bytes, size_t len, bool mapped) {
+    if (!bytes) return;
+#if !defined(_WIN32)
+    if (mapped) {
+        munmap(bytes, len);
+        return;
+    }
+#endif
+    free(bytes);
+}
 static bool ensure_parent_dirs(const char *fullpath, OCStringRef *outError) {
     if (!fullpath) {
         if (outError) *outError = STR("Invalid path");
@@ -1103,63 +1249,706 @@ static bool derive_directory_from_path(const char *filepath, char *output, size_
     }
     return true;
 }
-// ————— DatasetExport —————
-bool DatasetExport(DatasetRef ds,
-                   const char *json_path,
-                   const char *binary_dir,
-                   OCStringRef *outError) {
-    if (outError) *outError = NULL;
-    if (!ds || !json_path) {
-        if (outError) *outError = STR("Invalid arguments");
-        return false;
+/// Helper: sibling path that an atomic export writes before renaming,
+/// "<path>.<pid>-<serial>.rmntmp", so exports to the same path from other
+/// processes or threads never share (or delete) each other's temporaries.
+static bool temp_path_for(const char *path, char *out, size_t size) {
+    static atomic_uint serial;
+    unsigned n = atomic_fetch_add_explicit(&serial, 1u, memory_order_relaxed);
+    int len = snprintf(out, size, "%s.%ld-%u.rmntmp", path, (long)getpid(), n);
+    return len > 0 && (size_t)len < size;
+}
+/// Helper: rename() that replaces an existing `to`; atomic on POSIX.
+static bool replace_file(const char *from, const char *to) {
+#if defined(_WIN32)
+    remove(to);
+#endif
+    return rename(from, to) == 0;
+}
+/// Helper: push a stream's data to stable storage.
+static bool sync_stream(FILE *f) {
+    if (fflush(f) != 0) return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+/// Helper: make renames into the directory holding `path` durable.  There
+/// is no directory handle to flush on Windows, where NTFS journals renames.
+static bool sync_parent_directory(const char *path) {
+#if defined(_WIN32)
+    (void)path;
+    return true;
+#else
+    char tmp[PATH_MAX];
+    if (snprintf(tmp, sizeof(tmp), "%s", path) >= (int)sizeof(tmp)) return false;
+    int fd = open(dirname(tmp), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+#endif
+}
+/// Helper: after a durable write, drop the file's (now clean) pages so a
+/// multi-GB export does not evict everything else from the page cache.
+static void release_written_pages(FILE *f) {
+#if defined(POSIX_FADV_DONTNEED)
+    posix_fadvise(fileno(f), 0, 0, POSIX_FADV_DONTNEED);
+#else
+    (void)f;
+#endif
+}
+/// A pending base64 decode of one inline component into preallocated
+/// storage, decompressed too for compressed encodings; run by
+/// impl_RunBase64DecodeJob() on the I/O workers.
+typedef struct {
+    const char *text;
+    size_t length;
+    uint8_t *out;
+    OCIndex dvIndex;  // entry in the extracted-components array
+    RMNCodec codec;
+    bool shuffle;
+    size_t shuffleWidth;
+    size_t outLength;  // decoded size, checked against the frame's header
+    bool ok;
+} impl_Base64DecodeJob;
+typedef struct {
+    impl_Base64DecodeJob *items;
+    size_t count;
+    size_t capacity;
+} impl_Base64DecodeJobs;
+static bool impl_AppendBase64DecodeJob(impl_Base64DecodeJobs *jobs, impl_Base64DecodeJob job) {
+    if (jobs->count == jobs->capacity) {
+        size_t cap = jobs->capacity ? jobs->capacity * 2 : 16;
+        impl_Base64DecodeJob *grown = realloc(jobs->items, cap * sizeof(*grown));
+        if (!grown) return false;
+        jobs->items = grown;
+        jobs->capacity = cap;
     }
-    
-    // If binary_dir is NULL, derive it from json_path
-    char derived_binary_dir[PATH_MAX];
-    if (!binary_dir) {
-        if (!derive_directory_from_path(json_path, derived_binary_dir, sizeof(derived_binary_dir))) {
-            if (outError) *outError = STR("Cannot determine binary directory from JSON path");
-            return false;
+    jobs->items[jobs->count++] = job;
+    return true;
+}
+static void impl_RunBase64DecodeJob(void *context, size_t index) {
+    impl_Base64DecodeJob *job = (impl_Base64DecodeJob *)context + index;
+    if (job->codec == kRMNCodecNone) {
+        job->ok = RMNBase64Decode(job->text, job->length, job->out, NULL);
+        return;
+    }
+    size_t n = RMNBase64DecodedLength(job->text, job->length);
+    size_t consumed = 0;
+    uint8_t *frame = malloc(n ? n : 1);
+    job->ok = frame && RMNBase64Decode(job->text, job->length, frame, NULL) &&
+              RMNCodecDecode(job->codec, job->shuffle, job->shuffleWidth, frame, n, job->out,
+                             job->outLength, &consumed) &&
+              consumed == n;
+    free(frame);
+}
+/// Helper: store sample `j` of an integer component from its exact sign
+/// and magnitude.  Returns false if the integer type cannot hold it.
+static bool impl_StoreInlineInteger(OCNumberType type, uint8_t *bytes, size_t j,
+                                    bool negative, uint64_t magnitude) {
+    if (negative && magnitude == 0) negative = false;
+    uint64_t limit;
+    switch (type) {
+        case kOCNumberSInt8Type: limit = negative ? (uint64_t)INT8_MAX + 1 : INT8_MAX; break;
+        case kOCNumberSInt16Type: limit = negative ? (uint64_t)INT16_MAX + 1 : INT16_MAX; break;
+        case kOCNumberSInt32Type: limit = negative ? (uint64_t)INT32_MAX + 1 : INT32_MAX; break;
+        case kOCNumberSInt64Type: limit = negative ? (uint64_t)INT64_MAX + 1 : INT64_MAX; break;
+        case kOCNumberUInt8Type: limit = negative ? 0 : UINT8_MAX; break;
+        case kOCNumberUInt16Type: limit = negative ? 0 : UINT16_MAX; break;
+        case kOCNumberUInt32Type: limit = negative ? 0 : UINT32_MAX; break;
+        case kOCNumberUInt64Type: limit = negative ? 0 : UINT64_MAX; break;
+        default: return false;
+    }
+    if (magnitude > limit) return false;
+    // -(m - 1) - 1 reaches INT64_MIN without overflowing
+    int64_t value = 0;
+    if (negative)
+        value = -(int64_t)(magnitude - 1) - 1;
+    else if (magnitude <= INT64_MAX)
+        value = (int64_t)magnitude;
+    switch (type) {
+        case kOCNumberSInt8Type: ((int8_t *)bytes)[j] = (int8_t)value; break;
+        case kOCNumberSInt16Type: ((int16_t *)bytes)[j] = (int16_t)value; break;
+        case kOCNumberSInt32Type: ((int32_t *)bytes)[j] = (int32_t)value; break;
+        case kOCNumberSInt64Type: ((int64_t *)bytes)[j] = value; break;
+        case kOCNumberUInt8Type: ((uint8_t *)bytes)[j] = (uint8_t)magnitude; break;
+        case kOCNumberUInt16Type: ((uint16_t *)bytes)[j] = (uint16_t)magnitude; break;
+        case kOCNumberUInt32Type: ((uint32_t *)bytes)[j] = (uint32_t)magnitude; break;
+        default: ((uint64_t *)bytes)[j] = magnitude; break;
+    }
+    return true;
+}
+/// Helper: decode one inline "components" array straight into typed
+/// component buffers, without cJSON or OCNumber nodes.  Base64 payloads are
+/// only sized and allocated here (compressed ones from their frame header);
+/// the decoding itself is queued on `jobs`.
+/// Returns NULL for anything unusual (escaped strings, empty components,
+/// non-numeric entries other than null for NaN, odd complex value counts,
+/// integers the numeric type cannot hold) so that the regular cJSON path handles it and reports
+/// errors.
+static OCMutableArrayRef impl_DecodeInlineComponents(const char *array,
+                                                     const char *end,
+                                                     OCNumberType type,
+                                                     bool isBase64,
+                                                     RMNCodec codec,
+                                                     bool shuffle,
+                                                     impl_Base64DecodeJobs *jobs,
+                                                     OCIndex dvIndex) {
+    size_t elemSize = OCNumberTypeSize(type);
+    if (elemSize == 0) return NULL;
+    bool isComplex = (type == kOCNumberComplex64Type || type == kOCNumberComplex128Type);
+    size_t firstJob = jobs->count;
+    OCMutableArrayRef comps = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+    if (!comps) return NULL;
+    const char *elem = RMNJSONArrayNextElement(array, end);
+    while (elem) {
+        const char *elemEnd = RMNJSONSkipValue(elem, end);
+        if (!elemEnd) goto fail;
+        OCMutableDataRef data = NULL;
+        if (isBase64) {
+            if (*elem != '"') goto fail;
+            const char *body = elem + 1;
+            size_t len = (size_t)(elemEnd - 1 - body);
+            if (memchr(body, '\\', len)) goto fail;
+            size_t nbytes = RMNBase64DecodedLength(body, len);
+            if (codec != kRMNCodecNone) {
+                // 12 characters cover the 8-byte length header
+                uint8_t header[9];
+                if (len < 12 || !RMNBase64Decode(body, 12, header, NULL) ||
+                    !RMNCodecGetDecodedLength(header, sizeof(header), &nbytes))
+                    goto fail;
+            }
+            if (nbytes == 0) goto fail;
+            data = OCDataCreateMutable(nbytes);
+            if (!data) goto fail;
+            OCDataSetLength(data, nbytes);
+            impl_Base64DecodeJob job = {body, len, OCDataGetMutableBytes(data), dvIndex,
+                                        codec, shuffle, RMNCodecShuffleWidth(type), nbytes, false};
+            if (!impl_AppendBase64DecodeJob(jobs, job)) {
+                OCRelease(data);
+                goto fail;
+            }
+        } else {
+            if (*elem != '[') goto fail;
+            // values are plain numbers, so the separators give the count
+            size_t nvals = 0;
+            const char *first = RMNJSONSkipWhitespace(elem + 1, elemEnd);
+            if (first < elemEnd && *first != ']') {
+                nvals = 1;
+                for (const char *q = first; (q = memchr(q, ',', (size_t)(elemEnd - q))); ++q) ++nvals;
+            }
+            if (nvals == 0 || (isComplex && (nvals & 1))) goto fail;
+            size_t nelems = isComplex ? nvals / 2 : nvals;
+            data = OCDataCreateMutable(nelems * elemSize);
+            if (!data) goto fail;
+            OCDataSetLength(data, nelems * elemSize);
+            uint8_t *bytes = OCDataGetMutableBytes(data);
+            const char *q = first;
+            for (size_t j = 0; j < nvals; ++j) {
+                q = RMNJSONSkipWhitespace(q, elemEnd);
+                const char *stop;
+                double v = 0.0;
+                bool negative;
+                uint64_t magnitude;
+                bool isFloat32 = type == kOCNumberFloat32Type || type == kOCNumberComplex64Type;
+                bool isFloat64 = type == kOCNumberFloat64Type || type == kOCNumberComplex128Type;
+                // NaN is written as null; integer types leave it to the cJSON path to reject
+                if ((isFloat32 || isFloat64) && elemEnd - q >= 4 && memcmp(q, "null", 4) == 0) {
+                    if (isFloat32)
+                        ((float *)bytes)[j] = NAN;
+                    else
+                        ((double *)bytes)[j] = NAN;
+                    stop = q + 4;
+                    goto next;
+                }
+                // float samples are rounded from the text once, not via double
+                if (isFloat32)
+                    stop = RMNDecimalParseFloat(q, elemEnd, &((float *)bytes)[j]);
+                else if (!isFloat64 &&
+                         (stop = RMNDecimalParseInteger(q, elemEnd, &negative, &magnitude))) {
+                    // integer text is stored exactly; 64-bit values would round in a double
+                    if (!impl_StoreInlineInteger(type, bytes, j, negative, magnitude)) {
+                        OCRelease(data);
+                        goto fail;
+                    }
+                    goto next;
+                } else
+                    stop = RMNDecimalParseDouble(q, elemEnd, &v);
+                // an out-of-range integer cast is undefined, not a wrap
+                if (!stop || !RMNConvertDoubleFits(type, v)) {
+                    OCRelease(data);
+                    goto fail;
+                }
+                switch (type) {
+                    case kOCNumberSInt8Type: ((int8_t *)bytes)[j] = (int8_t)v; break;
+                    case kOCNumberSInt16Type: ((int16_t *)bytes)[j] = (int16_t)v; break;
+                    case kOCNumberSInt32Type: ((int32_t *)bytes)[j] = (int32_t)v; break;
+                    case kOCNumberSInt64Type: ((int64_t *)bytes)[j] = (int64_t)v; break;
+                    case kOCNumberUInt8Type: ((uint8_t *)bytes)[j] = (uint8_t)v; break;
+                    case kOCNumberUInt16Type: ((uint16_t *)bytes)[j] = (uint16_t)v; break;
+                    case kOCNumberUInt32Type: ((uint32_t *)bytes)[j] = (uint32_t)v; break;
+                    case kOCNumberUInt64Type: ((uint64_t *)bytes)[j] = (uint64_t)v; break;
+                    // complex values are stored as interleaved re/im pairs
+                    case kOCNumberFloat32Type:
+                    case kOCNumberComplex64Type: break;
+                    case kOCNumberFloat64Type:
+                    case kOCNumberComplex128Type: ((double *)bytes)[j] = v; break;
+                    default:
+                        OCRelease(data);
+                        goto fail;
+                }
+            next:
+                q = RMNJSONSkipWhitespace(stop, elemEnd);
+                if (q >= elemEnd || *q != (j + 1 < nvals ? ',' : ']')) {
+                    OCRelease(data);
+                    goto fail;
+                }
+                ++q;
+            }
         }
-        binary_dir = derived_binary_dir;
+        OCArrayAppendValue(comps, data);
+        OCRelease(data);
+        elem = RMNJSONArrayNextElement(elemEnd, end);
     }
-    // 0) decide extension
-    bool hasExternal = false;
-    OCArrayRef dvsArray = DatasetGetDependentVariables(ds);
-    OCIndex dvCount = dvsArray ? OCArrayGetCount(dvsArray) : 0;
-    for (OCIndex i = 0; i < dvCount; ++i) {
-        DependentVariableRef dv =
-            (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
-        if (dv && DependentVariableShouldSerializeExternally(dv)) {
-            hasExternal = true;
+    if (OCArrayGetCount(comps) == 0) goto fail;
+    return comps;
+fail:
+    jobs->count = firstJob;  // drop decodes queued into buffers we release
+    OCRelease(comps);
+    return NULL;
+}
+/// What the inline scanners need from one dependent-variable object, read
+/// straight from the text.
+typedef struct {
+    const char *comps, *compsEnd;  // "components" value, or NULL
+    bool inlinePayload;            // not external, and "components" is an array
+    OCNumberType numericType;      // kOCNumberTypeInvalid if absent/unknown
+    bool isBase64;                 // base64 text, plain or compressed
+    bool isNone;                   // arrays of JSON numbers
+    RMNCodec codec;                // compression of base64 payloads
+    bool shuffle;
+} impl_InlineDVMembers;
+/// Helper: fill `m` from the members of the DV object `[object, end)`.
+/// Like cJSON, the first occurrence of a key wins.
+static void impl_ScanInlineDVMembers(const char *object, const char *end, impl_InlineDVMembers *m) {
+    const char *type = NULL, *typeEnd = NULL, *enc = NULL, *encEnd = NULL;
+    const char *nt = NULL, *ntEnd = NULL;
+    const char *key = NULL, *vEnd = NULL;
+    size_t keyLen = 0;
+    *m = (impl_InlineDVMembers){NULL, NULL, false, kOCNumberTypeInvalid, false, false,
+                                kRMNCodecNone, false};
+    for (const char *v = RMNJSONObjectNextMember(object, end, &key, &keyLen, &vEnd); v;
+         v = RMNJSONObjectNextMember(vEnd, end, &key, &keyLen, &vEnd)) {
+#define KEY_IS(k) (keyLen == sizeof(k) - 1 && memcmp(key, k, keyLen) == 0)
+        if (KEY_IS(kDependentVariableTypeKey) && !type) {
+            type = v;
+            typeEnd = vEnd;
+        } else if (KEY_IS(kDependentVariableEncodingKey) && !enc) {
+            enc = v;
+            encEnd = vEnd;
+        } else if (KEY_IS(kDependentVariableNumericTypeKey) && !nt) {
+            nt = v;
+            ntEnd = vEnd;
+        } else if (KEY_IS(kDependentVariableComponentsKey) && !m->comps) {
+            m->comps = v;
+            m->compsEnd = vEnd;
+        }
+#undef KEY_IS
+    }
+    m->inlinePayload = type && m->comps && *m->comps == '[' &&
+                       !RMNJSONStringEquals(type, typeEnd, kDependentVariableComponentTypeValueExternal);
+    if (nt && *nt == '"' && ntEnd - nt < 32) {
+        char typeName[32];
+        memcpy(typeName, nt + 1, (size_t)(ntEnd - nt - 2));
+        typeName[ntEnd - nt - 2] = '\0';
+        m->numericType = OCNumberTypeFromName(typeName);
+    }
+    if (!enc) return;
+    m->isBase64 = RMNJSONStringEquals(enc, encEnd, kDependentVariableEncodingValueBase64);
+    m->isNone = RMNJSONStringEquals(enc, encEnd, kDependentVariableEncodingValueNone);
+    if (*enc == '"' && encEnd - enc < 32) {
+        char encName[32];
+        memcpy(encName, enc + 1, (size_t)(encEnd - enc - 2));
+        encName[encEnd - enc - 2] = '\0';
+        if (RMNCodecParseEncoding(encName, &m->codec, &m->shuffle) && RMNCodecIsAvailable(m->codec))
+            m->isBase64 = true;
+        else
+            m->codec = kRMNCodecNone;
+    }
+}
+/// Helper: pull every inline "components" payload out of a CSDM document.
+/// Returns one OCArray per dependent-variable object (empty where the DV is
+/// left to cJSON) and cuts the decoded values out of `text` in place,
+/// replacing each with [], so the DOM parse only sees the metadata.
+/// Returns NULL, leaving `text` untouched, if the layout is not recognised.
+static OCMutableArrayRef impl_DatasetExtractInlineComponents(char *text, size_t *length) {
+    const char *end = text + *length;
+    const char *csdm = RMNJSONFindMember(RMNJSONSkipWhitespace(text, end), end,
+                                         kDatasetCsdmEnvelopeKey, NULL);
+    if (!csdm || *csdm != '{') return NULL;
+    const char *dvs = RMNJSONFindMember(csdm, end, kDatasetDependentVariablesKey, NULL);
+    if (!dvs || *dvs != '[') return NULL;
+    OCMutableArrayRef result = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+    size_t cap = 0;
+    const char **spans = NULL;  // [start, end) of each DV's stripped value, or NULLs
+    impl_Base64DecodeJobs jobs = {NULL, 0, 0};
+    bool ok = true;
+    const char *elem = RMNJSONArrayNextElement(dvs, end);
+    while (elem) {
+        const char *elemEnd = RMNJSONSkipValue(elem, end);
+        if (!elemEnd) {
+            ok = false;
             break;
         }
+        if (*elem != '{') {  // non-objects are skipped by the DOM path too
+            elem = RMNJSONArrayNextElement(elemEnd, end);
+            continue;
+        }
+        impl_InlineDVMembers m;
+        impl_ScanInlineDVMembers(elem, elemEnd, &m);
+        OCIndex dvIndex = OCArrayGetCount(result);
+        if (2 * (size_t)dvIndex + 2 > cap) {
+            cap = cap ? cap * 2 : 16;
+            const char **grown = realloc(spans, cap * sizeof(*spans));
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            spans = grown;
+        }
+        OCMutableArrayRef decoded = NULL;
+        if (m.inlinePayload && m.numericType != kOCNumberTypeInvalid && (m.isBase64 || m.isNone))
+            decoded = impl_DecodeInlineComponents(m.comps, m.compsEnd, m.numericType, m.isBase64,
+                                                  m.codec, m.shuffle, &jobs, dvIndex);
+        spans[2 * dvIndex] = decoded ? m.comps : NULL;
+        spans[2 * dvIndex + 1] = decoded ? m.compsEnd : NULL;
+        if (!decoded) decoded = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+        OCArrayAppendValue(result, decoded);
+        OCRelease(decoded);
+        elem = RMNJSONArrayNextElement(elemEnd, end);
     }
-    const char *wantExt = hasExternal ? "csdfe" : "csdf";
-    const char *dot = strrchr(json_path, '.');
-    const char *gotExt = dot ? dot + 1 : "";
-    if (strcasecmp(gotExt, wantExt) != 0) {
-        if (outError) {
-            OCStringRef p = OCStringCreateWithCString(json_path);
-            OCStringRef e = OCStringCreateWithCString(wantExt);
-            OCStringRef s = OCStringCreateWithCString(
-                hasExternal ? "contains" : "does not contain");
-            *outError = OCStringCreateWithFormat(
-                STR("CSDM requires extension '%@' when file %@ external data; got '%@'"),
-                e, s, p);
-            OCRelease(p);
-            OCRelease(e);
-            OCRelease(s);
+    if (!ok) {
+        free(jobs.items);
+        free(spans);
+        OCRelease(result);
+        return NULL;
+    }
+    // decode every queued base64 payload, concurrently when enabled
+    RMNParallelFor(jobs.count, (size_t)DatasetGetIOWorkerCount(), impl_RunBase64DecodeJob, jobs.items);
+    for (size_t j = 0; j < jobs.count; ++j) {
+        OCIndex dvIndex = jobs.items[j].dvIndex;
+        if (jobs.items[j].ok || !spans[2 * dvIndex]) continue;
+        // leave this DV to cJSON, which reports the error if there is one
+        OCMutableArrayRef none = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+        OCArraySetValueAtIndex(result, dvIndex, none);
+        OCRelease(none);
+        spans[2 * dvIndex] = spans[2 * dvIndex + 1] = NULL;
+    }
+    free(jobs.items);
+    // compact the text in one forward pass
+    char *w = text;
+    const char *r = text;
+    for (OCIndex i = 0; i < OCArrayGetCount(result); ++i) {
+        if (!spans[2 * i]) continue;
+        size_t n = (size_t)(spans[2 * i] - r);
+        memmove(w, r, n);
+        w += n;
+        *w++ = '[';
+        *w++ = ']';
+        r = spans[2 * i + 1];
+    }
+    size_t tail = (size_t)(end - r);
+    memmove(w, r, tail);
+    w += tail;
+    *w = '\0';
+    *length = (size_t)(w - text);
+    free(spans);
+    return result;
+}
+/// CRC-32C of a blob in kDatasetChecksumBlockSize blocks, fed in pieces of
+/// any size (see DatasetSetBlobChecksums()).  On export finished blocks are
+/// appended to `crcs`; to verify an import `crcs` holds the recorded values
+/// and each finished block is compared against its entry instead.
+typedef struct {
+    size_t blockSize;
+    size_t filled;  // bytes of the current block seen so far
+    uint32_t crc;   // of the current block
+    uint32_t *crcs;
+    size_t count;     // finished blocks
+    size_t capacity;  // entries in `crcs`
+    bool verify;
+    bool failed;  // out of memory, or a mismatch when verifying
+} impl_BlobChecksum;
+static void impl_BlobChecksumEndBlock(impl_BlobChecksum *sum) {
+    if (sum->verify) {
+        sum->failed = sum->count >= sum->capacity || sum->crcs[sum->count] != sum->crc;
+    } else if (sum->count == sum->capacity) {
+        size_t capacity = sum->capacity ? 2 * sum->capacity : 16;
+        uint32_t *grown = realloc(sum->crcs, capacity * sizeof(*grown));
+        sum->failed = grown == NULL;
+        if (grown) sum->crcs = grown, sum->capacity = capacity;
+    }
+    if (sum->failed) return;
+    if (!sum->verify) sum->crcs[sum->count] = sum->crc;
+    ++sum->count;
+    sum->filled = 0;
+    sum->crc = 0;
+}
+static void impl_BlobChecksumUpdate(impl_BlobChecksum *sum, const void *bytes, size_t length) {
+    const uint8_t *p = bytes;
+    while (length > 0 && !sum->failed) {
+        size_t n = sum->blockSize - sum->filled;
+        if (n > length) n = length;
+        sum->crc = RMNHashCRC32C(sum->crc, p, n);
+        sum->filled += n;
+        p += n;
+        length -= n;
+        if (sum->filled == sum->blockSize) impl_BlobChecksumEndBlock(sum);
+    }
+}
+/// impl_BlobChecksumUpdate() fused with copying the bytes to `dst`.
+static void impl_BlobChecksumCopy(impl_BlobChecksum *sum, void *dst, const void *bytes,
+                                  size_t length) {
+    uint8_t *out = dst;
+    const uint8_t *p = bytes;
+    while (length > 0 && !sum->failed) {
+        size_t n = sum->blockSize - sum->filled;
+        if (n > length) n = length;
+        sum->crc = RMNHashCRC32CCopy(sum->crc, out, p, n);
+        sum->filled += n;
+        out += n;
+        p += n;
+        length -= n;
+        if (sum->filled == sum->blockSize) impl_BlobChecksumEndBlock(sum);
+    }
+}
+/// Close the last, short block (an empty blob has one empty block); when
+/// verifying, every recorded block must have been matched.
+static bool impl_BlobChecksumFinish(impl_BlobChecksum *sum) {
+    if (!sum->failed && (sum->filled > 0 || sum->count == 0)) impl_BlobChecksumEndBlock(sum);
+    if (sum->verify && sum->count != sum->capacity) sum->failed = true;
+    return !sum->failed;
+}
+/// RMNCodecSink that feeds the impl_BlobChecksum passed as context.
+static bool impl_BlobChecksumSink(void *context, const void *bytes, size_t length) {
+    impl_BlobChecksum *sum = context;
+    impl_BlobChecksumUpdate(sum, bytes, length);
+    return !sum->failed;
+}
+/// What DatasetExport() records for the external DVs: one content hash per
+/// component, and `alias[i]`, the first DV whose blob is byte-identical to
+/// DV i's (i itself when there is none), so each distinct blob is written
+/// once and duplicates point their components_url at it.  With blob
+/// checksums enabled, `checksums[i]` holds those of DV i's blob once it
+/// has been encoded (see impl_ChecksumBlobJobs()).
+typedef struct {
+    OCIndex count;
+    OCIndex *alias;
+    uint64_t **hashes;  // NULL for DVs written inline
+    impl_BlobChecksum *checksums;
+} impl_ExportPlan;
+typedef struct {
+    const void *bytes;
+    size_t length;
+    uint64_t *hash;
+} impl_HashJob;
+static void impl_RunHashJob(void *context, size_t index) {
+    impl_HashJob *job = (impl_HashJob *)context + index;
+    *job->hash = RMNHashXXH3(job->bytes, job->length);
+}
+static void impl_ExportPlanClear(impl_ExportPlan *plan) {
+    for (OCIndex i = 0; plan->hashes && i < plan->count; ++i) free(plan->hashes[i]);
+    for (OCIndex i = 0; plan->checksums && i < plan->count; ++i) free(plan->checksums[i].crcs);
+    free(plan->hashes);
+    free(plan->checksums);
+    free(plan->alias);
+    memset(plan, 0, sizeof(*plan));
+}
+/// Whether external DVs `a` and `b` (with component hashes `ha`, `hb`) are
+/// written as byte-identical blobs.  Equal hashes are confirmed with memcmp.
+static bool impl_BlobsMatch(DependentVariableRef a,
+                            const uint64_t *ha,
+                            DependentVariableRef b,
+                            const uint64_t *hb) {
+    // sparse blobs are packed against the dimensions while they are written
+    if (DependentVariableGetSparseSampling(a) || DependentVariableGetSparseSampling(b)) return false;
+    OCIndex n = DependentVariableGetComponentCount(a);
+    if (n != DependentVariableGetComponentCount(b) ||
+        DependentVariableGetElementType(a) != DependentVariableGetElementType(b))
+        return false;
+    for (OCIndex c = 0; c < n; ++c)
+        if (ha[c] != hb[c]) return false;
+    // the same bytes give the same blob only under the same encoding and layout
+    RMNCodec codecA = kRMNCodecNone, codecB = kRMNCodecNone;
+    bool shuffleA = false, shuffleB = false;
+    OCStringRef encA = DependentVariableGetEncoding(a), encB = DependentVariableGetEncoding(b);
+    if (!encA || !RMNCodecParseEncoding(OCStringGetCString(encA), &codecA, &shuffleA))
+        codecA = kRMNCodecNone, shuffleA = false;
+    if (!encB || !RMNCodecParseEncoding(OCStringGetCString(encB), &codecB, &shuffleB))
+        codecB = kRMNCodecNone, shuffleB = false;
+    if (codecA != codecB || shuffleA != shuffleB) return false;
+    OCIndexArrayRef shapeA = DependentVariableCopyChunkShape(a);
+    OCIndexArrayRef shapeB = DependentVariableCopyChunkShape(b);
+    bool same = !shapeA == !shapeB;
+    if (same && shapeA) {
+        OCIndex rank = OCIndexArrayGetCount(shapeA);
+        same = rank == OCIndexArrayGetCount(shapeB);
+        for (OCIndex d = 0; same && d < rank; ++d)
+            same = OCIndexArrayGetValueAtIndex(shapeA, d) == OCIndexArrayGetValueAtIndex(shapeB, d);
+    }
+    OCRelease(shapeA);
+    OCRelease(shapeB);
+    for (OCIndex c = 0; same && c < n; ++c) {
+        OCDataRef da = DependentVariableGetComponentAtIndex(a, c);
+        OCDataRef db = DependentVariableGetComponentAtIndex(b, c);
+        if (da == db) continue;
+        size_t length = da ? (size_t)OCDataGetLength(da) : 0;
+        same = da && db && length == (size_t)OCDataGetLength(db) &&
+               memcmp(OCDataGetBytesPtr(da), OCDataGetBytesPtr(db), length) == 0;
+    }
+    return same;
+}
+/// Hash every component of the external DVs (concurrently with I/O
+/// workers) and find the DVs whose blobs duplicate an earlier one.
+static bool impl_ExportPlanInit(impl_ExportPlan *plan, DatasetRef ds, OCStringRef *outError) {
+    memset(plan, 0, sizeof(*plan));
+    OCArrayRef dvs = DatasetGetDependentVariables(ds);
+    OCIndex dvCount = dvs ? OCArrayGetCount(dvs) : 0;
+    size_t slots = dvCount ? (size_t)dvCount : 1;
+    plan->count = dvCount;
+    plan->alias = malloc(slots * sizeof(*plan->alias));
+    plan->hashes = calloc(slots, sizeof(*plan->hashes));
+    if (DatasetGetBlobChecksums()) plan->checksums = calloc(slots, sizeof(*plan->checksums));
+    size_t njobs = 0;
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i);
+        if (impl_ExportsExternally(dv)) njobs += (size_t)DependentVariableGetComponentCount(dv);
+    }
+    impl_HashJob *jobs = calloc(njobs ? njobs : 1, sizeof(*jobs));
+    bool ok = plan->alias && plan->hashes && jobs && (plan->checksums || !DatasetGetBlobChecksums());
+    size_t j = 0;
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        plan->alias[i] = i;
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i);
+        if (!impl_ExportsExternally(dv)) continue;
+        OCIndex ncomps = DependentVariableGetComponentCount(dv);
+        plan->hashes[i] = calloc(ncomps ? (size_t)ncomps : 1, sizeof(**plan->hashes));
+        ok = plan->hashes[i] != NULL;
+        for (OCIndex c = 0; ok && c < ncomps; ++c, ++j) {
+            OCDataRef blob = DependentVariableGetComponentAtIndex(dv, c);
+            jobs[j].bytes = blob ? OCDataGetBytesPtr(blob) : NULL;
+            jobs[j].length = blob ? (size_t)OCDataGetLength(blob) : 0;
+            jobs[j].hash = &plan->hashes[i][c];
         }
+    }
+    if (ok) RMNParallelFor(j, (size_t)DatasetGetIOWorkerCount(), impl_RunHashJob, jobs);
+    free(jobs);
+    if (!ok) {
+        impl_ExportPlanClear(plan);
+        if (outError) *outError = STR("Failed to allocate component hashes");
         return false;
     }
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        if (!plan->hashes[i]) continue;
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i);
+        for (OCIndex k = 0; k < i; ++k) {
+            if (plan->alias[k] != k || !plan->hashes[k]) continue;
+            DependentVariableRef other = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, k);
+            if (impl_BlobsMatch(dv, plan->hashes[i], other, plan->hashes[k])) {
+                plan->alias[i] = k;
+                break;
+            }
+        }
+    }
+    return true;
+}
+/// The kRMNHashBlobChecksumMetaDataKey record of `sum`.
+static OCDictionaryRef impl_CreateChecksumRecord(const impl_BlobChecksum *sum) {
+    OCMutableArrayRef crcs = OCArrayCreateMutable((OCIndex)sum->count, &kOCTypeArrayCallBacks);
+    for (size_t b = 0; b < sum->count; ++b) {
+        char hex[9];
+        snprintf(hex, sizeof(hex), "%08lx", (unsigned long)sum->crcs[b]);
+        OCStringRef s = OCStringCreateWithCString(hex);
+        OCArrayAppendValue(crcs, s);
+        OCRelease(s);
+    }
+    OCMutableDictionaryRef record = OCDictionaryCreateMutable(0);
+    OCNumberRef blockSize = OCNumberCreateWithOCIndex((OCIndex)sum->blockSize);
+    OCDictionarySetValue(record, STR(kRMNHashBlockSizeKey), blockSize);
+    OCDictionarySetValue(record, STR(kRMNHashCRC32CKey), crcs);
+    OCRelease(blockSize);
+    OCRelease(crcs);
+    return (OCDictionaryRef)record;
+}
+/// Record `plan`'s hashes (and blob checksums) for DV `index` in its
+/// exported "application" dictionary and point a duplicate's
+/// components_url at the shared blob.  Without a plan, any hashes or
+/// checksums carried over from an earlier import are dropped rather than
+/// exported stale.
+static void impl_ApplyExportPlan(DatasetRef ds,
+                                 const impl_ExportPlan *plan,
+                                 OCIndex index,
+                                 OCMutableDictionaryRef dvDict) {
+    OCStringRef keyApp = STR(kDependentVariableMetaDataKey);
+    OCStringRef keyHash = STR(kRMNHashComponentsMetaDataKey);
+    OCStringRef keyChecksum = STR(kRMNHashBlobChecksumMetaDataKey);
+    OCMutableDictionaryRef app = (OCMutableDictionaryRef)OCDictionaryGetValue(dvDict, keyApp);
+    if (app) OCDictionaryRemoveValue(app, keyChecksum);
+    if (!plan || index >= plan->count || !plan->hashes[index]) {
+        if (app) OCDictionaryRemoveValue(app, keyHash);
+        return;
+    }
+    DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, index);
+    OCIndex ncomps = DependentVariableGetComponentCount(dv);
+    OCMutableArrayRef hashes = OCArrayCreateMutable(ncomps, &kOCTypeArrayCallBacks);
+    for (OCIndex c = 0; c < ncomps; ++c) {
+        char hex[kRMNHashHexLength + 1];
+        RMNHashFormat(plan->hashes[index][c], hex);
+        OCStringRef s = OCStringCreateWithCString(hex);
+        OCArrayAppendValue(hashes, s);
+        OCRelease(s);
+    }
+    if (!app) {
+        app = OCDictionaryCreateMutable(0);
+        OCDictionarySetValue(dvDict, keyApp, app);
+        OCRelease(app);
+    }
+    OCDictionarySetValue(app, keyHash, hashes);
+    OCRelease(hashes);
+    // a duplicate's blob is its alias's, checksums included
+    const impl_BlobChecksum *sum = plan->checksums ? &plan->checksums[plan->alias[index]] : NULL;
+    if (sum && sum->count > 0) {
+        OCDictionaryRef record = impl_CreateChecksumRecord(sum);
+        OCDictionarySetValue(app, keyChecksum, record);
+        OCRelease(record);
+    }
+    if (plan->alias[index] != index) {
+        DependentVariableRef shared = DatasetGetDependentVariableAtIndex(ds, plan->alias[index]);
+        OCDictionarySetValue(dvDict, STR(kDependentVariableComponentsURLKey),
+                             DependentVariableGetComponentsURL(shared));
+    }
+}
+/// Helper: build the {"csdm": {...}} export envelope.  With dvPlaceholders
+/// (one OCArray of OCStringRef per DV) encoded components are replaced by
+/// the placeholder strings instead of being encoded in memory.  `plan` (may
+/// be NULL) supplies the external DVs' hashes and shared blobs.
+static OCDictionaryRef impl_DatasetCreateExportRoot(DatasetRef ds,
+                                                    OCArrayRef dvPlaceholders,
+                                                    const impl_ExportPlan *plan,
+                                                    OCStringRef *outError) {
     // 1) build full in-memory dictionary
-    OCDictionaryRef core = DatasetCopyAsDictionary(ds);
+    OCStringRef error = NULL;
+    OCDictionaryRef core = impl_DatasetCopyAsDictionary(ds, dvPlaceholders, &error);
     if (!core) {
-        if (outError) *outError = STR("Failed to create dictionary from Dataset");
-        return false;
+        if (outError)
+            *outError = error ? error : STR("Failed to create dictionary from Dataset");
+        else
+            OCRelease(error);
+        return NULL;
     }
-    // 1a) strip inline components/encoding on externals
+    // 1a) strip inline components/encoding on externals; record their hashes
     {
         OCStringRef keyDVList = STR(kDatasetDependentVariablesKey);
         OCStringRef keyType = STR(kDependentVariableTypeKey);
@@ -1173,11 +1962,15 @@ bool DatasetExport(DatasetRef ds,
             for (OCIndex i = 0; i < n; ++i) {
                 OCDictionaryRef dvDict =
                     (OCDictionaryRef)OCArrayGetValueAtIndex(dvDicts, i);
+                impl_ApplyExportPlan(ds, plan, i, (OCMutableDictionaryRef)dvDict);
                 OCStringRef type =
                     OCDictionaryGetValue(dvDict, keyType);
                 if (type && OCStringEqual(type, keyExternal)) {
                     OCDictionaryRemoveValue((OCMutableDictionaryRef)dvDict, keyComp);
-                    OCDictionaryRemoveValue((OCMutableDictionaryRef)dvDict, keyEnc);
+                    // a compressed encoding also describes the external blob
+                    OCStringRef enc = OCDictionaryGetValue(dvDict, keyEnc);
+                    if (!enc || !RMNCodecParseEncoding(OCStringGetCString(enc), NULL, NULL))
+                        OCDictionaryRemoveValue((OCMutableDictionaryRef)dvDict, keyEnc);
                 }
             }
         }
@@ -1207,93 +2000,1341 @@ bool DatasetExport(DatasetRef ds,
     OCMutableDictionaryRef root = OCDictionaryCreateMutable(1);
     OCDictionarySetValue(root, STR(kDatasetCsdmEnvelopeKey), core);
     OCRelease(core);
-    // 4) serialize JSON → file
+    return (OCDictionaryRef)root;
+}
+/// A component pre-encoded to base64 by the I/O workers; `text` stays NULL
+/// for components that are streamed instead.
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    RMNCodec codec;  // compress before encoding unless kRMNCodecNone
+    bool shuffle;
+    size_t shuffleWidth;
+    char *text;
+    size_t textLength;
+} impl_Base64EncodeJob;
+static void impl_RunBase64EncodeJob(void *context, size_t index) {
+    impl_Base64EncodeJob *job = (impl_Base64EncodeJob *)context + index;
+    if (!job->bytes) return;
+    const uint8_t *bytes = job->bytes;
+    size_t length = job->length;
+    RMNCodecBuffer packed = {0};
+    if (job->codec != kRMNCodecNone) {
+        if (!RMNCodecEncode(job->codec, job->shuffle, job->shuffleWidth, bytes, length,
+                            RMNCodecBufferSink, &packed)) {
+            free(packed.bytes);
+            return;  // left to the serial writer, which reports the error
+        }
+        bytes = packed.bytes;
+        length = packed.length;
+    }
+    job->text = malloc(RMNBase64EncodedLength(length) + 1);
+    if (job->text) job->textLength = RMNBase64Encode(bytes, length, job->text);
+    free(packed.bytes);
+}
+/// Fail early, with a clear message, on compressed encodings whose codec
+/// was not compiled in.
+static bool impl_DatasetCheckCodecs(DatasetRef ds, OCStringRef *outError) {
+    OCArrayRef dvs = DatasetGetDependentVariables(ds);
+    OCIndex n = dvs ? OCArrayGetCount(dvs) : 0;
+    for (OCIndex i = 0; i < n; ++i) {
+        OCStringRef enc = DependentVariableGetEncoding(
+            (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i));
+        RMNCodec codec = kRMNCodecNone;
+        if (enc && RMNCodecParseEncoding(OCStringGetCString(enc), &codec, NULL) &&
+            !RMNCodecIsAvailable(codec)) {
+            if (outError)
+                *outError = OCStringCreateWithFormat(
+                    STR("Compression codec for encoding '%@' is not available in this build"), enc);
+            return false;
+        }
+    }
+    return true;
+}
+/// Helper: 128 random bits naming one export's component placeholders, so
+/// that no string stored in the dataset (title, metadata, ...) can spell a
+/// placeholder and be mistaken for one.  Without a system random source the
+/// clock, process id, a stack address and a serial are mixed instead.
+static void impl_ExportNonce(uint64_t nonce[2]) {
+#if !defined(_WIN32)
+    FILE *f = fopen("/dev/urandom", "rb");
+    if (f) {
+        bool filled = fread(nonce, sizeof(uint64_t), 2, f) == 2;
+        fclose(f);
+        if (filled) return;
+    }
+#endif
+    static atomic_uint serial;
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    uint64_t x = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    x ^= ((uint64_t)getpid() << 32) ^ (uint64_t)(uintptr_t)&ts ^
+         atomic_fetch_add_explicit(&serial, 1u, memory_order_relaxed);
+    for (int k = 0; k < 2; ++k) {  // splitmix64
+        uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
+        z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+        z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+        nonce[k] = z ^ (z >> 31);
+    }
+}
+/// DatasetExportJSONToStream() with an optional export `plan`.
+static bool impl_DatasetExportJSON(DatasetRef ds,
+                                   FILE *stream,
+                                   const impl_ExportPlan *plan,
+                                   OCStringRef *outError) {
+    if (!impl_DatasetCheckCodecs(ds, outError)) return false;
+    // 1) one placeholder per encoded component, unique to this call
+    uint64_t nonce[2];
+    impl_ExportNonce(nonce);
+    OCArrayRef dvsArray = DatasetGetDependentVariables(ds);
+    OCIndex dvCount = dvsArray ? OCArrayGetCount(dvsArray) : 0;
+    OCMutableArrayRef placeholders = OCArrayCreateMutable(dvCount, &kOCTypeArrayCallBacks);
+    if (!placeholders) {
+        if (outError) *outError = STR("Failed to allocate component placeholders");
+        return false;
+    }
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        OCIndex ncomps = DependentVariableGetComponentCount(dv);
+        OCMutableArrayRef ph = OCArrayCreateMutable(ncomps, &kOCTypeArrayCallBacks);
+        for (OCIndex c = 0; c < ncomps; ++c) {
+            char tag[96];
+            snprintf(tag, sizeof(tag), "@@RMNLib:%016llx%016llx:%ld:%ld@@",
+                     (unsigned long long)nonce[0], (unsigned long long)nonce[1], (long)i, (long)c);
+            OCStringRef s = OCStringCreateWithCString(tag);
+            OCArrayAppendValue(ph, s);
+            OCRelease(s);
+        }
+        OCArrayAppendValue(placeholders, ph);
+        OCRelease(ph);
+    }
+    // 2) render the (small) metadata skeleton
+    OCDictionaryRef root = impl_DatasetCreateExportRoot(ds, placeholders, plan, outError);
+    if (!root) {
+        OCRelease(placeholders);
+        return false;
+    }
     cJSON *json = OCTypeCopyJSON((OCTypeRef)root);
     OCRelease(root);
     if (!json) {
+        OCRelease(placeholders);
         if (outError) *outError = STR("Failed to convert dictionary to JSON");
         return false;
     }
     char *json_text = cJSON_Print(json);
     cJSON_Delete(json);
     if (!json_text) {
+        OCRelease(placeholders);
         if (outError) *outError = STR("Failed to generate JSON string");
         return false;
     }
-    size_t json_len = strlen(json_text);
-    if (!ensure_parent_dirs(json_path, outError)) {
-        free(json_text);
-        return false;
+    // 3) with I/O workers, components are base64-encoded concurrently a window
+    //    of about `workers` at a time, just ahead of the writer, so at most one
+    //    window of payloads is held in memory; otherwise each one is encoded
+    //    while it is streamed
+    OCStringRef keyRaw = STR(kDependentVariableEncodingValueRaw);
+    OCStringRef keyBase64 = STR(kDependentVariableEncodingValueBase64);
+    size_t workers = (size_t)DatasetGetIOWorkerCount();
+    size_t njobs = 0;
+    impl_Base64EncodeJob *jobs = NULL;
+    if (workers > 1) {
+        for (OCIndex i = 0; i < dvCount; ++i)
+            njobs += (size_t)OCArrayGetCount((OCArrayRef)OCArrayGetValueAtIndex(placeholders, i));
+        jobs = calloc(njobs ? njobs : 1, sizeof(*jobs));
+        size_t j = 0;
+        for (OCIndex i = 0; jobs && i < dvCount; ++i) {
+            DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+            OCStringRef enc = DependentVariableGetEncoding(dv);
+            RMNCodec codec = kRMNCodecNone;
+            bool shuffle = false;
+            bool isCodec = enc && RMNCodecParseEncoding(OCStringGetCString(enc), &codec, &shuffle);
+            bool isBase64 = !impl_ExportsExternally(dv) &&
+                            (isCodec || (enc && OCStringEqual(enc, keyBase64)));
+            size_t shuffleWidth = RMNCodecShuffleWidth(DependentVariableGetElementType(dv));
+            OCIndex ncomps = OCArrayGetCount((OCArrayRef)OCArrayGetValueAtIndex(placeholders, i));
+            for (OCIndex c = 0; c < ncomps; ++c, ++j) {
+                OCDataRef blob = DependentVariableGetComponentAtIndex(dv, c);
+                if (!isBase64 || !blob) continue;
+                jobs[j].bytes = OCDataGetBytesPtr(blob);
+                jobs[j].length = (size_t)OCDataGetLength(blob);
+                jobs[j].codec = codec;
+                jobs[j].shuffle = shuffle;
+                jobs[j].shuffleWidth = shuffleWidth;
+            }
+        }
     }
-    FILE *jf = fopen(json_path, "wb");
-    if (!jf) {
-        free(json_text);
-        if (outError) *outError = STR("Failed to open JSON output file");
-        return false;
+    // 4) copy the skeleton through, writing each payload in place of its placeholder
+    bool ok = true;
+    const char *cursor = json_text;
+    size_t jobIndex = 0;
+    size_t encodedEnd = 0;  // jobs before this index have been run
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        OCArrayRef ph = (OCArrayRef)OCArrayGetValueAtIndex(placeholders, i);
+        OCIndex ncomps = OCArrayGetCount(ph);
+        OCStringRef enc = DependentVariableGetEncoding(dv);
+        if ((enc && OCStringEqual(enc, keyRaw)) || impl_ExportsExternally(dv)) {
+            jobIndex += (size_t)ncomps;
+            continue;  // raw components are embedded in the skeleton, external ones in blobs
+        }
+        for (OCIndex c = 0; ok && c < ncomps; ++c, ++jobIndex) {
+            char quoted[100];
+            snprintf(quoted, sizeof(quoted), "\"%s\"",
+                     OCStringGetCString((OCStringRef)OCArrayGetValueAtIndex(ph, c)));
+            const char *hit = strstr(cursor, quoted);
+            if (!hit) {
+                if (outError) *outError = STR("Failed to locate component in JSON skeleton");
+                ok = false;
+                break;
+            }
+            if (jobs && jobIndex >= encodedEnd) {
+                // the next window: `workers` components to encode (streamed
+                // and raw ones have no bytes and are skipped by the task)
+                size_t window = 0;
+                if (encodedEnd < jobIndex) encodedEnd = jobIndex;
+                while (encodedEnd < njobs && window < workers)
+                    if (jobs[encodedEnd++].bytes) window++;
+                RMNParallelFor(encodedEnd - jobIndex, workers, impl_RunBase64EncodeJob,
+                               jobs + jobIndex);
+            }
+            size_t n = (size_t)(hit - cursor);
+            bool wrote = fwrite(cursor, 1, n, stream) == n;
+            impl_Base64EncodeJob *job = jobs ? &jobs[jobIndex] : NULL;
+            if (wrote && job && job->text) {
+                wrote = fputc('"', stream) != EOF &&
+                        fwrite(job->text, 1, job->textLength, stream) == job->textLength &&
+                        fputc('"', stream) != EOF;
+            } else if (wrote) {
+                wrote = DependentVariableWriteComponentJSON(dv, c, stream);
+            }
+            if (job) {
+                free(job->text);
+                job->text = NULL;
+            }
+            if (!wrote) {
+                if (outError) *outError = STR("Error writing JSON file");
+                ok = false;
+                break;
+            }
+            cursor = hit + strlen(quoted);
+        }
+    }
+    for (size_t j = 0; jobs && j < njobs; ++j) free(jobs[j].text);
+    free(jobs);
+    if (ok) {
+        size_t n = strlen(cursor);
+        if (fwrite(cursor, 1, n, stream) != n) {
+            if (outError) *outError = STR("Error writing JSON file");
+            ok = false;
+        }
     }
-    size_t wrote = fwrite(json_text, 1, json_len, jf);
-    fclose(jf);
     free(json_text);
-    if (wrote != json_len) {
-        if (outError) *outError = STR("Error writing JSON file");
+    OCRelease(placeholders);
+    return ok;
+}
+// ————— DatasetExportJSONToStream —————
+/// Helper: run every pending deferred load before anything is written.  A
+/// lazily imported DV already reads as internal (base64 unless compressed)
+/// with no components_url, so a blob that fails to load must stop the
+/// export rather than serialize as an empty or missing payload.
+static bool impl_DatasetLoadForExport(DatasetRef ds, OCStringRef *outError) {
+    OCArrayRef dvs = DatasetGetDependentVariables(ds);
+    OCIndex count = dvs ? OCArrayGetCount(dvs) : 0;
+    for (OCIndex i = 0; i < count; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i);
+        OCStringRef loadError = NULL;
+        if (!dv || DependentVariableLoadComponents(dv, &loadError)) continue;
+        if (outError)
+            *outError = OCStringCreateWithFormat(
+                STR("Dataset export failed: dependent variable %ld could not be loaded: %@"),
+                (long)i, loadError ? loadError : STR("unknown error"));
+        OCRelease(loadError);
         return false;
     }
-    // 5) dump binary blobs
-    if (!ensure_directory(binary_dir, outError))
+    return true;
+}
+bool DatasetExportJSONToStream(DatasetRef ds, FILE *stream, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!ds || !stream) {
+        if (outError) *outError = STR("Invalid arguments");
         return false;
-    for (OCIndex i = 0; i < dvCount; ++i) {
-        DependentVariableRef dv =
-            (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
-        if (!dv || !DependentVariableShouldSerializeExternally(dv))
-            continue;
-        OCStringRef url = DependentVariableGetComponentsURL(dv);
-        if (!url) {
-            if (outError) *outError = STR("External DV missing components_url");
-            return false;
-        }
-        const char *rel = parse_components_url_path(OCStringGetCString(url));
-        if (!rel) {
-            if (outError) *outError = STR("Invalid components_url");
-            return false;
-        }
-        char fullpath[PATH_MAX];
-        if (!join_path(fullpath, sizeof(fullpath),
-                       binary_dir, PATH_SEPARATOR, rel)) {
-            if (outError) *outError = STR("Binary path too long");
-            return false;
+    }
+    if (!impl_DatasetLoadForExport(ds, outError)) return false;
+    return impl_DatasetExportJSON(ds, stream, NULL, outError);
+}
+/// One external blob file written by the I/O workers: either a packed
+/// `blob` (sparse DVs), the DV's `chunks` written back to back, or, with
+/// a chunk shape (rank > 0), `chunks` in the chunked layout.  Containers
+/// write the same bytes as one section with impl_WriteBlob().  An atomic
+/// export writes to `path`, a temporary, and later renames it to `target`.
+/// A compressed blob checksummed by impl_ChecksumBlobJobs() is written
+/// from its `encoded` frames instead.
+typedef enum { kBlobWriteOK, kBlobWriteOpenFailed, kBlobWriteFailed } impl_BlobWriteStatus;
+typedef struct {
+    char path[PATH_MAX];
+    char target[PATH_MAX];  // empty unless atomic
+    bool sync;              // fsync before closing
+    bool async;             // written by impl_WriteBlobsAsync() instead
+    OCDataRef blob;
+    OCArrayRef chunks;
+    OCIndex rank;
+    OCIndex shape[kRMNChunkedLayoutMaxRank];
+    OCIndex chunkShape[kRMNChunkedLayoutMaxRank];
+    size_t elementSize;
+    RMNCodec codec;  // compressed encoding: one encoded frame per component
+    bool shuffle;
+    size_t shuffleWidth;
+    OCIndex ncomps;
+    impl_BlobChecksum *checksum;  // receives the blob's CRC-32C, or NULL
+    RMNCodecBuffer encoded;
+    impl_BlobWriteStatus status;
+} impl_BlobWriteJob;
+/// Pass the blob's bytes, in file order, to `sink`.
+static bool impl_EmitBlob(const impl_BlobWriteJob *job, RMNCodecSink sink, void *context) {
+    bool ok = true;
+    if (job->encoded.bytes) {
+        ok = sink(context, job->encoded.bytes, job->encoded.length);
+    } else if (job->codec != kRMNCodecNone) {
+        // a packed sparse blob holds its components back to back, like `chunks`
+        OCIndex n = job->blob ? job->ncomps : job->chunks ? OCArrayGetCount(job->chunks) : 0;
+        size_t slice = job->blob && n > 0 ? (size_t)OCDataGetLength(job->blob) / (size_t)n : 0;
+        for (OCIndex i = 0; ok && i < n; ++i) {
+            OCDataRef chunk =
+                job->blob ? job->blob : (OCDataRef)OCArrayGetValueAtIndex(job->chunks, i);
+            const uint8_t *bytes = OCDataGetBytesPtr(chunk);
+            size_t len = job->blob ? slice : (size_t)OCDataGetLength(chunk);
+            if (job->blob) bytes += (size_t)i * slice;
+            ok = RMNCodecEncode(job->codec, job->shuffle, job->shuffleWidth, bytes, len, sink,
+                                context);
         }
-        if (!ensure_parent_dirs(fullpath, outError))
-            return false;
-        OCDataRef blob = DependentVariableCreateCSDMComponentsData(
-            dv, DatasetGetDimensions(ds));
-        if (!blob) {
-            if (outError) *outError = STR("Failed to create binary blob");
-            return false;
+    } else if (job->blob) {
+        ok = sink(context, OCDataGetBytesPtr(job->blob), (size_t)OCDataGetLength(job->blob));
+    } else if (job->rank > 0) {
+        ok = RMNChunkedLayoutWriteToSink(sink, context, job->chunks, job->rank, job->shape,
+                                         job->chunkShape, job->elementSize);
+    } else {
+        OCIndex n = job->chunks ? OCArrayGetCount(job->chunks) : 0;
+        for (OCIndex i = 0; ok && i < n; ++i) {
+            OCDataRef chunk = (OCDataRef)OCArrayGetValueAtIndex(job->chunks, i);
+            ok = sink(context, OCDataGetBytesPtr(chunk), (size_t)OCDataGetLength(chunk));
         }
-        FILE *bf = fopen(fullpath, "wb");
-        if (!bf) {
-            OCRelease(blob);
-            if (outError) *outError = STR("Failed to open binary output file");
+    }
+    return ok;
+}
+static bool impl_WriteBlob(const impl_BlobWriteJob *job, FILE *bf) {
+    return impl_EmitBlob(job, RMNCodecFileSink, bf);
+}
+/// Checksum one job's blob ahead of the JSON that records it.  A compressed
+/// blob is encoded into memory here, once, and later written from there.
+static void impl_RunChecksumJob(void *context, size_t index) {
+    impl_BlobWriteJob *job = ((impl_BlobWriteJob **)context)[index];
+    impl_BlobChecksum *sum = job->checksum;
+    bool ok;
+    if (job->codec != kRMNCodecNone) {
+        ok = impl_EmitBlob(job, RMNCodecBufferSink, &job->encoded);
+        if (ok && !job->encoded.bytes) job->encoded.bytes = malloc(1);  // empty, but encoded
+        ok = ok && job->encoded.bytes;
+        if (ok) impl_BlobChecksumUpdate(sum, job->encoded.bytes, job->encoded.length);
+    } else {
+        ok = impl_EmitBlob(job, impl_BlobChecksumSink, sum);
+    }
+    if (!ok) sum->failed = true;
+    impl_BlobChecksumFinish(sum);
+}
+/// Compute the checksums of the `njobs` jobs that have a `checksum`
+/// (concurrently with I/O workers).
+static bool impl_ChecksumBlobJobs(impl_BlobWriteJob *jobs, size_t njobs, OCStringRef *outError) {
+    impl_BlobWriteJob **pending = malloc((njobs ? njobs : 1) * sizeof(*pending));
+    if (!pending) {
+        if (outError) *outError = STR("Failed to allocate blob checksums");
+        return false;
+    }
+    size_t n = 0;
+    for (size_t j = 0; j < njobs; ++j) {
+        if (!jobs[j].checksum) continue;
+        jobs[j].checksum->blockSize = kDatasetChecksumBlockSize;
+        pending[n++] = &jobs[j];
+    }
+    RMNParallelFor(n, (size_t)DatasetGetIOWorkerCount(), impl_RunChecksumJob, pending);
+    bool ok = true;
+    for (size_t j = 0; ok && j < n; ++j) ok = !pending[j]->checksum->failed;
+    free(pending);
+    if (!ok && outError) *outError = STR("Failed to checksum binary blob");
+    return ok;
+}
+static void impl_RunBlobWriteJob(void *context, size_t index) {
+    impl_BlobWriteJob *job = (impl_BlobWriteJob *)context + index;
+    if (job->async) return;
+    FILE *bf = fopen(job->path, "wb");
+    if (!bf) {
+        job->status = kBlobWriteOpenFailed;
+        return;
+    }
+    // large sequential writes: a chunked or compressed blob otherwise goes
+    // out in small pieces through the default stdio buffer
+    setvbuf(bf, NULL, _IOFBF, kDatasetBlobWriteBufferSize);
+    bool ok = impl_WriteBlob(job, bf);
+    if (ok && job->sync) {
+        ok = sync_stream(bf);
+        release_written_pages(bf);
+    }
+    if (fclose(bf) != 0) ok = false;
+    job->status = ok ? kBlobWriteOK : kBlobWriteFailed;
+}
+#if !defined(_WIN32)
+/// Whether impl_WriteBlobsAsync() can write `job`: its bytes are already
+/// in memory as whole pieces (components, a packed blob or encoded frames).
+static bool impl_BlobWriteJobIsPlain(const impl_BlobWriteJob *job) {
+    return job->encoded.bytes || (job->codec == kRMNCodecNone && job->rank == 0);
+}
+/// Pieces impl_WriteBlobsAsync() writes for a plain job.
+static OCIndex impl_BlobWriteJobPieces(const impl_BlobWriteJob *job) {
+    return job->encoded.bytes || job->blob ? 1 : job->chunks ? OCArrayGetCount(job->chunks) : 0;
+}
+/// With io_uring available, write the plain blobs among `jobs` (whole
+/// components, no chunked layout, no codec unless already encoded) as one
+/// RMNAsyncIO batch, so every component of every blob is in flight at
+/// once.  Handled jobs are marked `async` and skipped by
+/// impl_RunBlobWriteJob().
+static void impl_WriteBlobsAsync(impl_BlobWriteJob *jobs, size_t njobs) {
+    size_t nreq = 0;
+    for (size_t j = 0; j < njobs; ++j)
+        if (impl_BlobWriteJobIsPlain(&jobs[j])) nreq += (size_t)impl_BlobWriteJobPieces(&jobs[j]);
+    RMNAsyncIORequest *reqs = calloc(nreq ? nreq : 1, sizeof(*reqs));
+    int *fds = malloc((njobs ? njobs : 1) * sizeof(*fds));
+    if (!reqs || !fds) {
+        free(reqs);
+        free(fds);
+        return;  // the stdio writers handle every job
+    }
+    size_t r = 0;
+    for (size_t j = 0; j < njobs; ++j) {
+        impl_BlobWriteJob *job = &jobs[j];
+        fds[j] = -1;
+        if (!impl_BlobWriteJobIsPlain(job)) continue;
+        job->async = true;
+        fds[j] = open(job->path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fds[j] < 0) {
+            job->status = kBlobWriteOpenFailed;
+            continue;
+        }
+        OCIndex n = impl_BlobWriteJobPieces(job);
+        uint64_t offset = 0;
+        for (OCIndex i = 0; i < n; ++i, ++r) {
+            reqs[r] = (RMNAsyncIORequest){.fd = fds[j], .write = true, .offset = offset};
+            if (job->encoded.bytes) {
+                reqs[r].bytes = job->encoded.bytes;
+                reqs[r].length = job->encoded.length;
+            } else {
+                OCDataRef data =
+                    job->blob ? job->blob : (OCDataRef)OCArrayGetValueAtIndex(job->chunks, i);
+                reqs[r].bytes = (void *)OCDataGetBytesPtr(data);
+                reqs[r].length = (size_t)OCDataGetLength(data);
+            }
+            offset += reqs[r].length;
+        }
+    }
+    RMNAsyncIORun(reqs, r, kDatasetAsyncIODepth);
+    r = 0;
+    for (size_t j = 0; j < njobs; ++j) {
+        impl_BlobWriteJob *job = &jobs[j];
+        if (fds[j] < 0) continue;
+        OCIndex n = impl_BlobWriteJobPieces(job);
+        bool ok = true;
+        for (OCIndex i = 0; i < n; ++i, ++r) ok = ok && reqs[r].ok;
+        if (ok && job->sync) {
+            ok = fsync(fds[j]) == 0;
+#if defined(POSIX_FADV_DONTNEED)
+            posix_fadvise(fds[j], 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        }
+        if (close(fds[j]) != 0) ok = false;
+        job->status = ok ? kBlobWriteOK : kBlobWriteFailed;
+    }
+    free(reqs);
+    free(fds);
+}
+#endif
+/// Fill in everything but the path of the write job for an external DV.
+static bool impl_PrepareBlobWriteJob(DatasetRef ds,
+                                     DependentVariableRef dv,
+                                     impl_BlobWriteJob *job,
+                                     OCStringRef *outError) {
+    OCStringRef enc = DependentVariableGetEncoding(dv);
+    if (enc && RMNCodecParseEncoding(OCStringGetCString(enc), &job->codec, &job->shuffle)) {
+        job->shuffleWidth = RMNCodecShuffleWidth(DependentVariableGetElementType(dv));
+        job->ncomps = DependentVariableGetComponentCount(dv);
+    }
+    if (DependentVariableGetSparseSampling(dv)) {
+        // sparse DVs are packed first
+        job->blob = DependentVariableCreateCSDMComponentsData(dv, DatasetGetDimensions(ds));
+        if (!job->blob) {
+            if (outError) *outError = STR("Failed to create binary blob");
             return false;
         }
-        const void *bytes = OCDataGetBytesPtr(blob);
-        size_t len = (size_t)OCDataGetLength(blob);
-        bool ok = (fwrite(bytes, 1, len, bf) == len);
-        fclose(bf);
-        OCRelease(blob);
-        if (!ok) {
+        return true;
+    }
+    // dense components are written straight from the DV, without a staging copy
+    job->chunks = DependentVariableGetComponents(dv);
+    OCIndexArrayRef chunkShape = DependentVariableCopyChunkShape(dv);
+    if (!chunkShape) return true;
+    if (job->codec != kRMNCodecNone) {
+        OCRelease(chunkShape);
+        if (outError) *outError = STR("Chunked layout does not support compressed encodings");
+        return false;
+    }
+    OCArrayRef dims = DatasetGetDimensions(ds);
+    OCIndex rank = dims ? OCArrayGetCount(dims) : 0;
+    if (rank != OCIndexArrayGetCount(chunkShape)) {
+        OCRelease(chunkShape);
+        if (outError) *outError = STR("Chunk shape does not match the dataset's dimensions");
+        return false;
+    }
+    job->rank = rank;
+    for (OCIndex d = 0; d < rank; ++d) {
+        job->shape[d] = DimensionGetCount((DimensionRef)OCArrayGetValueAtIndex(dims, d));
+        job->chunkShape[d] = OCIndexArrayGetValueAtIndex(chunkShape, d);
+    }
+    job->elementSize = SIQuantityElementSize((SIQuantityRef)dv);
+    OCRelease(chunkShape);
+    return true;
+}
+/// Release what impl_PrepareBlobWriteJob() and impl_ChecksumBlobJobs() hold.
+static void impl_ReleaseBlobWriteJobs(impl_BlobWriteJob *jobs, size_t njobs) {
+    for (size_t j = 0; j < njobs; ++j) {
+        OCRelease(jobs[j].blob);
+        free(jobs[j].encoded.bytes);
+    }
+    free(jobs);
+}
+/// Write `ds` as a single-file container (see RMNContainer.h): the JSON
+/// document, then each external DV's blob as an aligned section.  A DV
+/// whose blob duplicates an earlier one (see `plan`) gets that DV's section.
+static bool impl_DatasetExportContainer(DatasetRef ds,
+                                        const char *path,
+                                        const impl_ExportPlan *plan,
+                                        OCStringRef *outError) {
+    OCArrayRef dvsArray = DatasetGetDependentVariables(ds);
+    OCIndex dvCount = dvsArray ? OCArrayGetCount(dvsArray) : 0;
+    RMNContainerInfo info = {0};
+    info.sections = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*info.sections));
+    // jobs[i]: DV i's section, prepared up front so checksums can precede the JSON
+    impl_BlobWriteJob *jobs = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*jobs));
+    if (!info.sections || !jobs) {
+        RMNContainerInfoClear(&info);
+        free(jobs);
+        if (outError) *outError = STR("Failed to allocate container section table");
+        return false;
+    }
+    bool ok = true;
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (!dv || !DependentVariableShouldSerializeExternally(dv) || plan->alias[i] != i) continue;
+        if (!DependentVariableGetComponentsURL(dv)) {
+            if (outError) *outError = STR("External DV missing components_url");
+            ok = false;
+            break;
+        }
+        jobs[i].checksum = plan->checksums ? &plan->checksums[i] : NULL;
+        ok = impl_PrepareBlobWriteJob(ds, dv, &jobs[i], outError);
+    }
+    if (ok && plan->checksums) ok = impl_ChecksumBlobJobs(jobs, (size_t)dvCount, outError);
+    if (!ok) {
+        impl_ReleaseBlobWriteJobs(jobs, (size_t)dvCount);
+        RMNContainerInfoClear(&info);
+        return false;
+    }
+    // an atomic export writes a temporary and renames it over `path`
+    DatasetExportMode mode = DatasetGetExportMode();
+    char tmp[PATH_MAX];
+    const char *out = path;
+    if (mode != kDatasetExportDirect) {
+        if (!temp_path_for(path, tmp, sizeof(tmp))) {
+            impl_ReleaseBlobWriteJobs(jobs, (size_t)dvCount);
+            RMNContainerInfoClear(&info);
+            if (outError) *outError = STR("Container path too long");
+            return false;
+        }
+        out = tmp;
+    }
+    FILE *f = ensure_parent_dirs(path, outError) ? fopen(out, "wb+") : NULL;
+    if (f) setvbuf(f, NULL, _IOFBF, kDatasetBlobWriteBufferSize);
+    if (!f) {
+        impl_ReleaseBlobWriteJobs(jobs, (size_t)dvCount);
+        RMNContainerInfoClear(&info);
+        if (outError && !*outError) *outError = STR("Failed to open container output file");
+        return false;
+    }
+    // the header is filled in last, once every offset is known
+    static const uint8_t zeros[kRMNContainerHeaderSize] = {0};
+    ok = fwrite(zeros, 1, sizeof(zeros), f) == sizeof(zeros);
+    if (!ok && outError) *outError = STR("Error writing container");
+    info.jsonOffset = kRMNContainerHeaderSize;
+    if (ok) ok = impl_DatasetExportJSON(ds, f, plan, outError);
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (dv && DependentVariableShouldSerializeExternally(dv)) ++info.sectionCount;
+    }
+    if (ok) {
+        info.jsonLength = RMNContainerTell(f) - info.jsonOffset;
+        ok = RMNContainerAlign(f, &info.tableOffset);
+        for (uint32_t i = 0; ok && i < info.sectionCount; ++i)
+            ok = fwrite(zeros, 1, 16, f) == 16;  // table placeholder
+        if (!ok && outError) *outError = STR("Error writing container");
+    }
+    uint32_t section = 0;
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (!dv || !DependentVariableShouldSerializeExternally(dv)) continue;
+        RMNContainerSection *s = &info.sections[section++];
+        if (plan->alias[i] != i) {
+            // sections are in external-DV order: find the shared blob's
+            uint32_t shared = 0;
+            for (OCIndex k = 0; k < plan->alias[i]; ++k)
+                if (DependentVariableShouldSerializeExternally(
+                        (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, k)))
+                    ++shared;
+            *s = info.sections[shared];
+            continue;
+        }
+        if (!(RMNContainerAlign(f, &s->offset) && impl_WriteBlob(&jobs[i], f))) {
             if (outError) *outError = STR("Error writing binary blob");
+            ok = false;
+        }
+        s->length = RMNContainerTell(f) - s->offset;
+    }
+    impl_ReleaseBlobWriteJobs(jobs, (size_t)dvCount);
+    if (ok) {
+        info.fileLength = RMNContainerTell(f);
+        ok = RMNContainerWriteInfo(f, &info);
+        if (ok && mode == kDatasetExportDurable) {
+            ok = sync_stream(f);
+            release_written_pages(f);
+        }
+        if (!ok && outError) *outError = STR("Error writing container");
+    }
+    if (fclose(f) != 0 && ok) {
+        if (outError) *outError = STR("Error writing container");
+        ok = false;
+    }
+    if (mode != kDatasetExportDirect) {
+        if (ok && !replace_file(tmp, path)) {
+            if (outError) *outError = STR("Failed to rename container into place");
+            ok = false;
+        }
+        if (ok && mode == kDatasetExportDurable && !sync_parent_directory(path)) {
+            if (outError) *outError = STR("Failed to sync container directory");
+            ok = false;
+        }
+        if (!ok) remove(tmp);
+    }
+    RMNContainerInfoClear(&info);
+    return ok;
+}
+/// Stream `ds`'s JSON to the file at `path`, fsync'ing it when `sync`.
+static bool impl_ExportJSONFile(DatasetRef ds,
+                                const char *path,
+                                const impl_ExportPlan *plan,
+                                bool sync,
+                                OCStringRef *outError) {
+    FILE *jf = fopen(path, "wb");
+    if (!jf) {
+        if (outError) *outError = STR("Failed to open JSON output file");
+        return false;
+    }
+    bool ok = impl_DatasetExportJSON(ds, jf, plan, outError);
+    if (ok && sync && !sync_stream(jf)) {
+        if (outError) *outError = STR("Error writing JSON file");
+        ok = false;
+    }
+    if (fclose(jf) != 0 && ok) {
+        if (outError) *outError = STR("Error writing JSON file");
+        ok = false;
+    }
+    return ok;
+}
+// ————— DatasetExport —————
+bool DatasetExport(DatasetRef ds,
+                   const char *json_path,
+                   const char *binary_dir,
+                   OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!ds || !json_path) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    if (!impl_DatasetLoadForExport(ds, outError)) return false;
+    
+    // If binary_dir is NULL, derive it from json_path
+    char derived_binary_dir[PATH_MAX];
+    if (!binary_dir) {
+        if (!derive_directory_from_path(json_path, derived_binary_dir, sizeof(derived_binary_dir))) {
+            if (outError) *outError = STR("Cannot determine binary directory from JSON path");
             return false;
         }
+        binary_dir = derived_binary_dir;
+    }
+    // a container holds the document and every blob in one file
+    const char *ext = strrchr(json_path, '.');
+    if (ext && strcasecmp(ext + 1, kRMNContainerExtension) == 0) {
+        impl_ExportPlan plan;
+        if (!impl_ExportPlanInit(&plan, ds, outError)) return false;
+        bool ok = impl_DatasetExportContainer(ds, json_path, &plan, outError);
+        impl_ExportPlanClear(&plan);
+        return ok;
+    }
+    // 0) decide extension
+    bool hasExternal = false;
+    OCArrayRef dvsArray = DatasetGetDependentVariables(ds);
+    OCIndex dvCount = dvsArray ? OCArrayGetCount(dvsArray) : 0;
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        DependentVariableRef dv =
+            (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (dv && DependentVariableShouldSerializeExternally(dv)) {
+            hasExternal = true;
+            break;
+        }
+    }
+    const char *wantExt = hasExternal ? "csdfe" : "csdf";
+    const char *dot = strrchr(json_path, '.');
+    const char *gotExt = dot ? dot + 1 : "";
+    if (strcasecmp(gotExt, wantExt) != 0) {
+        if (outError) {
+            OCStringRef p = OCStringCreateWithCString(json_path);
+            OCStringRef e = OCStringCreateWithCString(wantExt);
+            OCStringRef s = OCStringCreateWithCString(
+                hasExternal ? "contains" : "does not contain");
+            *outError = OCStringCreateWithFormat(
+                STR("CSDM requires extension '%@' when file %@ external data; got '%@'"),
+                e, s, p);
+            OCRelease(p);
+            OCRelease(e);
+            OCRelease(s);
+        }
+        return false;
+    }
+    // an atomic export writes everything to temporaries, JSON last, then
+    // renames the blobs and finally the JSON into place
+    DatasetExportMode mode = DatasetGetExportMode();
+    bool atomic = mode != kDatasetExportDirect;
+    bool durable = mode == kDatasetExportDurable;
+    char json_tmp[PATH_MAX];
+    if (atomic && !temp_path_for(json_path, json_tmp, sizeof(json_tmp))) {
+        if (outError) *outError = STR("JSON path too long");
+        return false;
+    }
+    // 1) hash the external components to find shared blobs
+    if (!ensure_parent_dirs(json_path, outError))
+        return false;
+    impl_ExportPlan plan;
+    if (!impl_ExportPlanInit(&plan, ds, outError))
+        return false;
+    if (!ensure_directory(binary_dir, outError)) {
+        impl_ExportPlanClear(&plan);
+        return false;
+    }
+    // 2) one blob job per distinct external blob; duplicates name the first
+    //    one's file
+    impl_BlobWriteJob *jobs = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*jobs));
+    if (!jobs) {
+        impl_ExportPlanClear(&plan);
+        if (outError) *outError = STR("Failed to allocate blob write jobs");
+        return false;
+    }
+    size_t njobs = 0;
+    bool ok = true;
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
+        DependentVariableRef dv =
+            (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (!dv || !DependentVariableShouldSerializeExternally(dv) || plan.alias[i] != i)
+            continue;
+        OCStringRef url = DependentVariableGetComponentsURL(dv);
+        if (!url) {
+            if (outError) *outError = STR("External DV missing components_url");
+            ok = false;
+            break;
+        }
+        const char *rel = parse_components_url_path(OCStringGetCString(url));
+        if (!rel) {
+            if (outError) *outError = STR("Invalid components_url");
+            ok = false;
+            break;
+        }
+        impl_BlobWriteJob *job = &jobs[njobs++];
+        char *final_path = atomic ? job->target : job->path;
+        if (!join_path(final_path, PATH_MAX, binary_dir, PATH_SEPARATOR, rel) ||
+            (atomic && !temp_path_for(job->target, job->path, sizeof(job->path)))) {
+            if (outError) *outError = STR("Binary path too long");
+            ok = false;
+            break;
+        }
+        job->sync = durable;
+        job->checksum = plan.checksums ? &plan.checksums[i] : NULL;
+        if (!ensure_parent_dirs(job->path, outError) ||
+            !impl_PrepareBlobWriteJob(ds, dv, job, outError)) {
+            ok = false;
+            break;
+        }
+    }
+    // 3–4) checksum the blobs if asked, then stream JSON → file
+    if (ok && plan.checksums) ok = impl_ChecksumBlobJobs(jobs, njobs, outError);
+    if (ok && !atomic) ok = impl_ExportJSONFile(ds, json_path, &plan, false, outError);
+    // 5) dump binary blobs (concurrently with I/O workers)
+    if (ok) {
+#if !defined(_WIN32)
+        if (RMNAsyncIOGetBackend() == kRMNAsyncIOUring) impl_WriteBlobsAsync(jobs, njobs);
+#endif
+        RMNParallelFor(njobs, (size_t)DatasetGetIOWorkerCount(), impl_RunBlobWriteJob, jobs);
+        for (size_t j = 0; j < njobs; ++j) {
+            if (jobs[j].status == kBlobWriteOK) continue;
+            if (outError)
+                *outError = jobs[j].status == kBlobWriteOpenFailed
+                                ? STR("Failed to open binary output file")
+                                : STR("Error writing binary blob");
+            ok = false;
+            break;
+        }
+    }
+    // 6) commit: blobs first, so the new JSON never names a missing blob
+    if (atomic) {
+        if (ok) ok = impl_ExportJSONFile(ds, json_tmp, &plan, durable, outError);
+        for (size_t j = 0; ok && j < njobs; ++j) {
+            if (!replace_file(jobs[j].path, jobs[j].target)) {
+                if (outError) *outError = STR("Failed to rename binary blob into place");
+                ok = false;
+            } else if (durable && !sync_parent_directory(jobs[j].target)) {
+                if (outError) *outError = STR("Failed to sync binary directory");
+                ok = false;
+            }
+        }
+        if (ok && !replace_file(json_tmp, json_path)) {
+            if (outError) *outError = STR("Failed to rename JSON file into place");
+            ok = false;
+        }
+        if (ok && durable && !sync_parent_directory(json_path)) {
+            if (outError) *outError = STR("Failed to sync JSON directory");
+            ok = false;
+        }
+        if (!ok) {
+            // renamed blobs have no temporary left to remove
+            remove(json_tmp);
+            for (size_t j = 0; j < njobs; ++j) remove(jobs[j].path);
+        }
+    }
+    impl_ReleaseBlobWriteJobs(jobs, njobs);
+    impl_ExportPlanClear(&plan);
+    return ok;
+}
+/// Index box requested from DatasetCreateWithImportSubset(), over the
+/// full grid `shape` (CSDM order, dimension 0 fastest).
+typedef struct {
+    OCIndex rank;
+    OCIndex shape[kRMNChunkedLayoutMaxRank];
+    OCIndex start[kRMNChunkedLayoutMaxRank];
+    OCIndex count[kRMNChunkedLayoutMaxRank];
+    OCIndex stride[kRMNChunkedLayoutMaxRank];
+} impl_ImportSubset;
+static size_t impl_ImportSubsetPointCount(const impl_ImportSubset *subset) {
+    size_t points = 1;
+    for (OCIndex d = 0; d < subset->rank; ++d) points *= (size_t)subset->count[d];
+    return points;
+}
+/// Reads `length` bytes at byte `offset` of a full component.
+typedef bool (*impl_SubsetRowReader)(void *context, uint64_t offset, uint8_t *dst, size_t length);
+static bool impl_ReadRowFromMemory(void *context, uint64_t offset, uint8_t *dst, size_t length) {
+    memcpy(dst, (const uint8_t *)context + offset, length);
+    return true;
+}
+typedef struct {
+    FILE *stream;
+    uint64_t base;  // component start within the file
+} impl_FileRowSource;
+static bool impl_ReadRowFromFile(void *context, uint64_t offset, uint8_t *dst, size_t length) {
+    impl_FileRowSource *src = context;
+#if defined(_WIN32)
+    if (_fseeki64(src->stream, (long long)(src->base + offset), SEEK_SET) != 0) return false;
+#else
+    if (fseeko(src->stream, (off_t)(src->base + offset), SEEK_SET) != 0) return false;
+#endif
+    return fread(dst, 1, length, src->stream) == length;
+}
+/// Gather the subset of one component into `dst`, one dimension-0 row
+/// at a time, so only the rows the box touches are read.  Byte offsets
+/// follow the same strides as RMNGridMemOffsetFromIndexes().
+static bool impl_GatherSubset(const impl_ImportSubset *subset,
+                              size_t elementSize,
+                              impl_SubsetRowReader read,
+                              void *context,
+                              uint8_t *dst) {
+    OCIndex rank = subset->rank;
+    uint64_t pitch[kRMNChunkedLayoutMaxRank];
+    OCIndex index[kRMNChunkedLayoutMaxRank] = {0};
+    uint64_t p = 1;
+    for (OCIndex d = 0; d < rank; ++d) {
+        pitch[d] = p;
+        p *= (uint64_t)subset->shape[d];
+    }
+    size_t rowPoints = (size_t)subset->count[0];
+    size_t step = (size_t)subset->stride[0];
+    size_t spanBytes = ((rowPoints - 1) * step + 1) * elementSize;
+    uint8_t *span = step > 1 ? malloc(spanBytes) : NULL;
+    if (step > 1 && !span) return false;
+    bool ok = true;
+    while (ok) {
+        uint64_t first = (uint64_t)subset->start[0];
+        for (OCIndex d = 1; d < rank; ++d)
+            first += (uint64_t)(subset->start[d] + index[d] * subset->stride[d]) * pitch[d];
+        if (step == 1) {
+            ok = read(context, first * elementSize, dst, rowPoints * elementSize);
+        } else {
+            ok = read(context, first * elementSize, span, spanBytes);
+            for (size_t i = 0; ok && i < rowPoints; ++i)
+                memcpy(dst + i * elementSize, span + i * step * elementSize, elementSize);
+        }
+        dst += rowPoints * elementSize;
+        OCIndex d = 1;
+        for (; d < rank; ++d) {
+            if (++index[d] < subset->count[d]) break;
+            index[d] = 0;
+        }
+        if (d >= rank) break;
+    }
+    free(span);
+    return ok;
+}
+/// One external blob read by the I/O workers: the file is mapped and
+/// copied once into the DV's preallocated component buffers (`targets`),
+/// unpacking the chunked layout or decompressing when the DV declares one.
+/// Subset reads instead pull only the rows of the requested box.  A blob
+/// exported with checksums has its recorded `crcs` verified as it is read.
+typedef enum {
+    kBlobReadOK,
+    kBlobReadFailed,
+    kBlobReadSizeMismatch,
+    kBlobReadChecksumMismatch,
+} impl_BlobReadStatus;
+typedef struct {
+    char path[PATH_MAX];
+    DependentVariableRef dv;
+    OCMutableArrayRef comps;
+    uint8_t **targets;
+    size_t ncomps;
+    size_t chunk;
+    size_t elementSize;
+    bool chunked;
+    bool inContainer;  // the blob is one section of the container at `path`
+    uint64_t sectionOffset;
+    uint64_t sectionLength;
+    RMNCodec codec;  // compressed encoding: one encoded frame per component
+    bool shuffle;
+    size_t shuffleWidth;
+    bool subsetted;    // read only `subset`; `chunk` is then the subset's size
+    size_t fullChunk;  // bytes per full component in the blob
+    impl_ImportSubset subset;
+    bool async;  // read by impl_ReadBlobsAsync() instead
+    uint32_t *crcs;  // recorded CRC-32C per block, or NULL
+    size_t crcCount;
+    size_t crcBlockSize;
+    impl_BlobReadStatus status;
+} impl_BlobReadJob;
+/// A checksum that verifies `job`'s blob against its recorded values.
+static impl_BlobChecksum impl_BlobReadJobChecksum(const impl_BlobReadJob *job) {
+    return (impl_BlobChecksum){.blockSize = job->crcBlockSize,
+                               .crcs = job->crcs,
+                               .capacity = job->crcCount,
+                               .verify = true};
+}
+/// Verify the whole blob at `bytes` in one pass.
+static bool impl_VerifyBlob(const impl_BlobReadJob *job, const uint8_t *bytes, size_t length) {
+    impl_BlobChecksum sum = impl_BlobReadJobChecksum(job);
+    impl_BlobChecksumUpdate(&sum, bytes, length);
+    return impl_BlobChecksumFinish(&sum);
+}
+/// Parse `dv`'s kRMNHashBlobChecksumMetaDataKey record, if any, into `job`.
+static bool impl_ParseBlobChecksums(DependentVariableRef dv,
+                                    impl_BlobReadJob *job,
+                                    OCStringRef *outError) {
+    OCDictionaryRef md = DependentVariableGetMetaData(dv);
+    OCDictionaryRef record = md ? OCDictionaryGetValue(md, STR(kRMNHashBlobChecksumMetaDataKey)) : NULL;
+    if (!record) return true;
+    OCNumberRef blockSize = NULL;
+    OCArrayRef crcs = NULL;
+    if (OCGetTypeID(record) == OCDictionaryGetTypeID()) {
+        blockSize = OCDictionaryGetValue(record, STR(kRMNHashBlockSizeKey));
+        crcs = OCDictionaryGetValue(record, STR(kRMNHashCRC32CKey));
+    }
+    OCIndex size = 0;
+    bool ok = blockSize && OCGetTypeID(blockSize) == OCNumberGetTypeID() &&
+              OCNumberTryGetOCIndex(blockSize, &size) && size > 0 && crcs &&
+              OCGetTypeID(crcs) == OCArrayGetTypeID() && OCArrayGetCount(crcs) > 0;
+    size_t n = ok ? (size_t)OCArrayGetCount(crcs) : 0;
+    job->crcs = ok ? malloc(n * sizeof(*job->crcs)) : NULL;
+    ok = ok && job->crcs;
+    for (size_t b = 0; ok && b < n; ++b) {
+        OCStringRef text = OCArrayGetValueAtIndex(crcs, (OCIndex)b);
+        const char *hex = text && OCGetTypeID(text) == OCStringGetTypeID() ? OCStringGetCString(text) : NULL;
+        ok = hex && strlen(hex) == 8 && strspn(hex, "0123456789abcdefABCDEF") == 8;
+        job->crcs[b] = ok ? (uint32_t)strtoul(hex, NULL, 16) : 0;
+    }
+    if (!ok) {
+        free(job->crcs);
+        job->crcs = NULL;
+        if (outError) *outError = STR("Dataset import failed: invalid blob checksum record");
+        return false;
+    }
+    job->crcCount = n;
+    job->crcBlockSize = (size_t)size;
+    return true;
+}
+/// Subset read of one blob: compressed blobs must be decoded whole, the
+/// chunked layout reads only the chunks under the box's span, and plain
+/// blobs read only the rows inside the box.
+static impl_BlobReadStatus impl_ReadBlobSubset(impl_BlobReadJob *job) {
+    uint64_t base = job->inContainer ? job->sectionOffset : 0;
+    if (job->codec != kRMNCodecNone) {
+        size_t total = 0, offset = (size_t)base;
+        bool mapped = false;
+        uint8_t *bytes = map_file_bytes(job->path, &total, &mapped);
+        uint8_t *full = malloc(job->fullChunk ? job->fullChunk : 1);
+        bool ok = bytes && full;
+        impl_BlobReadStatus status = ok ? kBlobReadOK : kBlobReadFailed;
+        // a container section ends where the next one starts, not at end of file
+        size_t end = total;
+        if (ok && job->inContainer) {
+            ok = job->sectionOffset <= total && job->sectionLength <= total - job->sectionOffset;
+            end = ok ? (size_t)(job->sectionOffset + job->sectionLength) : 0;
+            if (!ok) status = kBlobReadSizeMismatch;
+        }
+        for (size_t ci = 0; ok && ci < job->ncomps; ++ci) {
+            size_t consumed = 0;
+            ok = offset <= end &&
+                 RMNCodecDecode(job->codec, job->shuffle, job->shuffleWidth, bytes + offset,
+                                end - offset, full, job->fullChunk, &consumed) &&
+                 impl_GatherSubset(&job->subset, job->elementSize, impl_ReadRowFromMemory, full,
+                                   job->targets[ci]);
+            offset += consumed;
+            if (!ok) status = kBlobReadSizeMismatch;
+        }
+        // as for a full read, the frames must fill the blob exactly
+        if (ok && offset != end) status = kBlobReadSizeMismatch;
+        free(full);
+        unmap_file_bytes(bytes, total, mapped);
+        return status;
+    }
+    FILE *f = fopen(job->path, "rb");
+    if (!f) return kBlobReadFailed;
+    bool ok = true;
+    if (job->chunked) {
+        // read the chunks under the box's span, then apply the strides
+        impl_ImportSubset span = job->subset;
+        bool unitStride = true;
+        for (OCIndex d = 0; d < span.rank; ++d) {
+            span.shape[d] = (job->subset.count[d] - 1) * job->subset.stride[d] + 1;
+            span.start[d] = 0;
+            unitStride &= job->subset.stride[d] == 1;
+        }
+        size_t spanBytes = 1;
+        for (OCIndex d = 0; d < span.rank; ++d) spanBytes *= (size_t)span.shape[d];
+        spanBytes *= job->elementSize;
+        uint8_t *scratch = unitStride ? NULL : malloc(spanBytes);
+        ok = unitStride || scratch;
+        for (size_t ci = 0; ok && ci < job->ncomps; ++ci) {
+            uint8_t *out = unitStride ? job->targets[ci] : scratch;
+            ok = RMNChunkedLayoutReadHyperslab(f, base, (OCIndex)ci, span.rank, job->subset.start,
+                                               span.shape, job->elementSize, out);
+            if (ok && !unitStride)
+                ok = impl_GatherSubset(&span, job->elementSize, impl_ReadRowFromMemory, scratch,
+                                       job->targets[ci]);
+        }
+        free(scratch);
+    } else {
+        for (size_t ci = 0; ok && ci < job->ncomps; ++ci) {
+            impl_FileRowSource src = {f, base + (uint64_t)ci * job->fullChunk};
+            ok = impl_GatherSubset(&job->subset, job->elementSize, impl_ReadRowFromFile, &src,
+                                   job->targets[ci]);
+        }
+    }
+    fclose(f);
+    return ok ? kBlobReadOK : kBlobReadSizeMismatch;
+}
+static void impl_RunBlobReadJob(void *context, size_t index) {
+    impl_BlobReadJob *job = (impl_BlobReadJob *)context + index;
+    if (job->async) {
+        // read straight into the targets, which hold the blob in order
+        if (job->status == kBlobReadOK && job->crcs) {
+            impl_BlobChecksum sum = impl_BlobReadJobChecksum(job);
+            for (size_t ci = 0; ci < job->ncomps; ++ci)
+                impl_BlobChecksumUpdate(&sum, job->targets[ci], job->chunk);
+            if (!impl_BlobChecksumFinish(&sum)) job->status = kBlobReadChecksumMismatch;
+        }
+        return;
+    }
+    if (job->subsetted) {
+        job->status = impl_ReadBlobSubset(job);
+        return;
+    }
+    size_t total_bytes = 0;
+    bool mapped = false;
+    uint8_t *mapping = map_file_bytes(job->path, &total_bytes, &mapped);
+    if (!mapping) {
+        job->status = kBlobReadFailed;
+        return;
+    }
+    uint8_t *bytes = mapping;
+    size_t file_bytes = total_bytes;
+    if (job->inContainer) {
+        if (job->sectionOffset > file_bytes || job->sectionLength > file_bytes - job->sectionOffset) {
+            job->status = kBlobReadSizeMismatch;
+            unmap_file_bytes(mapping, file_bytes, mapped);
+            return;
+        }
+        bytes += job->sectionOffset;
+        total_bytes = (size_t)job->sectionLength;
+    }
+    // decoders read their input out of order; check it before decoding
+    if (job->crcs && (job->chunked || job->codec != kRMNCodecNone) &&
+        !impl_VerifyBlob(job, bytes, total_bytes)) {
+        job->status = kBlobReadChecksumMismatch;
+    } else if (job->chunked) {
+        bool ok = job->elementSize &&
+                  RMNChunkedLayoutDecode(bytes, total_bytes, job->elementSize,
+                                         job->chunk / job->elementSize, job->targets, job->ncomps);
+        job->status = ok ? kBlobReadOK : kBlobReadSizeMismatch;
+    } else if (job->codec != kRMNCodecNone) {
+        size_t offset = 0;
+        bool ok = true;
+        for (size_t ci = 0; ok && ci < job->ncomps; ++ci) {
+            size_t consumed = 0;
+            ok = RMNCodecDecode(job->codec, job->shuffle, job->shuffleWidth, bytes + offset,
+                                total_bytes - offset, job->targets[ci], job->chunk, &consumed);
+            offset += consumed;
+        }
+        job->status = ok && offset == total_bytes ? kBlobReadOK : kBlobReadSizeMismatch;
+    } else if (job->chunk * job->ncomps != total_bytes) {
+        job->status = kBlobReadSizeMismatch;
+    } else if (job->crcs) {
+        // checksum while copying: each byte of the mapping is read once
+        impl_BlobChecksum sum = impl_BlobReadJobChecksum(job);
+        for (size_t ci = 0; ci < job->ncomps; ++ci)
+            impl_BlobChecksumCopy(&sum, job->targets[ci], bytes + ci * job->chunk, job->chunk);
+        job->status = impl_BlobChecksumFinish(&sum) ? kBlobReadOK : kBlobReadChecksumMismatch;
+    } else {
+        for (size_t ci = 0; ci < job->ncomps; ++ci)
+            memcpy(job->targets[ci], bytes + ci * job->chunk, job->chunk);
+        job->status = kBlobReadOK;
+    }
+    unmap_file_bytes(mapping, file_bytes, mapped);
+}
+#if !defined(_WIN32)
+/// With io_uring available, read the plain blobs among `jobs` (whole
+/// components, no codec, chunked layout or subset) straight into their
+/// targets as one RMNAsyncIO batch.  Handled jobs are marked `async` and
+/// skipped by impl_RunBlobReadJob().
+static void impl_ReadBlobsAsync(impl_BlobReadJob *jobs, size_t njobs) {
+    size_t nreq = 0;
+    for (size_t j = 0; j < njobs; ++j)
+        if (!jobs[j].subsetted && !jobs[j].chunked && jobs[j].codec == kRMNCodecNone)
+            nreq += jobs[j].ncomps;
+    RMNAsyncIORequest *reqs = calloc(nreq ? nreq : 1, sizeof(*reqs));
+    int *fds = malloc((njobs ? njobs : 1) * sizeof(*fds));
+    if (!reqs || !fds) {
+        free(reqs);
+        free(fds);
+        return;  // the mapping readers handle every job
+    }
+    size_t r = 0;
+    for (size_t j = 0; j < njobs; ++j) {
+        impl_BlobReadJob *job = &jobs[j];
+        fds[j] = -1;
+        if (job->subsetted || job->chunked || job->codec != kRMNCodecNone) continue;
+        job->async = true;
+        job->status = kBlobReadOK;
+        fds[j] = open(job->path, O_RDONLY);
+        struct stat st;
+        if (fds[j] < 0 || fstat(fds[j], &st) != 0) {
+            job->status = kBlobReadFailed;
+            continue;
+        }
+        // the same size checks as impl_RunBlobReadJob()
+        uint64_t fileBytes = (uint64_t)st.st_size, base = 0, length = fileBytes;
+        if (job->inContainer) {
+            base = job->sectionOffset;
+            length = job->sectionLength;
+            if (base > fileBytes || length > fileBytes - base) length = UINT64_MAX;
+        }
+        if (length != (uint64_t)job->chunk * job->ncomps) {
+            job->status = kBlobReadSizeMismatch;
+            continue;
+        }
+        for (size_t ci = 0; ci < job->ncomps; ++ci, ++r)
+            reqs[r] = (RMNAsyncIORequest){.fd = fds[j],
+                                          .offset = base + (uint64_t)ci * job->chunk,
+                                          .bytes = job->targets[ci],
+                                          .length = job->chunk};
+    }
+    RMNAsyncIORun(reqs, r, kDatasetAsyncIODepth);
+    r = 0;
+    for (size_t j = 0; j < njobs; ++j) {
+        impl_BlobReadJob *job = &jobs[j];
+        if (fds[j] < 0) continue;
+        if (job->status == kBlobReadOK) {
+            for (size_t ci = 0; ci < job->ncomps; ++ci, ++r)
+                if (!reqs[r].ok) job->status = kBlobReadFailed;
+        }
+        close(fds[j]);
+    }
+    free(reqs);
+    free(fds);
+}
+#endif
+/// Preallocate the component buffers a read job fills.
+static bool impl_AllocateBlobReadTargets(impl_BlobReadJob *job, OCStringRef *outError) {
+    job->comps = OCArrayCreateMutable((OCIndex)job->ncomps, &kOCTypeArrayCallBacks);
+    job->targets = calloc(job->ncomps ? job->ncomps : 1, sizeof(*job->targets));
+    if (!job->comps || !job->targets) {
+        if (outError)
+            *outError = STR("Dataset import failed: cannot allocate components array");
+        return false;
+    }
+    for (size_t ci = 0; ci < job->ncomps; ++ci) {
+        OCMutableDataRef buf = OCDataCreateMutable(job->chunk);
+        if (!buf) {
+            if (outError)
+                *outError = STR("Dataset import failed: cannot create component buffer");
+            return false;
+        }
+        OCDataSetLength(buf, job->chunk);
+        job->targets[ci] = OCDataGetMutableBytes(buf);
+        OCArrayAppendValue(job->comps, buf);
+        OCRelease(buf);
+    }
+    return true;
+}
+static bool impl_BlobReadJobSucceeded(const impl_BlobReadJob *job, OCStringRef *outError) {
+    if (job->status == kBlobReadFailed) {
+        if (outError) {
+            OCStringRef p = OCStringCreateWithCString(job->path);
+            *outError = OCStringCreateWithFormat(
+                STR("Dataset import failed: cannot read binary component '%@'"), p);
+            OCRelease(p);
+        }
+        return false;
+    }
+    if (job->status == kBlobReadSizeMismatch) {
+        if (outError)
+            *outError = STR("Dataset import failed: binary size mismatch for component");
+        return false;
+    }
+    if (job->status == kBlobReadChecksumMismatch) {
+        if (outError) {
+            OCStringRef p = OCStringCreateWithCString(job->path);
+            *outError = OCStringCreateWithFormat(
+                STR("Dataset import failed: checksum mismatch in binary component '%@'"), p);
+            OCRelease(p);
+        }
+        return false;
+    }
+    return true;
+}
+static void impl_ReleaseBlobReadJob(void *context) {
+    impl_BlobReadJob *job = context;
+    OCRelease(job->comps);
+    free(job->targets);
+    free(job->crcs);
+    free(job);
+}
+/// DependentVariableComponentsLoader for lazy imports: reads one blob on
+/// the thread that first touches the DV's components.
+static OCMutableArrayRef impl_LoadDeferredBlob(DependentVariableRef dv, void *context,
+                                               OCStringRef *outError) {
+    (void)dv;
+    impl_BlobReadJob *job = context;
+    if (!impl_AllocateBlobReadTargets(job, outError)) return NULL;
+    impl_RunBlobReadJob(job, 0);
+    if (!impl_BlobReadJobSucceeded(job, outError)) return NULL;
+    OCMutableArrayRef comps = job->comps;
+    job->comps = NULL;
+    return comps;
+}
+/// Restrict every DV of a freshly imported dataset whose components are
+/// already in memory to `subset`, then replace the dimensions to match.
+/// Dimensions reduced to a single index are dropped.
+static bool impl_DatasetApplySubset(DatasetRef ds,
+                                    const impl_ImportSubset *subset,
+                                    const bool *readAsSubset,
+                                    OCStringRef *outError) {
+    OCArrayRef dvs = DatasetGetDependentVariables(ds);
+    OCIndex dvCount = dvs ? OCArrayGetCount(dvs) : 0;
+    size_t points = impl_ImportSubsetPointCount(subset);
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        if (readAsSubset[i]) continue;
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvs, i);
+        size_t elemSize = SIQuantityElementSize((SIQuantityRef)dv);
+        OCIndex ncomps = DependentVariableGetComponentCount(dv);
+        OCMutableArrayRef comps = OCArrayCreateMutable(ncomps, &kOCTypeArrayCallBacks);
+        bool ok = comps != NULL;
+        for (OCIndex c = 0; ok && c < ncomps; ++c) {
+            OCDataRef full = DependentVariableGetComponentAtIndex(dv, c);
+            OCMutableDataRef part = OCDataCreateMutable(points * elemSize);
+            ok = full && part &&
+                 OCDataGetLength(full) == (uint64_t)RMNCalculateSizeFromDimensions(
+                                              DatasetGetDimensions(ds)) * elemSize;
+            if (ok) {
+                OCDataSetLength(part, points * elemSize);
+                ok = impl_GatherSubset(subset, elemSize, impl_ReadRowFromMemory,
+                                       (void *)OCDataGetBytesPtr(full), OCDataGetMutableBytes(part));
+                OCArrayAppendValue(comps, part);
+            }
+            OCRelease(part);
+        }
+        if (ok) ok = DependentVariableSetComponents(dv, comps);
+        OCRelease(comps);
+        if (!ok) {
+            if (outError) *outError = STR("Dataset import failed: cannot restrict components to subset");
+            return false;
+        }
+    }
+    OCArrayRef dims = DatasetGetDimensions(ds);
+    OCMutableArrayRef newDims = OCArrayCreateMutable(subset->rank, &kOCTypeArrayCallBacks);
+    if (!newDims) {
+        if (outError) *outError = STR("Dataset import failed: memory allocation error");
+        return false;
+    }
+    for (OCIndex d = 0; d < subset->rank; ++d) {
+        if (subset->count[d] == 1) continue;
+        DimensionRef dim = DimensionCreateSubset((DimensionRef)OCArrayGetValueAtIndex(dims, d),
+                                                 subset->start[d], subset->count[d],
+                                                 subset->stride[d], outError);
+        if (!dim) {
+            OCRelease(newDims);
+            return false;
+        }
+        OCArrayAppendValue(newDims, dim);
+        OCRelease(dim);
+    }
+    bool dropped = OCArrayGetCount(newDims) != subset->rank;
+    DatasetSetDimensions(ds, newDims);
+    OCRelease(newDims);
+    if (dropped) {
+        // precedence referred to the old dimension indexes
+        OCMutableIndexArrayRef order = OCIndexArrayCreateMutable(0);
+        for (OCIndex d = 0; order && d < OCArrayGetCount(DatasetGetDimensions(ds)); ++d)
+            OCIndexArrayAppendValue(order, d);
+        if (order) DatasetSetDimensionPrecedence(ds, order);
+        OCRelease(order);
     }
     return true;
 }
 // ————— DatasetCreateWithImport —————
-DatasetRef DatasetCreateWithImport(const char *json_path,
-                                   const char *binary_dir,
-                                   OCStringRef *outError) {
+static DatasetRef impl_DatasetCreateWithImport(const char *json_path,
+                                               const char *binary_dir,
+                                               const OCIndex *start,
+                                               const OCIndex *count,
+                                               const OCIndex *stride,
+                                               bool lazy,
+                                               OCStringRef *outError) {
     if (outError) *outError = NULL;
-    if (!json_path || !binary_dir) {
+    if (!json_path) {
         if (outError)
             *outError = STR("Dataset import failed: invalid arguments");
         return NULL;
@@ -1309,21 +3350,48 @@ DatasetRef DatasetCreateWithImport(const char *json_path,
         }
         return NULL;
     }
-    if (fseek(jf, 0, SEEK_END) != 0) {
-        fclose(jf);
-        if (outError) *outError = STR("Dataset import failed: cannot seek JSON file");
-        return NULL;
-    }
-    long fsize = ftell(jf);
-    if (fsize < 0) {
-        fclose(jf);
-        if (outError) *outError = STR("Dataset import failed: cannot determine JSON file size");
-        return NULL;
+    // a container carries its JSON and blobs in one file (see RMNContainer.h)
+    uint8_t magic[8];
+    bool isContainer = fread(magic, 1, sizeof(magic), jf) == sizeof(magic) &&
+                       RMNContainerHasMagic(magic, sizeof(magic));
+    RMNContainerInfo container = {0};
+    long fsize = -1;
+    if (isContainer) {
+        OCStringRef cerr = NULL;
+        if (!RMNContainerReadInfo(jf, &container, &cerr) ||
+            fseek(jf, (long)container.jsonOffset, SEEK_SET) != 0) {
+            fclose(jf);
+            if (outError)
+                *outError = OCStringCreateWithFormat(STR("Dataset import failed: %@"),
+                                                     cerr ? cerr : STR("cannot read container"));
+            if (cerr) OCRelease(cerr);
+            RMNContainerInfoClear(&container);
+            return NULL;
+        }
+        fsize = (long)container.jsonLength;
+    } else {
+        if (!binary_dir) {
+            fclose(jf);
+            if (outError) *outError = STR("Dataset import failed: invalid arguments");
+            return NULL;
+        }
+        if (fseek(jf, 0, SEEK_END) != 0) {
+            fclose(jf);
+            if (outError) *outError = STR("Dataset import failed: cannot seek JSON file");
+            return NULL;
+        }
+        fsize = ftell(jf);
+        if (fsize < 0) {
+            fclose(jf);
+            if (outError) *outError = STR("Dataset import failed: cannot determine JSON file size");
+            return NULL;
+        }
+        rewind(jf);
     }
-    rewind(jf);
     char *buffer = malloc((size_t)fsize + 1);
     if (!buffer) {
         fclose(jf);
+        RMNContainerInfoClear(&container);
         if (outError) *outError = STR("Dataset import failed: memory allocation error");
         return NULL;
     }
@@ -1331,13 +3399,19 @@ DatasetRef DatasetCreateWithImport(const char *json_path,
     fclose(jf);
     if (got != (size_t)fsize) {
         free(buffer);
+        RMNContainerInfoClear(&container);
         if (outError) *outError = STR("Dataset import failed: incomplete read of JSON file");
         return NULL;
     }
     buffer[fsize] = '\0';
+    // decode inline components straight from the text; cJSON sees the rest
+    size_t textLength = (size_t)fsize;  // text stays NUL-terminated
+    OCMutableArrayRef decoded = impl_DatasetExtractInlineComponents(buffer, &textLength);
     cJSON *root = cJSON_Parse(buffer);
     free(buffer);
     if (!root) {
+        OCRelease(decoded);
+        RMNContainerInfoClear(&container);
         const char *e = cJSON_GetErrorPtr();
         if (outError) {
             if (e) {
@@ -1352,19 +3426,63 @@ DatasetRef DatasetCreateWithImport(const char *json_path,
         return NULL;
     }
     // 2) JSON → dictionary → Dataset
-    DatasetRef ds = DatasetCreateFromJSON(root, outError);
+    DatasetRef ds = impl_DatasetCreateFromJSON(root, decoded, outError);
     cJSON_Delete(root);
-    if (!ds) return NULL;
+    OCRelease(decoded);
+    if (!ds) {
+        RMNContainerInfoClear(&container);
+        return NULL;
+    }
     // 3) compute expected number of points from the dataset’s dimensions
     OCArrayRef dims = DatasetGetDimensions(ds);
     OCIndex expectedSize = RMNCalculateSizeFromDimensions(dims);
-    // 4) process dependent variables
+    // 3a) a subset request is checked against the dimensions just read
+    impl_ImportSubset subset = {0};
+    bool subsetted = start != NULL;
+    if (subsetted) {
+        subset.rank = dims ? OCArrayGetCount(dims) : 0;
+        bool valid = subset.rank > 0 && subset.rank <= kRMNChunkedLayoutMaxRank;
+        for (OCIndex d = 0; valid && d < subset.rank; ++d) {
+            subset.shape[d] = DimensionGetCount((DimensionRef)OCArrayGetValueAtIndex(dims, d));
+            subset.start[d] = start[d];
+            subset.count[d] = count[d];
+            subset.stride[d] = stride ? stride[d] : 1;
+            valid = subset.start[d] >= 0 && subset.count[d] >= 1 && subset.stride[d] >= 1 &&
+                    subset.start[d] + (subset.count[d] - 1) * subset.stride[d] < subset.shape[d];
+        }
+        if (!valid) {
+            if (outError) *outError = STR("Dataset import failed: subset out of range");
+            RMNContainerInfoClear(&container);
+            OCRelease(ds);
+            return NULL;
+        }
+    }
+    // 4) size every external DV's components and queue its blob read
     OCArrayRef dvsArray = DatasetGetDependentVariables(ds);
     OCIndex dvCount = dvsArray ? OCArrayGetCount(dvsArray) : 0;
     OCStringRef keyInternal = STR(kDependentVariableComponentTypeValueInternal);
     OCStringRef keyBase64 = STR(kDependentVariableEncodingValueBase64);
-    for (OCIndex i = 0; i < dvCount; ++i) {
+    impl_BlobReadJob *jobs = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*jobs));
+    bool *readAsSubset = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*readAsSubset));
+    if (!jobs || !readAsSubset) {
+        if (outError) *outError = STR("Dataset import failed: memory allocation error");
+        free(jobs);
+        free(readAsSubset);
+        RMNContainerInfoClear(&container);
+        OCRelease(ds);
+        return NULL;
+    }
+    size_t njobs = 0;
+    uint32_t section = 0;
+    bool ok = true;
+    for (OCIndex i = 0; ok && i < dvCount; ++i) {
         DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(dvsArray, i);
+        if (subsetted && dv && DependentVariableGetSparseSampling(dv)) {
+            if (outError)
+                *outError = STR("Dataset import failed: subsets of sparsely sampled variables are not supported");
+            ok = false;
+            break;
+        }
         if (!dv || !DependentVariableShouldSerializeExternally(dv))
             continue;
         // ensure DV.size is set
@@ -1373,93 +3491,835 @@ DatasetRef DatasetCreateWithImport(const char *json_path,
             npts = expectedSize;
             DependentVariableSetSize(dv, npts);
         }
-        // path resolution
-        OCStringRef url = DependentVariableGetComponentsURL(dv);
-        if (!url) {
+        impl_BlobReadJob *job = &jobs[njobs++];
+        job->dv = dv;
+        if (isContainer) {
+            // external DVs own the container's sections, in order
+            if (section >= container.sectionCount) {
+                if (outError)
+                    *outError = STR("Dataset import failed: container is missing a binary section");
+                ok = false;
+                break;
+            }
+            if (strlen(json_path) >= sizeof(job->path)) {
+                if (outError) *outError = STR("Dataset import failed: container path too long");
+                ok = false;
+                break;
+            }
+            strcpy(job->path, json_path);
+            job->inContainer = true;
+            job->sectionOffset = container.sections[section].offset;
+            job->sectionLength = container.sections[section].length;
+            ++section;
+        } else {
+            // path resolution
+            OCStringRef url = DependentVariableGetComponentsURL(dv);
+            if (!url) {
+                if (outError)
+                    *outError = STR("Dataset import failed: missing components_url for external variable");
+                ok = false;
+                break;
+            }
+            const char *rel = parse_components_url_path(OCStringGetCString(url));
+            if (!rel) {
+                if (outError)
+                    *outError = STR("Dataset import failed: invalid components_url");
+                ok = false;
+                break;
+            }
+            if (!join_path(job->path, sizeof(job->path), binary_dir, PATH_SEPARATOR, rel)) {
+                if (outError)
+                    *outError = STR("Dataset import failed: binary path too long for component");
+                ok = false;
+                break;
+            }
+        }
+        OCIndex ncomps = DependentVariableGetComponentCount(dv);
+        if (ncomps == 0) {
+            OCStringRef qt = DependentVariableGetQuantityType(dv);
+            ncomps = DependentVariableComponentsCountFromQuantityType(qt);
+        }
+        size_t elemSize = SIQuantityElementSize((SIQuantityRef)dv);
+        job->chunk = (size_t)npts * elemSize;
+        job->elementSize = elemSize;
+        OCIndexArrayRef chunkShape = DependentVariableCopyChunkShape(dv);
+        job->chunked = chunkShape != NULL && !DependentVariableGetSparseSampling(dv);
+        OCRelease(chunkShape);
+        job->ncomps = (size_t)ncomps;
+        // compressed blobs keep their encoding once loaded; plain ones become base64
+        OCStringRef enc = DependentVariableGetEncoding(dv);
+        bool isCodec = enc && RMNCodecParseEncoding(OCStringGetCString(enc), &job->codec, &job->shuffle);
+        if (isCodec && !RMNCodecIsAvailable(job->codec)) {
             if (outError)
-                *outError = STR("Dataset import failed: missing components_url for external variable");
-            OCRelease(ds);
-            return NULL;
+                *outError = STR("Dataset import failed: compression codec not available in this build");
+            ok = false;
+            break;
         }
-        const char *rel = parse_components_url_path(OCStringGetCString(url));
-        if (!rel) {
+        job->shuffleWidth = RMNCodecShuffleWidth(DependentVariableGetElementType(dv));
+        if (!subsetted && !impl_ParseBlobChecksums(dv, job, outError)) {
+            ok = false;
+            break;
+        }
+        if (subsetted) {
+            // workers read only the box; targets are sized for it
+            if (npts != expectedSize) {
+                if (outError)
+                    *outError = STR("Dataset import failed: variable size does not match dimensions");
+                ok = false;
+                break;
+            }
+            job->subsetted = true;
+            job->subset = subset;
+            job->fullChunk = job->chunk;
+            job->chunk = impl_ImportSubsetPointCount(&subset) * elemSize;
+            readAsSubset[i] = true;
+        }
+        if (lazy) {
+            // hand the job to the DV; its blob is read on first access
+            impl_BlobReadJob *deferred = malloc(sizeof(*deferred));
+            if (!deferred) {
+                if (outError) *outError = STR("Dataset import failed: memory allocation error");
+                ok = false;
+                break;
+            }
+            *deferred = *job;
+            memset(job, 0, sizeof(*job));
+            --njobs;
+            if (!DependentVariableSetComponentsLoader(dv, (OCIndex)deferred->ncomps,
+                                                      (OCIndex)(deferred->chunk / deferred->elementSize),
+                                                      impl_LoadDeferredBlob, deferred,
+                                                      impl_ReleaseBlobReadJob)) {
+                free(deferred->crcs);
+                free(deferred);
+                if (outError) *outError = STR("Dataset import failed: cannot defer component load");
+                ok = false;
+                break;
+            }
+            DependentVariableSetType(dv, keyInternal);
+            if (!isCodec) DependentVariableSetEncoding(dv, keyBase64);
+            DependentVariableSetComponentsURL(dv, NULL);
+            continue;
+        }
+        // preallocate the component buffers the workers fill
+        if (!impl_AllocateBlobReadTargets(job, outError)) {
+            ok = false;
+            break;
+        }
+    }
+    if (ok && isContainer && section != container.sectionCount) {
+        if (outError)
+            *outError = STR("Dataset import failed: container sections do not match external variables");
+        ok = false;
+    }
+    // 5) read the blobs (concurrently with I/O workers), then install in DV order
+    if (ok) {
+#if !defined(_WIN32)
+        if (RMNAsyncIOGetBackend() == kRMNAsyncIOUring) impl_ReadBlobsAsync(jobs, njobs);
+#endif
+        RMNParallelFor(njobs, (size_t)DatasetGetIOWorkerCount(), impl_RunBlobReadJob, jobs);
+    }
+    for (size_t j = 0; ok && j < njobs; ++j) {
+        impl_BlobReadJob *job = &jobs[j];
+        if (!impl_BlobReadJobSucceeded(job, outError)) {
+            ok = false;
+            break;
+        }
+        if (!DependentVariableSetComponents(job->dv, job->comps)) {
             if (outError)
-                *outError = STR("Dataset import failed: invalid components_url");
-            OCRelease(ds);
-            return NULL;
+                *outError = STR("Dataset import failed: cannot install DV components");
+            ok = false;
+            break;
+        }
+        // flip to internal, base64 (unless compressed), and NULL components URL
+        DependentVariableSetType(job->dv, keyInternal);
+        if (job->codec == kRMNCodecNone) DependentVariableSetEncoding(job->dv, keyBase64);
+        DependentVariableSetComponentsURL(job->dv, NULL);
+    }
+    for (size_t j = 0; j < njobs; ++j) {
+        OCRelease(jobs[j].comps);
+        free(jobs[j].targets);
+        free(jobs[j].crcs);
+    }
+    free(jobs);
+    RMNContainerInfoClear(&container);
+    // 6) cut inline components down to the subset and shrink the dimensions
+    if (ok && subsetted) ok = impl_DatasetApplySubset(ds, &subset, readAsSubset, outError);
+    free(readAsSubset);
+    if (!ok) {
+        OCRelease(ds);
+        return NULL;
+    }
+    return ds;
+}
+DatasetRef DatasetCreateWithImport(const char *json_path,
+                                   const char *binary_dir,
+                                   OCStringRef *outError) {
+    return impl_DatasetCreateWithImport(json_path, binary_dir, NULL, NULL, NULL, false, outError);
+}
+DatasetRef DatasetCreateWithLazyImport(const char *json_path,
+                                       const char *binary_dir,
+                                       OCStringRef *outError) {
+    return impl_DatasetCreateWithImport(json_path, binary_dir, NULL, NULL, NULL, true, outError);
+}
+DatasetRef DatasetCreateWithImportSubset(const char *json_path,
+                                         const char *binary_dir,
+                                         const OCIndex *start,
+                                         const OCIndex *count,
+                                         const OCIndex *stride,
+                                         OCStringRef *outError) {
+    if (!start || !count) {
+        if (outError) *outError = STR("Dataset import failed: invalid arguments");
+        return NULL;
+    }
+    return impl_DatasetCreateWithImport(json_path, binary_dir, start, count, stride, false, outError);
+}
+/// Shape of one DV as read from its inline payload by
+/// impl_CopyHeaderText(); -1 where the text does not tell.
+typedef struct {
+    OCIndex componentCount;
+    OCIndex size;
+} impl_HeaderShape;
+/// Helper: points per component from one element of an inline
+/// "components" array, sized without decoding it; -1 if unknown.
+static OCIndex impl_InlineComponentSize(const char *elem, const char *elemEnd,
+                                        const impl_InlineDVMembers *m) {
+    size_t elemSize = OCNumberTypeSize(m->numericType);
+    if (elemSize == 0) return -1;
+    if (m->isNone && *elem == '[') {
+        size_t nvals = 0;
+        const char *first = RMNJSONSkipWhitespace(elem + 1, elemEnd);
+        if (first < elemEnd && *first != ']') {
+            nvals = 1;
+            for (const char *q = first; (q = memchr(q, ',', (size_t)(elemEnd - q))); ++q) ++nvals;
+        }
+        bool isComplex = (m->numericType == kOCNumberComplex64Type ||
+                          m->numericType == kOCNumberComplex128Type);
+        return (OCIndex)(isComplex ? (nvals + 1) / 2 : nvals);
+    }
+    if (!m->isBase64 || *elem != '"') return -1;
+    const char *body = elem + 1;
+    size_t len = (size_t)(elemEnd - 1 - body);
+    if (memchr(body, '\\', len)) return -1;
+    size_t nbytes = RMNBase64DecodedLength(body, len);
+    if (m->codec != kRMNCodecNone) {
+        // 12 characters cover the 8-byte length header
+        uint8_t header[9];
+        if (len < 12 || !RMNBase64Decode(body, 12, header, NULL) ||
+            !RMNCodecGetDecodedLength(header, sizeof(header), &nbytes))
+            return -1;
+    }
+    return (OCIndex)(nbytes / elemSize);
+}
+/// Helper: copy a CSDM document with every dependent variable's
+/// "components" value replaced by [], so only metadata is left to parse.
+/// Payloads are stepped over (strings with memchr()) rather than decoded;
+/// `*shapes` receives what they reveal, one entry per DV object.  A layout
+/// the scanner does not recognise is copied whole, for cJSON to judge.
+/// Returns a malloc'd NUL-terminated string, or NULL if out of memory.
+static char *impl_CopyHeaderText(const char *text, size_t length, impl_HeaderShape **shapes,
+                                 OCIndex *shapeCount) {
+    const char *end = text + length;
+    *shapes = NULL;
+    *shapeCount = 0;
+    const char **spans = NULL;  // [start, end) of each stripped "components" value
+    size_t nspans = 0, spansCap = 0, shapesCap = 0, cut = 0;
+    bool ok = true;
+    const char *csdm = RMNJSONFindMember(RMNJSONSkipWhitespace(text, end), end,
+                                         kDatasetCsdmEnvelopeKey, NULL);
+    const char *dvs = csdm && *csdm == '{'
+                          ? RMNJSONFindMember(csdm, end, kDatasetDependentVariablesKey, NULL)
+                          : NULL;
+    const char *elem = dvs && *dvs == '[' ? RMNJSONArrayNextElement(dvs, end) : NULL;
+    while (ok && elem) {
+        const char *elemEnd = RMNJSONSkipValue(elem, end);
+        if (!elemEnd) {
+            ok = false;
+            break;
+        }
+        if (*elem != '{') {  // skipped by the DOM path too
+            elem = RMNJSONArrayNextElement(elemEnd, end);
+            continue;
+        }
+        impl_InlineDVMembers m;
+        impl_ScanInlineDVMembers(elem, elemEnd, &m);
+        impl_HeaderShape shape = {-1, -1};
+        if (m.comps && *m.comps == '[') {
+            OCIndex count = 0;
+            for (const char *c = RMNJSONArrayNextElement(m.comps, m.compsEnd); ok && c;) {
+                const char *cEnd = RMNJSONSkipValue(c, m.compsEnd);
+                if (!cEnd) {
+                    ok = false;
+                    break;
+                }
+                if (count++ == 0 && m.inlinePayload)
+                    shape.size = impl_InlineComponentSize(c, cEnd, &m);
+                c = RMNJSONArrayNextElement(cEnd, m.compsEnd);
+            }
+            if (m.inlinePayload) shape.componentCount = count;
+            if (nspans + 2 > spansCap) {
+                spansCap = spansCap ? spansCap * 2 : 16;
+                const char **grown = realloc(spans, spansCap * sizeof(*spans));
+                if (!grown) {
+                    ok = false;
+                    break;
+                }
+                spans = grown;
+            }
+            spans[nspans++] = m.comps;
+            spans[nspans++] = m.compsEnd;
+            cut += (size_t)(m.compsEnd - m.comps) - 2;
+        }
+        if ((size_t)*shapeCount == shapesCap) {
+            shapesCap = shapesCap ? shapesCap * 2 : 16;
+            impl_HeaderShape *grown = realloc(*shapes, shapesCap * sizeof(**shapes));
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            *shapes = grown;
+        }
+        (*shapes)[(*shapeCount)++] = shape;
+        elem = RMNJSONArrayNextElement(elemEnd, end);
+    }
+    if (!ok) {
+        nspans = 0;
+        cut = 0;
+        free(*shapes);
+        *shapes = NULL;
+        *shapeCount = 0;
+    }
+    char *out = malloc(length - cut + 1);
+    if (out) {
+        char *w = out;
+        const char *r = text;
+        for (size_t i = 0; i < nspans; i += 2) {
+            memcpy(w, r, (size_t)(spans[i] - r));
+            w += spans[i] - r;
+            *w++ = '[';
+            *w++ = ']';
+            r = spans[i + 1];
+        }
+        memcpy(w, r, (size_t)(end - r));
+        w += end - r;
+        *w = '\0';
+    }
+    free(spans);
+    return out;
+}
+OCDictionaryRef DatasetCopyHeaderFromFile(const char *json_path, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!json_path) {
+        if (outError) *outError = STR("Dataset header scan failed: invalid arguments");
+        return NULL;
+    }
+    size_t fileLength = 0;
+    bool mapped = false;
+    uint8_t *file = map_file_bytes(json_path, &fileLength, &mapped);
+    if (!file) {
+        if (outError) {
+            OCStringRef p = OCStringCreateWithCString(json_path);
+            *outError = OCStringCreateWithFormat(
+                STR("Dataset header scan failed: cannot open JSON file '%@'"), p);
+            OCRelease(p);
         }
-        char fullpath[PATH_MAX];
-        if (!join_path(fullpath, sizeof(fullpath), binary_dir, PATH_SEPARATOR, rel)) {
+        return NULL;
+    }
+    // a container's JSON sits between its header and its sections
+    const char *text = (const char *)file;
+    size_t length = fileLength;
+    if (RMNContainerHasMagic(file, fileLength)) {
+        RMNContainerInfo container = {0};
+        OCStringRef cerr = NULL;
+        FILE *cf = fopen(json_path, "rb");
+        bool valid = cf && RMNContainerReadInfo(cf, &container, &cerr) &&
+                     container.jsonOffset + container.jsonLength <= fileLength;
+        if (cf) fclose(cf);
+        text += container.jsonOffset;
+        length = (size_t)container.jsonLength;
+        RMNContainerInfoClear(&container);
+        if (!valid) {
+            unmap_file_bytes(file, fileLength, mapped);
             if (outError)
-                *outError = STR("Dataset import failed: binary path too long for component");
-            OCRelease(ds);
+                *outError = OCStringCreateWithFormat(STR("Dataset header scan failed: %@"),
+                                                     cerr ? cerr : STR("cannot read container"));
+            if (cerr) OCRelease(cerr);
             return NULL;
         }
-        size_t total_bytes = 0;
-        uint8_t *bytes = read_file_bytes(fullpath, &total_bytes);
-        if (!bytes) {
-            if (outError) {
-                OCStringRef p = OCStringCreateWithCString(fullpath);
+    }
+    impl_HeaderShape *shapes = NULL;
+    OCIndex shapeCount = 0;
+    char *header = impl_CopyHeaderText(text, length, &shapes, &shapeCount);
+    unmap_file_bytes(file, fileLength, mapped);
+    bool copied = header != NULL;
+    cJSON *root = copied ? cJSON_Parse(header) : NULL;
+    free(header);
+    if (!root) {
+        free(shapes);
+        const char *e = copied ? cJSON_GetErrorPtr() : NULL;
+        if (outError) {
+            if (!copied) {
+                *outError = STR("Dataset header scan failed: memory allocation error");
+            } else if (e) {
+                OCStringRef estr = OCStringCreateWithCString(e);
                 *outError = OCStringCreateWithFormat(
-                    STR("Dataset import failed: cannot read binary component '%@'"), p);
-                OCRelease(p);
+                    STR("Dataset header scan failed: JSON parse error at '%@'"), estr);
+                OCRelease(estr);
+            } else {
+                *outError = STR("Dataset header scan failed: invalid JSON format");
             }
-            OCRelease(ds);
-            return NULL;
         }
-        OCIndex ncomps = DependentVariableGetComponentCount(dv);
-        if (ncomps == 0) {
-            OCStringRef qt = DependentVariableGetQuantityType(dv);
-            ncomps = DependentVariableComponentsCountFromQuantityType(qt);
+        return NULL;
+    }
+    OCDictionaryRef dict = DatasetDictionaryCreateFromJSON(root, outError);
+    cJSON_Delete(root);
+    if (!dict) {
+        free(shapes);
+        return NULL;
+    }
+    // external payloads are sized from the dimensions, as the importer does
+    OCIndex gridSize = 1;
+    OCArrayRef dimDicts = OCDictionaryGetValue(dict, STR(kDatasetDimensionsKey));
+    OCMutableArrayRef dims = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+    for (OCIndex d = 0; dims && dimDicts && d < OCArrayGetCount(dimDicts); ++d) {
+        DimensionRef dim = DimensionCreateFromDictionary(OCArrayGetValueAtIndex(dimDicts, d), NULL);
+        if (!dim) continue;
+        OCArrayAppendValue(dims, dim);
+        OCRelease(dim);
+    }
+    if (dims) gridSize = RMNCalculateSizeFromDimensions(dims);
+    OCRelease(dims);
+    OCArrayRef dvDicts = OCDictionaryGetValue(dict, STR(kDatasetDependentVariablesKey));
+    for (OCIndex i = 0; dvDicts && i < OCArrayGetCount(dvDicts); ++i) {
+        OCMutableDictionaryRef dvDict = (OCMutableDictionaryRef)OCArrayGetValueAtIndex(dvDicts, i);
+        impl_HeaderShape shape = i < shapeCount ? shapes[i] : (impl_HeaderShape){-1, -1};
+        if (shape.componentCount < 0) {
+            OCArrayRef comps = OCDictionaryGetValue(dvDict, STR(kDependentVariableComponentsKey));
+            shape.componentCount =
+                comps && OCArrayGetCount(comps) > 0
+                    ? OCArrayGetCount(comps)
+                    : DependentVariableComponentsCountFromQuantityType(
+                          OCDictionaryGetValue(dvDict, STR(kDependentVariableQuantityTypeKey)));
         }
-        size_t elemSize = SIQuantityElementSize((SIQuantityRef)dv);
-        size_t chunk = (size_t)npts * elemSize;
-        if (chunk * (size_t)ncomps != total_bytes) {
-            free(bytes);
-            if (outError)
-                *outError = STR("Dataset import failed: binary size mismatch for component");
-            OCRelease(ds);
+        if (shape.size < 0) shape.size = gridSize;
+        OCDictionaryRemoveValue(dvDict, STR(kDependentVariableComponentsKey));
+        OCNumberRef n = OCNumberCreateWithOCIndex(shape.componentCount);
+        OCDictionarySetValue(dvDict, STR(kDatasetHeaderComponentCountKey), n);
+        OCRelease(n);
+        n = OCNumberCreateWithOCIndex(shape.size);
+        OCDictionarySetValue(dvDict, STR(kDatasetHeaderSizeKey), n);
+        OCRelease(n);
+    }
+    free(shapes);
+    return dict;
+}
+#pragma endregion Export / Import
+#pragma region Streaming Writer
+#define kDatasetWriterIndexMagic "RMNWIDX1"
+#define kDatasetWriterIndexSuffix ".idx"
+#define kDatasetWriterCopyBlock 65536
+/// One external DV being written: its blob, and with several components
+/// one part file per component, concatenated into the blob on close.
+typedef struct {
+    char path[PATH_MAX];
+    OCIndex ncomps;
+    OCNumberType elementType;
+    size_t rowBytes;  // bytes of one row of one component
+    FILE **files;     // ncomps part files, or the blob itself for one component
+} impl_WriterStream;
+struct impl_DatasetWriter {
+    DatasetRef header;  // the template, with the slowest dimension's count kept current
+    char jsonPath[PATH_MAX];
+    char indexPath[PATH_MAX];
+    OCIndex streamCount;
+    impl_WriterStream *streams;
+    OCIndex rows;       // appended so far
+    OCIndex committed;  // recorded in the index by the last flush
+    bool failed;        // a partial append left the files ahead of `rows`
+};
+static void impl_WriterPartPath(const impl_WriterStream *s, OCIndex c, char *out, size_t size) {
+    if (s->ncomps == 1)
+        snprintf(out, size, "%s", s->path);
+    else
+        snprintf(out, size, "%s.part%ld", s->path, (long)c);
+}
+static bool impl_TruncateFile(const char *path, uint64_t length) {
+#if defined(_WIN32)
+    FILE *f = fopen(path, "r+b");
+    if (!f) return false;
+    bool ok = _chsize_s(_fileno(f), (__int64)length) == 0;
+    return fclose(f) == 0 && ok;
+#else
+    return truncate(path, (off_t)length) == 0;
+#endif
+}
+/// Write `rows` to the sidecar index through a temporary file, so the index
+/// always holds either the previous or the new count.
+static bool impl_WriterWriteIndex(DatasetWriterRef w, OCIndex rows) {
+    bool durable = DatasetGetExportMode() == kDatasetExportDurable;
+    char tmp[PATH_MAX];
+    if (!temp_path_for(w->indexPath, tmp, sizeof(tmp))) return false;
+    FILE *f = fopen(tmp, "wb");
+    if (!f) return false;
+    uint8_t record[16];
+    memcpy(record, kDatasetWriterIndexMagic, 8);
+    for (int i = 0; i < 8; ++i) record[8 + i] = (uint8_t)((uint64_t)rows >> (8 * i));
+    bool ok = fwrite(record, 1, sizeof(record), f) == sizeof(record) &&
+              (!durable || sync_stream(f));
+    if (fclose(f) != 0) ok = false;
+    ok = ok && replace_file(tmp, w->indexPath) && (!durable || sync_parent_directory(w->indexPath));
+    if (!ok) remove(tmp);
+    return ok;
+}
+static bool impl_WriterReadIndex(const char *path, OCIndex *outRows) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t record[16];
+    bool ok = fread(record, 1, sizeof(record), f) == sizeof(record) &&
+              memcmp(record, kDatasetWriterIndexMagic, 8) == 0;
+    fclose(f);
+    if (!ok) return false;
+    uint64_t rows = 0;
+    for (int i = 7; i >= 0; --i) rows = (rows << 8) | record[8 + i];
+    *outRows = (OCIndex)rows;
+    return true;
+}
+/// Rewrite the .csdfe document for `rows` rows through a temporary file.
+static bool impl_WriterWriteHeader(DatasetWriterRef w, OCIndex rows, bool durable,
+                                   OCStringRef *outError) {
+    OCArrayRef dims = DatasetGetDimensions(w->header);
+    SILinearDimensionRef slowest =
+        (SILinearDimensionRef)OCArrayGetValueAtIndex(dims, OCArrayGetCount(dims) - 1);
+    if (!SILinearDimensionSetCount(slowest, rows)) {
+        if (outError) *outError = STR("Failed to update the slowest dimension's count");
+        return false;
+    }
+    char tmp[PATH_MAX];
+    if (!temp_path_for(w->jsonPath, tmp, sizeof(tmp))) {
+        if (outError) *outError = STR("JSON path too long");
+        return false;
+    }
+    bool ok = impl_ExportJSONFile(w->header, tmp, NULL, durable, outError);
+    if (ok && (!replace_file(tmp, w->jsonPath) ||
+               (durable && !sync_parent_directory(w->jsonPath)))) {
+        if (outError) *outError = STR("Failed to replace JSON file");
+        ok = false;
+    }
+    if (!ok) remove(tmp);
+    return ok;
+}
+/// Whether some DV is written as part files, whose blob only exists once
+/// DatasetWriterClose() has concatenated them.
+static bool impl_WriterHasParts(DatasetWriterRef w) {
+    for (OCIndex i = 0; i < w->streamCount; ++i)
+        if (w->streams[i].ncomps > 1) return true;
+    return false;
+}
+static void impl_WriterFree(DatasetWriterRef w) {
+    for (OCIndex i = 0; i < w->streamCount; ++i) {
+        impl_WriterStream *s = &w->streams[i];
+        for (OCIndex c = 0; s->files && c < s->ncomps; ++c)
+            if (s->files[c]) fclose(s->files[c]);
+        free(s->files);
+    }
+    free(w->streams);
+    OCRelease(w->header);
+    free(w);
+}
+static DatasetWriterRef impl_DatasetWriterCreate(DatasetRef layout,
+                                                 const char *json_path,
+                                                 const char *binary_dir,
+                                                 bool resume,
+                                                 OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!layout || !json_path) {
+        if (outError) *outError = STR("Invalid arguments");
+        return NULL;
+    }
+    char derived_binary_dir[PATH_MAX];
+    if (!binary_dir) {
+        if (!derive_directory_from_path(json_path, derived_binary_dir, sizeof(derived_binary_dir))) {
+            if (outError) *outError = STR("Cannot determine binary directory from JSON path");
             return NULL;
         }
-        OCMutableArrayRef comps = OCArrayCreateMutable(ncomps, &kOCTypeArrayCallBacks);
-        if (!comps) {
-            free(bytes);
+        binary_dir = derived_binary_dir;
+    }
+    const char *dot = strrchr(json_path, '.');
+    if (!dot || strcasecmp(dot + 1, "csdfe") != 0) {
+        if (outError) *outError = STR("Streaming writer requires a .csdfe path");
+        return NULL;
+    }
+    OCArrayRef dims = DatasetGetDimensions(layout);
+    OCIndex rank = dims ? OCArrayGetCount(dims) : 0;
+    if (rank == 0 || OCGetTypeID(OCArrayGetValueAtIndex(dims, rank - 1)) !=
+                         SILinearDimensionGetTypeID()) {
+        if (outError) *outError = STR("Streaming writer requires a linear slowest dimension");
+        return NULL;
+    }
+    size_t rowPoints = 1;
+    for (OCIndex d = 0; d + 1 < rank; ++d)
+        rowPoints *= (size_t)DimensionGetCount((DimensionRef)OCArrayGetValueAtIndex(dims, d));
+    struct impl_DatasetWriter *w = calloc(1, sizeof(*w));
+    if (!w) {
+        if (outError) *outError = STR("Memory allocation error");
+        return NULL;
+    }
+    w->header = DatasetCreateCopy(layout);
+    OCIndex dvCount = DatasetGetDependentVariableCount(layout);
+    w->streams = calloc(dvCount ? (size_t)dvCount : 1, sizeof(*w->streams));
+    if (!w->header || !w->streams ||
+        snprintf(w->jsonPath, sizeof(w->jsonPath), "%s", json_path) >= (int)sizeof(w->jsonPath) ||
+        snprintf(w->indexPath, sizeof(w->indexPath), "%s%s", json_path,
+                 kDatasetWriterIndexSuffix) >= (int)sizeof(w->indexPath)) {
+        impl_WriterFree(w);
+        if (outError) *outError = STR("Memory allocation error");
+        return NULL;
+    }
+    if (resume && !impl_WriterReadIndex(w->indexPath, &w->committed)) {
+        impl_WriterFree(w);
+        if (outError) *outError = STR("No streaming writer index to resume from");
+        return NULL;
+    }
+    w->rows = w->committed;
+    // 1) each DV streams to its own blob; validate them all before touching a file
+    for (OCIndex i = 0; i < dvCount; ++i) {
+        DependentVariableRef dv = DatasetGetDependentVariableAtIndex(layout, i);
+        OCStringRef url = DependentVariableGetComponentsURL(dv);
+        OCStringRef enc = DependentVariableGetEncoding(dv);
+        OCIndexArrayRef chunkShape = DependentVariableCopyChunkShape(dv);
+        bool supported = DependentVariableShouldSerializeExternally(dv) && url &&
+                         !DependentVariableGetSparseSampling(dv) && !chunkShape &&
+                         !(enc && RMNCodecParseEncoding(OCStringGetCString(enc), NULL, NULL));
+        OCRelease(chunkShape);
+        if (!supported) {
+            impl_WriterFree(w);
             if (outError)
-                *outError = STR("Dataset import failed: cannot allocate components array");
-            OCRelease(ds);
+                *outError = STR("Streaming writer requires plain external dependent variables");
             return NULL;
         }
-        for (OCIndex ci = 0; ci < ncomps; ++ci) {
-            OCMutableDataRef buf = OCDataCreateMutable(chunk);
-            if (!buf || !OCDataAppendBytes(buf, bytes + (ci * chunk), chunk)) {
-                OCRelease(buf);
-                OCRelease(comps);
-                free(bytes);
-                if (outError)
-                    *outError = STR("Dataset import failed: cannot create component buffer");
-                OCRelease(ds);
+        const char *rel = parse_components_url_path(OCStringGetCString(url));
+        impl_WriterStream *s = &w->streams[w->streamCount++];
+        s->ncomps = DependentVariableGetComponentCount(dv);
+        s->elementType = DependentVariableGetElementType(dv);
+        s->rowBytes = rowPoints * SIQuantityElementSize((SIQuantityRef)dv);
+        s->files = calloc(s->ncomps ? (size_t)s->ncomps : 1, sizeof(*s->files));
+        if (!rel || !s->files || s->ncomps < 1 ||
+            !join_path(s->path, sizeof(s->path), binary_dir, PATH_SEPARATOR, rel) ||
+            !ensure_parent_dirs(s->path, outError)) {
+            impl_WriterFree(w);
+            if (outError && !*outError) *outError = STR("Invalid components_url");
+            return NULL;
+        }
+    }
+    // 2) open every component file, dropping any rows appended after the last flush
+    for (OCIndex i = 0; i < w->streamCount; ++i) {
+        impl_WriterStream *s = &w->streams[i];
+        uint64_t keep = (uint64_t)w->committed * s->rowBytes;
+        for (OCIndex c = 0; c < s->ncomps; ++c) {
+            char part[PATH_MAX + 32];
+            impl_WriterPartPath(s, c, part, sizeof(part));
+            struct stat st;
+            if (resume && (stat(part, &st) != 0 || (uint64_t)st.st_size < keep ||
+                           !impl_TruncateFile(part, keep))) {
+                impl_WriterFree(w);
+                if (outError) *outError = STR("Streaming writer data is shorter than its index");
+                return NULL;
+            }
+            s->files[c] = fopen(part, resume ? "ab" : "wb");
+            if (!s->files[c]) {
+                impl_WriterFree(w);
+                if (outError) *outError = STR("Failed to open binary output file");
                 return NULL;
             }
-            OCArrayAppendValue(comps, buf);
-            OCRelease(buf);
         }
-        free(bytes);
-        if (!DependentVariableSetComponents(dv, comps)) {
-            OCRelease(comps);
-            if (outError)
-                *outError = STR("Dataset import failed: cannot install DV components");
-            OCRelease(ds);
-            return NULL;
+    }
+    if (!ensure_parent_dirs(json_path, outError) ||
+        (!resume && !impl_WriterWriteIndex(w, 0))) {
+        impl_WriterFree(w);
+        if (outError && !*outError) *outError = STR("Failed to write streaming writer index");
+        return NULL;
+    }
+    return w;
+}
+DatasetWriterRef DatasetWriterCreate(DatasetRef layout,
+                                     const char *json_path,
+                                     const char *binary_dir,
+                                     OCStringRef *outError) {
+    return impl_DatasetWriterCreate(layout, json_path, binary_dir, false, outError);
+}
+DatasetWriterRef DatasetWriterCreateResuming(DatasetRef layout,
+                                             const char *json_path,
+                                             const char *binary_dir,
+                                             OCStringRef *outError) {
+    return impl_DatasetWriterCreate(layout, json_path, binary_dir, true, outError);
+}
+OCIndex DatasetWriterGetRowCount(DatasetWriterRef w) {
+    return w ? w->rows : 0;
+}
+bool DatasetWriterAppend(DatasetWriterRef w, OCArrayRef rows, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!w || !rows || OCArrayGetCount(rows) != w->streamCount) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    if (w->failed) {
+        if (outError) *outError = STR("Streaming writer failed; resume from its last flush");
+        return false;
+    }
+    // 1) the same checks as DependentVariableAppend(), plus whole rows that
+    //    agree across DVs, so nothing is written unless everything fits
+    OCIndex added = -1;
+    for (OCIndex i = 0; i < w->streamCount; ++i) {
+        const impl_WriterStream *s = &w->streams[i];
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(rows, i);
+        DependentVariableRef like = DatasetGetDependentVariableAtIndex(w->header, i);
+        OCIndex n = DependentVariableGetComponentCount(dv);
+        if (!SIQuantityHasSameReducedDimensionality((SIQuantityRef)like, (SIQuantityRef)dv) ||
+            DependentVariableGetElementType(dv) != s->elementType ||
+            (n != s->ncomps && n != 1)) {
+            if (outError) *outError = STR("Append Error: rows do not match the dataset layout");
+            return false;
+        }
+        for (OCIndex c = 0; c < n; ++c) {
+            size_t len = (size_t)OCDataGetLength(DependentVariableGetComponentAtIndex(dv, c));
+            OCIndex count = s->rowBytes ? (OCIndex)(len / s->rowBytes) : 0;
+            if (len == 0 || len % s->rowBytes != 0 || (added >= 0 && count != added)) {
+                if (outError) *outError = STR("Append Error: components must hold the same whole rows");
+                return false;
+            }
+            added = count;
         }
-        OCRelease(comps);
-        // flip to internal, base64, and NULL components URL
-        DependentVariableSetType(dv, keyInternal);
-        DependentVariableSetEncoding(dv, keyBase64);
-        DependentVariableSetComponentsURL(dv, NULL);
     }
-    return ds;
+    // 2) append each component's rows; a single component is broadcast
+    for (OCIndex i = 0; i < w->streamCount; ++i) {
+        impl_WriterStream *s = &w->streams[i];
+        DependentVariableRef dv = (DependentVariableRef)OCArrayGetValueAtIndex(rows, i);
+        OCIndex n = DependentVariableGetComponentCount(dv);
+        for (OCIndex c = 0; c < s->ncomps; ++c) {
+            OCDataRef src = DependentVariableGetComponentAtIndex(dv, n != 1 ? c : 0);
+            size_t len = (size_t)OCDataGetLength(src);
+            if (fwrite(OCDataGetBytesPtr(src), 1, len, s->files[c]) != len) {
+                w->failed = true;
+                if (outError) *outError = STR("Error writing binary blob");
+                return false;
+            }
+        }
+    }
+    w->rows += added;
+    return true;
 }
-#pragma endregion Export / Import
+/// Push the appended rows to the part files, then record them in the index.
+static bool impl_WriterCommit(DatasetWriterRef w, OCStringRef *outError) {
+    if (w->failed) {
+        if (outError) *outError = STR("Streaming writer failed; resume from its last flush");
+        return false;
+    }
+    // data first, then the index that vouches for it
+    bool durable = DatasetGetExportMode() == kDatasetExportDurable;
+    for (OCIndex i = 0; i < w->streamCount; ++i)
+        for (OCIndex c = 0; c < w->streams[i].ncomps; ++c)
+            if (durable ? !sync_stream(w->streams[i].files[c])
+                        : fflush(w->streams[i].files[c]) != 0) {
+                w->failed = true;
+                if (outError) *outError = STR("Error writing binary blob");
+                return false;
+            }
+    if (!impl_WriterWriteIndex(w, w->rows)) {
+        if (outError) *outError = STR("Failed to write streaming writer index");
+        return false;
+    }
+    w->committed = w->rows;
+    return true;
+}
+bool DatasetWriterFlush(DatasetWriterRef w, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!w) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    if (!impl_WriterCommit(w, outError)) return false;
+    // a linear dimension needs two points, and the document may only name
+    // blobs that exist; until then only the index is kept
+    return w->rows < 2 || impl_WriterHasParts(w) ||
+           impl_WriterWriteHeader(w, w->rows, DatasetGetExportMode() == kDatasetExportDurable,
+                                  outError);
+}
+bool DatasetWriterClose(DatasetWriterRef w, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!w) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    bool ok = impl_WriterCommit(w, outError);
+    if (ok && w->rows < 2) {
+        if (outError) *outError = STR("Streaming writer needs at least two rows to close");
+        ok = false;
+    }
+    for (OCIndex i = 0; i < w->streamCount; ++i) {
+        impl_WriterStream *s = &w->streams[i];
+        for (OCIndex c = 0; c < s->ncomps; ++c) {
+            FILE *f = s->files[c];
+            s->files[c] = NULL;
+            if (!f) continue;
+            // a single component is the blob itself, which must be on disk
+            // before the index goes
+            bool synced = !ok || s->ncomps > 1 || sync_stream(f);
+            if ((fclose(f) != 0 || !synced) && ok) {
+                if (outError) *outError = STR("Error writing binary blob");
+                ok = false;
+            }
+        }
+    }
+    // 1) concatenate multi-component parts into the CSDM component-major
+    //    blob through a synced temporary, so the parts are only removed once
+    //    the blob is on disk
+    uint8_t *block = ok ? malloc(kDatasetWriterCopyBlock) : NULL;
+    if (ok && !block) {
+        if (outError) *outError = STR("Memory allocation error");
+        ok = false;
+    }
+    for (OCIndex i = 0; ok && i < w->streamCount; ++i) {
+        impl_WriterStream *s = &w->streams[i];
+        if (s->ncomps == 1) continue;
+        char tmp[PATH_MAX];
+        FILE *out = temp_path_for(s->path, tmp, sizeof(tmp)) ? fopen(tmp, "wb") : NULL;
+        ok = out != NULL;
+        for (OCIndex c = 0; ok && c < s->ncomps; ++c) {
+            char part[PATH_MAX + 32];
+            impl_WriterPartPath(s, c, part, sizeof(part));
+            FILE *in = fopen(part, "rb");
+            ok = in != NULL;
+            size_t got;
+            while (ok && (got = fread(block, 1, kDatasetWriterCopyBlock, in)) > 0)
+                ok = fwrite(block, 1, got, out) == got;
+            if (in) fclose(in);
+        }
+        if (out) {
+            ok = ok && sync_stream(out);
+            if (fclose(out) != 0) ok = false;
+            ok = ok && replace_file(tmp, s->path) && sync_parent_directory(s->path);
+            if (!ok) remove(tmp);
+        }
+        if (!ok && outError) *outError = STR("Error writing binary blob");
+    }
+    free(block);
+    // 2) the document, durably, now that every blob it names exists
+    if (ok) ok = impl_WriterWriteHeader(w, w->rows, true, outError);
+    // 3) the document describes complete blobs; the index and parts can go
+    if (ok) {
+        remove(w->indexPath);
+        for (OCIndex i = 0; i < w->streamCount; ++i) {
+            impl_WriterStream *s = &w->streams[i];
+            for (OCIndex c = 0; s->ncomps > 1 && c < s->ncomps; ++c) {
+                char part[PATH_MAX + 32];
+                impl_WriterPartPath(s, c, part, sizeof(part));
+                remove(part);
+            }
+        }
+    }
+    impl_WriterFree(w);
+    return ok;
+}
+#pragma endregion Streaming Writer
 #pragma region Getters/Setters
 OCMutableArrayRef DatasetGetDimensions(DatasetRef ds) {
     return ds ? ds->dimensions : NULL;
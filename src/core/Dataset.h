@@ -117,7 +117,8 @@ DatasetCreateFromDictionary(OCDictionaryRef dict, OCStringRef *outError);
  * Use this for tests, round-trip, or JSON conversion via cJSON.
  *
  * @param ds DatasetRef to serialize.
- * @return An OCDictionaryRef you must OCRelease() when done.
+ * @return An OCDictionaryRef you must OCRelease() when done, or NULL if a
+ *         dependent variable's components cannot be encoded.
  */
 OCDictionaryRef DatasetCopyAsDictionary(DatasetRef ds);
 /**
@@ -180,16 +181,55 @@ bool DatasetSetMetaData(DatasetRef ds, OCDictionaryRef md);
  *
  * - Serializes the Dataset to JSON and writes to `json_path` (must end in
  *   “.csdf” if no externals, or “.csdfe” if any external DVs),
- * - Writes each external DV’s raw blob under `binary_dir/…`.
+ * - Writes each external DV’s raw blob under `binary_dir/…`; the JSON
+ *   keeps such DVs “external”, with their components_url and no inline
+ *   components.
+ *
+ * The JSON is streamed with DatasetExportJSONToStream(), so inline
+ * components are encoded chunk by chunk rather than held in memory (or,
+ * with several I/O workers, a bounded window of components at a time).
+ *
+ * Each external DV's component hashes (RMNHashXXH3()) are recorded in its
+ * "application" metadata under kRMNHashComponentsMetaDataKey, so a reader
+ * can compare them via DatasetCopyHeaderFromFile() before loading any blob.
+ * External DVs whose blobs would be byte-identical (same components,
+ * encoding and layout) share one: it is written once, under the first
+ * such DV's components_url, and the others' components_url name that file.
+ * With DatasetSetBlobChecksums() enabled the blobs' CRC-32C values are
+ * recorded alongside (kRMNHashBlobChecksumMetaDataKey).
+ *
+ * If `json_path` ends in “.csdmx”, the document and every external blob
+ * are instead packed into that one file (see RMNContainer.h) and
+ * `binary_dir` is ignored.
  *
  * @param ds         Dataset to export.
- * @param json_path  Full path to JSON file (.csdf/.csdfe).
+ * @param json_path  Full path to JSON file (.csdf/.csdfe), or to a .csdmx
+ *                   container.
  * @param binary_dir Directory under which to write external‐data files.
  *                   If NULL, the directory containing json_path is used.
  * @param outError   On error, set to a brief OCStringRef.
  * @return true on success, false on failure (and `*outError` set).
  */
 bool DatasetExport(DatasetRef ds, const char *json_path, const char *binary_dir, OCStringRef *outError);
+/**
+ * @brief Stream a Dataset's CSDM JSON to an open stream.
+ *
+ * Produces the same text DatasetExport() writes to `json_path` without
+ * building the whole document in memory: the metadata is rendered with
+ * placeholder components and each component is then base64-encoded (or
+ * number-formatted for "none") in fixed-size chunks straight to `stream`.
+ * With several I/O workers (DatasetSetIOWorkerCount()) base64 components
+ * are instead encoded whole, a window of about one per worker at a time,
+ * so at most that many payloads are held in memory.
+ * External blobs are not written; use DatasetExport() for a complete
+ * .csdfe export.  For a raw file descriptor, wrap it with fdopen().
+ *
+ * @param ds       Dataset to serialize.
+ * @param stream   Destination, opened for writing.
+ * @param outError On error, set to a brief OCStringRef.
+ * @return true on success, false on failure (and `*outError` set).
+ */
+bool DatasetExportJSONToStream(DatasetRef ds, FILE *stream, OCStringRef *outError);
 /**
  * @brief Read a Dataset + externals back from disk.
  *
@@ -197,12 +237,270 @@ bool DatasetExport(DatasetRef ds, const char *json_path, const char *binary_dir,
  * - Constructs the Dataset object,
  * - Loads any external blobs from `binary_dir/…`.
  *
- * @param json_path  Path to JSON (.csdf/.csdfe).
+ * External blobs are memory-mapped (POSIX) rather than read into a staging
+ * buffer.  This saves the staging buffer, not the copy: every component is
+ * still copied out of the mapping into its own buffer, and that copy faults
+ * the blob's pages in from disk or the page cache.  Empty files, and
+ * platforms without mmap, are read with fread() instead.
+ *
+ * A .csdmx container is recognised by its magic bytes; its blobs are read
+ * from the container's sections and `binary_dir` may be NULL.
+ *
+ * @param json_path  Path to JSON (.csdf/.csdfe) or to a .csdmx container.
  * @param binary_dir Directory where external-data files live.
  * @param outError   On error, set to a brief OCStringRef.
  * @return Newly allocated DatasetRef, or NULL on failure.
  */
 DatasetRef DatasetCreateWithImport(const char *json_path, const char *binary_dir, OCStringRef *outError);
+/**
+ * @brief Import a Dataset, deferring external blob reads until first use.
+ *
+ * Like DatasetCreateWithImport(), but leaves each external DV's blob on
+ * disk; it is read the first time one of that DV's component accessors
+ * (e.g. DependentVariableGetComponentAtIndex()) runs.  Dataset-level
+ * accessors such as DatasetGetDependentVariableAtIndex(), and
+ * DependentVariableGetComponentCount() / DependentVariableGetSize(), never
+ * trigger a read.  Load errors surface through
+ * DependentVariableLoadComponents().  DatasetExport() and
+ * DatasetExportJSONToStream() load every pending DV first and fail,
+ * writing nothing, if any load fails.
+ *
+ * The blob files must stay in place until each DV has been loaded.
+ *
+ * @param json_path  Path to JSON (.csdf/.csdfe) or to a .csdmx container.
+ * @param binary_dir Directory where external-data files live.
+ * @param outError   On error, set to a brief OCStringRef.
+ * @return Newly allocated DatasetRef, or NULL on failure.
+ */
+DatasetRef DatasetCreateWithLazyImport(const char *json_path, const char *binary_dir, OCStringRef *outError);
+/**
+ * @brief Read a hyper-slab of a Dataset without loading full components.
+ *
+ * Like DatasetCreateWithImport(), but keeps only the index box
+ * start[d], start[d] + stride[d], …, start[d] + (count[d] − 1)·stride[d]
+ * along each dimension d (CSDM order, dimension 0 fastest).  External
+ * blobs are read row by row at the byte offsets of the box, so only the
+ * requested data comes off disk; chunked blobs read only the chunks the
+ * box touches, and compressed blobs are decoded then cut.  Inline
+ * components are cut after parsing.
+ *
+ * The result's dimensions are restricted to the box; a dimension reduced
+ * to a single index is dropped.  Sparsely sampled variables are not
+ * supported.
+ *
+ * @param json_path  Path to JSON (.csdf/.csdfe) or to a .csdmx container.
+ * @param binary_dir Directory where external-data files live.
+ * @param start      First index along each dimension.
+ * @param count      Number of indexes along each dimension (≥1).
+ * @param stride     Index step along each dimension (≥1), or NULL for 1.
+ * @param outError   On error, set to a brief OCStringRef.
+ * @return Newly allocated DatasetRef, or NULL on failure.
+ */
+DatasetRef DatasetCreateWithImportSubset(const char *json_path,
+                                         const char *binary_dir,
+                                         const OCIndex *start,
+                                         const OCIndex *count,
+                                         const OCIndex *stride,
+                                         OCStringRef *outError);
+/** Key added to each dependent-variable entry by DatasetCopyHeaderFromFile(). */
+#define kDatasetHeaderComponentCountKey "component_count"
+/** Key added to each dependent-variable entry by DatasetCopyHeaderFromFile(). */
+#define kDatasetHeaderSizeKey "size"
+/**
+ * @brief Read a CSDM file's metadata without loading any component data.
+ *
+ * Meant for indexing many files: component payloads are stepped over in the
+ * text (base64 strings with a memchr() for the closing quote) instead of
+ * being decoded, external blobs are never opened, and only the remaining
+ * metadata goes through the JSON parser.
+ *
+ * The result has the shape DatasetCopyAsDictionary() produces ("title",
+ * "dimensions", "dependent_variables", ...), except that each dependent
+ * variable drops "components" and gains two OCNumbers:
+ * - kDatasetHeaderComponentCountKey: number of components;
+ * - kDatasetHeaderSizeKey: points per component, from the inline payload
+ *   or, for external variables, from the dimensions as
+ *   DatasetCreateWithImport() assumes.
+ *
+ * Pass a dimension entry to DimensionCreateFromDictionary() for a
+ * DimensionRef.
+ *
+ * @param json_path  Path to JSON (.csdf/.csdfe) or to a .csdmx container.
+ * @param outError   On error, set to a brief OCStringRef.
+ * @return A new dictionary (caller releases), or NULL on failure.
+ */
+OCDictionaryRef DatasetCopyHeaderFromFile(const char *json_path, OCStringRef *outError);
+/**
+ * @brief Set the number of worker threads used for Dataset I/O.
+ *
+ * With more than one worker, DatasetExport() and DatasetCreateWithImport()
+ * read and write external blobs and base64-code inline components
+ * concurrently.  Results are identical to serial mode: work is split per
+ * component and reassembled in dependent-variable order.  Exporting then
+ * encodes about one inline component per worker ahead of the writer,
+ * holding that window of base64 text in memory instead of streaming it.
+ *
+ * Where RMNAsyncIOGetBackend() reports io_uring, plain external blobs
+ * (no compression, chunked layout or subset) bypass the workers: all of
+ * their components are read or written as one RMNAsyncIO batch.
+ *
+ * Not thread-safe; set it before starting I/O.
+ *
+ * @param workers 1 for serial I/O (the default), 0 for one worker per
+ *                online processor, or an explicit thread count.
+ */
+void DatasetSetIOWorkerCount(OCIndex workers);
+/**
+ * @brief Number of worker threads Dataset I/O will use (0 is resolved to
+ *        the processor count).
+ */
+OCIndex DatasetGetIOWorkerCount(void);
+/** @brief How DatasetExport() puts its files in place. */
+typedef enum {
+    /** Write each file at its final path: JSON first, then blobs (the default). */
+    kDatasetExportDirect = 0,
+    /** Write blobs, then JSON, to uniquely named "<path>.*.rmntmp"
+     *  temporaries and rename them into place, the JSON last, once
+     *  everything is written. */
+    kDatasetExportAtomic,
+    /** As kDatasetExportAtomic, but fsync every file before its rename and
+     *  the directories after, so the export survives power loss. */
+    kDatasetExportDurable,
+} DatasetExportMode;
+/**
+ * @brief Choose how DatasetExport() and DatasetWriterFlush() commit files.
+ *
+ * With an atomic mode a reader never sees a partially written file: each
+ * file is written to a temporary beside it and renamed into place, which
+ * is atomic on POSIX.  An export that fails before its renames leaves the
+ * previous files untouched, apart from stray ".rmntmp" temporaries after
+ * a crash.  The files of an export are not replaced as one, though: a
+ * .csdfe and its blobs are renamed one by one, blobs first and the JSON
+ * last.  A reader that opens the new JSON finds its blobs, but one still
+ * holding the previous JSON may meet blobs already replaced.  A failure
+ * or crash during the renames likewise leaves the previous JSON beside
+ * the blobs renamed so far; there is no rollback.  Use a new blob path
+ * per export where readers must never see such a mix.
+ * DatasetWriter always replaces its index and document through
+ * temporaries; kDatasetExportDurable additionally makes it fsync.
+ *
+ * Not thread-safe; set it before starting I/O.
+ */
+void DatasetSetExportMode(DatasetExportMode mode);
+/** @brief The current DatasetExport() commit mode. */
+DatasetExportMode DatasetGetExportMode(void);
+/**
+ * @brief Record CRC-32C checksums of external blobs on export.
+ *
+ * When enabled, DatasetExport() stores under each external DV's
+ * kRMNHashBlobChecksumMetaDataKey the CRC-32C of every 4 MiB block of its
+ * blob as written (after compression or chunking), for .csdfe blob files
+ * and .csdmx sections alike.  DatasetCreateWithImport() verifies every
+ * blob that carries such a record, whatever this setting, and fails with
+ * a checksum error on a mismatch; subset imports, which read only part of
+ * a blob, skip the check.  Verification runs while the blob is copied
+ * into its components, using the SSE4.2 / ARMv8 crc32 instructions where
+ * available.
+ *
+ * A compressed blob is encoded into memory once to checksum it, and its
+ * frames are written from there.  Not thread-safe; set it before starting
+ * I/O.
+ *
+ * @param enabled true to record checksums, false (the default) to export
+ *                without them.
+ */
+void DatasetSetBlobChecksums(bool enabled);
+/** @brief Whether DatasetExport() records blob checksums. */
+bool DatasetGetBlobChecksums(void);
+/** @} */
+/** @defgroup Writer Streaming .csdfe writer
+ *  Grow a .csdfe + blobs row by row, e.g. while an acquisition runs.
+ *  @{
+ */
+/** Opaque handle for an append-mode writer; freed by DatasetWriterClose(). */
+typedef struct impl_DatasetWriter *DatasetWriterRef;
+/**
+ * @brief Start writing a .csdfe whose slowest dimension grows over time.
+ *
+ * `layout` gives everything but the data: its dimensions (the last one,
+ * the slowest in CSDM order, must be an SILinearDimension whose count is
+ * replaced by the number of rows written) and its dependent variables,
+ * which must all be external with a "components_url", dense, unchunked and
+ * uncompressed.  A row is one index of the slowest dimension, i.e. the
+ * product of the other dimensions' counts in points.
+ *
+ * Each DV's blob is appended to as rows arrive; a DV with several
+ * components writes one "<blob>.partN" file per component, concatenated
+ * into the CSDM blob by DatasetWriterClose().  Crash safety comes from a
+ * sidecar index, "<json_path>.idx", that records the rows committed by
+ * the last DatasetWriterFlush(); it and the .csdfe are replaced through
+ * temporary files, so each is always either the old or the new version.
+ * After a crash, DatasetWriterCreateResuming() drops any uncommitted rows
+ * and carries on.  Existing output files are overwritten.
+ *
+ * The .csdfe is only written once every blob it names exists.  With
+ * single-component DVs it is rewritten at each flush and the output is
+ * readable while the writer is open.  A multi-component DV's blob does not
+ * exist until DatasetWriterClose() merges its parts, so until then,
+ * including after a crash, such output has no .csdfe and can only be
+ * resumed and closed.
+ *
+ * @param layout     Template Dataset; copied, not retained.
+ * @param json_path  Path of the .csdfe to write.
+ * @param binary_dir Directory for the blobs, or NULL for json_path's.
+ * @param outError   On error, set to a brief OCStringRef.
+ * @return A new writer, or NULL on failure.
+ */
+DatasetWriterRef DatasetWriterCreate(DatasetRef layout,
+                                     const char *json_path,
+                                     const char *binary_dir,
+                                     OCStringRef *outError);
+/**
+ * @brief Reopen an interrupted DatasetWriterCreate() output for appending.
+ *
+ * Takes the same arguments as the original call.  Files are cut back to
+ * the row count in the sidecar index; rows appended after the last flush
+ * are lost.
+ */
+DatasetWriterRef DatasetWriterCreateResuming(DatasetRef layout,
+                                             const char *json_path,
+                                             const char *binary_dir,
+                                             OCStringRef *outError);
+/**
+ * @brief Append one or more rows.
+ *
+ * `rows` holds one DependentVariable per layout DV, in order.  As with
+ * DependentVariableAppend(), each must match its layout DV's reduced
+ * dimensionality and element type and have the same number of components,
+ * or a single component that is written to all of them.  Every component
+ * must hold the same whole number of rows.  Nothing is written if any
+ * check fails.
+ *
+ * @return true on success, false on failure (and `*outError` set).
+ */
+bool DatasetWriterAppend(DatasetWriterRef writer, OCArrayRef rows, OCStringRef *outError);
+/** @brief Rows appended so far, including any not yet flushed. */
+OCIndex DatasetWriterGetRowCount(DatasetWriterRef writer);
+/**
+ * @brief Commit the rows appended so far.
+ *
+ * Flushes the blobs, records the row count in the sidecar index and, once
+ * there are at least two rows and no DV is still split into part files,
+ * rewrites the .csdfe with the new count.
+ */
+bool DatasetWriterFlush(DatasetWriterRef writer, OCStringRef *outError);
+/**
+ * @brief Flush, assemble the final blobs and free the writer.
+ *
+ * Multi-component blobs are assembled in temporary files, synced and
+ * renamed into place, then the .csdfe is written and synced; only then
+ * are the sidecar index and part files removed, so a crash at any point
+ * leaves output that can be resumed.  Afterwards the .csdfe and its blobs
+ * are ordinary CSDM files.  At least two rows must have been written.
+ * The writer is freed even on failure; the output can then still be
+ * resumed from the last successful flush.
+ */
+bool DatasetWriterClose(DatasetWriterRef writer, OCStringRef *outError);
 /** @} */
 /** @name CSDM-1.0 Fields
  * @{ */
@@ -1,7 +1,27 @@
 /* DependentVariable OCType implementation */
+#include <float.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include "DependentVariable.h"
 #pragma region Type Registration
 static OCTypeID kDependentVariableID = kOCNotATypeID;
+/// One recorded in-place operation (DependentVariableSetDefersOperations).
+typedef enum {
+    kQueuedScaleReal,     // MultiplyValuesByDimensionlessRealConstant
+    kQueuedScaleComplex,  // MultiplyValuesByDimensionlessComplexConstant
+    kQueuedConjugate,     // Conjugate
+    kQueuedAbsolute,      // TakeAbsoluteValue
+    kQueuedZeroPart,      // ZeroPartInRange
+    kQueuedNarrowToReal,  // complex -> real after TakeAbsoluteValue, every component
+} impl_QueuedKind;
+typedef struct {
+    impl_QueuedKind kind;
+    OCIndex componentIndex;  // negative: every component
+    double complex factor;
+    OCRange range;
+    complexPart part;
+} impl_QueuedOperation;
 struct impl_DependentVariable {
     OCBase base;
     // SIQuantity Type attributes
@@ -23,6 +43,21 @@ struct impl_DependentVariable {
     SparseSamplingRef sparseSampling;
     // weak back‐pointer
     OCTypeRef owner;
+    // deferred component load (DependentVariableSetComponentsLoader)
+    DependentVariableComponentsLoader loader;
+    void *loaderContext;
+    void (*loaderContextRelease)(void *);
+    OCIndex deferredCount, deferredSize;  // shape the loader will produce
+    OCStringRef loadError;
+    atomic_bool loadPending;
+    bool loadLockReady;
+    pthread_mutex_t loadLock;
+    // recorded element-wise operations, run in one pass on the next access
+    bool defersOperations;
+    impl_QueuedOperation *queuedOps;
+    OCIndex queuedCount, queuedCapacity;
+    OCNumberType queuedType;  // element type once the queue has run
+    atomic_bool opsPending;   // deferred operations queued; drained under loadLock
 };
 OCTypeID DependentVariableGetTypeID(void) {
     if (kDependentVariableID == kOCNotATypeID)
@@ -46,8 +81,79 @@ static void impl_DependentVariableFinalize(const void *ptr) {
     OCRelease(dv->components);
     OCRelease(dv->componentLabels);
     OCRelease(dv->metaData);
+    // --- deferred load ---
+    if (dv->loaderContextRelease) dv->loaderContextRelease(dv->loaderContext);
+    OCRelease(dv->loadError);
+    if (dv->loadLockReady) pthread_mutex_destroy(&dv->loadLock);
+    // --- deferred operations ---
+    free(dv->queuedOps);
     // NOTE: dv->owner is a weak back-pointer — do NOT OCRelease it
 }
+static void impl_DependentVariableReleaseLoader(struct impl_DependentVariable *dv) {
+    if (dv->loaderContextRelease) dv->loaderContextRelease(dv->loaderContext);
+    dv->loader = NULL;
+    dv->loaderContext = NULL;
+    dv->loaderContextRelease = NULL;
+}
+static void impl_DependentVariableRunDeferredLoad(struct impl_DependentVariable *dv) {
+    pthread_mutex_lock(&dv->loadLock);
+    // re-check under the lock: another thread may have finished the load
+    if (atomic_load_explicit(&dv->loadPending, memory_order_relaxed)) {
+        OCStringRef error = NULL;
+        OCMutableArrayRef comps = dv->loader((DependentVariableRef)dv, dv->loaderContext, &error);
+        if (comps) {
+            OCRelease(dv->components);
+            dv->components = comps;
+            OCRelease(error);
+        } else {
+            dv->loadError = error ? error : STR("Deferred component load failed");
+        }
+        impl_DependentVariableReleaseLoader(dv);
+        atomic_store_explicit(&dv->loadPending, false, memory_order_release);
+    }
+    pthread_mutex_unlock(&dv->loadLock);
+}
+static bool impl_DependentVariableRunQueuedOperations(struct impl_DependentVariable *dv);
+/// Run the deferred operations exactly once however many readers arrive
+/// together: as with the deferred load, the first caller takes loadLock
+/// and re-checks the queue, the others wait and then find it empty.
+/// Returns false if the operations could not run; they then stay queued.
+static bool impl_DependentVariableDrainQueue(struct impl_DependentVariable *dv) {
+    if (!atomic_load_explicit(&dv->opsPending, memory_order_acquire)) return true;
+    pthread_mutex_lock(&dv->loadLock);
+    bool ok = dv->queuedCount == 0 || impl_DependentVariableRunQueuedOperations(dv);
+    pthread_mutex_unlock(&dv->loadLock);
+    return ok;
+}
+/// Load-once guard for every accessor that reaches dv->components: the
+/// first caller runs the deferred loader, concurrent callers wait for it,
+/// and afterwards the check is a single acquire load.  Deferred operations
+/// are drained here too, so no accessor sees the components before them.
+/// Returns false if dv is NULL or its deferred operations could not run.
+static inline bool impl_DependentVariableEnsureLoaded(const struct impl_DependentVariable *cdv) {
+    struct impl_DependentVariable *dv = (struct impl_DependentVariable *)cdv;
+    if (!dv) return false;
+    if (atomic_load_explicit(&dv->loadPending, memory_order_acquire))
+        impl_DependentVariableRunDeferredLoad(dv);
+    return impl_DependentVariableDrainQueue(dv);
+}
+/// Create loadLock on first use; it guards the deferred load and the
+/// deferred-operation queue.
+static bool impl_DependentVariablePrepareLoadLock(struct impl_DependentVariable *dv) {
+    if (dv->loadLockReady) return true;
+    if (pthread_mutex_init(&dv->loadLock, NULL) != 0) return false;
+    dv->loadLockReady = true;
+    return true;
+}
+static void impl_DependentVariableCancelDeferredLoad(struct impl_DependentVariable *dv) {
+    if (!atomic_load_explicit(&dv->loadPending, memory_order_acquire)) return;
+    pthread_mutex_lock(&dv->loadLock);
+    if (atomic_load_explicit(&dv->loadPending, memory_order_relaxed)) {
+        impl_DependentVariableReleaseLoader(dv);
+        atomic_store_explicit(&dv->loadPending, false, memory_order_release);
+    }
+    pthread_mutex_unlock(&dv->loadLock);
+}
 static bool DependentVariableComponentsAreEqual(const struct impl_DependentVariable *a,
                                                 const struct impl_DependentVariable *b) {
     if (!a || !b) return false;
@@ -72,6 +178,8 @@ static bool impl_DependentVariableEqual(const void *a, const void *b) {
     const struct impl_DependentVariable *dvB = b;
     if (!dvA || !dvB) return false;
     if (dvA == dvB) return true;
+    if (!impl_DependentVariableEnsureLoaded(dvA) || !impl_DependentVariableEnsureLoaded(dvB))
+        return false;
     // 1) URL, unit, numeric type, type, encoding, name
     if (dvA->componentsURL != dvB->componentsURL &&
         !OCTypeEqual(dvA->componentsURL, dvB->componentsURL)) return false;
@@ -105,6 +213,7 @@ static bool impl_DependentVariableEqual(const void *a, const void *b) {
 }
 static OCStringRef impl_DependentVariableCopyFormattingDesc(OCTypeRef cf) {
     const struct impl_DependentVariable *dv = (struct impl_DependentVariable *)cf;
+    impl_DependentVariableEnsureLoaded(dv);
     // Build a little summary of sparseSampling, or "none" if absent
     OCStringRef sparseDesc = dv->sparseSampling
                                  ? OCTypeCopyFormattingDesc((OCTypeRef)dv->sparseSampling)
@@ -135,6 +244,7 @@ cJSON *impl_DependentVariableCreateJSON(const void *obj) {
 static void *impl_DependentVariableDeepCopy(const void *ptr) {
     if (!ptr) return NULL;
     const struct impl_DependentVariable *src = (const struct impl_DependentVariable *)ptr;
+    if (!impl_DependentVariableEnsureLoaded(src)) return NULL;
     struct impl_DependentVariable *dst = calloc(1, sizeof(*dst));
     if (!dst) return NULL;
     // 1) Copy base
@@ -236,6 +346,19 @@ static void impl_InitDependentVariableFields(DependentVariableRef dv) {
     dv->componentLabels = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
     // Sparse-sampling: start out with NO sparseSampling attached
     dv->sparseSampling = NULL;
+    // Components are resident unless a loader is installed
+    dv->loader = NULL;
+    dv->loaderContext = NULL;
+    dv->loaderContextRelease = NULL;
+    dv->loadError = NULL;
+    atomic_init(&dv->loadPending, false);
+    dv->loadLockReady = false;
+    // Operations run immediately unless deferral is switched on
+    dv->defersOperations = false;
+    dv->queuedOps = NULL;
+    dv->queuedCount = 0;
+    dv->queuedCapacity = 0;
+    atomic_init(&dv->opsPending, false);
     // weak back-pointer
     dv->owner = NULL;
 }
@@ -704,7 +827,130 @@ DependentVariableRef DependentVariableCreateMinimal(
         /* metaData           */ NULL,  // minimal - no metadata
         /* outError           */ outError);
 }
-OCDictionaryRef DependentVariableCopyAsDictionary(DependentVariableRef dv) {
+/// Helper: base64-encode a component with the vectorized RMNBase64 codec.
+static OCStringRef impl_CreateBase64StringFromBytes(const uint8_t *bytes, size_t len) {
+    char *text = malloc(RMNBase64EncodedLength(len) + 1);
+    if (!text) return NULL;
+    size_t n = RMNBase64Encode(bytes, len, text);
+    text[n] = '\0';
+    OCStringRef b64 = OCStringCreateWithCString(text);
+    free(text);
+    return b64;
+}
+static OCStringRef impl_CreateBase64String(OCDataRef blob) {
+    return impl_CreateBase64StringFromBytes(OCDataGetBytesPtr(blob), (size_t)OCDataGetLength(blob));
+}
+/// Helper: decode base64 straight into a preallocated component buffer;
+/// falls back to the lenient OCTypes decoder (line breaks etc.) on failure.
+static OCDataRef impl_CreateDataFromBase64String(OCStringRef b64) {
+    const char *text = b64 ? OCStringGetCString(b64) : NULL;
+    if (!text) return NULL;
+    size_t len = strlen(text);
+    size_t nbytes = RMNBase64DecodedLength(text, len);
+    if (nbytes > 0) {
+        OCMutableDataRef data = OCDataCreateMutable(nbytes);
+        if (data) {
+            OCDataSetLength(data, nbytes);
+            if (RMNBase64Decode(text, len, OCDataGetMutableBytes(data), NULL)) return data;
+            OCRelease(data);
+        }
+    }
+    return OCDataCreateFromBase64EncodedString(b64);
+}
+/// Helper: the codec named by a compressed encoding ("shuffle+zstd", ...).
+static bool impl_DependentVariableGetCodec(DependentVariableRef dv, RMNCodec *codec, bool *shuffle) {
+    return dv->encoding && RMNCodecParseEncoding(OCStringGetCString(dv->encoding), codec, shuffle);
+}
+/// Helper: compress a component, then base64-encode the result.
+static OCStringRef impl_CreateCompressedBase64String(OCDataRef blob, RMNCodec codec, bool shuffle,
+                                                     size_t shuffleWidth) {
+    RMNCodecBuffer packed = {0};
+    OCStringRef b64 = NULL;
+    if (RMNCodecEncode(codec, shuffle, shuffleWidth, OCDataGetBytesPtr(blob),
+                       (size_t)OCDataGetLength(blob), RMNCodecBufferSink, &packed))
+        b64 = impl_CreateBase64StringFromBytes(packed.bytes, packed.length);
+    free(packed.bytes);
+    return b64;
+}
+/// Helper: inverse of impl_CreateCompressedBase64String(); decompresses
+/// straight into a preallocated component buffer.
+static OCDataRef impl_CreateDataFromCompressedBase64String(OCStringRef b64, RMNCodec codec,
+                                                           bool shuffle, size_t shuffleWidth) {
+    OCDataRef packed = impl_CreateDataFromBase64String(b64);
+    if (!packed) return NULL;
+    const uint8_t *src = OCDataGetBytesPtr(packed);
+    size_t srcLength = (size_t)OCDataGetLength(packed), n = 0;
+    OCMutableDataRef data = NULL;
+    if (RMNCodecGetDecodedLength(src, srcLength, &n) && (data = OCDataCreateMutable(n))) {
+        OCDataSetLength(data, n);
+        if (!RMNCodecDecode(codec, shuffle, shuffleWidth, src, srcLength,
+                            OCDataGetMutableBytes(data), n, NULL)) {
+            OCRelease(data);
+            data = NULL;
+        }
+    }
+    OCRelease(packed);
+    return data;
+}
+/// Helper: build a "none" component from its OCNumber list in one pass.
+/// The buffer is sized up front and the type switch sits outside the value
+/// loops.  Complex components are stored as interleaved re/im pairs, so an
+/// odd-length list is malformed and yields NULL, as do non-numeric entries
+/// and values an integer type cannot hold.
+static OCDataRef impl_CreateDataFromNumberArray(OCArrayRef numList, OCNumberType type) {
+    size_t elemSize = OCNumberTypeSize(type);
+    if (!numList || elemSize == 0) return NULL;
+    OCIndex n = OCArrayGetCount(numList);
+    bool isComplex = (type == kOCNumberComplex64Type || type == kOCNumberComplex128Type);
+    if (isComplex && (n & 1)) return NULL;
+    size_t nbytes = (size_t)(isComplex ? n / 2 : n) * elemSize;
+    OCMutableDataRef data = OCDataCreateMutable(nbytes);
+    if (!data) return NULL;
+    OCDataSetLength(data, nbytes);
+    uint8_t *bytes = OCDataGetMutableBytes(data);
+    // numbers from cJSON were parsed as doubles, where INT64_MAX and
+    // UINT64_MAX round up to 2^63 and 2^64; those read back as the maximum
+#define FILL_FROM_NUMBERS(T, MAX)                                              \
+    do {                                                                       \
+        T *out = (T *)bytes;                                                   \
+        for (OCIndex j = 0; j < n; ++j) {                                      \
+            double v = 0;                                                      \
+            if (!OCNumberTryGetDouble(OCArrayGetValueAtIndex(numList, j), &v)) { \
+                OCRelease(data);                                               \
+                return NULL;                                                   \
+            }                                                                  \
+            if (RMNConvertDoubleFits(type, v)) {                               \
+                out[j] = (T)v;                                                 \
+            } else if (v == (double)(MAX)) {                                   \
+                out[j] = (MAX);                                                \
+            } else {                                                           \
+                OCRelease(data);                                               \
+                return NULL;                                                   \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
+    switch (type) {
+        case kOCNumberSInt8Type: FILL_FROM_NUMBERS(int8_t, INT8_MAX); break;
+        case kOCNumberSInt16Type: FILL_FROM_NUMBERS(int16_t, INT16_MAX); break;
+        case kOCNumberSInt32Type: FILL_FROM_NUMBERS(int32_t, INT32_MAX); break;
+        case kOCNumberSInt64Type: FILL_FROM_NUMBERS(int64_t, INT64_MAX); break;
+        case kOCNumberUInt8Type: FILL_FROM_NUMBERS(uint8_t, UINT8_MAX); break;
+        case kOCNumberUInt16Type: FILL_FROM_NUMBERS(uint16_t, UINT16_MAX); break;
+        case kOCNumberUInt32Type: FILL_FROM_NUMBERS(uint32_t, UINT32_MAX); break;
+        case kOCNumberUInt64Type: FILL_FROM_NUMBERS(uint64_t, UINT64_MAX); break;
+        case kOCNumberFloat32Type:
+        case kOCNumberComplex64Type: FILL_FROM_NUMBERS(float, FLT_MAX); break;
+        case kOCNumberFloat64Type:
+        case kOCNumberComplex128Type: FILL_FROM_NUMBERS(double, DBL_MAX); break;
+        default:
+            OCDataSetLength(data, 0);
+            break;
+    }
+#undef FILL_FROM_NUMBERS
+    return data;
+}
+static OCDictionaryRef impl_DependentVariableCopyAsDictionary(DependentVariableRef dv,
+                                                             OCArrayRef placeholders) {
     if (!dv) return NULL;
     OCMutableDictionaryRef dict = OCDictionaryCreateMutable(0);
     if (!dict) return NULL;
@@ -733,6 +979,9 @@ OCDictionaryRef DependentVariableCopyAsDictionary(DependentVariableRef dv) {
         OCNumberType et = DependentVariableGetElementType(dv);
         bool isBase64 = dv->encoding && OCStringEqual(dv->encoding, STR(kDependentVariableEncodingValueBase64));
         bool isRaw = dv->encoding && OCStringEqual(dv->encoding, STR(kDependentVariableEncodingValueRaw));
+        RMNCodec codec = kRMNCodecNone;
+        bool shuffle = false;
+        bool isCodec = impl_DependentVariableGetCodec(dv, &codec, &shuffle);
         bool isComplex = (et == kOCNumberComplex64Type || et == kOCNumberComplex128Type);
         OCIndex ncomps = DependentVariableGetComponentCount(dv);
         OCMutableArrayRef compsArr = OCArrayCreateMutable(ncomps, &kOCTypeArrayCallBacks);
@@ -742,8 +991,19 @@ OCDictionaryRef DependentVariableCopyAsDictionary(DependentVariableRef dv) {
                 // If raw, we just store the OCDataRef directly
                 OCArrayAppendValue(compsArr, blob);
                 continue;
-            } else if (isBase64) {
-                OCStringRef b64 = OCDataCreateBase64EncodedString(blob, OCBase64EncodingOptionsNone);
+            } else if (placeholders) {
+                // streaming writers splice the encoded payload in later
+                OCArrayAppendValue(compsArr, OCArrayGetValueAtIndex(placeholders, i));
+            } else if (isBase64 || isCodec) {
+                OCStringRef b64 = isCodec ? impl_CreateCompressedBase64String(
+                                                blob, codec, shuffle, RMNCodecShuffleWidth(et))
+                                          : impl_CreateBase64String(blob);
+                if (!b64) {
+                    // an unencodable component fails the copy rather than vanishing
+                    OCRelease(compsArr);
+                    OCRelease(dict);
+                    return NULL;
+                }
                 OCArrayAppendValue(compsArr, b64);
                 OCRelease(b64);
             } else {
@@ -939,6 +1199,101 @@ OCDictionaryRef DependentVariableCopyAsDictionary(DependentVariableRef dv) {
     }
     return (OCDictionaryRef)dict;
 }
+OCDictionaryRef DependentVariableCopyAsDictionary(DependentVariableRef dv) {
+    return impl_DependentVariableCopyAsDictionary(dv, NULL);
+}
+OCDictionaryRef DependentVariableCopyAsDictionaryWithPlaceholders(DependentVariableRef dv,
+                                                                  OCArrayRef placeholders) {
+    if (!dv || !placeholders) return NULL;
+    if (OCArrayGetCount(placeholders) < DependentVariableGetComponentCount(dv)) return NULL;
+    return impl_DependentVariableCopyAsDictionary(dv, placeholders);
+}
+bool DependentVariableWriteComponentJSON(DependentVariableRef dv,
+                                         OCIndex componentIndex,
+                                         FILE *stream) {
+    if (!dv || !stream) return false;
+    OCDataRef blob = DependentVariableGetComponentAtIndex(dv, componentIndex);
+    if (!blob) return false;
+    const uint8_t *bytes = OCDataGetBytesPtr(blob);
+    size_t length = (size_t)OCDataGetLength(blob);
+    // same branch selection as DependentVariableCopyAsDictionary()
+    bool isBase64 = dv->encoding && OCStringEqual(dv->encoding, STR(kDependentVariableEncodingValueBase64));
+    if (dv->encoding && OCStringEqual(dv->encoding, STR(kDependentVariableEncodingValueRaw)))
+        return false;
+    // compressed encodings: base64 of the codec output
+    RMNCodec codec = kRMNCodecNone;
+    bool shuffle = false;
+    RMNCodecBuffer packed = {0};
+    if (impl_DependentVariableGetCodec(dv, &codec, &shuffle)) {
+        if (!RMNCodecEncode(codec, shuffle, RMNCodecShuffleWidth(DependentVariableGetElementType(dv)),
+                            bytes, length, RMNCodecBufferSink, &packed)) {
+            free(packed.bytes);
+            return false;
+        }
+        bytes = packed.bytes;
+        length = packed.length;
+        isBase64 = true;
+    }
+    // bounded scratch buffer: base64 text or formatted numbers, flushed as it fills
+    char out[16384];
+    size_t used = 0;
+    if (isBase64) {
+        // 3-byte aligned input chunks so padding is only emitted at the very end
+        const size_t inChunk = (sizeof(out) / 4) * 3;
+        bool ok = fputc('"', stream) != EOF;
+        for (size_t off = 0; ok && off < length; off += inChunk) {
+            size_t n = length - off < inChunk ? length - off : inChunk;
+            size_t w = RMNBase64Encode(bytes + off, n, out);
+            ok = fwrite(out, 1, w, stream) == w;
+        }
+        free(packed.bytes);
+        return ok && fputc('"', stream) != EOF;
+    }
+    OCNumberType et = DependentVariableGetElementType(dv);
+    size_t stride = OCNumberTypeSize(et);
+    if (stride == 0) return false;
+    bool isComplex = (et == kOCNumberComplex64Type || et == kOCNumberComplex128Type);
+    size_t count = length / stride * (isComplex ? 2 : 1);
+    out[used++] = '[';
+    for (size_t j = 0; j < count; ++j) {
+        if (used + 2 + kRMNDecimalMaxLength > sizeof(out)) {
+            if (fwrite(out, 1, used, stream) != used) return false;
+            used = 0;
+        }
+        if (j > 0) {
+            out[used++] = ',';
+            out[used++] = ' ';
+        }
+        // 64-bit integers are written exactly; a double would round them above 2^53
+        if (et == kOCNumberSInt64Type) {
+            used += (size_t)snprintf(out + used, kRMNDecimalMaxLength, "%" PRId64,
+                                     ((const int64_t *)bytes)[j]);
+            continue;
+        }
+        if (et == kOCNumberUInt64Type) {
+            used += (size_t)snprintf(out + used, kRMNDecimalMaxLength, "%" PRIu64,
+                                     ((const uint64_t *)bytes)[j]);
+            continue;
+        }
+        double v;
+        switch (et) {
+            case kOCNumberSInt8Type: v = ((const int8_t *)bytes)[j]; break;
+            case kOCNumberSInt16Type: v = ((const int16_t *)bytes)[j]; break;
+            case kOCNumberSInt32Type: v = ((const int32_t *)bytes)[j]; break;
+            case kOCNumberUInt8Type: v = ((const uint8_t *)bytes)[j]; break;
+            case kOCNumberUInt16Type: v = ((const uint16_t *)bytes)[j]; break;
+            case kOCNumberUInt32Type: v = ((const uint32_t *)bytes)[j]; break;
+            case kOCNumberFloat32Type:
+            case kOCNumberComplex64Type: v = ((const float *)bytes)[j]; break;
+            case kOCNumberFloat64Type:
+            case kOCNumberComplex128Type: v = ((const double *)bytes)[j]; break;
+            default: return false;
+        }
+        used += RMNDecimalFormatDouble(v, out + used);
+    }
+    out[used++] = ']';
+    return fwrite(out, 1, used, stream) == used;
+}
 DependentVariableRef DependentVariableCreateFromDictionary(OCDictionaryRef dict,
                                                            OCStringRef *outError) {
     if (outError) *outError = NULL;
@@ -995,6 +1350,13 @@ DependentVariableRef DependentVariableCreateFromDictionary(OCDictionaryRef dict,
     OCStringRef encoding = OCDictionaryGetValue(dict, STR(kDependentVariableEncodingKey));
     bool isBase64 = encoding && OCStringEqual(encoding, STR(kDependentVariableEncodingValueBase64));
     bool isRaw = encoding && OCStringEqual(encoding, STR(kDependentVariableEncodingValueRaw));
+    RMNCodec codec = kRMNCodecNone;
+    bool shuffle = false;
+    bool isCodec = encoding && RMNCodecParseEncoding(OCStringGetCString(encoding), &codec, &shuffle);
+    if (isCodec && !RMNCodecIsAvailable(codec)) {
+        if (outError) *outError = STR("DependentVariableCreateFromDictionary: compression codec not available in this build");
+        return NULL;
+    }
     // 7) SIUnitFromExpression
     SIUnitRef unit = NULL;
     if (unitExpr) {
@@ -1014,6 +1376,13 @@ DependentVariableRef DependentVariableCreateFromDictionary(OCDictionaryRef dict,
     }
     if (!isExternal) {
         for (OCIndex i = 0; i < count; ++i) {
+            OCTypeRef entry = OCArrayGetValueAtIndex(compArr, i);
+            if (!isRaw && entry && OCGetTypeID(entry) == OCDataGetTypeID()) {
+                // Already decoded by the import scanner: adopt it as-is
+                if (OCDataGetLength((OCDataRef)entry) > 0)
+                    OCArrayAppendValue(components, entry);
+                continue;
+            }
             if (isRaw) {
                 // If raw, we just store the OCDataRef directly
                 OCDataRef blob = (OCDataRef)OCArrayGetValueAtIndex(compArr, i);
@@ -1022,100 +1391,20 @@ DependentVariableRef DependentVariableCreateFromDictionary(OCDictionaryRef dict,
                     OCArrayAppendValue(components, data);
                     OCRelease(data);
                 }
-            } else if (isBase64) {
+            } else if (isBase64 || isCodec) {
                 OCStringRef b64 = OCArrayGetValueAtIndex(compArr, i);
-                OCDataRef data = OCDataCreateFromBase64EncodedString(b64);
+                OCDataRef data = isCodec ? impl_CreateDataFromCompressedBase64String(
+                                               b64, codec, shuffle, RMNCodecShuffleWidth(numericType))
+                                         : impl_CreateDataFromBase64String(b64);
                 if (data && OCDataGetLength(data) > 0)
                     OCArrayAppendValue(components, data);
                 if (data) OCRelease(data);
             } else {
-                OCArrayRef numList = OCArrayGetValueAtIndex(compArr, i);
-                OCIndex n = OCArrayGetCount(numList);
-                OCMutableDataRef data = OCDataCreateMutable(0);
-                for (OCIndex j = 0; j < n; ++j) {
-                    OCNumberRef num = OCArrayGetValueAtIndex(numList, j);
-                    double v = 0;
-                    OCNumberTryGetDouble(num, &v);
-                    switch (numericType) {
-                        case kOCNumberSInt8Type: {
-                            int8_t i8 = (int8_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&i8, sizeof(i8));
-                            break;
-                        }
-                        case kOCNumberSInt16Type: {
-                            int16_t i16 = (int16_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&i16, sizeof(i16));
-                            break;
-                        }
-                        case kOCNumberSInt32Type: {
-                            int32_t i32 = (int32_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&i32, sizeof(i32));
-                            break;
-                        }
-                        case kOCNumberSInt64Type: {
-                            int64_t i64 = (int64_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&i64, sizeof(i64));
-                            break;
-                        }
-                        case kOCNumberUInt8Type: {
-                            uint8_t u8 = (uint8_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&u8, sizeof(u8));
-                            break;
-                        }
-                        case kOCNumberUInt16Type: {
-                            uint16_t u16 = (uint16_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&u16, sizeof(u16));
-                            break;
-                        }
-                        case kOCNumberUInt32Type: {
-                            uint32_t u32 = (uint32_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&u32, sizeof(u32));
-                            break;
-                        }
-                        case kOCNumberUInt64Type: {
-                            uint64_t u64 = (uint64_t)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&u64, sizeof(u64));
-                            break;
-                        }
-                        case kOCNumberFloat32Type: {
-                            float f = (float)v;
-                            OCDataAppendBytes(data, (uint8_t const *)&f, sizeof(f));
-                            break;
-                        }
-                        case kOCNumberFloat64Type: {
-                            double d = v;
-                            OCDataAppendBytes(data, (uint8_t const *)&d, sizeof(d));
-                            break;
-                        }
-                        case kOCNumberComplex64Type: {
-                            float re = (float)v, im = 0;
-                            if (j + 1 < n) {
-                                OCNumberRef next = OCArrayGetValueAtIndex(numList, ++j);
-                                OCNumberTryGetDouble(next, &v);
-                                im = (float)v;
-                            }
-                            float complex z = re + im * I;
-                            OCDataAppendBytes(data, (uint8_t const *)&z, sizeof(z));
-                            break;
-                        }
-                        case kOCNumberComplex128Type: {
-                            double re = v, im = 0;
-                            if (j + 1 < n) {
-                                OCNumberRef next = OCArrayGetValueAtIndex(numList, ++j);
-                                OCNumberTryGetDouble(next, &v);
-                                im = v;
-                            }
-                            double complex z = re + im * I;
-                            OCDataAppendBytes(data, (uint8_t const *)&z, sizeof(z));
-                            break;
-                        }
-                        default:
-                            break;
-                    }
-                }
-                if (OCDataGetLength(data) > 0)
+                OCDataRef data = impl_CreateDataFromNumberArray(
+                    OCArrayGetValueAtIndex(compArr, i), numericType);
+                if (data && OCDataGetLength(data) > 0)
                     OCArrayAppendValue(components, data);
-                OCRelease(data);
+                if (data) OCRelease(data);
             }
         }
         if ((OCIndex)OCArrayGetCount(components) != count) {
@@ -1249,8 +1538,9 @@ OCDictionaryRef DependentVariableDictionaryCreateFromJSON(cJSON *json, OCStringR
                 OCMutableArrayRef numArr = OCArrayCreateMutable(cJSON_GetArraySize(comp), &kOCTypeArrayCallBacks);
                 cJSON *val = NULL;
                 cJSON_ArrayForEach(val, comp) {
-                    if (cJSON_IsNumber(val)) {
-                        OCNumberRef n = OCNumberCreateWithDouble(val->valuedouble);
+                    // "none" writes NaN as null; integer types reject it when filled
+                    if (cJSON_IsNumber(val) || cJSON_IsNull(val)) {
+                        OCNumberRef n = OCNumberCreateWithDouble(cJSON_IsNull(val) ? NAN : val->valuedouble);
                         OCArrayAppendValue(numArr, n);
                         OCRelease(n);
                     }
@@ -1534,7 +1824,7 @@ bool DependentVariableAppend(DependentVariableRef dv, DependentVariableRef appen
     return true;
 }
 OCArrayRef DependentVariableCreatePackedSparseComponentsArray(DependentVariableRef dv, OCArrayRef dimensions) {
-    if (!dv || !dimensions) return NULL;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !dimensions) return NULL;
     SparseSamplingRef ss = DependentVariableGetSparseSampling(dv);
     OCIndexSetRef idxs = SparseSamplingGetDimensionIndexes(ss);
     OCArrayRef verts = SparseSamplingGetSparseGridVertexes(ss);
@@ -1572,7 +1862,7 @@ OCArrayRef DependentVariableCreatePackedSparseComponentsArray(DependentVariableR
 }
 OCDataRef DependentVariableCreateCSDMComponentsData(DependentVariableRef dv,
                                                     OCArrayRef dimensions) {
-    if (!dv) return NULL;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NULL;
     // 1) Allocate the output buffer
     OCMutableDataRef buffer = OCDataCreateMutable(0);
     if (!buffer) return NULL;
@@ -1714,13 +2004,18 @@ OCIndex DependentVariableComponentsCountFromQuantityType(OCStringRef quantityTyp
 }
 OCIndex DependentVariableGetComponentCount(DependentVariableRef dv) {
     if (!dv) return 0;
+    // a pending load already knows its shape; queued operations keep it
+    if (atomic_load_explicit(&dv->loadPending, memory_order_acquire)) return dv->deferredCount;
+    impl_DependentVariableEnsureLoaded(dv);
     return OCArrayGetCount(dv->components);
 }
 OCMutableArrayRef DependentVariableGetComponents(DependentVariableRef dv) {
-    return dv ? dv->components : NULL;
+    return impl_DependentVariableEnsureLoaded(dv) ? dv->components : NULL;
 }
 bool DependentVariableSetComponents(DependentVariableRef dv, OCArrayRef newComponents) {
     if (!dv || !newComponents) return false;
+    // new components supersede a pending deferred load
+    impl_DependentVariableCancelDeferredLoad(dv);
     OCIndex count = OCArrayGetCount(newComponents);
     if (count == 0) return false;
     // Validate each component is OCDataRef and has matching size
@@ -1763,7 +2058,7 @@ bool DependentVariableSetComponents(DependentVariableRef dv, OCArrayRef newCompo
     return true;
 }
 OCMutableArrayRef DependentVariableCopyComponents(DependentVariableRef dv) {
-    if (!dv || !dv->components) return NULL;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !dv->components) return NULL;
     OCIndex n = OCArrayGetCount(dv->components);
     OCMutableArrayRef copy =
         OCArrayCreateMutable(n, &kOCTypeArrayCallBacks);
@@ -1779,14 +2074,22 @@ OCMutableArrayRef DependentVariableCopyComponents(DependentVariableRef dv) {
     return copy;
 }
 OCDataRef DependentVariableGetComponentAtIndex(DependentVariableRef dv, OCIndex componentIndex) {
-    if (!dv || !dv->components ||
+    if (!impl_DependentVariableEnsureLoaded(dv) || !dv->components ||
         componentIndex < 0 ||
         componentIndex >= OCArrayGetCount(dv->components))
         return NULL;
     return (OCDataRef)OCArrayGetValueAtIndex(dv->components, componentIndex);
 }
+bool DependentVariableComputeComponentHash(DependentVariableRef dv,
+                                           OCIndex componentIndex,
+                                           uint64_t *outHash) {
+    OCDataRef blob = DependentVariableGetComponentAtIndex(dv, componentIndex);
+    if (!blob || !outHash) return false;
+    *outHash = RMNHashXXH3(OCDataGetBytesPtr(blob), (size_t)OCDataGetLength(blob));
+    return true;
+}
 bool DependentVariableSetComponentAtIndex(DependentVariableRef dv, OCDataRef newBuf, OCIndex componentIndex) {
-    if (!dv || !dv->components || !newBuf) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !dv->components || !newBuf) return false;
     OCIndex n = OCArrayGetCount(dv->components);
     if (componentIndex < 0 || componentIndex >= n) return false;
     OCDataRef oldBuf = (OCDataRef)OCArrayGetValueAtIndex(dv->components, componentIndex);
@@ -1794,6 +2097,43 @@ bool DependentVariableSetComponentAtIndex(DependentVariableRef dv, OCDataRef new
     OCArraySetValueAtIndex(dv->components, componentIndex, newBuf);
     return true;
 }
+bool DependentVariableSetComponentsLoader(DependentVariableRef dv,
+                                         OCIndex componentCount,
+                                         OCIndex size,
+                                         DependentVariableComponentsLoader loader,
+                                         void *context,
+                                         void (*releaseContext)(void *)) {
+    if (!dv || !loader || componentCount < 0 || size < 0 ||
+        !impl_DependentVariablePrepareLoadLock(dv))
+        return false;
+    impl_DependentVariableReleaseLoader(dv);
+    OCRelease(dv->loadError);
+    dv->loadError = NULL;
+    dv->loader = loader;
+    dv->loaderContext = context;
+    dv->loaderContextRelease = releaseContext;
+    dv->deferredCount = componentCount;
+    dv->deferredSize = size;
+    atomic_store_explicit(&dv->loadPending, true, memory_order_release);
+    return true;
+}
+bool DependentVariableLoadComponents(DependentVariableRef dv, OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!dv) return false;
+    bool ran = impl_DependentVariableEnsureLoaded(dv);
+    if (dv->loadError) {
+        if (outError) *outError = OCStringCreateCopy(dv->loadError);
+        return false;
+    }
+    if (!ran) {
+        if (outError) *outError = STR("Deferred operations could not be applied");
+        return false;
+    }
+    return true;
+}
+bool DependentVariableComponentsAreLoaded(DependentVariableRef dv) {
+    return dv && !atomic_load_explicit(&dv->loadPending, memory_order_acquire);
+}
 static void updateForComponentCountChange(DependentVariableRef dv) {
     OCIndex count = OCArrayGetCount(dv->components);
     const char *qt = OCStringGetCString(dv->quantityType);
@@ -1812,7 +2152,7 @@ static void updateForComponentCountChange(DependentVariableRef dv) {
     }
 }
 bool DependentVariableInsertComponentAtIndex(DependentVariableRef dv, OCDataRef component, OCIndex idx) {
-    if (!dv || !component) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !component) return false;
     OCMutableArrayRef comps = dv->components;
     if (!comps) return false;
     OCIndex count = OCArrayGetCount(comps);
@@ -1830,7 +2170,7 @@ bool DependentVariableInsertComponentAtIndex(DependentVariableRef dv, OCDataRef
     return true;
 }
 bool DependentVariableRemoveComponentAtIndex(DependentVariableRef dv, OCIndex idx) {
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
     OCIndex count = OCArrayGetCount(dv->components);
     if (idx >= count || count <= 1)
         return false;
@@ -1841,6 +2181,8 @@ bool DependentVariableRemoveComponentAtIndex(DependentVariableRef dv, OCIndex id
 }
 OCIndex DependentVariableGetSize(DependentVariableRef dv) {
     if (!dv) return 0;
+    if (atomic_load_explicit(&dv->loadPending, memory_order_acquire)) return dv->deferredSize;
+    impl_DependentVariableEnsureLoaded(dv);
     OCIndex componentsCount = OCArrayGetCount(dv->components);
     if (componentsCount == 0) return 0;
     OCDataRef blob = (OCDataRef)OCArrayGetValueAtIndex(dv->components, 0);
@@ -1851,7 +2193,7 @@ OCIndex DependentVariableGetSize(DependentVariableRef dv) {
     return (OCIndex)(byteLength / eltSize);
 }
 bool DependentVariableSetSize(DependentVariableRef dv, OCIndex newSize) {
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (nComps == 0) return false;
     OCIndex oldSize = DependentVariableGetSize(dv);
@@ -2020,6 +2362,7 @@ OCStringRef DependentVariableGetQuantityType(DependentVariableRef dv) {
     return dv->quantityType;
 }
 bool DependentVariableSetQuantityType(DependentVariableRef dv, OCStringRef qt) {
+    impl_DependentVariableEnsureLoaded(dv);
     IF_NO_OBJECT_EXISTS_RETURN(dv, false);
     if (!qt) return false;
     const char *cstr = OCStringGetCString(qt);
@@ -2072,6 +2415,7 @@ bool DependentVariableSetQuantityType(DependentVariableRef dv, OCStringRef qt) {
     return false;
 }
 OCMutableArrayRef DependentVariableCreateQuantityTypesArray(DependentVariableRef dv) {
+    impl_DependentVariableEnsureLoaded(dv);
     IF_NO_OBJECT_EXISTS_RETURN(dv, NULL);
     OCIndex count = OCArrayGetCount(dv->components);
     OCMutableArrayRef types = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
@@ -2126,6 +2470,58 @@ bool DependentVariableSetMetaData(DependentVariableRef dv, OCDictionaryRef dict)
     dv->metaData = dict ? OCTypeDeepCopyMutable(dict) : OCDictionaryCreateMutable(0);
     return dv->metaData != NULL;
 }
+bool DependentVariableSetChunkShape(DependentVariableRef dv, OCIndexArrayRef chunkShape) {
+    if (!dv) return false;
+    if (!dv->metaData) dv->metaData = OCDictionaryCreateMutable(0);
+    if (!dv->metaData) return false;
+    if (!chunkShape) {
+        OCDictionaryRemoveValue(dv->metaData, STR(kRMNChunkedLayoutMetaDataKey));
+        return true;
+    }
+    OCIndex rank = OCIndexArrayGetCount(chunkShape);
+    if (rank < 1 || rank > kRMNChunkedLayoutMaxRank) return false;
+    OCMutableArrayRef shape = OCArrayCreateMutable(rank, &kOCTypeArrayCallBacks);
+    for (OCIndex d = 0; d < rank; ++d) {
+        OCIndex n = OCIndexArrayGetValueAtIndex(chunkShape, d);
+        if (n <= 0) {
+            OCRelease(shape);
+            return false;
+        }
+        OCNumberRef num = OCNumberCreateWithOCIndex(n);
+        OCArrayAppendValue(shape, num);
+        OCRelease(num);
+    }
+    OCMutableDictionaryRef layout = OCDictionaryCreateMutable(0);
+    OCNumberRef version = OCNumberCreateWithInt(1);
+    OCDictionarySetValue(layout, STR(kRMNChunkedLayoutVersionKey), version);
+    OCDictionarySetValue(layout, STR(kRMNChunkedLayoutChunkShapeKey), shape);
+    OCDictionarySetValue(dv->metaData, STR(kRMNChunkedLayoutMetaDataKey), layout);
+    OCRelease(version);
+    OCRelease(shape);
+    OCRelease(layout);
+    return true;
+}
+OCIndexArrayRef DependentVariableCopyChunkShape(DependentVariableRef dv) {
+    if (!dv || !dv->metaData) return NULL;
+    OCDictionaryRef layout = OCDictionaryGetValue(dv->metaData, STR(kRMNChunkedLayoutMetaDataKey));
+    if (!layout || OCGetTypeID(layout) != OCDictionaryGetTypeID()) return NULL;
+    OCArrayRef shape = OCDictionaryGetValue(layout, STR(kRMNChunkedLayoutChunkShapeKey));
+    if (!shape || OCGetTypeID(shape) != OCArrayGetTypeID()) return NULL;
+    OCIndex rank = OCArrayGetCount(shape);
+    if (rank < 1 || rank > kRMNChunkedLayoutMaxRank) return NULL;
+    OCMutableIndexArrayRef out = OCIndexArrayCreateMutable(rank);
+    for (OCIndex d = 0; d < rank; ++d) {
+        OCNumberRef num = OCArrayGetValueAtIndex(shape, d);
+        OCIndex n = 0;
+        if (!num || OCGetTypeID(num) != OCNumberGetTypeID() || !OCNumberTryGetOCIndex(num, &n) ||
+            n <= 0) {
+            OCRelease(out);
+            return NULL;
+        }
+        OCIndexArrayAppendValue(out, n);
+    }
+    return (OCIndexArrayRef)out;
+}
 OCTypeRef DependentVariableGetOwner(DependentVariableRef dv) {
     if (!dv) return NULL;
     return dv->owner;
@@ -2158,7 +2554,7 @@ OCStringRef DependentVariableGetQuantityName(DependentVariableRef dv) {
     return dv->quantityName;
 }
 bool DependentVariableSetQuantityName(DependentVariableRef dv, OCStringRef quantityName) {
-    if (!dv || !quantityName) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !quantityName) return false;
     // 1) Check that the name corresponds to a known dimensionality
     OCStringRef err = NULL;
     SIDimensionalityRef qDim = SIDimensionalityForQuantity(quantityName, &err);
@@ -2231,7 +2627,7 @@ OCStringRef DependentVariableGetComponentLabelAtIndex(DependentVariableRef dv, O
     return OCArrayGetValueAtIndex(labels, componentIndex);
 }
 bool DependentVariableSetComponentLabelAtIndex(DependentVariableRef dv, OCStringRef newLabel, OCIndex componentIndex) {
-    if (!dv || !newLabel) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv) || !newLabel) return false;
     OCArrayRef comps = (OCArrayRef)dv->components;
     OCMutableArrayRef labels = dv->componentLabels;
     OCIndex count = comps ? OCArrayGetCount(comps) : 0;
@@ -2244,125 +2640,43 @@ bool DependentVariableSetComponentLabelAtIndex(DependentVariableRef dv, OCString
 }
 OCNumberType DependentVariableGetElementType(DependentVariableRef dv) {
     if (!dv) return kOCNumberTypeInvalid;
+    // no deferred load for a type query, but queued operations may change it
+    impl_DependentVariableDrainQueue((struct impl_DependentVariable *)dv);
     return dv->numericType;
 }
 bool DependentVariableSetElementType(DependentVariableRef dv, OCNumberType newType) {
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
     OCNumberType oldType = dv->numericType;
     if (oldType == newType) return true;
     OCMutableArrayRef comps = dv->components;
-    if (!comps) return false;
+    if (!comps || !RMNConvertIsSupported(oldType, newType)) return false;
     OCIndex nComps = OCArrayGetCount(comps);
     OCIndex nElems = DependentVariableGetSize(dv);
-    size_t newBytes = nElems * OCNumberTypeSize((OCNumberType)newType);
-    for (OCIndex ci = 0; ci < nComps; ci++) {
-        OCMutableDataRef oldData = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        uint8_t *oldPtr = OCDataGetMutableBytes(oldData);
-        OCMutableDataRef newData = OCDataCreateMutable(0);
-        void *tmpBuf = malloc(newBytes);
-        // copy/convert element-by-element:
-        for (OCIndex ei = 0; ei < nElems; ei++) {
-            switch (oldType) {
-                case kOCNumberFloat32Type: {
-                    float *src = (float *)oldPtr;
-                    float f = src[ei];
-                    switch (newType) {
-                        case kOCNumberFloat32Type:
-                            ((float *)tmpBuf)[ei] = f;
-                            break;
-                        case kOCNumberFloat64Type:
-                            ((double *)tmpBuf)[ei] = f;
-                            break;
-                        case kOCNumberComplex64Type:
-                            ((float complex *)tmpBuf)[ei] = f;
-                            break;
-                        case kOCNumberComplex128Type:
-                            ((double complex *)tmpBuf)[ei] = f;
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case kOCNumberFloat64Type: {
-                    double *src = (double *)oldPtr;
-                    double d = src[ei];
-                    switch (newType) {
-                        case kOCNumberFloat32Type:
-                            ((float *)tmpBuf)[ei] = (float)d;
-                            break;
-                        case kOCNumberFloat64Type:
-                            ((double *)tmpBuf)[ei] = d;
-                            break;
-                        case kOCNumberComplex64Type:
-                            ((float complex *)tmpBuf)[ei] = (float)d;
-                            break;
-                        case kOCNumberComplex128Type:
-                            ((double complex *)tmpBuf)[ei] = d;
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case kOCNumberComplex64Type: {
-                    float complex *src = (float complex *)oldPtr;
-                    float complex z = src[ei];
-                    switch (newType) {
-                        case kOCNumberFloat32Type:
-                            ((float *)tmpBuf)[ei] = crealf(z);
-                            break;
-                        case kOCNumberFloat64Type:
-                            ((double *)tmpBuf)[ei] = crealf(z);
-                            break;
-                        case kOCNumberComplex64Type:
-                            ((float complex *)tmpBuf)[ei] = z;
-                            break;
-                        case kOCNumberComplex128Type:
-                            ((double complex *)tmpBuf)[ei] = z;
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                case kOCNumberComplex128Type: {
-                    double complex *src = (double complex *)oldPtr;
-                    double complex z = src[ei];
-                    switch (newType) {
-                        case kOCNumberFloat32Type:
-                            ((float *)tmpBuf)[ei] = (float)creal(z);
-                            break;
-                        case kOCNumberFloat64Type:
-                            ((double *)tmpBuf)[ei] = creal(z);
-                            break;
-                        case kOCNumberComplex64Type:
-                            ((float complex *)tmpBuf)[ei] = (float)creal(z) + (float)cimag(z) * I;
-                            break;
-                        case kOCNumberComplex128Type:
-                            ((double complex *)tmpBuf)[ei] = z;
-                            break;
-                        default:
-                            break;
-                    }
-                    break;
-                }
-                default:
-                    break;
-            }
+    size_t oldBytes = (size_t)nElems * OCNumberTypeSize(oldType);
+    size_t newBytes = (size_t)nElems * OCNumberTypeSize(newType);
+    // Buffers are converted in place.  When widening they are all grown
+    // first, so a failed reallocation leaves every component untouched.
+    if (newBytes > oldBytes) {
+        for (OCIndex ci = 0; ci < nComps; ci++) {
+            OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
+            OCDataSetLength(data, newBytes);
+            if ((size_t)OCDataGetLength(data) == newBytes) continue;
+            for (OCIndex cj = 0; cj <= ci; cj++)
+                OCDataSetLength((OCMutableDataRef)OCArrayGetValueAtIndex(comps, cj), oldBytes);
+            return false;
         }
-        // append and swap in
-        OCDataAppendBytes(newData, tmpBuf, newBytes);
-        free(tmpBuf);
-        OCArraySetValueAtIndex(comps, ci, newData);
-        OCRelease(newData);
+    }
+    for (OCIndex ci = 0; ci < nComps; ci++) {
+        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
+        RMNConvertElementsInPlace(newType, oldType, OCDataGetMutableBytes(data), (size_t)nElems);
+        if (newBytes < oldBytes) OCDataSetLength(data, newBytes);
     }
     dv->numericType = newType;
     return true;
 }
 bool DependentVariableSetValues(DependentVariableRef dv, OCIndex componentIndex, OCDataRef values) {
     // NULL‐check
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
     // Bounds check
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (nComps == 0 || componentIndex < 0 || componentIndex >= nComps) {
@@ -2388,7 +2702,7 @@ bool DependentVariableSetValues(DependentVariableRef dv, OCIndex componentIndex,
 float DependentVariableGetFloatValueAtMemOffset(DependentVariableRef dv,
                                                 OCIndex componentIndex,
                                                 OCIndex memOffset) {
-    if (!dv) return NAN;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 ||
@@ -2464,7 +2778,7 @@ float DependentVariableGetFloatValueAtMemOffset(DependentVariableRef dv,
 double DependentVariableGetDoubleValueAtMemOffset(DependentVariableRef dv,
                                                   OCIndex componentIndex,
                                                   OCIndex memOffset) {
-    if (!dv) return NAN;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 ||
@@ -2514,7 +2828,7 @@ double DependentVariableGetDoubleValueAtMemOffset(DependentVariableRef dv,
     }
 }
 float complex DependentVariableGetFloatComplexValueAtMemOffset(DependentVariableRef dv, OCIndex componentIndex, OCIndex memOffset) {
-    if (!dv) return NAN + NAN * I;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN + NAN * I;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 || nComps == 0 ||
@@ -2547,7 +2861,7 @@ float complex DependentVariableGetFloatComplexValueAtMemOffset(DependentVariable
     }
 }
 double complex DependentVariableGetDoubleComplexValueAtMemOffset(DependentVariableRef dv, OCIndex componentIndex, OCIndex memOffset) {
-    if (!dv) return NAN + NAN * I;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN + NAN * I;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 || nComps == 0 ||
@@ -2584,7 +2898,7 @@ double DependentVariableGetDoubleValueAtMemOffsetForPart(
     OCIndex componentIndex,
     OCIndex memOffset,
     complexPart part) {
-    if (!dv) return NAN;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 ||
@@ -2671,7 +2985,7 @@ float DependentVariableGetFloatValueAtMemOffsetForPart(
     OCIndex componentIndex,
     OCIndex memOffset,
     complexPart part) {
-    if (!dv) return NAN;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NAN;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 ||
@@ -2753,8 +3067,160 @@ float DependentVariableGetFloatValueAtMemOffsetForPart(
     }
     return NAN;
 }
+/// Locate a run of `count` elements of component `componentIndex` starting
+/// at `memOffset`, `memStride` elements apart.  Fails unless the whole run
+/// lies inside the component; unlike the per-element getters, offsets are
+/// not wrapped.
+static bool impl_ComponentRun(DependentVariableRef dv,
+                              OCIndex componentIndex,
+                              OCIndex memOffset,
+                              OCIndex memStride,
+                              OCIndex count,
+                              const uint8_t **outFirst) {
+    if (!impl_DependentVariableEnsureLoaded(dv) || !dv->components || count < 0 || memStride == 0)
+        return false;
+    OCIndex nComps = OCArrayGetCount(dv->components);
+    if (componentIndex < 0 || componentIndex >= nComps) return false;
+    OCIndex size = DependentVariableGetSize(dv);
+    if (count > 0) {
+        if (memOffset < 0 || memOffset >= size) return false;
+        // Elements left before the run leaves [0, size), compared by
+        // division so that huge counts or strides cannot overflow.
+        OCIndex room = memStride > 0 ? size - 1 - memOffset : memOffset;
+        if (memStride > room || memStride < -room) {
+            if (count > 1) return false;
+        } else if (count - 1 > room / (memStride > 0 ? memStride : -memStride)) {
+            return false;
+        }
+    }
+    OCDataRef data = (OCDataRef)OCArrayGetValueAtIndex(dv->components, componentIndex);
+    const uint8_t *bytes = OCDataGetBytesPtr(data);
+    *outFirst = bytes && count > 0
+                    ? bytes + (size_t)memOffset * OCNumberTypeSize(dv->numericType)
+                    : bytes;
+    return true;
+}
+bool DependentVariableGetComponentSpan(DependentVariableRef dv,
+                                       OCIndex componentIndex,
+                                       OCIndex memOffset,
+                                       OCIndex memStride,
+                                       OCIndex count,
+                                       DependentVariableSpan *outSpan) {
+    if (!outSpan) return false;
+    const uint8_t *first = NULL;
+    if (!impl_ComponentRun(dv, componentIndex, memOffset, memStride, count, &first)) return false;
+    outSpan->bytes = first;
+    outSpan->count = count;
+    outSpan->stride = memStride;
+    outSpan->type = dv->numericType;
+    return true;
+}
+/// Bulk getters: one bounds check and one kernel lookup per call.
+static bool impl_CopyValues(DependentVariableRef dv,
+                            OCIndex componentIndex,
+                            OCIndex memOffset,
+                            OCIndex memStride,
+                            OCIndex count,
+                            OCNumberType outType,
+                            void *out) {
+    if (!out && count > 0) return false;
+    const uint8_t *first = NULL;
+    if (!impl_ComponentRun(dv, componentIndex, memOffset, memStride, count, &first)) return false;
+    return RMNConvertElements(outType, out, dv->numericType, first, memStride, (size_t)count);
+}
+bool DependentVariableCopyFloatValues(DependentVariableRef dv,
+                                      OCIndex componentIndex,
+                                      OCIndex memOffset,
+                                      OCIndex memStride,
+                                      OCIndex count,
+                                      float *out) {
+    return impl_CopyValues(dv, componentIndex, memOffset, memStride, count,
+                           kOCNumberFloat32Type, out);
+}
+bool DependentVariableCopyDoubleValues(DependentVariableRef dv,
+                                       OCIndex componentIndex,
+                                       OCIndex memOffset,
+                                       OCIndex memStride,
+                                       OCIndex count,
+                                       double *out) {
+    return impl_CopyValues(dv, componentIndex, memOffset, memStride, count,
+                           kOCNumberFloat64Type, out);
+}
+bool DependentVariableCopyFloatComplexValues(DependentVariableRef dv,
+                                             OCIndex componentIndex,
+                                             OCIndex memOffset,
+                                             OCIndex memStride,
+                                             OCIndex count,
+                                             float complex *out) {
+    return impl_CopyValues(dv, componentIndex, memOffset, memStride, count,
+                           kOCNumberComplex64Type, out);
+}
+bool DependentVariableCopyDoubleComplexValues(DependentVariableRef dv,
+                                              OCIndex componentIndex,
+                                              OCIndex memOffset,
+                                              OCIndex memStride,
+                                              OCIndex count,
+                                              double complex *out) {
+    return impl_CopyValues(dv, componentIndex, memOffset, memStride, count,
+                           kOCNumberComplex128Type, out);
+}
+bool DependentVariableCopyDoubleValuesForPart(DependentVariableRef dv,
+                                              OCIndex componentIndex,
+                                              OCIndex memOffset,
+                                              OCIndex memStride,
+                                              OCIndex count,
+                                              complexPart part,
+                                              double *out) {
+    if (!out && count > 0) return false;
+    const uint8_t *first = NULL;
+    if (!impl_ComponentRun(dv, componentIndex, memOffset, memStride, count, &first)) return false;
+    OCNumberType type = dv->numericType;
+    bool isComplex = type == kOCNumberComplex64Type || type == kOCNumberComplex128Type;
+    // the real and imaginary parts of complex storage are strided real views
+    OCNumberType partType = type == kOCNumberComplex64Type    ? kOCNumberFloat32Type
+                            : type == kOCNumberComplex128Type ? kOCNumberFloat64Type
+                                                              : type;
+    size_t partSize = OCNumberTypeSize(partType);
+    ptrdiff_t partStride = isComplex ? 2 * (ptrdiff_t)memStride : (ptrdiff_t)memStride;
+    switch (part) {
+        case kSIRealPart:
+            return RMNConvertElements(kOCNumberFloat64Type, out, partType, first, partStride,
+                                      (size_t)count);
+        case kSIImaginaryPart:
+            if (!isComplex) {
+                for (OCIndex i = 0; i < count; ++i) out[i] = 0.0;
+                return true;
+            }
+            return RMNConvertElements(kOCNumberFloat64Type, out, partType, first + partSize,
+                                      partStride, (size_t)count);
+        case kSIMagnitudePart:
+        case kSIArgumentPart:
+            break;
+        default:
+            return false;
+    }
+    bool magnitude = part == kSIMagnitudePart;
+    if (!isComplex) {
+        if (!RMNConvertElements(kOCNumberFloat64Type, out, type, first, memStride, (size_t)count))
+            return false;
+        for (OCIndex i = 0; i < count; ++i) out[i] = magnitude ? fabs(out[i]) : atan2(0.0, out[i]);
+        return true;
+    }
+    for (OCIndex i = 0; i < count; ++i) {
+        double re, im;
+        if (type == kOCNumberComplex64Type) {
+            const float *z = (const float *)first + partStride * i;
+            re = z[0], im = z[1];
+        } else {
+            const double *z = (const double *)first + partStride * i;
+            re = z[0], im = z[1];
+        }
+        out[i] = magnitude ? hypot(re, im) : atan2(im, re);
+    }
+    return true;
+}
 SIScalarRef DependentVariableCreateValueFromMemOffset(DependentVariableRef dv, OCIndex componentIndex, OCIndex memOffset) {
-    if (!dv) return NULL;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return NULL;
     OCIndex size = DependentVariableGetSize(dv);
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (size == 0 || nComps == 0 ||
@@ -2791,7 +3257,7 @@ SIScalarRef DependentVariableCreateValueFromMemOffset(DependentVariableRef dv, O
 bool DependentVariableSetValueAtMemOffset(DependentVariableRef dv, OCIndex componentIndex, OCIndex memOffset, SIScalarRef value, OCStringRef *error) {
     // if caller already set *error, bail
     if (error && *error) return false;
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
     OCIndex nComps = OCArrayGetCount(dv->components);
     if (nComps == 0 ||
         componentIndex < 0 || componentIndex >= nComps) {
@@ -2840,6 +3306,239 @@ bool DependentVariableSetValueAtMemOffset(DependentVariableRef dv, OCIndex compo
 }
 #pragma endregion Tests, Getters &Setters
 #pragma region Conversion and Manipulation
+/// Elements per task when recorded operations run: every operation in the
+/// queue is applied to one block before the next, so the chain reads and
+/// writes each element once while the block sits in cache.
+enum { kQueuedBlock = 4096 };
+/// Zero `part` of `count` elements starting at `values` (ZeroPartInRange).
+/// Real types only have a real part and a magnitude; kSIArgumentPart keeps
+/// the magnitude of complex elements, i.e. replaces them by (|z|, 0).
+static void impl_ZeroPart(OCNumberType type, uint8_t *values, size_t count, complexPart part) {
+    switch (type) {
+        case kOCNumberFloat32Type:
+        case kOCNumberFloat64Type:
+            if (part == kSIRealPart || part == kSIMagnitudePart)
+                memset(values, 0, count * OCNumberTypeSize(type));
+            break;
+        case kOCNumberComplex64Type: {
+            float *v = (float *)values;
+            if (part == kSIMagnitudePart) memset(v, 0, count * 2 * sizeof(float));
+            if (part == kSIRealPart || part == kSIImaginaryPart) {
+                size_t offset = part == kSIRealPart ? 0 : 1;
+                for (size_t i = 0; i < count; ++i) v[2 * i + offset] = 0.0f;
+            }
+            if (part == kSIArgumentPart) RMNElementwiseAbsolute(type, values, count);
+            break;
+        }
+        case kOCNumberComplex128Type: {
+            double *v = (double *)values;
+            if (part == kSIMagnitudePart) memset(v, 0, count * 2 * sizeof(double));
+            if (part == kSIRealPart || part == kSIImaginaryPart) {
+                size_t offset = part == kSIRealPart ? 0 : 1;
+                for (size_t i = 0; i < count; ++i) v[2 * i + offset] = 0.0;
+            }
+            if (part == kSIArgumentPart) RMNElementwiseAbsolute(type, values, count);
+            break;
+        }
+        default:
+            break;
+    }
+}
+typedef struct {
+    const impl_QueuedOperation *ops;
+    OCIndex opCount;
+    OCNumberType type;            // element type before the first operation
+    OCNumberType narrowType;      // element type after kQueuedNarrowToReal
+    uint8_t *const *values;       // per component
+    uint8_t *const *narrowed;     // per component, the values when narrowing in place
+    size_t size;                  // elements per component
+    size_t blocksPerComponent;
+} impl_QueuedJob;
+static void impl_RunQueuedBlock(void *context, size_t index) {
+    const impl_QueuedJob *job = context;
+    OCIndex ci = (OCIndex)(index / job->blocksPerComponent);
+    size_t first = (index % job->blocksPerComponent) * kQueuedBlock;
+    size_t n = job->size - first < kQueuedBlock ? job->size - first : kQueuedBlock;
+    OCNumberType type = job->type;
+    uint8_t *block = job->values[ci] + first * OCNumberTypeSize(type);
+    for (OCIndex k = 0; k < job->opCount; ++k) {
+        const impl_QueuedOperation *op = &job->ops[k];
+        if (op->componentIndex >= 0 && op->componentIndex != ci) continue;
+        switch (op->kind) {
+            case kQueuedScaleReal:
+                RMNElementwiseScaleReal(type, block, n, creal(op->factor));
+                break;
+            case kQueuedScaleComplex:
+                RMNElementwiseScaleComplex(type, block, n, op->factor);
+                break;
+            case kQueuedConjugate:
+                RMNElementwiseConjugate(type, block, n);
+                break;
+            case kQueuedAbsolute:
+                RMNElementwiseAbsolute(type, block, n);
+                break;
+            case kQueuedZeroPart: {
+                size_t lo = (size_t)op->range.location, hi = lo + (size_t)op->range.length;
+                if (lo < first) lo = first;
+                if (hi > first + n) hi = first + n;
+                if (lo < hi)
+                    impl_ZeroPart(type, block + (lo - first) * OCNumberTypeSize(type), hi - lo,
+                                  op->part);
+                break;
+            }
+            case kQueuedNarrowToReal: {
+                uint8_t *out = job->narrowed[ci] + first * OCNumberTypeSize(job->narrowType);
+                // in place, block k > 0 lands below its source; block 0 overlaps it
+                if (out == block)
+                    RMNConvertElementsInPlace(job->narrowType, type, block, n);
+                else
+                    RMNConvertElements(job->narrowType, out, type, block, 1, n);
+                type = job->narrowType;
+                block = out;
+                break;
+            }
+        }
+    }
+}
+/// Apply the recorded operations to every component in one blocked pass
+/// (threaded for large variables) and empty the queue.  A complex-to-real
+/// narrowing is done in place when the blocks run in order, and into new
+/// buffers when they run on several threads; if those cannot be allocated,
+/// nothing is changed and the operations stay queued.
+static bool impl_DependentVariableRunQueuedOperations(struct impl_DependentVariable *dv) {
+    if (dv->queuedCount == 0) return true;
+    OCIndex nComps = dv->components ? OCArrayGetCount(dv->components) : 0;
+    OCNumberType type = dv->numericType;
+    size_t width = OCNumberTypeSize(type);
+    size_t size = nComps > 0 && width > 0
+                      ? (size_t)OCDataGetLength(OCArrayGetValueAtIndex(dv->components, 0)) / width
+                      : 0;
+    bool narrows = dv->queuedType != type;
+    size_t workers = size * (size_t)nComps >= RMNElementwiseGetParallelThreshold()
+                         ? RMNParallelProcessorCount()
+                         : 1;
+    uint8_t **values = calloc((size_t)nComps + 1, sizeof(*values));
+    uint8_t **narrowed = calloc((size_t)nComps + 1, sizeof(*narrowed));
+    OCMutableDataRef *buffers = calloc((size_t)nComps + 1, sizeof(*buffers));
+    bool ok = values && narrowed && buffers;
+    for (OCIndex ci = 0; ok && ci < nComps; ++ci) {
+        values[ci] = OCDataGetMutableBytes(
+            (OCMutableDataRef)OCArrayGetValueAtIndex(dv->components, ci));
+        narrowed[ci] = values[ci];
+        if (!narrows || workers < 2) continue;
+        size_t bytes = size * OCNumberTypeSize(dv->queuedType);
+        buffers[ci] = OCDataCreateMutable(bytes);
+        if (buffers[ci]) OCDataSetLength(buffers[ci], bytes);
+        ok = buffers[ci] && (size_t)OCDataGetLength(buffers[ci]) == bytes;
+        if (ok) narrowed[ci] = OCDataGetMutableBytes(buffers[ci]);
+    }
+    if (ok) {
+        size_t blocksPerComponent = (size + kQueuedBlock - 1) / kQueuedBlock;
+        impl_QueuedJob job = {dv->queuedOps, dv->queuedCount, type, dv->queuedType,
+                              values, narrowed, size, blocksPerComponent};
+        size_t tasks = blocksPerComponent * (size_t)nComps;
+        if (tasks > 0) RMNParallelFor(tasks, workers, impl_RunQueuedBlock, &job);
+        for (OCIndex ci = 0; narrows && ci < nComps; ++ci) {
+            OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(dv->components, ci);
+            if (buffers[ci])
+                OCArraySetValueAtIndex(dv->components, ci, buffers[ci]);
+            else
+                OCDataSetLength(data, size * OCNumberTypeSize(dv->queuedType));
+        }
+        if (narrows) dv->numericType = dv->queuedType;
+        dv->queuedCount = 0;
+        atomic_store_explicit(&dv->opsPending, false, memory_order_release);
+    }
+    for (OCIndex ci = 0; buffers && ci < nComps; ++ci)
+        if (buffers[ci]) OCRelease(buffers[ci]);
+    free(values);
+    free(narrowed);
+    free(buffers);
+    return ok;
+}
+/// Record `op` (which must target dv's current element type) and, unless
+/// operations are deferred, run it at once.  This is the single path for
+/// the in-place element-wise operations, so deferred and immediate results
+/// are the same.  Returns false, recording nothing, for an invalid request.
+static bool impl_DependentVariableQueue(struct impl_DependentVariable *dv, impl_QueuedOperation op) {
+    if (!dv) return false;
+    // Reach the components without flushing the queue that is being built
+    if (atomic_load_explicit(&dv->loadPending, memory_order_acquire))
+        impl_DependentVariableRunDeferredLoad(dv);
+    OCIndex nComps = dv->components ? OCArrayGetCount(dv->components) : 0;
+    if (nComps == 0 || op.componentIndex >= nComps) return false;
+    OCNumberType type = dv->queuedCount > 0 ? dv->queuedType : dv->numericType;
+    bool floating = type == kOCNumberFloat32Type || type == kOCNumberFloat64Type ||
+                    type == kOCNumberComplex64Type || type == kOCNumberComplex128Type;
+    switch (op.kind) {
+        case kQueuedZeroPart: {
+            size_t width = OCNumberTypeSize(dv->numericType);
+            OCIndex size = width ? (OCIndex)((size_t)OCDataGetLength(
+                                                 OCArrayGetValueAtIndex(dv->components, 0)) /
+                                             width)
+                                 : 0;
+            if (!floating || op.componentIndex < 0 || op.range.location < 0 ||
+                op.range.length < 0 || op.range.location + op.range.length > size)
+                return false;
+            break;
+        }
+        case kQueuedConjugate:
+            if (!floating) return false;
+            break;
+        default:
+            if (!RMNConvertIsSupported(type, type)) return false;
+            break;
+    }
+    OCNumberType narrowType = type == kOCNumberComplex64Type    ? kOCNumberFloat32Type
+                              : type == kOCNumberComplex128Type ? kOCNumberFloat64Type
+                                                                : type;
+    bool narrows = op.kind == kQueuedAbsolute && narrowType != type;
+    if (dv->defersOperations && !impl_DependentVariablePrepareLoadLock(dv)) return false;
+    OCIndex needed = dv->queuedCount + (narrows ? 2 : 1);
+    if (needed > dv->queuedCapacity) {
+        OCIndex capacity = dv->queuedCapacity ? dv->queuedCapacity : 8;
+        while (capacity < needed) capacity *= 2;
+        impl_QueuedOperation *ops = realloc(dv->queuedOps, (size_t)capacity * sizeof(*ops));
+        if (!ops) return false;
+        dv->queuedOps = ops;
+        dv->queuedCapacity = capacity;
+    }
+    if (dv->queuedCount == 0) dv->queuedType = dv->numericType;
+    dv->queuedOps[dv->queuedCount++] = op;
+    if (narrows) {
+        // |z| leaves (|z|, 0); the element type then narrows for every component
+        dv->queuedOps[dv->queuedCount++] = (impl_QueuedOperation){.kind = kQueuedNarrowToReal,
+                                                                   .componentIndex = -1};
+        dv->queuedType = narrowType;
+    }
+    if (dv->defersOperations) {
+        atomic_store_explicit(&dv->opsPending, true, memory_order_release);
+        return true;
+    }
+    if (impl_DependentVariableRunQueuedOperations(dv)) return true;
+    dv->queuedCount = 0;
+    atomic_store_explicit(&dv->opsPending, false, memory_order_release);
+    return false;
+}
+bool DependentVariableSetDefersOperations(DependentVariableRef dv, bool defer) {
+    if (!dv) return false;
+    dv->defersOperations = defer;
+    return defer || DependentVariableFlushOperations(dv);
+}
+bool DependentVariableDefersOperations(DependentVariableRef dv) {
+    return dv && dv->defersOperations;
+}
+OCIndex DependentVariableGetQueuedOperationCount(DependentVariableRef dv) {
+    if (!dv) return 0;
+    OCIndex count = 0;
+    for (OCIndex k = 0; k < dv->queuedCount; ++k)
+        if (dv->queuedOps[k].kind != kQueuedNarrowToReal) count++;
+    return count;
+}
+bool DependentVariableFlushOperations(DependentVariableRef dv) {
+    if (!dv) return false;
+    return impl_DependentVariableDrainQueue(dv);
+}
 /**
  * @brief Convert all component data in a dependent variable to a new unit.
  *        Integer‐typed dependent variables cannot be converted and will error.
@@ -2896,44 +3595,11 @@ bool DependentVariableConvertToUnit(DependentVariableRef dv,
     /* Compute conversion factor and update stored unit */
     double factor = SIUnitConversion(oldUnit, unit);
     SIQuantitySetUnit((SIMutableQuantityRef) dv, unit);
-    /* Scale each component in a simple loop */
+    /* Scale each component in place */
     uint64_t size = DependentVariableGetSize(dv);
     for (uint64_t ci = 0; ci < count; ++ci) {
         OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        uint8_t *bytes = OCDataGetMutableBytes(data);
-        switch (etype) {
-            case kOCNumberFloat32Type: {
-                float *arr = (float *)bytes;
-                for (uint64_t i = 0; i < size; ++i) {
-                    arr[i] *= (float)factor;
-                }
-                break;
-            }
-            case kOCNumberFloat64Type: {
-                double *arr = (double *)bytes;
-                for (uint64_t i = 0; i < size; ++i) {
-                    arr[i] *= factor;
-                }
-                break;
-            }
-            case kOCNumberComplex64Type: {
-                float complex *arr = (float complex *)bytes;
-                for (uint64_t i = 0; i < size; ++i) {
-                    arr[i] *= (float)factor;
-                }
-                break;
-            }
-            case kOCNumberComplex128Type: {
-                double complex *arr = (double complex *)bytes;
-                for (uint64_t i = 0; i < size; ++i) {
-                    arr[i] *= factor;
-                }
-                break;
-            }
-            default:
-                /* All integer types handled above; no action here */
-                break;
-        }
+        RMNElementwiseScaleReal(etype, OCDataGetMutableBytes(data), (size_t)size, factor);
     }
     return true;
 }
@@ -2964,311 +3630,27 @@ bool DependentVariableZeroPartInRange(DependentVariableRef dv,
                                  OCRange range,
                                  complexPart part)
 {
-    if (!dv) return false;
-
-    OCArrayRef comps = dv->components;
-    OCIndex nComps = comps ? OCArrayGetCount(comps) : 0;
-    if (nComps == 0 || componentIndex < 0 || componentIndex >= nComps) {
-        return false;
-    }
-
-    OCIndex totalSize = DependentVariableGetSize(dv);
-    if (range.location < 0
-     || range.length  < 0
-     || range.location + range.length > totalSize) {
-        return false;
-    }
-
-    OCIndex startComp = componentIndex;
-    OCIndex endComp   = componentIndex + 1;
-
-    for (OCIndex ci = startComp; ci < endComp; ++ci) {
-        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        uint8_t *ptr = OCDataGetMutableBytes(data);
-        OCNumberType etype = DependentVariableGetElementType(dv);
-
-        switch (etype) {
-
-          case kOCNumberFloat32Type:
-            if (part == kSIRealPart || part == kSIMagnitudePart) {
-                /* scale the subvector at &ptr[range.location] by 0.0f */
-                cblas_sscal((int)range.length,
-                            0.0f,
-                            (float*)ptr + range.location,
-                            1);
-            }
-            break;
-
-          case kOCNumberFloat64Type:
-            if (part == kSIRealPart || part == kSIMagnitudePart) {
-                cblas_dscal((int)range.length,
-                            0.0,
-                            (double*)ptr + range.location,
-                            1);
-            }
-            break;
-
-          case kOCNumberComplex64Type: {
-            float complex *cptr = (float complex*)ptr;
-            switch (part) {
-              case kSIRealPart:
-                /* zero real entries, keep imag: real at stride=2 offset 0 */
-                cblas_sscal((int)range.length,
-                            0.0f,
-                            (float*)cptr + 2*range.location,
-                            2);
-                break;
-              case kSIImaginaryPart:
-                /* zero imag entries: offset 1, stride=2 */
-                cblas_sscal((int)range.length,
-                            0.0f,
-                            (float*)cptr + 2*range.location + 1,
-                            2);
-                break;
-              case kSIMagnitudePart:
-                /* zero both real & imag: treat as 2*length contiguous */
-                cblas_sscal((int)(2*range.length),
-                            0.0f,
-                            (float*)cptr + 2*range.location,
-                            1);
-                break;
-              case kSIArgumentPart:
-                /* must compute abs and zero imag by hand */
-                for (OCIndex i = range.location; i < range.location + range.length; ++i) {
-                  float complex v = cptr[i];
-                  float m = cabsf(v);
-                  cptr[i] = m + 0.0f * I;
-                }
-                break;
-            }
-            break;
-          }
-
-          case kOCNumberComplex128Type: {
-            double complex *cptr = (double complex*)ptr;
-            switch (part) {
-              case kSIRealPart:
-                cblas_dscal((int)range.length,
-                            0.0,
-                            (double*)cptr + 2*range.location,
-                            2);
-                break;
-              case kSIImaginaryPart:
-                cblas_dscal((int)range.length,
-                            0.0,
-                            (double*)cptr + 2*range.location + 1,
-                            2);
-                break;
-              case kSIMagnitudePart:
-                cblas_dscal((int)(2*range.length),
-                            0.0,
-                            (double*)cptr + 2*range.location,
-                            1);
-                break;
-              case kSIArgumentPart:
-                for (OCIndex i = range.location; i < range.location + range.length; ++i) {
-                  double complex v = cptr[i];
-                  double m = cabs(v);
-                  cptr[i] = m + 0.0 * I;
-                }
-                break;
-            }
-            break;
-          }
-
-          default:
-            /* integer types or unsupported */
-            return false;
-        }
-    }
-
-    return true;
+    impl_QueuedOperation op = {.kind = kQueuedZeroPart, .componentIndex = componentIndex,
+                               .range = range, .part = part};
+    return impl_DependentVariableQueue(dv, op);
 }
 
 bool DependentVariableTakeAbsoluteValue(DependentVariableRef dv,
                                         int64_t componentIndex) {
     IF_NO_OBJECT_EXISTS_RETURN(dv, false);
-    OCArrayRef comps = DependentVariableGetComponents(dv);
-    uint64_t nComps = OCArrayGetCount(comps);
-    if (nComps == 0 ||
-        (componentIndex >= 0 && (uint64_t)componentIndex >= nComps)) {
-        return false;
-    }
-    uint64_t lower = 0, upper = nComps;
-    if (componentIndex >= 0) {
-        lower = (uint64_t)componentIndex;
-        upper = lower + 1;
-    }
-    uint64_t size = DependentVariableGetSize(dv);
-    OCNumberType origEtype = DependentVariableGetElementType(dv);
-    OCNumberType newEtype = origEtype;
-    for (uint64_t ci = lower; ci < upper; ++ci) {
-        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        uint8_t *bytes = OCDataGetMutableBytes(data);
-        switch (origEtype) {
-            case kOCNumberSInt8Type: {
-                int8_t *arr = (int8_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = arr[i] < 0 ? -arr[i] : arr[i];
-                break;
-            }
-            case kOCNumberSInt16Type: {
-                int16_t *arr = (int16_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = arr[i] < 0 ? -arr[i] : arr[i];
-                break;
-            }
-            case kOCNumberSInt32Type: {
-                int32_t *arr = (int32_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = arr[i] < 0 ? -arr[i] : arr[i];
-                break;
-            }
-            case kOCNumberSInt64Type: {
-                int64_t *arr = (int64_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = arr[i] < 0 ? -arr[i] : arr[i];
-                break;
-            }
-            case kOCNumberUInt8Type:
-            case kOCNumberUInt16Type:
-            case kOCNumberUInt32Type:
-            case kOCNumberUInt64Type:
-                /* Unsigned types are already non-negative */
-                break;
-            case kOCNumberFloat32Type: {
-                float *arr = (float *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = fabsf(arr[i]);
-                break;
-            }
-            case kOCNumberFloat64Type: {
-                double *arr = (double *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = fabs(arr[i]);
-                break;
-            }
-            case kOCNumberComplex64Type: {
-                float complex *arr = (float complex *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = cabsf(arr[i]); /* real=|z|, imag=0 */
-                newEtype = kOCNumberFloat32Type;
-                break;
-            }
-            case kOCNumberComplex128Type: {
-                double complex *arr = (double complex *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = cabs(arr[i]); /* real=|z|, imag=0 */
-                newEtype = kOCNumberFloat64Type;
-                break;
-            }
-            default:
-                return false;
-        }
-    }
-    if (newEtype != origEtype) {
-        DependentVariableSetElementType(dv, newEtype);
-    }
-    return true;
+    /* Complex values become (|z|, 0) and the type narrows to real */
+    impl_QueuedOperation op = {.kind = kQueuedAbsolute,
+                               .componentIndex = componentIndex < 0 ? -1 : (OCIndex)componentIndex};
+    return impl_DependentVariableQueue(dv, op);
 }
 bool DependentVariableMultiplyValuesByDimensionlessComplexConstant(DependentVariableRef dv,
                                                                    int64_t componentIndex,
                                                                    double complex constant) {
     IF_NO_OBJECT_EXISTS_RETURN(dv, false);
-    OCArrayRef comps = DependentVariableGetComponents(dv);
-    uint64_t nComps = OCArrayGetCount(comps);
-    if (nComps == 0 ||
-        (componentIndex >= 0 && (uint64_t)componentIndex >= nComps)) {
-        return false;
-    }
-    uint64_t lower = 0, upper = nComps;
-    if (componentIndex >= 0) {
-        lower = (uint64_t)componentIndex;
-        upper = lower + 1;
-    }
-    uint64_t size = DependentVariableGetSize(dv);
-    OCNumberType etype = DependentVariableGetElementType(dv);
-    /* Prepare BLAS scalars */
-    float scalar_f32 = (float)creal(constant);
-    double scalar_f64 = creal(constant);
-    float scalar_c32[2] = {(float)creal(constant), (float)cimag(constant)};
-    double scalar_c64[2] = {creal(constant), cimag(constant)};
-    for (uint64_t ci = lower; ci < upper; ++ci) {
-        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        uint8_t *bytes = OCDataGetMutableBytes(data);
-        switch (etype) {
-            case kOCNumberSInt8Type: {
-                int8_t *arr = (int8_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int8_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt16Type: {
-                int16_t *arr = (int16_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int16_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt32Type: {
-                int32_t *arr = (int32_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int32_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt64Type: {
-                int64_t *arr = (int64_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int64_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt8Type: {
-                uint8_t *arr = (uint8_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint8_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt16Type: {
-                uint16_t *arr = (uint16_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint16_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt32Type: {
-                uint32_t *arr = (uint32_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint32_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt64Type: {
-                uint64_t *arr = (uint64_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint64_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberFloat32Type:
-                cblas_sscal((int)size, scalar_f32, (float *)bytes, 1);
-                break;
-            case kOCNumberFloat64Type:
-                cblas_dscal((int)size, scalar_f64, (double *)bytes, 1);
-                break;
-            case kOCNumberComplex64Type:
-                cblas_cscal((int)size,
-                            (const void *)scalar_c32,
-                            (float _Complex *)bytes,
-                            1);
-                break;
-            case kOCNumberComplex128Type:
-                cblas_zscal((int)size,
-                            (const void *)scalar_c64,
-                            (double _Complex *)bytes,
-                            1);
-                break;
-            default:
-                /* Unsupported element type */
-                return false;
-        }
-    }
-    return true;
+    impl_QueuedOperation op = {.kind = kQueuedScaleComplex,
+                               .componentIndex = componentIndex < 0 ? -1 : (OCIndex)componentIndex,
+                               .factor = constant};
+    return impl_DependentVariableQueue(dv, op);
 }
 
 /**
@@ -3299,7 +3681,7 @@ DependentVariableTakeComplexPart(DependentVariableRef dv,
                                  OCIndex componentIndex,
                                  complexPart part)
 {
-    if (!dv) return false;
+    if (!impl_DependentVariableEnsureLoaded(dv)) return false;
 
     OCArrayRef comps = dv->components;
     OCIndex nComps = comps ? OCArrayGetCount(comps) : 0;
@@ -3399,51 +3781,10 @@ bool
 DependentVariableConjugate(DependentVariableRef dv,
                            OCIndex            componentIndex)
 {
-    if (!dv) return false;
-
-    OCArrayRef comps   = dv->components;
-    OCIndex   nComps   = comps ? OCArrayGetCount(comps) : 0;
-    if (nComps == 0 || componentIndex >= nComps) {
-        return false;
-    }
-
-    size_t totalSize = DependentVariableGetSize(dv);
-
-    OCIndex lo = componentIndex >= 0 ? componentIndex : 0;
-    OCIndex hi = componentIndex >= 0 ? componentIndex + 1  : nComps;
-
-    for (OCIndex ci = lo; ci < hi; ++ci) {
-        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-
-        switch (dv->numericType) {
-            case kOCNumberFloat32Type:
-            case kOCNumberFloat64Type:
-                // real‐only, nothing to do
-                break;
-
-            case kOCNumberComplex64Type: {
-                // interleaved [r0,i0, r1,i1, …]
-                float complex *buf = (float complex*)OCDataGetMutableBytes(data);
-                float *imag = ((float*)buf) + 1;
-                // negate each imaginary entry:
-                //      imag[j] = -imag[j],  j=0..totalSize-1, stride=2
-                cblas_sscal((int)totalSize, -1.0f, imag, 2);
-                break;
-            }
-
-            case kOCNumberComplex128Type: {
-                double complex *buf = (double complex*)OCDataGetMutableBytes(data);
-                double *imag = ((double*)buf) + 1;
-                cblas_dscal((int)totalSize, -1.0, imag, 2);
-                break;
-            }
-
-            default:
-                return false;  // integers & others not supported
-        }
-    }
-
-    return true;
+    // real types have nothing to conjugate; integers are not supported
+    impl_QueuedOperation op = {.kind = kQueuedConjugate,
+                               .componentIndex = componentIndex < 0 ? -1 : componentIndex};
+    return impl_DependentVariableQueue(dv, op);
 }
 
 bool
@@ -3451,109 +3792,104 @@ DependentVariableMultiplyValuesByDimensionlessRealConstant(DependentVariableRef
                                                            OCIndex            componentIndex,
                                                            double             constant)
 {
-    if (!dv) return false;
+    impl_QueuedOperation op = {.kind = kQueuedScaleReal,
+                               .componentIndex = componentIndex < 0 ? -1 : componentIndex,
+                               .factor = constant};
+    return impl_DependentVariableQueue(dv, op);
+}
 
-    OCArrayRef    comps      = DependentVariableGetComponents(dv);
-    uint64_t      nComps     = comps ? OCArrayGetCount(comps) : 0;
-    if (nComps == 0 ||
-        (componentIndex >= 0 && (uint64_t)componentIndex >= nComps))
-    {
+/// Unit of a product (or quotient) of values in `a` and `b`.  Numbers in the
+/// unexpanded product unit must be multiplied by *multiplier to be in the
+/// returned unit (m * km, for instance, gives m^2 and 1000).
+static SIUnitRef impl_CombinedUnit(SIUnitRef a, SIUnitRef b, bool divide, double *multiplier,
+                                   OCStringRef *outError) {
+    SIUnitRef dimensionless = SIUnitDimensionlessAndUnderived();
+    *multiplier = 1.0;
+    if (b == dimensionless) return a;
+    if (a == dimensionless && !divide) return b;
+    OCStringRef symbolA = a == dimensionless ? NULL : SIUnitCopySymbol(a);
+    OCStringRef symbolB = SIUnitCopySymbol(b);
+    OCStringRef expression = NULL;
+    if (!symbolA)
+        expression = OCStringCreateWithFormat(STR("1/(%@)"), symbolB);
+    else
+        expression = OCStringCreateWithFormat(divide ? STR("(%@)/(%@)") : STR("(%@)*(%@)"),
+                                              symbolA, symbolB);
+    SIUnitRef unit = expression ? SIUnitFromExpression(expression, multiplier, outError) : NULL;
+    if (symbolA) OCRelease(symbolA);
+    if (symbolB) OCRelease(symbolB);
+    if (expression) OCRelease(expression);
+    return unit;
+}
+/// Shared body of DependentVariableAdd, Subtract, Multiply and Divide.
+static bool impl_DependentVariableCombine(DependentVariableRef dv, DependentVariableRef operand,
+                                          RMNElementwiseOperation op, OCStringRef name,
+                                          OCStringRef *outError) {
+    if (outError && *outError) return false;
+    if (!dv || !operand) return false;
+    OCIndex n1 = DependentVariableGetComponentCount(dv);
+    OCIndex n2 = DependentVariableGetComponentCount(operand);
+    if (n1 == 0 || n2 == 0) return false;
+    // matching components pair up; a single operand component is broadcast
+    if (n1 != n2 && n2 != 1) {
+        if (outError)
+            *outError = OCStringCreateWithFormat(STR("%@ Error: Incompatible component counts."), name);
         return false;
     }
-
-    uint64_t lower = (componentIndex >= 0 ? componentIndex : 0);
-    uint64_t upper = (componentIndex >= 0 ? lower + 1        : nComps);
-    uint64_t size  = DependentVariableGetSize(dv);
-    OCNumberType type  = DependentVariableGetElementType(dv);
-
-    /* prepare BLAS scalars */
-    float  alpha_f = (float)constant;
-    double alpha_d = constant;
-
-    for (uint64_t ci = lower; ci < upper; ++ci) {
-        OCMutableDataRef data = (OCMutableDataRef)OCArrayGetValueAtIndex(comps, ci);
-        void *bytes = OCDataGetMutableBytes(data);
-
-        switch (type) {
-            /* 8/16/32/64-bit signed ints */
-            case kOCNumberSInt8Type: {
-                int8_t *arr = (int8_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int8_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt16Type: {
-                int16_t *arr = (int16_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int16_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt32Type: {
-                int32_t *arr = (int32_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int32_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberSInt64Type: {
-                int64_t *arr = (int64_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (int64_t)(arr[i] * constant);
-                break;
-            }
-
-            /* 8/16/32/64-bit unsigned ints */
-            case kOCNumberUInt8Type: {
-                uint8_t *arr = (uint8_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint8_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt16Type: {
-                uint16_t *arr = (uint16_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint16_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt32Type: {
-                uint32_t *arr = (uint32_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint32_t)(arr[i] * constant);
-                break;
-            }
-            case kOCNumberUInt64Type: {
-                uint64_t *arr = (uint64_t *)bytes;
-                for (uint64_t i = 0; i < size; ++i)
-                    arr[i] = (uint64_t)(arr[i] * constant);
-                break;
-            }
-
-            /* 32-bit float */
-            case kOCNumberFloat32Type:
-                cblas_sscal((int)size, alpha_f, (float*)bytes, 1);
-                break;
-
-            /* 64-bit float */
-            case kOCNumberFloat64Type:
-                cblas_dscal((int)size, alpha_d, (double*)bytes, 1);
-                break;
-
-            /* single-precision complex: scale by real constant */
-            case kOCNumberComplex64Type:
-                cblas_csscal((int)size, alpha_f, (void*)bytes, 1);
-                break;
-
-            /* double-precision complex: scale by real constant */
-            case kOCNumberComplex128Type:
-                cblas_zdscal((int)size, alpha_d, (void*)bytes, 1);
-                break;
-
-            default:
-                /* unsupported type */
-                return false;
+    OCIndex size = DependentVariableGetSize(dv);
+    if (DependentVariableGetSize(operand) != size) {
+        if (outError)
+            *outError = OCStringCreateWithFormat(STR("%@ Error: Incompatible sizes."), name);
+        return false;
+    }
+    OCNumberType et1 = DependentVariableGetElementType(dv);
+    OCNumberType et2 = DependentVariableGetElementType(operand);
+    if (SIQuantityIsComplexType((SIQuantityRef)operand) && !SIQuantityIsComplexType((SIQuantityRef)dv)) {
+        if (outError)
+            *outError = OCStringCreateWithFormat(STR("%@ Error: Complex operand for a real dependent variable."), name);
+        return false;
+    }
+    // sums need one dimensionality and take the operand into dv's unit;
+    // products and quotients change the unit instead
+    double scale = 1.0;
+    SIUnitRef unit = dv->unit;
+    if (op == kRMNElementwiseAdd || op == kRMNElementwiseSubtract) {
+        if (!SIQuantityHasSameReducedDimensionality((SIQuantityRef)dv, (SIQuantityRef)operand)) {
+            if (outError)
+                *outError = OCStringCreateWithFormat(STR("%@ Error: Incompatible dimensionalities."), name);
+            return false;
         }
+        scale = SIUnitConversion(operand->unit, dv->unit);
+    } else {
+        double multiplier = 1.0;
+        unit = impl_CombinedUnit(dv->unit, operand->unit, op == kRMNElementwiseDivide, &multiplier, outError);
+        if (!unit) return false;
+        scale = op == kRMNElementwiseDivide ? 1.0 / multiplier : multiplier;
+    }
+    for (OCIndex ci = 0; ci < n1; ++ci) {
+        OCMutableDataRef dest = (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, ci);
+        OCDataRef src = DependentVariableGetComponentAtIndex(operand, n2 != 1 ? ci : 0);
+        if (!RMNElementwiseCombine(op, et1, OCDataGetMutableBytes(dest), et2,
+                                   OCDataGetBytesPtr(src), (size_t)size, scale))
+            return false;
+    }
+    if (unit != dv->unit) {
+        dv->unit = unit;
+        OCRelease(dv->quantityName);
+        dv->quantityName = OCStringCreateCopy(SIUnitGuessQuantityName(unit));
     }
-
     return true;
 }
-
+bool DependentVariableAdd(DependentVariableRef dv, DependentVariableRef operand, OCStringRef *outError) {
+    return impl_DependentVariableCombine(dv, operand, kRMNElementwiseAdd, STR("Add"), outError);
+}
+bool DependentVariableSubtract(DependentVariableRef dv, DependentVariableRef operand, OCStringRef *outError) {
+    return impl_DependentVariableCombine(dv, operand, kRMNElementwiseSubtract, STR("Subtract"), outError);
+}
+bool DependentVariableMultiply(DependentVariableRef dv, DependentVariableRef operand, OCStringRef *outError) {
+    return impl_DependentVariableCombine(dv, operand, kRMNElementwiseMultiply, STR("Multiply"), outError);
+}
+bool DependentVariableDivide(DependentVariableRef dv, DependentVariableRef operand, OCStringRef *outError) {
+    return impl_DependentVariableCombine(dv, operand, kRMNElementwiseDivide, STR("Divide"), outError);
+}
 #pragma endregion Conversion and Manipulation
\ No newline at end of file
@@ -229,6 +229,58 @@ bool DependentVariableAppend(
     DependentVariableRef dv,
     DependentVariableRef appendedDV,
     OCStringRef *outError);
+/**
+ * @brief Add another DependentVariable to this one, element by element.
+ *
+ * Both must have the same size and reduced dimensionality; the operand's
+ * values are converted into this variable's unit on the fly.  Components
+ * pair up by index, or a single-component operand is applied to every
+ * component.  The operand may have a different element type (converted as
+ * RMNConvertElements() does), but a complex operand requires a complex
+ * variable.  The work runs through RMNElementwiseCombine().
+ *
+ * @param dv        The variable to modify.
+ * @param operand   The variable to add; may be `dv` itself.
+ * @param outError  Optional; receives a description on failure.
+ * @return false on incompatible units, sizes, component counts or types
+ *         (nothing is changed).
+ */
+bool DependentVariableAdd(
+    DependentVariableRef dv,
+    DependentVariableRef operand,
+    OCStringRef *outError);
+/**
+ * @brief Subtract another DependentVariable from this one, element by element.
+ *
+ * Same rules as DependentVariableAdd().
+ */
+bool DependentVariableSubtract(
+    DependentVariableRef dv,
+    DependentVariableRef operand,
+    OCStringRef *outError);
+/**
+ * @brief Multiply this DependentVariable by another, element by element.
+ *
+ * Any units combine: the result unit is the reduced product of the two
+ * (with the values rescaled if the reduction changes the prefix, as for
+ * m·km → m²) and the quantity name is guessed from it.  Sizes, component
+ * counts and types follow DependentVariableAdd().
+ */
+bool DependentVariableMultiply(
+    DependentVariableRef dv,
+    DependentVariableRef operand,
+    OCStringRef *outError);
+/**
+ * @brief Divide this DependentVariable by another, element by element.
+ *
+ * The result unit is the reduced quotient of the two units, as in
+ * DependentVariableMultiply().  Division by zero follows IEEE arithmetic
+ * for floating types and saturates for integer types.
+ */
+bool DependentVariableDivide(
+    DependentVariableRef dv,
+    DependentVariableRef operand,
+    OCStringRef *outError);
 /** @} end of In-place Mutation */
 /**
  * @name Serialization
@@ -236,11 +288,49 @@ bool DependentVariableAppend(
  */
 /**
  * @brief Serialize into a deep-copyable OCDictionary (for JSON, tests).
+ * @return A new dictionary (caller releases), or NULL if a base64 or
+ *         compressed component cannot be encoded.
  */
 OCDictionaryRef
 DependentVariableCopyAsDictionary(DependentVariableRef dv);
+/**
+ * @brief Serialize like CopyAsDictionary(), but with stand-in components.
+ *
+ * Each encoded component (base64 or "none") is replaced by the matching
+ * entry of `placeholders`, so the metadata can be rendered cheaply and the
+ * payloads written afterwards with DependentVariableWriteComponentJSON().
+ * "raw" components are embedded as usual.
+ *
+ * @param dv           Source DependentVariable.
+ * @param placeholders Array of OCStringRef, at least one per component.
+ * @return A new dictionary (caller releases), or NULL on bad arguments.
+ */
+OCDictionaryRef
+DependentVariableCopyAsDictionaryWithPlaceholders(DependentVariableRef dv,
+                                                  OCArrayRef placeholders);
+/**
+ * @brief Write one component as a JSON value.
+ *
+ * Writes a quoted base64 string or, for "none" encoding, a number array
+ * (complex values as re/im pairs), encoding through a small fixed buffer so
+ * memory use does not grow with the component size.  Numbers are written
+ * with RMNDecimalFormatDouble(), so every value reads back bit for bit.
+ *
+ * @param dv             Source DependentVariable.
+ * @param componentIndex Component to write.
+ * @param stream         Destination stream.
+ * @return true on success; false on bad arguments, "raw" encoding, or a
+ *         write error.
+ */
+bool
+DependentVariableWriteComponentJSON(DependentVariableRef dv,
+                                    OCIndex componentIndex,
+                                    FILE *stream);
 /**
  * @brief Reconstruct from a dictionary produced by CopyAsDictionary().
+ *
+ * For "base64" and "none" encodings a "components" entry may also hold an
+ * already-decoded OCData; it is adopted without copying.
  */
 DependentVariableRef
 DependentVariableCreateFromDictionary(
@@ -272,6 +362,10 @@ OCStringRef DependentVariableGetType(DependentVariableRef dv);
 bool DependentVariableSetType(DependentVariableRef dv, OCStringRef newType);
 bool DependentVariableShouldSerializeExternally(DependentVariableRef dv);
 OCStringRef DependentVariableGetEncoding(DependentVariableRef dv);
+/**
+ * @brief Set the component encoding: "base64", "none", "raw", or a compressed
+ *        encoding such as "shuffle+zstd" (see RMNCodec.h).
+ */
 bool DependentVariableSetEncoding(DependentVariableRef dv, OCStringRef newEnc);
 OCStringRef DependentVariableGetComponentsURL(DependentVariableRef dv);
 bool DependentVariableSetComponentsURL(DependentVariableRef dv, OCStringRef url);
@@ -285,6 +379,20 @@ OCStringRef DependentVariableGetQuantityType(DependentVariableRef dv);
 bool DependentVariableSetQuantityType(DependentVariableRef dv, OCStringRef quantityType);
 OCStringRef DependentVariableGetUnitSymbol(DependentVariableRef dv);
 OCNumberType DependentVariableGetElementType(DependentVariableRef dv);
+/**
+ * @brief Convert every component to a new element type.
+ *
+ * Any numeric type converts to any other with RMNConvertElementsInPlace():
+ * complex to real keeps the real part, and conversions to integer types
+ * truncate and saturate (NaN becomes 0).  Components are converted in
+ * place, reallocated at most once each when the new type is wider.
+ *
+ * @param dv       The dependent variable.
+ * @param newType  The new element type.
+ * @return false if `newType` is not a numeric type or memory runs out; the
+ *         components are then unchanged.
+ * @ingroup RMNLib
+ */
 bool DependentVariableSetElementType(DependentVariableRef dv, OCNumberType newType);
 /** @} end of Basic Accessors */
 /**
@@ -298,6 +406,25 @@ bool DependentVariableSetSparseSampling(DependentVariableRef dv,
 /** @} end of Sparse-sampling Accessors */
 OCDictionaryRef DependentVariableGetMetaData(DependentVariableRef dv);
 bool DependentVariableSetMetaData(DependentVariableRef dv, OCDictionaryRef dict);
+/**
+ * @brief Opt in to (or out of) the chunked external layout.
+ *
+ * Stores the chunk shape under kRMNChunkedLayoutMetaDataKey in the DV's
+ * "application" metadata, so it round-trips through CSDM files.  When the
+ * DV is exported externally its blob is written in the layout described in
+ * RMNChunkedLayout.h; it is ignored for internal and sparse DVs.
+ *
+ * @param dv          Target DependentVariable.
+ * @param chunkShape  One chunk size (> 0) per dimension, or NULL to return
+ *                    to the flat layout.
+ * @return true on success.
+ */
+bool DependentVariableSetChunkShape(DependentVariableRef dv, OCIndexArrayRef chunkShape);
+/**
+ * @brief The DV's chunk shape, if it uses the chunked external layout.
+ * @return A new OCIndexArray (caller releases), or NULL if none is set.
+ */
+OCIndexArrayRef DependentVariableCopyChunkShape(DependentVariableRef dv);
 OCTypeRef DependentVariableGetOwner(DependentVariableRef dv);
 bool DependentVariableSetOwner(DependentVariableRef dv, OCTypeRef owner);
 /**
@@ -312,7 +439,128 @@ OCDataRef DependentVariableGetComponentAtIndex(DependentVariableRef dv, OCIndex
 bool DependentVariableSetComponentAtIndex(DependentVariableRef dv, OCDataRef newBuf, OCIndex idx);
 bool DependentVariableInsertComponentAtIndex(DependentVariableRef dv, OCDataRef component, OCIndex idx);
 bool DependentVariableRemoveComponentAtIndex(DependentVariableRef dv, OCIndex idx);
+/**
+ * @brief Content hash of one component: RMNHashXXH3() of its bytes.
+ *
+ * DatasetExport() records these hashes for external DVs (see
+ * kRMNHashComponentsMetaDataKey), so a cache can compare them with the
+ * values in a file's header before reading any blob.
+ *
+ * @param dv              Source DependentVariable.
+ * @param idx             Component index.
+ * @param[out] outHash    The component's hash.
+ * @return false if there is no such component.
+ */
+bool DependentVariableComputeComponentHash(DependentVariableRef dv, OCIndex idx, uint64_t *outHash);
 /** @} end of Component-array Accessors */
+/**
+ * @name Deferred Component Loading
+ * @{
+ */
+/**
+ * @brief Produces a DV's components the first time they are needed.
+ *
+ * Runs at most once per installed loader, with the DV's load lock held, so
+ * it must not call the component accessors of `dv` itself.
+ *
+ * @param dv            The DependentVariable being loaded.
+ * @param context       Context passed to DependentVariableSetComponentsLoader().
+ * @param[out] outError On failure, set to a brief OCStringRef.
+ * @return A new array of OCData components, whose ownership passes to the
+ *         DV, or NULL on failure.
+ */
+typedef OCMutableArrayRef (*DependentVariableComponentsLoader)(DependentVariableRef dv,
+                                                               void *context,
+                                                               OCStringRef *outError);
+/**
+ * @brief Defer loading a DV's components until they are first accessed.
+ *
+ * The first component access (DependentVariableGetComponentAtIndex(), the
+ * value accessors, copies, serialization, ...) runs `loader`.  The guard is
+ * thread-safe: concurrent first accesses wait for a single load, and later
+ * accesses cost one atomic load.  DependentVariableSetComponents() cancels
+ * a pending load.  Install the loader before sharing the DV between threads.
+ *
+ * Until the load runs, DependentVariableGetComponentCount() and
+ * DependentVariableGetSize() report `componentCount` and `size` without
+ * loading, so these must match what `loader` returns.
+ *
+ * @param dv             Target DependentVariable.
+ * @param componentCount Number of components `loader` will produce.
+ * @param size           Elements per component `loader` will produce.
+ * @param loader         Callback producing the components.
+ * @param context        Passed to `loader`; owned by the DV on success.
+ * @param releaseContext Called on `context` once it is no longer needed
+ *                       (may be NULL).
+ * @return true on success.
+ */
+bool DependentVariableSetComponentsLoader(DependentVariableRef dv,
+                                         OCIndex componentCount,
+                                         OCIndex size,
+                                         DependentVariableComponentsLoader loader,
+                                         void *context,
+                                         void (*releaseContext)(void *));
+/**
+ * @brief Run a pending deferred load now and report how it went.
+ *
+ * Accessors cannot report load errors; a failed load leaves the DV without
+ * components and this function returns the loader's error.
+ *
+ * @param dv            Target DependentVariable.
+ * @param[out] outError On failure, set to an OCStringRef (caller releases).
+ * @return true if the components are resident.
+ */
+bool DependentVariableLoadComponents(DependentVariableRef dv, OCStringRef *outError);
+/** @brief false while a deferred load is still pending. */
+bool DependentVariableComponentsAreLoaded(DependentVariableRef dv);
+/** @} end of Deferred Component Loading */
+/**
+ * @name Deferred Operations
+ * @{
+ */
+/**
+ * @brief Record in-place element-wise operations instead of running them.
+ *
+ * While deferral is on, DependentVariableMultiplyValuesByDimensionlessRealConstant(),
+ * DependentVariableMultiplyValuesByDimensionlessComplexConstant(),
+ * DependentVariableConjugate(), DependentVariableTakeAbsoluteValue() and
+ * DependentVariableZeroPartInRange() validate their arguments and queue the
+ * operation.  The queue runs as a single pass over cache-sized blocks of
+ * each component (threaded for large variables) the next time the
+ * components, the values, or the element type are read, on
+ * DependentVariableFlushOperations(), or when deferral is switched off.
+ * Results are the same as running the operations one by one.
+ *
+ * Reads therefore mutate the DV while operations are queued: the first
+ * read rewrites the components (and, after a complex absolute value,
+ * replaces their buffers and narrows the element type), so pointers or
+ * OCDataRefs taken before it are stale.  Concurrent readers are safe,
+ * because the queue is drained once under the same lock as a deferred
+ * component load, the others waiting for it.  If the queue cannot run,
+ * readers fail as for a NULL DV (NULL, false or NaN) and it stays queued.
+ * Queueing itself is not thread-safe: record operations from one thread,
+ * with no readers running.
+ *
+ * @param dv     Target DependentVariable.
+ * @param defer  true to record operations; false flushes the queue.
+ * @return false if `dv` is NULL or the flush fails.
+ */
+bool DependentVariableSetDefersOperations(DependentVariableRef dv, bool defer);
+/** @brief true while in-place operations are being recorded. */
+bool DependentVariableDefersOperations(DependentVariableRef dv);
+/** @brief Number of recorded operations that have not run yet. */
+OCIndex DependentVariableGetQueuedOperationCount(DependentVariableRef dv);
+/**
+ * @brief Run the recorded operations now.
+ *
+ * Fails, leaving the queue in place, only if the narrowed buffers for a
+ * queued complex DependentVariableTakeAbsoluteValue() cannot be allocated.
+ *
+ * @param dv  Target DependentVariable.
+ * @return true once the queue is empty.
+ */
+bool DependentVariableFlushOperations(DependentVariableRef dv);
+/** @} end of Deferred Operations */
 /**
  * @name Size & Element Type
  * @{
@@ -343,6 +591,115 @@ float DependentVariableGetFloatValueAtMemOffsetForPart(DependentVariableRef dv,
 SIScalarRef DependentVariableCreateValueFromMemOffset(DependentVariableRef dv, OCIndex compIdx, OCIndex memOffset);
 bool DependentVariableSetValueAtMemOffset(DependentVariableRef dv, OCIndex compIdx, OCIndex memOffset, SIScalarRef value, OCStringRef *error);
 /** @} end of Low-level Value Accessors */
+/**
+ * @name Bulk Value Accessors
+ *
+ * These work on a run of `count` elements of one component starting at
+ * `memOffset` and `memStride` elements apart (1 for a contiguous run, the
+ * product of the faster dimensions' counts to walk a slower dimension,
+ * negative to walk backwards).  The element type is dispatched once per
+ * call and conversion goes through RMNConvertElements(), so loops over
+ * millions of points avoid the per-element getters' checks and switch.
+ * Unlike those getters, offsets are not wrapped: the call fails unless the
+ * whole run lies inside the component.
+ * @{
+ */
+/**
+ * @brief Read-only view of a run of elements in a component's storage.
+ *
+ * Element `i` is at `(const T *)bytes + i * stride` for the C type `T` of
+ * `type`.  The view is invalidated by anything that reallocates the
+ * component (resizing, changing the element type, replacing components).
+ */
+typedef struct {
+    const void *bytes;  ///< First element (may be NULL when count is 0).
+    OCIndex count;      ///< Number of elements.
+    OCIndex stride;     ///< Distance between elements, in elements of `type`.
+    OCNumberType type;  ///< Element type of the storage.
+} DependentVariableSpan;
+/**
+ * @brief Describe a run of elements without copying them.
+ *
+ * @param dv        The dependent variable.
+ * @param compIdx   Component index.
+ * @param memOffset Offset of the first element.
+ * @param memStride Distance between elements (non-zero).
+ * @param count     Number of elements.
+ * @param outSpan   Receives the view.
+ * @return false if the component or run is out of range.
+ * @ingroup RMNLib
+ */
+bool DependentVariableGetComponentSpan(DependentVariableRef dv, OCIndex compIdx, OCIndex memOffset,
+                                       OCIndex memStride, OCIndex count,
+                                       DependentVariableSpan *outSpan);
+/**
+ * @brief Copy a run of elements into `out`, converted to float.
+ *
+ * Complex values contribute their real part, as with
+ * DependentVariableGetFloatValueAtMemOffset().
+ *
+ * @param dv        The dependent variable.
+ * @param compIdx   Component index.
+ * @param memOffset Offset of the first element.
+ * @param memStride Distance between elements (non-zero).
+ * @param count     Number of elements.
+ * @param out       Room for `count` values.
+ * @return false if the component or run is out of range.
+ * @ingroup RMNLib
+ */
+bool DependentVariableCopyFloatValues(DependentVariableRef dv, OCIndex compIdx, OCIndex memOffset,
+                                      OCIndex memStride, OCIndex count, float *out);
+/**
+ * @brief Copy a run of elements into `out`, converted to double.
+ *
+ * Complex values contribute their real part, as with
+ * DependentVariableGetDoubleValueAtMemOffset().
+ *
+ * Parameters and result as for DependentVariableCopyFloatValues().
+ */
+bool DependentVariableCopyDoubleValues(DependentVariableRef dv, OCIndex compIdx, OCIndex memOffset,
+                                       OCIndex memStride, OCIndex count, double *out);
+/**
+ * @brief Copy a run of elements into `out`, converted to float complex.
+ *
+ * Every element type is accepted; real values get a zero imaginary part.
+ *
+ * Parameters and result as for DependentVariableCopyFloatValues().
+ */
+bool DependentVariableCopyFloatComplexValues(DependentVariableRef dv, OCIndex compIdx,
+                                             OCIndex memOffset, OCIndex memStride, OCIndex count,
+                                             float complex *out);
+/**
+ * @brief Copy a run of elements into `out`, converted to double complex.
+ *
+ * Every element type is accepted; real values get a zero imaginary part.
+ *
+ * Parameters and result as for DependentVariableCopyFloatValues().
+ */
+bool DependentVariableCopyDoubleComplexValues(DependentVariableRef dv, OCIndex compIdx,
+                                              OCIndex memOffset, OCIndex memStride, OCIndex count,
+                                              double complex *out);
+/**
+ * @brief Copy one part of a run of elements into `out` as doubles.
+ *
+ * The bulk counterpart of DependentVariableGetDoubleValueAtMemOffsetForPart():
+ * real values have a zero imaginary part, their magnitude is fabs() and
+ * their argument atan2(0, x).
+ *
+ * @param dv        The dependent variable.
+ * @param compIdx   Component index.
+ * @param memOffset Offset of the first element.
+ * @param memStride Distance between elements (non-zero).
+ * @param count     Number of elements.
+ * @param part      Real, imaginary, magnitude or argument.
+ * @param out       Room for `count` values.
+ * @return false if the component or run is out of range.
+ * @ingroup RMNLib
+ */
+bool DependentVariableCopyDoubleValuesForPart(DependentVariableRef dv, OCIndex compIdx,
+                                              OCIndex memOffset, OCIndex memStride, OCIndex count,
+                                              complexPart part, double *out);
+/** @} end of Bulk Value Accessors */
 /**
  * @brief Convert all component data in a dependent variable to a new unit.
  *        Integer‐typed dependent variables cannot be converted and will error.
@@ -410,7 +767,8 @@ bool DependentVariableTakeAbsoluteValue(DependentVariableRef dv,
                                         int64_t componentIndex);
 /**
  * @brief Multiply each value in a dependent variable (or a single component) by a dimensionless complex constant.
- *        Uses BLAS level-1 routines for optimized real and complex scaling; falls back to simple loops for integer types.
+ *        Complex types are scaled with cblas_cscal()/cblas_zscal(); real and integer types are scaled by the real part
+ *        (integers saturate, see RMNElementwiseScaleComplex()).
  * @param dv             The dependent variable whose data will be modified.
  * @param componentIndex Index of the component to process; use -1 to process all components.
  * @param constant       The dimensionless complex constant to multiply each element by.
@@ -477,9 +835,10 @@ bool DependentVariableConjugate(DependentVariableRef dv,
  *
  * This function supports signed and unsigned integer types (8/16/32/64-bit),
  * single- and double-precision real types, and single- and double-precision
- * complex types.  For integer types, each element is cast to double, scaled,
- * then cast back.  Real and complex types are scaled via the corresponding
- * CBLAS “scal” routines for maximum performance.
+ * complex types.  For integer types, each element is scaled in double
+ * precision and converted back, saturating at the type's limits.  The work
+ * runs through RMNElementwiseScaleReal(), on several threads for large
+ * components.
  *
  * @param dv
  *   The DependentVariable whose data will be modified in place.
@@ -3076,6 +3076,68 @@ OCIndex DimensionGetCount(DimensionRef dim) {
     // abstract base and any other subclasses default to a single point
     return 1;
 }
+DimensionRef DimensionCreateSubset(DimensionRef dim,
+                                   OCIndex start,
+                                   OCIndex count,
+                                   OCIndex stride,
+                                   OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    OCIndex n = DimensionGetCount(dim);
+    if (!dim || stride < 1 || count < 2 || start < 0 || start + (count - 1) * stride >= n) {
+        if (outError) *outError = STR("DimensionCreateSubset: range out of bounds or fewer than 2 points");
+        return NULL;
+    }
+    OCTypeID tid = OCGetTypeID(dim);
+    DimensionRef copy = (DimensionRef)OCTypeDeepCopy(dim);
+    if (!copy) {
+        if (outError) *outError = STR("DimensionCreateSubset: copy failed");
+        return NULL;
+    }
+    if (tid == SILinearDimensionGetTypeID()) {
+        // coordinates are offset + (i - shift)·increment, where shift is
+        // count/2 in complex-FFT order and 0 otherwise; the subset starts at
+        // `start` in plain order, so the shift folds into the new offset
+        SILinearDimensionRef lin = (SILinearDimensionRef)copy;
+        SIScalarRef oldOffset = SIDimensionGetCoordinatesOffset((SIDimensionRef)lin);
+        SIScalarRef oldIncrement = SILinearDimensionGetIncrement(lin);
+        SIUnitRef u = SIQuantityGetUnit((SIQuantityRef)oldOffset);
+        OCIndex first = start - (SILinearDimensionGetComplexFFT(lin) ? n / 2 : 0);
+        double offset = SIScalarDoubleValueInUnit(oldOffset, u, NULL) +
+                        (double)first * SIScalarDoubleValueInUnit(oldIncrement, u, NULL);
+        SIScalarRef newOffset = SIScalarCreateWithDouble(offset, u);
+        SIScalarRef newIncrement =
+            SIScalarCreateByMultiplyingByDimensionlessRealConstant(oldIncrement, (double)stride);
+        // the reciprocal describes the transform of the full sampling
+        bool ok = newOffset && newIncrement &&
+                  SIDimensionSetCoordinatesOffset((SIDimensionRef)lin, newOffset, NULL) &&
+                  SILinearDimensionSetIncrement(lin, newIncrement) &&
+                  SILinearDimensionSetCount(lin, count) &&
+                  SILinearDimensionSetComplexFFT(lin, false) &&
+                  SILinearDimensionSetReciprocal(lin, NULL, NULL);
+        OCRelease(newOffset);
+        OCRelease(newIncrement);
+        if (!ok) {
+            OCRelease(copy);
+            if (outError) *outError = STR("DimensionCreateSubset: cannot rescale linear dimension");
+            return NULL;
+        }
+    } else if (tid == SIMonotonicDimensionGetTypeID() || tid == LabeledDimensionGetTypeID()) {
+        bool monotonic = tid == SIMonotonicDimensionGetTypeID();
+        OCMutableArrayRef *values = monotonic ? &((SIMonotonicDimensionRef)copy)->coordinates
+                                              : &((LabeledDimensionRef)copy)->coordinateLabels;
+        OCMutableArrayRef picked = OCArrayCreateMutable(count, &kOCTypeArrayCallBacks);
+        if (!picked) {
+            OCRelease(copy);
+            if (outError) *outError = STR("DimensionCreateSubset: allocation failed");
+            return NULL;
+        }
+        for (OCIndex i = 0; i < count; ++i)
+            OCArrayAppendValue(picked, OCArrayGetValueAtIndex(*values, start + i * stride));
+        OCRelease(*values);
+        *values = picked;
+    }
+    return copy;
+}
 OCStringRef CreateDimensionLongLabel(DimensionRef dim, OCIndex index) {
     if (!dim)
         return NULL;
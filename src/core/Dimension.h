@@ -646,6 +646,27 @@ DimensionRef DimensionCreateFromJSON(cJSON *json,
  * @return Non-negative count, or 0 if invalid.
  */
 OCIndex DimensionGetCount(DimensionRef dim);
+/**
+ * @brief Create a copy of a Dimension restricted to every `stride`-th
+ *        coordinate from `start`, `count` coordinates in all.
+ *
+ * Linear dimensions get a shifted coordinates offset and a scaled
+ * increment, with a complex-FFT ordering folded into the offset (the
+ * subset is in plain order) and any reciprocal dimension dropped, since
+ * it describes the full sampling.  Monotonic and labeled dimensions keep
+ * the picked entries.
+ * @param dim      Source dimension.
+ * @param start    First coordinate index.
+ * @param count    Number of coordinates (≥2).
+ * @param stride   Index step (≥1).
+ * @param outError On failure, receives a descriptive OCStringRef.
+ * @return New DimensionRef, or NULL on failure. Caller must release.
+ */
+DimensionRef DimensionCreateSubset(DimensionRef dim,
+                                   OCIndex start,
+                                   OCIndex count,
+                                   OCIndex stride,
+                                   OCStringRef *outError);
 /**
  * @brief Create a human-readable label for a specific coordinate index.
  *
@@ -0,0 +1,348 @@
+// BatchConvert.c
+#include "BatchConvert.h"
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#if !defined(_MSC_VER)
+#define RMN_HAVE_PTHREADS 1
+#include <pthread.h>
+#endif
+#if defined(_WIN32)
+#include <direct.h>
+#define MKDIR(path) _mkdir(path)
+#define PATH_SEPARATOR '\\'
+#else
+#define MKDIR(path) mkdir(path, 0755)
+#define PATH_SEPARATOR '/'
+#endif
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+static double impl_Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+/// Pick the importer for `path` by extension; NULL if none applies.
+typedef DatasetRef (*impl_Importer)(OCDataRef contents, OCStringRef *error);
+static impl_Importer impl_ImporterForPath(const char *path) {
+    const char *dot = strrchr(path, '.');
+    const char *sep = strrchr(path, '/');
+    if (!dot || (sep && dot < sep)) return NULL;
+    const char *ext = dot + 1;
+    if (strcasecmp(ext, "tnt") == 0) return DatasetImportTecmagCreateWithFileData;
+    if (strcasecmp(ext, "jdx") == 0 || strcasecmp(ext, "dx") == 0 || strcasecmp(ext, "jcamp") == 0)
+        return DatasetImportJCAMPCreateSignalWithData;
+    static const char *const images[] = {"png", "jpg", "jpeg", "bmp", "gif", "tga"};
+    for (size_t i = 0; i < sizeof(images) / sizeof(images[0]); ++i)
+        if (strcasecmp(ext, images[i]) == 0) return DatasetImportImageCreateSignalWithData;
+    return NULL;
+}
+#pragma region Prefetch
+/// Per-file state shared by the reader threads and the converting thread.
+typedef enum { kSlotPending, kSlotReading, kSlotReady } impl_SlotState;
+typedef struct {
+    impl_SlotState state;
+    uint64_t size;  // from stat(); what the file is charged against the budget
+    uint8_t *bytes;
+    size_t length;
+    bool readOK;
+    bool collides;  // an earlier input has the same output name
+    double readSeconds;
+} impl_Slot;
+typedef struct {
+    const char *const *paths;
+    size_t count;
+    impl_Slot *slots;
+    size_t next;        // next file to claim; files are claimed in list order
+    uint64_t reserved;  // bytes charged against the budget
+    uint64_t budget;    // 0 for no limit
+#if RMN_HAVE_PTHREADS
+    bool threaded;  // lock and changed are initialized
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+#endif
+} impl_Batch;
+static void impl_Lock(impl_Batch *b) {
+#if RMN_HAVE_PTHREADS
+    if (b->threaded) pthread_mutex_lock(&b->lock);
+#else
+    (void)b;
+#endif
+}
+static void impl_Unlock(impl_Batch *b) {
+#if RMN_HAVE_PTHREADS
+    if (b->threaded) pthread_mutex_unlock(&b->lock);
+#else
+    (void)b;
+#endif
+}
+static void impl_Broadcast(impl_Batch *b) {
+#if RMN_HAVE_PTHREADS
+    if (b->threaded) pthread_cond_broadcast(&b->changed);
+#else
+    (void)b;
+#endif
+}
+static bool impl_Fits(const impl_Batch *b, size_t i) {
+    return b->budget == 0 || b->reserved == 0 || b->reserved + b->slots[i].size <= b->budget;
+}
+/// Load one file into plain memory; no OCTypes objects are touched.
+static void impl_ReadSlot(impl_Batch *b, size_t i) {
+    impl_Slot *s = &b->slots[i];
+    double t0 = impl_Now();
+    FILE *f = fopen(b->paths[i], "rb");
+    s->bytes = f ? malloc(s->size ? (size_t)s->size : 1) : NULL;
+    s->length = s->bytes ? fread(s->bytes, 1, (size_t)s->size, f) : 0;
+    s->readOK = s->bytes && s->length == (size_t)s->size;
+    if (f) fclose(f);
+    s->readSeconds = impl_Now() - t0;
+    impl_Lock(b);
+    s->state = kSlotReady;
+    impl_Broadcast(b);
+    impl_Unlock(b);
+}
+#if RMN_HAVE_PTHREADS
+static void *impl_ReaderMain(void *context) {
+    impl_Batch *b = context;
+    for (;;) {
+        pthread_mutex_lock(&b->lock);
+        while (b->next < b->count && !impl_Fits(b, b->next))
+            pthread_cond_wait(&b->changed, &b->lock);
+        if (b->next >= b->count) {
+            pthread_mutex_unlock(&b->lock);
+            return NULL;
+        }
+        size_t i = b->next++;
+        b->slots[i].state = kSlotReading;
+        b->reserved += b->slots[i].size;
+        pthread_mutex_unlock(&b->lock);
+        impl_ReadSlot(b, i);
+    }
+}
+#endif
+/// Wait for file `i`, reading it on this thread if no reader has claimed
+/// it yet (readers claim in order, so nothing after it is held either).
+static void impl_AwaitSlot(impl_Batch *b, size_t i) {
+    impl_Lock(b);
+    if (b->slots[i].state == kSlotPending) {
+        b->next = i + 1;
+        b->slots[i].state = kSlotReading;
+        b->reserved += b->slots[i].size;
+        impl_Unlock(b);
+        impl_ReadSlot(b, i);
+        return;
+    }
+#if RMN_HAVE_PTHREADS
+    while (b->threaded && b->slots[i].state != kSlotReady) pthread_cond_wait(&b->changed, &b->lock);
+#endif
+    impl_Unlock(b);
+}
+static void impl_ReleaseSlot(impl_Batch *b, size_t i) {
+    impl_Lock(b);
+    free(b->slots[i].bytes);
+    b->slots[i].bytes = NULL;
+    b->reserved -= b->slots[i].size;
+    impl_Broadcast(b);
+    impl_Unlock(b);
+}
+#pragma endregion Prefetch
+/// The part of `input` an output is named after: its file name without the
+/// extension.  Returns the name and sets `*length`.
+static const char *impl_OutputStem(const char *input, int *length) {
+    const char *name = strrchr(input, '/');
+#if defined(_WIN32)
+    const char *bs = strrchr(input, '\\');
+    if (bs && (!name || bs > name)) name = bs;
+#endif
+    name = name ? name + 1 : input;
+    const char *dot = strrchr(name, '.');
+    *length = dot && dot != name ? (int)(dot - name) : (int)strlen(name);
+    return name;
+}
+/// Output path: `outputDir`/<input file name with `extension`>.
+static bool impl_OutputPath(const char *input, const char *outputDir, const char *extension,
+                            char *out, size_t size) {
+    int stem = 0;
+    const char *name = impl_OutputStem(input, &stem);
+    int len = snprintf(out, size, "%s%c%.*s.%s", outputDir, PATH_SEPARATOR, stem, name, extension);
+    return len > 0 && (size_t)len < size;
+}
+typedef struct {
+    const char *stem;
+    int length;
+    size_t index;
+} impl_StemEntry;
+/// Stems compare case-insensitively, since the output directory may be on
+/// a case-insensitive file system; ties keep list order.
+static int impl_CompareStems(const void *a, const void *b) {
+    const impl_StemEntry *x = a, *y = b;
+    int n = x->length < y->length ? x->length : y->length;
+    int c = strncasecmp(x->stem, y->stem, (size_t)n);
+    if (c == 0) c = (x->length > y->length) - (x->length < y->length);
+    if (c == 0) c = (x->index > y->index) - (x->index < y->index);
+    return c;
+}
+/// Mark every convertible input whose output name an earlier one already
+/// takes, so that it fails instead of overwriting that output.
+static bool impl_MarkCollisions(const char *const *paths, size_t count, impl_Slot *slots) {
+    impl_StemEntry *entries = malloc((count ? count : 1) * sizeof(*entries));
+    if (!entries) return false;
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!impl_ImporterForPath(paths[i])) continue;
+        entries[n].stem = impl_OutputStem(paths[i], &entries[n].length);
+        entries[n].index = i;
+        ++n;
+    }
+    qsort(entries, n, sizeof(*entries), impl_CompareStems);
+    for (size_t k = 1; k < n; ++k) {
+        const impl_StemEntry *prev = &entries[k - 1], *cur = &entries[k];
+        if (prev->length == cur->length &&
+            strncasecmp(prev->stem, cur->stem, (size_t)cur->length) == 0)
+            slots[cur->index].collides = true;
+    }
+    free(entries);
+    return true;
+}
+/// Import and export one loaded file on the calling thread.
+static void impl_ConvertSlot(const char *path, const impl_Slot *slot, const char *outputDir,
+                             DatasetBatchResult *r) {
+    impl_Importer importer = impl_ImporterForPath(path);
+    if (!importer) {
+        r->error = STR("Unrecognized file extension");
+        return;
+    }
+    if (slot->collides) {
+        r->error = STR("Output name already used by an earlier input");
+        return;
+    }
+    if (!slot->readOK) {
+        r->error = STR("Cannot read input file");
+        return;
+    }
+    double t0 = impl_Now();
+    OCDataRef contents = OCDataCreate(slot->bytes, (uint64_t)slot->length);
+    OCStringRef err = NULL;
+    DatasetRef ds = contents ? importer(contents, &err) : NULL;
+    OCRelease(contents);
+    r->importSeconds = impl_Now() - t0;
+    if (!ds) {
+        r->error = err ? err : STR("Import failed");
+        return;
+    }
+    bool hasExternal = false;
+    for (OCIndex i = 0; i < DatasetGetDependentVariableCount(ds); ++i)
+        hasExternal |= DependentVariableShouldSerializeExternally(DatasetGetDependentVariableAtIndex(ds, i));
+    char outPath[PATH_MAX];
+    if (!impl_OutputPath(path, outputDir, hasExternal ? "csdfe" : "csdf", outPath, sizeof(outPath))) {
+        OCRelease(ds);
+        r->error = STR("Output path too long");
+        return;
+    }
+    t0 = impl_Now();
+    r->ok = DatasetExport(ds, outPath, outputDir, &err);
+    r->exportSeconds = impl_Now() - t0;
+    OCRelease(ds);
+    if (!r->ok) {
+        r->error = err ? err : STR("Export failed");
+        return;
+    }
+    struct stat st;
+    if (stat(outPath, &st) == 0) r->outputBytes = (uint64_t)st.st_size;
+}
+bool DatasetBatchConvert(const char *const *paths,
+                         size_t count,
+                         const char *outputDir,
+                         size_t memoryBudget,
+                         OCIndex readers,
+                         DatasetBatchResult *results,
+                         OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if ((!paths && count) || !outputDir) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    struct stat dirInfo;
+    if (stat(outputDir, &dirInfo) != 0 && (MKDIR(outputDir) != 0 && errno != EEXIST)) {
+        if (outError) *outError = STR("Cannot create output directory");
+        return false;
+    }
+    impl_Batch batch = {.paths = paths, .count = count, .budget = memoryBudget};
+    batch.slots = calloc(count ? count : 1, sizeof(*batch.slots));
+    DatasetBatchResult *local = results ? NULL : calloc(count ? count : 1, sizeof(*local));
+    DatasetBatchResult *res = results ? results : local;
+    if (!batch.slots || !res) {
+        free(batch.slots);
+        free(local);
+        if (outError) *outError = STR("Memory allocation error");
+        return false;
+    }
+    memset(res, 0, count * sizeof(*res));
+    if (!impl_MarkCollisions(paths, count, batch.slots)) {
+        free(batch.slots);
+        free(local);
+        if (outError) *outError = STR("Memory allocation error");
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        struct stat st;
+        // unreadable, unsupported or colliding inputs cost nothing and fail
+        // in conversion
+        if (impl_ImporterForPath(paths[i]) && !batch.slots[i].collides && stat(paths[i], &st) == 0)
+            batch.slots[i].size = (uint64_t)st.st_size;
+    }
+    // 1) start the readers
+#if RMN_HAVE_PTHREADS
+    size_t nthreads = 0;
+    size_t wanted = readers > 0 ? (size_t)readers : RMNParallelProcessorCount();
+    if (wanted > count) wanted = count;
+    pthread_t *threads = calloc(wanted ? wanted : 1, sizeof(*threads));
+    bool synced = threads && pthread_mutex_init(&batch.lock, NULL) == 0;
+    if (synced && pthread_cond_init(&batch.changed, NULL) != 0) {
+        pthread_mutex_destroy(&batch.lock);
+        synced = false;
+    }
+    batch.threaded = synced;
+    while (synced && nthreads < wanted &&
+           pthread_create(&threads[nthreads], NULL, impl_ReaderMain, &batch) == 0)
+        ++nthreads;
+#else
+    (void)readers;
+#endif
+    // 2) convert in list order; files nobody has read yet are read here
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        impl_AwaitSlot(&batch, i);
+        res[i].inputBytes = batch.slots[i].size;
+        res[i].readSeconds = batch.slots[i].readSeconds;
+        impl_ConvertSlot(paths[i], &batch.slots[i], outputDir, &res[i]);
+        impl_ReleaseSlot(&batch, i);
+        if (!res[i].ok) ++failed;
+    }
+#if RMN_HAVE_PTHREADS
+    for (size_t t = 0; t < nthreads; ++t) pthread_join(threads[t], NULL);
+    if (synced) {
+        pthread_cond_destroy(&batch.changed);
+        pthread_mutex_destroy(&batch.lock);
+    }
+    free(threads);
+#endif
+    free(batch.slots);
+    if (local) DatasetBatchResultsClear(local, count);
+    free(local);
+    if (failed && outError) {
+        *outError = OCStringCreateWithFormat(STR("%ld of %ld files failed to convert"),
+                                             (long)failed, (long)count);
+    }
+    return failed == 0;
+}
+void DatasetBatchResultsClear(DatasetBatchResult *results, size_t count) {
+    for (size_t i = 0; results && i < count; ++i) {
+        if (results[i].error) OCRelease(results[i].error);
+        results[i].error = NULL;
+    }
+}
@@ -0,0 +1,85 @@
+// BatchConvert.h
+#ifndef BATCHCONVERT_H
+#define BATCHCONVERT_H
+
+#include "../RMNLibrary.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file BatchConvert.h
+ * @brief Convert many instrument files to CSDM in one call.
+ *
+ * Each input is imported with the importer its extension selects and
+ * exported next to the others in an output directory:
+ *
+ * | Extension                          | Importer                                    |
+ * |------------------------------------|---------------------------------------------|
+ * | .tnt                               | DatasetImportTecmagCreateWithFileData()     |
+ * | .jdx, .dx, .jcamp                  | DatasetImportJCAMPCreateSignalWithData()    |
+ * | .png, .jpg, .jpeg, .bmp, .gif, .tga | DatasetImportImageCreateSignalWithData()    |
+ *
+ * Reader threads load input files ahead of the conversion, taking files
+ * off a shared queue in list order, while the caller's thread imports and
+ * exports each file in turn; OCTypes objects are not thread-safe, so all
+ * of that work stays on one thread.  If the readers fall behind, the
+ * converting thread reads the next file itself.  Export blob I/O still
+ * uses DatasetSetIOWorkerCount() and RMNAsyncIO.
+ */
+
+/** @brief Outcome and timings of one file in a batch. */
+typedef struct {
+    bool ok;
+    /** Why the file failed, or NULL; see DatasetBatchResultsClear(). */
+    OCStringRef error;
+    uint64_t inputBytes;
+    /** Size of the written .csdf/.csdfe document (blobs not included). */
+    uint64_t outputBytes;
+    double readSeconds;    ///< loading the input file
+    double importSeconds;  ///< building the Dataset
+    double exportSeconds;  ///< writing the CSDM files
+} DatasetBatchResult;
+
+/**
+ * @brief Convert `count` files to CSDM files in `outputDir`.
+ *
+ * Each output is named after its input's file name, with the extension
+ * replaced by ".csdf", or ".csdfe" when the Dataset has external
+ * variables; external blobs go next to it.  Inputs whose file names match
+ * apart from the extension (ignoring case) would share an output: only the
+ * first of them in `paths` is converted, and the others fail without
+ * touching its output.  A failed file does not stop the batch.
+ *
+ * `memoryBudget` bounds the input bytes held at once: a file counts from
+ * when a reader starts loading it until its conversion ends, and readers
+ * wait while the next file would exceed the budget.  A file larger than
+ * the budget is still converted, alone.  The Datasets built during
+ * conversion are not counted.
+ *
+ * @param paths        Input files.
+ * @param count        Number of input files.
+ * @param outputDir    Directory for the outputs; created if missing.
+ * @param memoryBudget Input bytes held at once, or 0 for no limit.
+ * @param readers      Reader threads: 0 for one per online processor.
+ * @param results      `count` entries, filled in order (may be NULL).
+ * @param[out] outError Set to a brief OCStringRef unless every file converted.
+ * @return true if every file converted.
+ */
+bool DatasetBatchConvert(const char *const *paths,
+                         size_t count,
+                         const char *outputDir,
+                         size_t memoryBudget,
+                         OCIndex readers,
+                         DatasetBatchResult *results,
+                         OCStringRef *outError);
+
+/** @brief Release the error strings held by `count` results. */
+void DatasetBatchResultsClear(DatasetBatchResult *results, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BATCHCONVERT_H
@@ -0,0 +1,183 @@
+// RMNAsyncIO.c
+#include "RMNAsyncIO.h"
+#include <errno.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#ifdef RMN_HAVE_LIBURING
+#include <liburing.h>
+#endif
+static RMNAsyncIOBackend gRMNAsyncIOBackend = kRMNAsyncIOUring;
+void RMNAsyncIOSetBackend(RMNAsyncIOBackend backend) {
+    gRMNAsyncIOBackend = backend;
+}
+static size_t impl_Min(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+#ifdef RMN_HAVE_LIBURING
+// io_uring may be compiled in yet disabled by the kernel or a seccomp
+// filter; probe once with a tiny ring (-1 unknown, 0 no, 1 yes)
+static int gRMNAsyncIOUringUsable = -1;
+static bool impl_UringUsable(void) {
+    if (gRMNAsyncIOUringUsable < 0) {
+        struct io_uring ring;
+        gRMNAsyncIOUringUsable = io_uring_queue_init(1, &ring, 0) == 0;
+        if (gRMNAsyncIOUringUsable) io_uring_queue_exit(&ring);
+    }
+    return gRMNAsyncIOUringUsable;
+}
+#endif
+RMNAsyncIOBackend RMNAsyncIOGetBackend(void) {
+#ifdef RMN_HAVE_LIBURING
+    if (gRMNAsyncIOBackend == kRMNAsyncIOUring && impl_UringUsable()) return kRMNAsyncIOUring;
+#endif
+    return kRMNAsyncIOThreads;
+}
+#pragma region Threads
+static long long impl_Transfer(RMNAsyncIORequest *r, uint64_t done, size_t n) {
+    uint8_t *p = (uint8_t *)r->bytes + done;
+#if defined(_WIN32)
+    // no pread() here: RMNAsyncIORun() keeps Windows batches on one thread
+    if (_lseeki64(r->fd, (__int64)(r->offset + done), SEEK_SET) < 0) return -1;
+    unsigned chunk = (unsigned)impl_Min(n, (size_t)1 << 30);
+    return r->write ? _write(r->fd, p, chunk) : _read(r->fd, p, chunk);
+#else
+    off_t at = (off_t)(r->offset + done);
+    return r->write ? (long long)pwrite(r->fd, p, n, at) : (long long)pread(r->fd, p, n, at);
+#endif
+}
+static void impl_RunRequest(void *context, size_t index) {
+    RMNAsyncIORequest *r = (RMNAsyncIORequest *)context + index;
+    uint64_t done = 0;
+    r->ok = true;
+    while (done < r->length) {
+        long long got = impl_Transfer(r, done, impl_Min(r->length - done, kRMNAsyncIOSegmentSize));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) {
+            r->ok = false;  // error, or end of file on a read
+            return;
+        }
+        done += (uint64_t)got;
+    }
+}
+#pragma endregion Threads
+#ifdef RMN_HAVE_LIBURING
+#pragma region io_uring
+/// A piece of one request in flight; resubmitted in place after a short
+/// transfer.
+typedef struct {
+    size_t request;
+    uint64_t offset;  // within the request
+    size_t length;
+} impl_Segment;
+static void impl_QueueSegment(struct io_uring *ring, RMNAsyncIORequest *requests, impl_Segment *s) {
+    RMNAsyncIORequest *r = &requests[s->request];
+    struct io_uring_sqe *sqe = io_uring_get_sqe(ring);
+    uint8_t *p = (uint8_t *)r->bytes + s->offset;
+    if (r->write)
+        io_uring_prep_write(sqe, r->fd, p, (unsigned)s->length, r->offset + s->offset);
+    else
+        io_uring_prep_read(sqe, r->fd, p, (unsigned)s->length, r->offset + s->offset);
+    io_uring_sqe_set_data(sqe, s);
+}
+/// Returns false only if the ring could not be set up, so the caller can
+/// fall back to threads; request failures are reported through `ok`.
+static bool impl_RunUring(RMNAsyncIORequest *requests, size_t count, size_t depth) {
+    struct io_uring ring;
+    impl_Segment *slots = calloc(depth, sizeof(*slots));
+    impl_Segment **idle = calloc(depth, sizeof(*idle));
+    uint64_t *remaining = calloc(count ? count : 1, sizeof(*remaining));
+    if (!slots || !idle || !remaining || io_uring_queue_init((unsigned)depth, &ring, 0) < 0) {
+        free(slots);
+        free(idle);
+        free(remaining);
+        return false;
+    }
+    size_t nidle = depth, inflight = 0;
+    for (size_t i = 0; i < depth; ++i) idle[i] = &slots[i];
+    for (size_t i = 0; i < count; ++i) {
+        requests[i].ok = true;
+        remaining[i] = requests[i].length;
+    }
+    size_t next = 0;      // request being split into segments
+    uint64_t cursor = 0;  // offset within it
+    for (;;) {
+        // 1) keep the ring full
+        while (nidle > 0 && next < count) {
+            RMNAsyncIORequest *r = &requests[next];
+            if (cursor >= r->length || !r->ok) {
+                ++next;
+                cursor = 0;
+                continue;
+            }
+            impl_Segment *s = idle[--nidle];
+            s->request = next;
+            s->offset = cursor;
+            s->length = impl_Min(r->length - cursor, kRMNAsyncIOSegmentSize);
+            cursor += s->length;
+            impl_QueueSegment(&ring, requests, s);
+            ++inflight;
+        }
+        if (inflight == 0) break;
+        // 2) reap what has completed, resuming short transfers
+        int rc = io_uring_submit_and_wait(&ring, 1);
+        if (rc < 0 && rc != -EINTR) {
+            for (size_t i = 0; i < count; ++i) requests[i].ok = false;
+            break;
+        }
+        struct io_uring_cqe *cqe;
+        while (io_uring_peek_cqe(&ring, &cqe) == 0) {
+            impl_Segment *s = io_uring_cqe_get_data(cqe);
+            int res = cqe->res;
+            io_uring_cqe_seen(&ring, cqe);
+            --inflight;
+            if (res == -EINTR || res == -EAGAIN) {
+                impl_QueueSegment(&ring, requests, s);
+                ++inflight;
+                continue;
+            }
+            if (res <= 0) {
+                requests[s->request].ok = false;
+            } else {
+                remaining[s->request] -= (uint64_t)res;
+                if ((size_t)res < s->length) {
+                    s->offset += (uint64_t)res;
+                    s->length -= (size_t)res;
+                    impl_QueueSegment(&ring, requests, s);
+                    ++inflight;
+                    continue;
+                }
+            }
+            idle[nidle++] = s;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) requests[i].ok = requests[i].ok && remaining[i] == 0;
+    io_uring_queue_exit(&ring);
+    free(slots);
+    free(idle);
+    free(remaining);
+    return true;
+}
+#pragma endregion io_uring
+#endif
+bool RMNAsyncIORun(RMNAsyncIORequest *requests, size_t count, size_t depth) {
+    if (!requests && count) return false;
+    if (depth < 1) depth = 1;
+    bool ran = false;
+#ifdef RMN_HAVE_LIBURING
+    if (RMNAsyncIOGetBackend() == kRMNAsyncIOUring) ran = impl_RunUring(requests, count, depth);
+#endif
+    if (!ran) {
+#if defined(_WIN32)
+        depth = 1;  // seek + read shares the descriptor's file position
+#endif
+        RMNParallelFor(count, depth, impl_RunRequest, requests);
+    }
+    bool ok = true;
+    for (size_t i = 0; i < count; ++i) ok = ok && requests[i].ok;
+    return ok;
+}
@@ -0,0 +1,64 @@
+// RMNAsyncIO.h
+#ifndef RMNASYNCIO_H
+#define RMNASYNCIO_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNAsyncIO.h
+ * @brief Batched positioned reads and writes with many requests in flight.
+ *
+ * A batch is a list of independent transfers between memory and open file
+ * descriptors.  On Linux builds with liburing (RMN_HAVE_LIBURING) the batch
+ * is driven through one io_uring, keeping up to `depth` transfers queued in
+ * the kernel; otherwise, or when the kernel refuses io_uring, `depth`
+ * threads issue pread()/pwrite() (see RMNParallel.h).  Large requests are
+ * split into kRMNAsyncIOSegmentSize pieces and short transfers are resumed,
+ * so callers see whole-request success or failure.
+ *
+ * Like RMNParallelFor(), a batch touches only the caller's memory and file
+ * descriptors, never OCTypes objects.
+ */
+/** Largest single transfer handed to the kernel. */
+#define kRMNAsyncIOSegmentSize ((size_t)1 << 22)
+/** @brief How batches are executed. */
+typedef enum {
+    kRMNAsyncIOThreads = 0,  ///< pread()/pwrite() on a thread pool
+    kRMNAsyncIOUring,        ///< Linux io_uring
+} RMNAsyncIOBackend;
+/** @brief One transfer of a batch. */
+typedef struct {
+    int fd;           ///< open file descriptor
+    bool write;       ///< false reads into `bytes`, true writes from it
+    uint64_t offset;  ///< file offset of the first byte
+    void *bytes;      ///< `length` bytes of caller memory
+    size_t length;
+    bool ok;          ///< set when the batch returns
+} RMNAsyncIORequest;
+/**
+ * @brief Prefer a backend for later batches.
+ *
+ * kRMNAsyncIOUring (the default) falls back to threads when liburing was
+ * not compiled in or io_uring is unavailable at run time.  Not
+ * thread-safe; set it before starting I/O.
+ */
+void RMNAsyncIOSetBackend(RMNAsyncIOBackend backend);
+/** @brief The backend the next batch will use. */
+RMNAsyncIOBackend RMNAsyncIOGetBackend(void);
+/**
+ * @brief Run every request and wait for all of them.
+ *
+ * A read past end of file fails its request.  Requests must not overlap
+ * in memory, nor in a file they write.
+ *
+ * @param requests  Transfers to perform; each `ok` is set.
+ * @param count     Number of requests.
+ * @param depth     Transfers (or threads) in flight at once; at least 1.
+ * @return true if every request succeeded.
+ */
+bool RMNAsyncIORun(RMNAsyncIORequest *requests, size_t count, size_t depth);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNASYNCIO_H */
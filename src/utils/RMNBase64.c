@@ -0,0 +1,282 @@
+// RMNBase64.c
+#include "RMNBase64.h"
+#include <string.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RMN_BASE64_X86 1
+#include <immintrin.h>
+#endif
+static const char kRMNBase64Alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+size_t RMNBase64EncodedLength(size_t length) {
+    return ((length + 2) / 3) * 4;
+}
+#pragma region SIMD Kernels
+// Each kernel handles a whole number of blocks and returns how many input
+// bytes/characters it consumed; the scalar code finishes the tail.
+#if RMN_BASE64_X86
+// Muła & Lemire, "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" (ACM TOW 2018): pshufb-based sextet split, character
+// translation by range offsets, and nibble-bitmask validation.
+#define RMN_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define RMN_TARGET_AVX2 __attribute__((target("avx2")))
+RMN_TARGET_SSE41 static inline __m128i impl_SplitSextets128(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+RMN_TARGET_SSE41 static inline __m128i impl_SextetsToASCII128(__m128i idx) {
+    // 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+    __m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+    r = _mm_or_si128(r, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                        '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, r), idx);
+}
+RMN_TARGET_SSE41 static size_t impl_EncodeSSE41(const uint8_t *bytes, size_t length, char *out) {
+    size_t i = 0;
+    // 12 bytes in, 16 characters out; the load reads 4 bytes ahead
+    for (; i + 16 <= length; i += 12, out += 16) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(bytes + i));
+        _mm_storeu_si128((__m128i *)out, impl_SextetsToASCII128(impl_SplitSextets128(in)));
+    }
+    return i;
+}
+// Nonzero if any of the 16 characters is outside the alphabet.
+RMN_TARGET_SSE41 static inline int impl_ASCIIToSextets128(__m128i in, __m128i *out) {
+    __m128i hi = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+    __m128i lo = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+    const __m128i shiftLUT = _mm_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    // valid high nibbles for each low nibble, one bit per high nibble 0..7
+    const __m128i maskLUT = _mm_setr_epi8((char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8,
+                                          (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+                                          (char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50,
+                                          0x50, 0x54);
+    const __m128i bitLUT = _mm_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80,
+                                         0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i shift = _mm_shuffle_epi8(shiftLUT, hi);
+    shift = _mm_blendv_epi8(shift, _mm_set1_epi8(16), _mm_cmpeq_epi8(in, _mm_set1_epi8('/')));
+    __m128i valid = _mm_and_si128(_mm_shuffle_epi8(maskLUT, lo), _mm_shuffle_epi8(bitLUT, hi));
+    *out = _mm_add_epi8(in, shift);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(valid, _mm_setzero_si128()));
+}
+RMN_TARGET_SSE41 static inline __m128i impl_PackSextets128(__m128i v) {
+    __m128i ab = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+    __m128i abc = _mm_madd_epi16(ab, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(abc, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+RMN_TARGET_SSE41 static size_t impl_DecodeSSE41(const char *text, size_t length, uint8_t *out, bool *bad) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16, out += 12) {
+        __m128i v;
+        if (impl_ASCIIToSextets128(_mm_loadu_si128((const __m128i *)(text + i)), &v)) {
+            *bad = true;
+            return i;
+        }
+        v = impl_PackSextets128(v);
+        _mm_storel_epi64((__m128i *)out, v);
+        uint32_t w = (uint32_t)_mm_extract_epi32(v, 2);
+        memcpy(out + 8, &w, sizeof(w));
+    }
+    return i;
+}
+RMN_TARGET_AVX2 static size_t impl_EncodeAVX2(const uint8_t *bytes, size_t length, char *out) {
+    size_t i = 0;
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                           '/' - 63, 'A', 0, 0,
+                                           'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                           '/' - 63, 'A', 0, 0);
+    // 24 bytes in (two 12-byte lanes), 32 characters out
+    for (; i + 28 <= length; i += 24, out += 32) {
+        __m256i in = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(bytes + i))),
+            _mm_loadu_si128((const __m128i *)(bytes + i + 12)), 1);
+        in = _mm256_shuffle_epi8(in, shuf);
+        __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i idx = _mm256_or_si256(t1, t3);
+        __m256i r = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx);
+        r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        r = _mm256_add_epi8(_mm256_shuffle_epi8(shift, r), idx);
+        _mm256_storeu_si256((__m256i *)out, r);
+    }
+    return i;
+}
+RMN_TARGET_AVX2 static size_t impl_DecodeAVX2(const char *text, size_t length, uint8_t *out, bool *bad) {
+    const __m256i shiftLUT = _mm256_setr_epi8(0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i maskLUT = _mm256_setr_epi8(
+        (char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+        (char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54,
+        (char)0xa8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8, (char)0xf8,
+        (char)0xf8, (char)0xf8, (char)0xf0, 0x54, 0x50, 0x50, 0x50, 0x54);
+    const __m256i bitLUT = _mm256_setr_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80,
+                                            0, 0, 0, 0, 0, 0, 0, 0,
+                                            0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80,
+                                            0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    // 32 characters in, 24 bytes out
+    for (; i + 32 <= length; i += 32, out += 24) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(text + i));
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi32(in, 4), _mm256_set1_epi8(0x0f));
+        __m256i lo = _mm256_and_si256(in, _mm256_set1_epi8(0x0f));
+        __m256i valid = _mm256_and_si256(_mm256_shuffle_epi8(maskLUT, lo),
+                                         _mm256_shuffle_epi8(bitLUT, hi));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(valid, _mm256_setzero_si256()))) {
+            *bad = true;
+            return i;
+        }
+        __m256i shift = _mm256_shuffle_epi8(shiftLUT, hi);
+        shift = _mm256_blendv_epi8(shift, _mm256_set1_epi8(16),
+                                   _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')));
+        __m256i v = _mm256_add_epi8(in, shift);
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+        v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+        v = _mm256_shuffle_epi8(v, pack);
+        v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm_storeu_si128((__m128i *)out, _mm256_castsi256_si128(v));
+        _mm_storel_epi64((__m128i *)(out + 16), _mm256_extracti128_si256(v, 1));
+    }
+    return i;
+}
+#endif
+static RMNBase64Kernel impl_BestKernel(void) {
+#if RMN_BASE64_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return kRMNBase64KernelAVX2;
+    if (__builtin_cpu_supports("sse4.1")) return kRMNBase64KernelSSE41;
+#endif
+    return kRMNBase64KernelScalar;
+}
+// -1 until first use; the race on first use is benign (same value stored)
+static volatile int gRMNBase64Kernel = -1;
+static RMNBase64Kernel impl_ActiveKernel(void) {
+    int k = gRMNBase64Kernel;
+    if (k < 0) gRMNBase64Kernel = k = (int)impl_BestKernel();
+    return (RMNBase64Kernel)k;
+}
+RMNBase64Kernel RMNBase64GetKernel(void) {
+    return impl_ActiveKernel();
+}
+bool RMNBase64SetKernel(RMNBase64Kernel kernel) {
+    RMNBase64Kernel best = impl_BestKernel();
+    if (kernel == kRMNBase64KernelAuto) kernel = best;
+    if (kernel > best) return false;
+    gRMNBase64Kernel = (int)kernel;
+    return true;
+}
+#pragma endregion SIMD Kernels
+size_t RMNBase64Encode(const uint8_t *bytes, size_t length, char *out) {
+    if (!out || (!bytes && length)) return 0;
+    size_t i = 0;
+    char *p = out;
+#if RMN_BASE64_X86
+    switch (impl_ActiveKernel()) {
+        case kRMNBase64KernelAVX2:
+            i = impl_EncodeAVX2(bytes, length, p);
+            break;
+        case kRMNBase64KernelSSE41:
+            i = impl_EncodeSSE41(bytes, length, p);
+            break;
+        default:
+            break;
+    }
+    p += i / 3 * 4;
+#endif
+    for (; i + 3 <= length; i += 3) {
+        uint32_t v = ((uint32_t)bytes[i] << 16) | ((uint32_t)bytes[i + 1] << 8) | bytes[i + 2];
+        *p++ = kRMNBase64Alphabet[(v >> 18) & 0x3F];
+        *p++ = kRMNBase64Alphabet[(v >> 12) & 0x3F];
+        *p++ = kRMNBase64Alphabet[(v >> 6) & 0x3F];
+        *p++ = kRMNBase64Alphabet[v & 0x3F];
+    }
+    size_t rem = length - i;
+    if (rem) {
+        uint32_t v = (uint32_t)bytes[i] << 16;
+        if (rem == 2) v |= (uint32_t)bytes[i + 1] << 8;
+        *p++ = kRMNBase64Alphabet[(v >> 18) & 0x3F];
+        *p++ = kRMNBase64Alphabet[(v >> 12) & 0x3F];
+        *p++ = rem == 2 ? kRMNBase64Alphabet[(v >> 6) & 0x3F] : '=';
+        *p++ = '=';
+    }
+    return (size_t)(p - out);
+}
+// sextet value + 1 for alphabet characters, 0 for anything else
+static const uint8_t kRMNBase64DecodeTable[256] = {
+    ['A'] = 1, ['B'] = 2, ['C'] = 3, ['D'] = 4, ['E'] = 5, ['F'] = 6,
+    ['G'] = 7, ['H'] = 8, ['I'] = 9, ['J'] = 10, ['K'] = 11, ['L'] = 12,
+    ['M'] = 13, ['N'] = 14, ['O'] = 15, ['P'] = 16, ['Q'] = 17, ['R'] = 18,
+    ['S'] = 19, ['T'] = 20, ['U'] = 21, ['V'] = 22, ['W'] = 23, ['X'] = 24,
+    ['Y'] = 25, ['Z'] = 26, ['a'] = 27, ['b'] = 28, ['c'] = 29, ['d'] = 30,
+    ['e'] = 31, ['f'] = 32, ['g'] = 33, ['h'] = 34, ['i'] = 35, ['j'] = 36,
+    ['k'] = 37, ['l'] = 38, ['m'] = 39, ['n'] = 40, ['o'] = 41, ['p'] = 42,
+    ['q'] = 43, ['r'] = 44, ['s'] = 45, ['t'] = 46, ['u'] = 47, ['v'] = 48,
+    ['w'] = 49, ['x'] = 50, ['y'] = 51, ['z'] = 52, ['0'] = 53, ['1'] = 54,
+    ['2'] = 55, ['3'] = 56, ['4'] = 57, ['5'] = 58, ['6'] = 59, ['7'] = 60,
+    ['8'] = 61, ['9'] = 62, ['+'] = 63, ['/'] = 64,
+};
+size_t RMNBase64DecodedLength(const char *text, size_t length) {
+    if (!text) return 0;
+    for (int pad = 0; pad < 2 && length > 0 && text[length - 1] == '='; ++pad) --length;
+    if (length % 4 == 1) return 0;
+    return (length / 4) * 3 + (length % 4 ? length % 4 - 1 : 0);
+}
+bool RMNBase64Decode(const char *text, size_t length, uint8_t *out, size_t *outLength) {
+    if (outLength) *outLength = 0;
+    if (!text || !out) return false;
+    for (int pad = 0; pad < 2 && length > 0 && text[length - 1] == '='; ++pad) --length;
+    if (length % 4 == 1) return false;
+    const unsigned char *s = (const unsigned char *)text;
+    uint8_t *p = out;
+    size_t i = 0;
+#if RMN_BASE64_X86
+    bool bad = false;
+    switch (impl_ActiveKernel()) {
+        case kRMNBase64KernelAVX2:
+            i = impl_DecodeAVX2(text, length, p, &bad);
+            break;
+        case kRMNBase64KernelSSE41:
+            i = impl_DecodeSSE41(text, length, p, &bad);
+            break;
+        default:
+            break;
+    }
+    if (bad) return false;
+    p += i / 4 * 3;
+#endif
+    for (; i + 4 <= length; i += 4) {
+        uint32_t a = kRMNBase64DecodeTable[s[i]], b = kRMNBase64DecodeTable[s[i + 1]],
+                 c = kRMNBase64DecodeTable[s[i + 2]], d = kRMNBase64DecodeTable[s[i + 3]];
+        if (!a || !b || !c || !d) return false;
+        uint32_t v = ((a - 1) << 18) | ((b - 1) << 12) | ((c - 1) << 6) | (d - 1);
+        *p++ = (uint8_t)(v >> 16);
+        *p++ = (uint8_t)(v >> 8);
+        *p++ = (uint8_t)v;
+    }
+    size_t rem = length - i;
+    if (rem) {
+        uint32_t v = 0;
+        for (size_t k = 0; k < rem; ++k) {
+            uint32_t x = kRMNBase64DecodeTable[s[i + k]];
+            if (!x) return false;
+            v |= (x - 1) << (18 - 6 * k);
+        }
+        *p++ = (uint8_t)(v >> 16);
+        if (rem == 3) *p++ = (uint8_t)(v >> 8);
+    }
+    if (outLength) *outLength = (size_t)(p - out);
+    return true;
+}
@@ -0,0 +1,91 @@
+// RMNBase64.h
+#ifndef RMNBASE64_H
+#define RMNBASE64_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNBase64.h
+ * @brief Standard (RFC 4648) base64 codec working on caller-owned buffers.
+ *
+ * These routines never allocate; they let serializers encode component
+ * payloads in fixed-size chunks (streaming export) and decode directly into
+ * preallocated component storage.  Output is byte-identical to
+ * OCDataCreateBase64EncodedString() with OCBase64EncodingOptionsNone:
+ * standard alphabet, '=' padding, no line breaks.
+ */
+/**
+ * @brief Base64 kernels, in increasing order of capability.
+ *
+ * The best kernel the CPU supports is picked on first use (x86: AVX2, then
+ * SSE4.1); all kernels produce identical output.
+ */
+typedef enum {
+    kRMNBase64KernelAuto = -1,  ///< Select the best supported kernel.
+    kRMNBase64KernelScalar = 0, ///< Portable table-driven code.
+    kRMNBase64KernelSSE41,      ///< 16 characters per step (SSSE3/SSE4.1).
+    kRMNBase64KernelAVX2,       ///< 32 characters per step.
+} RMNBase64Kernel;
+/**
+ * @brief Kernel currently used by RMNBase64Encode() and RMNBase64Decode().
+ */
+RMNBase64Kernel RMNBase64GetKernel(void);
+/**
+ * @brief Force a kernel (for benchmarking and testing).
+ *
+ * Not thread-safe with respect to concurrent encode/decode calls.
+ *
+ * @param kernel  Kernel to use, or kRMNBase64KernelAuto.
+ * @return false if the CPU does not support `kernel`.
+ */
+bool RMNBase64SetKernel(RMNBase64Kernel kernel);
+/**
+ * @brief Number of characters needed to encode `length` bytes (with padding).
+ *
+ * @param length  Number of input bytes.
+ * @return        4 * ceil(length / 3).
+ */
+size_t RMNBase64EncodedLength(size_t length);
+/**
+ * @brief Encode `length` bytes into `out`.
+ *
+ * When encoding a long buffer in pieces, every piece except the last must
+ * have a length that is a multiple of 3 so that no padding is emitted
+ * mid-stream.
+ *
+ * @param bytes   Input bytes (may be NULL when length is 0).
+ * @param length  Number of input bytes.
+ * @param out     Destination with room for RMNBase64EncodedLength(length)
+ *                characters.  No terminating NUL is written.
+ * @return        Number of characters written.
+ */
+size_t RMNBase64Encode(const uint8_t *bytes, size_t length, char *out);
+/**
+ * @brief Exact number of bytes that `length` characters of base64 decode to.
+ *
+ * Trailing '=' padding is accounted for; unpadded input is accepted.
+ *
+ * @param text    Base64 text (need not be NUL-terminated).
+ * @param length  Number of characters.
+ * @return        Decoded size, or 0 if `length` cannot be valid base64.
+ */
+size_t RMNBase64DecodedLength(const char *text, size_t length);
+/**
+ * @brief Decode base64 text into a caller-owned buffer.
+ *
+ * Accepts only the standard alphabet with optional trailing padding; any
+ * other character (including whitespace) makes the call fail so callers
+ * can fall back to a more lenient decoder.
+ *
+ * @param text          Base64 text (need not be NUL-terminated).
+ * @param length        Number of characters.
+ * @param out           Destination with room for RMNBase64DecodedLength() bytes.
+ * @param[out] outLength If non-NULL, set to the number of bytes written.
+ * @return true on success, false on invalid input.
+ */
+bool RMNBase64Decode(const char *text, size_t length, uint8_t *out, size_t *outLength);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNBASE64_H */
@@ -0,0 +1,367 @@
+// RMNChunkedLayout.c
+#include "RMNChunkedLayout.h"
+#include <string.h>
+#define kRMNChunkedMagic "RMNCHUNK"
+#define kRMNChunkedVersion 1
+#define kRMNChunkedFixedHeaderSize 32  // magic, version, rank, elemSize, componentCount
+typedef struct {
+    uint32_t rank;
+    uint64_t elemSize;
+    uint64_t componentCount;
+    uint64_t shape[kRMNChunkedLayoutMaxRank];
+    uint64_t chunk[kRMNChunkedLayoutMaxRank];
+    uint64_t grid[kRMNChunkedLayoutMaxRank];  // chunks along each dimension
+    uint64_t chunkCount;                      // chunks per component
+    uint64_t indexOffset;                     // first index entry
+} impl_ChunkedHeader;
+static void impl_PutU32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+static void impl_PutU64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+static uint32_t impl_GetU32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+static uint64_t impl_GetU64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+/// Fill in the derived fields; false if the geometry is unusable.
+static bool impl_FinishHeader(impl_ChunkedHeader *h) {
+    if (h->rank < 1 || h->rank > kRMNChunkedLayoutMaxRank || h->elemSize == 0) return false;
+    h->chunkCount = 1;
+    for (uint32_t d = 0; d < h->rank; ++d) {
+        if (h->shape[d] == 0 || h->chunk[d] == 0) return false;
+        if (h->chunk[d] > h->shape[d]) h->chunk[d] = h->shape[d];
+        h->grid[d] = (h->shape[d] + h->chunk[d] - 1) / h->chunk[d];
+        h->chunkCount *= h->grid[d];
+    }
+    h->indexOffset = kRMNChunkedFixedHeaderSize + 16 * (uint64_t)h->rank;
+    return true;
+}
+static bool impl_ParseHeader(const uint8_t *p, size_t length, impl_ChunkedHeader *h) {
+    if (length < kRMNChunkedFixedHeaderSize || memcmp(p, kRMNChunkedMagic, 8) != 0) return false;
+    if (impl_GetU32(p + 8) != kRMNChunkedVersion) return false;
+    h->rank = impl_GetU32(p + 12);
+    h->elemSize = impl_GetU64(p + 16);
+    h->componentCount = impl_GetU64(p + 24);
+    if (h->rank < 1 || h->rank > kRMNChunkedLayoutMaxRank) return false;
+    if (length < kRMNChunkedFixedHeaderSize + 16 * (size_t)h->rank) return false;
+    for (uint32_t d = 0; d < h->rank; ++d) {
+        h->shape[d] = impl_GetU64(p + kRMNChunkedFixedHeaderSize + 8 * d);
+        h->chunk[d] = impl_GetU64(p + kRMNChunkedFixedHeaderSize + 8 * (h->rank + d));
+    }
+    return impl_FinishHeader(h);
+}
+/// Origin and (edge-clipped) extent of chunk `t` in grid coordinates.
+static uint64_t impl_ChunkBox(const impl_ChunkedHeader *h, uint64_t t, uint64_t *lo, uint64_t *ext) {
+    uint64_t n = 1;
+    for (uint32_t d = 0; d < h->rank; ++d) {
+        lo[d] = (t % h->grid[d]) * h->chunk[d];
+        t /= h->grid[d];
+        ext[d] = h->shape[d] - lo[d] < h->chunk[d] ? h->shape[d] - lo[d] : h->chunk[d];
+        n *= ext[d];
+    }
+    return n;
+}
+/// Copy the box [boxLo, boxHi) between two dense N-D arrays, each given by
+/// its origin and extent in grid coordinates (dimension 0 fastest).
+static void impl_CopyBox(uint8_t *dst, const uint64_t *dstLo, const uint64_t *dstExt,
+                         const uint8_t *src, const uint64_t *srcLo, const uint64_t *srcExt,
+                         const uint64_t *boxLo, const uint64_t *boxHi,
+                         uint32_t rank, size_t elemSize) {
+    uint64_t idx[kRMNChunkedLayoutMaxRank];
+    for (uint32_t d = 0; d < rank; ++d) {
+        if (boxHi[d] <= boxLo[d]) return;
+        idx[d] = boxLo[d];
+    }
+    size_t run = (size_t)(boxHi[0] - boxLo[0]) * elemSize;
+    for (;;) {
+        uint64_t so = 0, dof = 0, ss = 1, ds = 1;
+        for (uint32_t d = 0; d < rank; ++d) {
+            so += (idx[d] - srcLo[d]) * ss;
+            dof += (idx[d] - dstLo[d]) * ds;
+            ss *= srcExt[d];
+            ds *= dstExt[d];
+        }
+        memcpy(dst + dof * elemSize, src + so * elemSize, run);
+        uint32_t d = 1;
+        for (; d < rank; ++d) {
+            if (++idx[d] < boxHi[d]) break;
+            idx[d] = boxLo[d];
+        }
+        if (d >= rank) break;
+    }
+}
+static bool impl_FileSink(void *context, const void *bytes, size_t length) {
+    return fwrite(bytes, 1, length, (FILE *)context) == length;
+}
+bool RMNChunkedLayoutWrite(FILE *stream,
+                           OCArrayRef components,
+                           OCIndex rank,
+                           const OCIndex *shape,
+                           const OCIndex *chunkShape,
+                           size_t elementSize) {
+    return stream && RMNChunkedLayoutWriteToSink(impl_FileSink, stream, components, rank, shape,
+                                                 chunkShape, elementSize);
+}
+bool RMNChunkedLayoutWriteToSink(bool (*sink)(void *context, const void *bytes, size_t length),
+                                 void *context,
+                                 OCArrayRef components,
+                                 OCIndex rank,
+                                 const OCIndex *shape,
+                                 const OCIndex *chunkShape,
+                                 size_t elementSize) {
+    if (!sink || !components || !shape || !chunkShape || rank < 1 ||
+        rank > kRMNChunkedLayoutMaxRank)
+        return false;
+    impl_ChunkedHeader h = {.rank = (uint32_t)rank,
+                            .elemSize = elementSize,
+                            .componentCount = (uint64_t)OCArrayGetCount(components)};
+    for (OCIndex d = 0; d < rank; ++d) {
+        if (shape[d] <= 0 || chunkShape[d] <= 0) return false;
+        h.shape[d] = (uint64_t)shape[d];
+        h.chunk[d] = (uint64_t)chunkShape[d];
+    }
+    if (!impl_FinishHeader(&h)) return false;
+    uint64_t points = 1, chunkPoints = 1;
+    for (uint32_t d = 0; d < h.rank; ++d) {
+        points *= h.shape[d];
+        chunkPoints *= h.chunk[d];
+    }
+    for (uint64_t c = 0; c < h.componentCount; ++c) {
+        OCDataRef data = (OCDataRef)OCArrayGetValueAtIndex(components, (OCIndex)c);
+        if ((uint64_t)OCDataGetLength(data) != points * elementSize) return false;
+    }
+    // header and index up front: chunk sizes are known, so offsets are too
+    size_t indexBytes = (size_t)(16 * h.componentCount * h.chunkCount);
+    size_t headBytes = (size_t)h.indexOffset + indexBytes;
+    uint8_t *head = malloc(headBytes);
+    uint8_t *chunk = malloc((size_t)chunkPoints * elementSize);
+    bool ok = head && chunk;
+    if (ok) {
+        memcpy(head, kRMNChunkedMagic, 8);
+        impl_PutU32(head + 8, kRMNChunkedVersion);
+        impl_PutU32(head + 12, h.rank);
+        impl_PutU64(head + 16, h.elemSize);
+        impl_PutU64(head + 24, h.componentCount);
+        for (uint32_t d = 0; d < h.rank; ++d) {
+            impl_PutU64(head + kRMNChunkedFixedHeaderSize + 8 * d, h.shape[d]);
+            impl_PutU64(head + kRMNChunkedFixedHeaderSize + 8 * (h.rank + d), h.chunk[d]);
+        }
+        uint64_t lo[kRMNChunkedLayoutMaxRank], ext[kRMNChunkedLayoutMaxRank];
+        uint64_t offset = headBytes;
+        uint8_t *entry = head + h.indexOffset;
+        for (uint64_t c = 0; c < h.componentCount; ++c) {
+            for (uint64_t t = 0; t < h.chunkCount; ++t, entry += 16) {
+                uint64_t len = impl_ChunkBox(&h, t, lo, ext) * elementSize;
+                impl_PutU64(entry, offset);
+                impl_PutU64(entry + 8, len);
+                offset += len;
+            }
+        }
+        ok = sink(context, head, headBytes);
+        // gather each chunk out of its flat component, then write it
+        const uint64_t zero[kRMNChunkedLayoutMaxRank] = {0};
+        for (uint64_t c = 0; ok && c < h.componentCount; ++c) {
+            const uint8_t *src =
+                OCDataGetBytesPtr((OCDataRef)OCArrayGetValueAtIndex(components, (OCIndex)c));
+            for (uint64_t t = 0; ok && t < h.chunkCount; ++t) {
+                uint64_t n = impl_ChunkBox(&h, t, lo, ext);
+                uint64_t hi[kRMNChunkedLayoutMaxRank];
+                for (uint32_t d = 0; d < h.rank; ++d) hi[d] = lo[d] + ext[d];
+                impl_CopyBox(chunk, lo, ext, src, zero, h.shape, lo, hi, h.rank, elementSize);
+                size_t len = (size_t)n * elementSize;
+                ok = sink(context, chunk, len);
+            }
+        }
+    }
+    free(head);
+    free(chunk);
+    return ok;
+}
+bool RMNChunkedLayoutDecode(const uint8_t *bytes,
+                            size_t length,
+                            size_t elementSize,
+                            size_t pointCount,
+                            uint8_t *const *targets,
+                            size_t componentCount) {
+    impl_ChunkedHeader h;
+    if (!bytes || !targets || !impl_ParseHeader(bytes, length, &h)) return false;
+    uint64_t points = 1;
+    for (uint32_t d = 0; d < h.rank; ++d) points *= h.shape[d];
+    if (h.elemSize != elementSize || h.componentCount != componentCount || points != pointCount)
+        return false;
+    if (length < h.indexOffset + 16 * h.componentCount * h.chunkCount) return false;
+    const uint64_t zero[kRMNChunkedLayoutMaxRank] = {0};
+    uint64_t lo[kRMNChunkedLayoutMaxRank], ext[kRMNChunkedLayoutMaxRank], hi[kRMNChunkedLayoutMaxRank];
+    const uint8_t *entry = bytes + h.indexOffset;
+    for (uint64_t c = 0; c < h.componentCount; ++c) {
+        for (uint64_t t = 0; t < h.chunkCount; ++t, entry += 16) {
+            uint64_t offset = impl_GetU64(entry), len = impl_GetU64(entry + 8);
+            uint64_t n = impl_ChunkBox(&h, t, lo, ext);
+            if (len != n * elementSize || offset > length || length - offset < len) return false;
+            for (uint32_t d = 0; d < h.rank; ++d) hi[d] = lo[d] + ext[d];
+            impl_CopyBox(targets[c], zero, h.shape, bytes + offset, lo, ext, lo, hi, h.rank,
+                         elementSize);
+        }
+    }
+    return true;
+}
+static bool impl_ReadAt(FILE *f, uint64_t offset, void *buf, size_t len) {
+#if defined(_WIN32)
+    if (_fseeki64(f, (long long)offset, SEEK_SET) != 0) return false;
+#else
+    if (fseeko(f, (off_t)offset, SEEK_SET) != 0) return false;
+#endif
+    return fread(buf, 1, len, f) == len;
+}
+/// Read the header of a chunked blob that starts `base` bytes into `f`.
+static bool impl_ReadHeader(FILE *f, uint64_t base, impl_ChunkedHeader *h) {
+    uint8_t head[kRMNChunkedFixedHeaderSize + 16 * kRMNChunkedLayoutMaxRank];
+#if defined(_WIN32)
+    if (_fseeki64(f, (long long)base, SEEK_SET) != 0) return false;
+#else
+    if (fseeko(f, (off_t)base, SEEK_SET) != 0) return false;
+#endif
+    size_t got = fread(head, 1, sizeof(head), f);
+    return impl_ParseHeader(head, got, h);
+}
+static bool impl_HyperslabInRange(const impl_ChunkedHeader *h,
+                                  const OCIndex *start,
+                                  const OCIndex *count) {
+    for (uint32_t d = 0; d < h->rank; ++d)
+        if (start[d] < 0 || count[d] <= 0 || (uint64_t)(start[d] + count[d]) > h->shape[d])
+            return false;
+    return true;
+}
+/// Copy the box [start, start + count) of one component into `out`,
+/// reading only the index entries and chunks it touches.
+static bool impl_ReadHyperslab(FILE *f,
+                               uint64_t base,
+                               const impl_ChunkedHeader *hp,
+                               OCIndex componentIndex,
+                               const OCIndex *start,
+                               const OCIndex *count,
+                               uint8_t *out) {
+    const impl_ChunkedHeader h = *hp;
+    uint64_t lo[kRMNChunkedLayoutMaxRank], hi[kRMNChunkedLayoutMaxRank], ext[kRMNChunkedLayoutMaxRank];
+    uint64_t cLo[kRMNChunkedLayoutMaxRank], cHi[kRMNChunkedLayoutMaxRank], c[kRMNChunkedLayoutMaxRank];
+    uint64_t chunkPoints = 1;
+    for (uint32_t d = 0; d < h.rank; ++d) {
+        lo[d] = (uint64_t)start[d];
+        hi[d] = lo[d] + (uint64_t)count[d];
+        ext[d] = (uint64_t)count[d];
+        cLo[d] = lo[d] / h.chunk[d];
+        cHi[d] = (hi[d] - 1) / h.chunk[d];
+        c[d] = cLo[d];
+        chunkPoints *= h.chunk[d];
+    }
+    // this component's index, then only the chunks the box touches
+    size_t indexBytes = (size_t)(16 * h.chunkCount);
+    uint8_t *index = malloc(indexBytes);
+    uint8_t *chunk = malloc((size_t)(chunkPoints * h.elemSize));
+    bool ok = index && chunk &&
+              impl_ReadAt(f, base + h.indexOffset + (uint64_t)componentIndex * indexBytes, index,
+                          indexBytes);
+    while (ok) {
+        uint64_t t = 0, stride = 1;
+        for (uint32_t d = 0; d < h.rank; ++d) {
+            t += c[d] * stride;
+            stride *= h.grid[d];
+        }
+        uint64_t tLo[kRMNChunkedLayoutMaxRank], tExt[kRMNChunkedLayoutMaxRank];
+        uint64_t bLo[kRMNChunkedLayoutMaxRank], bHi[kRMNChunkedLayoutMaxRank];
+        uint64_t n = impl_ChunkBox(&h, t, tLo, tExt);
+        uint64_t offset = impl_GetU64(index + 16 * t), len = impl_GetU64(index + 16 * t + 8);
+        if (len != n * h.elemSize || !impl_ReadAt(f, base + offset, chunk, (size_t)len)) {
+            ok = false;
+            break;
+        }
+        for (uint32_t d = 0; d < h.rank; ++d) {
+            bLo[d] = lo[d] > tLo[d] ? lo[d] : tLo[d];
+            bHi[d] = hi[d] < tLo[d] + tExt[d] ? hi[d] : tLo[d] + tExt[d];
+        }
+        impl_CopyBox(out, lo, ext, chunk, tLo, tExt, bLo, bHi, h.rank, (size_t)h.elemSize);
+        uint32_t d = 0;
+        for (; d < h.rank; ++d) {
+            if (++c[d] <= cHi[d]) break;
+            c[d] = cLo[d];
+        }
+        if (d >= h.rank) break;
+    }
+    free(index);
+    free(chunk);
+    return ok;
+}
+OCDataRef RMNChunkedLayoutCreateHyperslab(const char *path,
+                                          OCIndex componentIndex,
+                                          OCIndex rank,
+                                          const OCIndex *start,
+                                          const OCIndex *count,
+                                          OCStringRef *outError) {
+    if (outError) *outError = NULL;
+    if (!path || !start || !count || rank < 1 || rank > kRMNChunkedLayoutMaxRank) {
+        if (outError) *outError = STR("Invalid hyper-slab arguments");
+        return NULL;
+    }
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        if (outError) *outError = STR("Cannot open chunked blob");
+        return NULL;
+    }
+    impl_ChunkedHeader h;
+    if (!impl_ReadHeader(f, 0, &h)) {
+        fclose(f);
+        if (outError) *outError = STR("Not a chunked blob");
+        return NULL;
+    }
+    if ((OCIndex)h.rank != rank || componentIndex < 0 ||
+        (uint64_t)componentIndex >= h.componentCount) {
+        fclose(f);
+        if (outError) *outError = STR("Hyper-slab rank or component does not match chunked blob");
+        return NULL;
+    }
+    if (!impl_HyperslabInRange(&h, start, count)) {
+        fclose(f);
+        if (outError) *outError = STR("Hyper-slab out of range");
+        return NULL;
+    }
+    uint64_t points = 1;
+    for (uint32_t d = 0; d < h.rank; ++d) points *= (uint64_t)count[d];
+    OCMutableDataRef out = OCDataCreateMutable((uint64_t)(points * h.elemSize));
+    bool ok = out != NULL;
+    if (ok) {
+        OCDataSetLength(out, (uint64_t)(points * h.elemSize));
+        ok = impl_ReadHyperslab(f, 0, &h, componentIndex, start, count,
+                                OCDataGetMutableBytes(out));
+    }
+    fclose(f);
+    if (!ok) {
+        OCRelease(out);
+        if (outError) *outError = STR("Error reading chunked blob");
+        return NULL;
+    }
+    return (OCDataRef)out;
+}
+bool RMNChunkedLayoutReadHyperslab(FILE *stream,
+                                   uint64_t baseOffset,
+                                   OCIndex componentIndex,
+                                   OCIndex rank,
+                                   const OCIndex *start,
+                                   const OCIndex *count,
+                                   size_t elementSize,
+                                   uint8_t *out) {
+    if (!stream || !start || !count || !out || rank < 1 || rank > kRMNChunkedLayoutMaxRank)
+        return false;
+    impl_ChunkedHeader h;
+    if (!impl_ReadHeader(stream, baseOffset, &h)) return false;
+    if ((OCIndex)h.rank != rank || h.elemSize != elementSize || componentIndex < 0 ||
+        (uint64_t)componentIndex >= h.componentCount || !impl_HyperslabInRange(&h, start, count))
+        return false;
+    return impl_ReadHyperslab(stream, baseOffset, &h, componentIndex, start, count, out);
+}
@@ -0,0 +1,155 @@
+// RMNChunkedLayout.h
+#ifndef RMNCHUNKEDLAYOUT_H
+#define RMNCHUNKEDLAYOUT_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNChunkedLayout.h
+ * @brief Chunked (tiled) layout for external dependent-variable blobs.
+ *
+ * This is an RMNLib extension to CSDM.  A dependent variable opts in by
+ * carrying, in its "application" metadata, the entry
+ *
+ * @code
+ * "rmnlib.chunked_layout": { "version": 1, "chunk_shape": [c0, c1, ...] }
+ * @endcode
+ *
+ * (see DependentVariableSetChunkShape()).  Its external blob is then not
+ * the plain concatenation of components but a self-describing file:
+ *
+ * | Field                         | Type (little-endian)          |
+ * |-------------------------------|-------------------------------|
+ * | magic "RMNCHUNK"              | 8 bytes                       |
+ * | version (1)                   | uint32                        |
+ * | rank                          | uint32                        |
+ * | element size in bytes         | uint64                        |
+ * | component count               | uint64                        |
+ * | shape[rank]                   | uint64 each                   |
+ * | chunk_shape[rank]             | uint64 each                   |
+ * | index[components × chunks]    | uint64 offset, uint64 length  |
+ * | chunk data                    | raw elements                  |
+ *
+ * Chunks tile the grid in CSDM order (dimension 0 fastest), both in the
+ * index and for the elements inside each chunk; chunks on the upper edge
+ * are clipped to the grid.  The index lets a reader fetch only the chunks
+ * that intersect a hyper-slab (RMNChunkedLayoutCreateHyperslab()).
+ */
+/** Key of the layout entry in a dependent variable's "application" metadata. */
+#define kRMNChunkedLayoutMetaDataKey "rmnlib.chunked_layout"
+/** Key of the chunk shape array inside the layout entry. */
+#define kRMNChunkedLayoutChunkShapeKey "chunk_shape"
+/** Key of the layout version inside the layout entry. */
+#define kRMNChunkedLayoutVersionKey "version"
+/** Highest rank the layout supports. */
+#define kRMNChunkedLayoutMaxRank 32
+/**
+ * @brief Write components in the chunked layout.
+ *
+ * Does not allocate OCTypes objects, so it may run on a worker thread.
+ *
+ * @param stream        Destination, opened for binary writing.
+ * @param components    OCArray of OCData, one per component, each holding
+ *                      product(shape) elements in CSDM order.
+ * @param rank          Number of dimensions (1..kRMNChunkedLayoutMaxRank).
+ * @param shape         Grid size along each dimension.
+ * @param chunkShape    Chunk size along each dimension (values larger than
+ *                      the grid are clipped).
+ * @param elementSize   Bytes per element.
+ * @return true on success, false on bad arguments or a write error.
+ */
+bool RMNChunkedLayoutWrite(FILE *stream,
+                           OCArrayRef components,
+                           OCIndex rank,
+                           const OCIndex *shape,
+                           const OCIndex *chunkShape,
+                           size_t elementSize);
+/**
+ * @brief RMNChunkedLayoutWrite() to a callback instead of a stream.
+ *
+ * The header and index arrive in one call, then each chunk in its own, in
+ * file order; callers use it to checksum or buffer the bytes as written.
+ *
+ * @param sink     Receives the bytes; returns false to abort.  Same
+ *                 signature as RMNCodecSink.
+ * @param context  Passed to `sink`.
+ * @return true on success, false on bad arguments or when `sink` fails.
+ */
+bool RMNChunkedLayoutWriteToSink(bool (*sink)(void *context, const void *bytes, size_t length),
+                                 void *context,
+                                 OCArrayRef components,
+                                 OCIndex rank,
+                                 const OCIndex *shape,
+                                 const OCIndex *chunkShape,
+                                 size_t elementSize);
+/**
+ * @brief Unpack a whole chunked blob into flat component buffers.
+ *
+ * Does not allocate OCTypes objects, so it may run on a worker thread.
+ *
+ * @param bytes           The blob (e.g. a memory-mapped file).
+ * @param length          Blob size in bytes.
+ * @param elementSize     Expected bytes per element.
+ * @param pointCount      Expected elements per component.
+ * @param targets         One destination per component, each with room for
+ *                        pointCount × elementSize bytes.
+ * @param componentCount  Expected number of components.
+ * @return false if the blob is malformed or does not match the expectation.
+ */
+bool RMNChunkedLayoutDecode(const uint8_t *bytes,
+                            size_t length,
+                            size_t elementSize,
+                            size_t pointCount,
+                            uint8_t *const *targets,
+                            size_t componentCount);
+/**
+ * @brief Read one component's hyper-slab from a chunked blob file.
+ *
+ * Only the header, the component's chunk index and the chunks that
+ * intersect the requested box are read.
+ *
+ * @param path            Blob file.
+ * @param componentIndex  Component to read.
+ * @param rank            Number of dimensions; must match the file.
+ * @param start           First index along each dimension.
+ * @param count           Number of indexes along each dimension.
+ * @param[out] outError   On failure, set to a brief OCStringRef.
+ * @return New OCData holding product(count) elements in CSDM order
+ *         (dimension 0 fastest), or NULL on failure.
+ */
+OCDataRef RMNChunkedLayoutCreateHyperslab(const char *path,
+                                          OCIndex componentIndex,
+                                          OCIndex rank,
+                                          const OCIndex *start,
+                                          const OCIndex *count,
+                                          OCStringRef *outError);
+/**
+ * @brief Read one component's hyper-slab into a caller-owned buffer.
+ *
+ * Like RMNChunkedLayoutCreateHyperslab(), but reads from an open stream in
+ * which the blob starts `baseOffset` bytes in (e.g. a container section),
+ * and allocates no OCTypes objects, so it may run on a worker thread.
+ *
+ * @param stream          Stream opened for binary reading.
+ * @param baseOffset      Offset of the blob within `stream`.
+ * @param componentIndex  Component to read.
+ * @param rank            Number of dimensions; must match the blob.
+ * @param start           First index along each dimension.
+ * @param count           Number of indexes along each dimension.
+ * @param elementSize     Expected bytes per element.
+ * @param out             Room for product(count) × elementSize bytes.
+ * @return false if the blob is malformed, does not match, or cannot be read.
+ */
+bool RMNChunkedLayoutReadHyperslab(FILE *stream,
+                                   uint64_t baseOffset,
+                                   OCIndex componentIndex,
+                                   OCIndex rank,
+                                   const OCIndex *start,
+                                   const OCIndex *count,
+                                   size_t elementSize,
+                                   uint8_t *out);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNCHUNKEDLAYOUT_H */
@@ -0,0 +1,395 @@
+// RMNCodec.c
+#include "RMNCodec.h"
+#include <limits.h>
+#include <string.h>
+#ifdef RMN_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RMN_HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef RMN_HAVE_LZ4
+#include <lz4frame.h>
+#endif
+#define kRMNCodecBlockSize 65536  // shuffle block and streaming buffer size
+#define kRMNCodecZstdLevel 3      // zstd's own default: fast, good ratio
+static size_t impl_Min(size_t a, size_t b) {
+    return a < b ? a : b;
+}
+static size_t impl_ShuffleBlockBytes(size_t elementSize) {
+    return kRMNCodecBlockSize / elementSize * elementSize;
+}
+/// Byte i of element j goes to row i, column j; a ragged tail is copied as is.
+static void impl_Shuffle(const uint8_t *src, uint8_t *dst, size_t length, size_t elementSize) {
+    size_t n = length / elementSize;
+    for (size_t b = 0; b < elementSize; ++b)
+        for (size_t i = 0; i < n; ++i) dst[b * n + i] = src[i * elementSize + b];
+    memcpy(dst + n * elementSize, src + n * elementSize, length - n * elementSize);
+}
+static void impl_Unshuffle(const uint8_t *src, uint8_t *dst, size_t length, size_t elementSize) {
+    size_t n = length / elementSize;
+    for (size_t b = 0; b < elementSize; ++b)
+        for (size_t i = 0; i < n; ++i) dst[i * elementSize + b] = src[b * n + i];
+    memcpy(dst + n * elementSize, src + n * elementSize, length - n * elementSize);
+}
+bool RMNCodecParseEncoding(const char *encoding, RMNCodec *outCodec, bool *outShuffle) {
+    if (!encoding) return false;
+    size_t prefix = strlen(kRMNCodecShufflePrefix);
+    bool shuffle = strncmp(encoding, kRMNCodecShufflePrefix, prefix) == 0;
+    const char *name = shuffle ? encoding + prefix : encoding;
+    RMNCodec codec = strcmp(name, "deflate") == 0 ? kRMNCodecDeflate
+                     : strcmp(name, "zstd") == 0  ? kRMNCodecZstd
+                     : strcmp(name, "lz4") == 0   ? kRMNCodecLZ4
+                                                  : kRMNCodecNone;
+    if (codec == kRMNCodecNone) return false;
+    if (outCodec) *outCodec = codec;
+    if (outShuffle) *outShuffle = shuffle;
+    return true;
+}
+bool RMNCodecIsAvailable(RMNCodec codec) {
+    switch (codec) {
+#ifdef RMN_HAVE_ZLIB
+        case kRMNCodecDeflate: return true;
+#endif
+#ifdef RMN_HAVE_ZSTD
+        case kRMNCodecZstd: return true;
+#endif
+#ifdef RMN_HAVE_LZ4
+        case kRMNCodecLZ4: return true;
+#endif
+        default: return false;
+    }
+}
+size_t RMNCodecShuffleWidth(OCNumberType elementType) {
+    size_t size = OCNumberTypeSize(elementType);
+    bool isComplex = elementType == kOCNumberComplex64Type || elementType == kOCNumberComplex128Type;
+    return isComplex ? size / 2 : size;
+}
+#pragma region Encoding
+/// Feeds a component to a codec one block at a time, shuffling each block
+/// into `scratch` first when requested.
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t offset;
+    size_t block;
+    size_t elementSize;
+    uint8_t *scratch;  // NULL without shuffle
+} impl_BlockReader;
+static const uint8_t *impl_NextBlock(impl_BlockReader *r, size_t *outLength, bool *outLast) {
+    size_t n = impl_Min(r->block, r->length - r->offset);
+    const uint8_t *in = r->bytes + r->offset;
+    if (r->scratch) {
+        impl_Shuffle(in, r->scratch, n, r->elementSize);
+        in = r->scratch;
+    }
+    r->offset += n;
+    *outLength = n;
+    *outLast = r->offset >= r->length;
+    return in;
+}
+#ifdef RMN_HAVE_ZLIB
+static bool impl_EncodeDeflate(impl_BlockReader *r, RMNCodecSink sink, void *context) {
+    uint8_t *out = malloc(kRMNCodecBlockSize);
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (!out || deflateInit(&z, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        free(out);
+        return false;
+    }
+    bool ok = true, last = false;
+    while (ok && !last) {
+        size_t n = 0;
+        z.next_in = (Bytef *)impl_NextBlock(r, &n, &last);
+        z.avail_in = (uInt)n;
+        int rc;
+        do {
+            z.next_out = out;
+            z.avail_out = kRMNCodecBlockSize;
+            rc = deflate(&z, last ? Z_FINISH : Z_NO_FLUSH);
+            size_t produced = kRMNCodecBlockSize - z.avail_out;
+            if (rc == Z_STREAM_ERROR || (produced && !sink(context, out, produced))) ok = false;
+        } while (ok && (last ? rc != Z_STREAM_END : z.avail_out == 0));
+    }
+    deflateEnd(&z);
+    free(out);
+    return ok;
+}
+#endif
+#ifdef RMN_HAVE_ZSTD
+static bool impl_EncodeZstd(impl_BlockReader *r, RMNCodecSink sink, void *context) {
+    uint8_t *out = malloc(kRMNCodecBlockSize);
+    ZSTD_CCtx *cctx = ZSTD_createCCtx();
+    bool ok = out && cctx &&
+              !ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, kRMNCodecZstdLevel)) &&
+              !ZSTD_isError(ZSTD_CCtx_setPledgedSrcSize(cctx, r->length));
+    bool last = false;
+    while (ok && !last) {
+        size_t n = 0;
+        ZSTD_inBuffer in = {impl_NextBlock(r, &n, &last), n, 0};
+        size_t remaining;
+        do {
+            ZSTD_outBuffer o = {out, kRMNCodecBlockSize, 0};
+            remaining = ZSTD_compressStream2(cctx, &o, &in, last ? ZSTD_e_end : ZSTD_e_continue);
+            if (ZSTD_isError(remaining) || (o.pos && !sink(context, out, o.pos))) ok = false;
+        } while (ok && (last ? remaining != 0 : in.pos < in.size));
+    }
+    ZSTD_freeCCtx(cctx);
+    free(out);
+    return ok;
+}
+#endif
+#ifdef RMN_HAVE_LZ4
+static bool impl_EncodeLZ4(impl_BlockReader *r, RMNCodecSink sink, void *context) {
+    LZ4F_preferences_t prefs;
+    memset(&prefs, 0, sizeof(prefs));
+    prefs.frameInfo.contentSize = r->length;
+    size_t cap = LZ4F_compressBound(kRMNCodecBlockSize, &prefs);
+    if (cap < LZ4F_HEADER_SIZE_MAX) cap = LZ4F_HEADER_SIZE_MAX;
+    uint8_t *out = malloc(cap);
+    LZ4F_cctx *cctx = NULL;
+    if (!out || LZ4F_isError(LZ4F_createCompressionContext(&cctx, LZ4F_VERSION))) {
+        free(out);
+        return false;
+    }
+    size_t w = LZ4F_compressBegin(cctx, out, cap, &prefs);
+    bool ok = !LZ4F_isError(w) && sink(context, out, w), last = false;
+    while (ok && !last) {
+        size_t n = 0;
+        const uint8_t *in = impl_NextBlock(r, &n, &last);
+        w = LZ4F_compressUpdate(cctx, out, cap, in, n, NULL);
+        ok = !LZ4F_isError(w) && (w == 0 || sink(context, out, w));
+    }
+    if (ok) {
+        w = LZ4F_compressEnd(cctx, out, cap, NULL);
+        ok = !LZ4F_isError(w) && sink(context, out, w);
+    }
+    LZ4F_freeCompressionContext(cctx);
+    free(out);
+    return ok;
+}
+#endif
+bool RMNCodecEncode(RMNCodec codec,
+                    bool shuffle,
+                    size_t elementSize,
+                    const uint8_t *bytes,
+                    size_t length,
+                    RMNCodecSink sink,
+                    void *sinkContext) {
+    if (!sink || (!bytes && length) || !RMNCodecIsAvailable(codec)) return false;
+    if (elementSize <= 1) shuffle = false;
+    impl_BlockReader r = {.bytes = bytes,
+                          .length = length,
+                          .block = shuffle ? impl_ShuffleBlockBytes(elementSize) : kRMNCodecBlockSize,
+                          .elementSize = elementSize};
+    if (shuffle && !(r.scratch = malloc(r.block))) return false;
+    uint8_t header[kRMNCodecHeaderSize];
+    for (int i = 0; i < kRMNCodecHeaderSize; ++i) header[i] = (uint8_t)((uint64_t)length >> (8 * i));
+    bool ok = sink(sinkContext, header, sizeof(header));
+    switch (ok ? codec : kRMNCodecNone) {
+#ifdef RMN_HAVE_ZLIB
+        case kRMNCodecDeflate: ok = impl_EncodeDeflate(&r, sink, sinkContext); break;
+#endif
+#ifdef RMN_HAVE_ZSTD
+        case kRMNCodecZstd: ok = impl_EncodeZstd(&r, sink, sinkContext); break;
+#endif
+#ifdef RMN_HAVE_LZ4
+        case kRMNCodecLZ4: ok = impl_EncodeLZ4(&r, sink, sinkContext); break;
+#endif
+        default: ok = false; break;
+    }
+    free(r.scratch);
+    return ok;
+}
+#pragma endregion Encoding
+#pragma region Decoding
+bool RMNCodecGetDecodedLength(const uint8_t *src, size_t length, size_t *outLength) {
+    if (!src || length < kRMNCodecHeaderSize) return false;
+    uint64_t n = 0;
+    for (int i = kRMNCodecHeaderSize - 1; i >= 0; --i) n = (n << 8) | src[i];
+    if (n > SIZE_MAX) return false;
+    if (outLength) *outLength = (size_t)n;
+    return true;
+}
+/// Where the codec writes next: straight into `dst`, or into one block of
+/// `scratch` that is unshuffled into `dst` once full.  Past the expected
+/// length the codec gets a one-byte `spill` buffer; anything written there
+/// means the frame is longer than its header claims.
+typedef struct {
+    uint8_t *dst;
+    size_t length;
+    size_t done;
+    uint8_t *scratch;
+    size_t block;
+    size_t fill;
+    size_t elementSize;
+    uint8_t spill[1];
+    bool spilled;
+} impl_DecodeWindow;
+static uint8_t *impl_WindowNext(impl_DecodeWindow *w, size_t *outCap) {
+    size_t cap = w->scratch ? impl_Min(w->block, w->length - w->done) - w->fill : w->length - w->done;
+    if (cap == 0) {
+        *outCap = sizeof(w->spill);
+        return w->spill;
+    }
+    *outCap = cap;
+    return w->scratch ? w->scratch + w->fill : w->dst + w->done;
+}
+static void impl_WindowCommit(impl_DecodeWindow *w, const uint8_t *region, size_t produced) {
+    if (region == w->spill) {
+        w->spilled |= produced > 0;
+        return;
+    }
+    if (!w->scratch) {
+        w->done += produced;
+        return;
+    }
+    w->fill += produced;
+    size_t blockLength = impl_Min(w->block, w->length - w->done);
+    if (w->fill == blockLength) {
+        impl_Unshuffle(w->scratch, w->dst + w->done, blockLength, w->elementSize);
+        w->done += blockLength;
+        w->fill = 0;
+    }
+}
+#ifdef RMN_HAVE_ZLIB
+static bool impl_DecodeDeflate(impl_DecodeWindow *w, const uint8_t *src, size_t srcLength,
+                               size_t *outConsumed) {
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (inflateInit(&z) != Z_OK) return false;
+    z.next_in = (Bytef *)src;
+    size_t unfed = srcLength;  // input not yet handed to zlib
+    int rc = Z_OK;
+    bool ok = true;
+    while (ok && !w->spilled && rc != Z_STREAM_END) {
+        if (z.avail_in == 0) {
+            if (unfed == 0) {
+                ok = false;  // truncated
+                break;
+            }
+            z.avail_in = (uInt)impl_Min(unfed, UINT_MAX);
+            unfed -= z.avail_in;
+        }
+        size_t cap = 0;
+        uint8_t *region = impl_WindowNext(w, &cap);
+        z.next_out = region;
+        z.avail_out = (uInt)impl_Min(cap, UINT_MAX);
+        uInt before = z.avail_out;
+        rc = inflate(&z, Z_NO_FLUSH);
+        if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) ok = false;
+        impl_WindowCommit(w, region, before - z.avail_out);
+    }
+    *outConsumed = srcLength - unfed - z.avail_in;
+    inflateEnd(&z);
+    return ok;
+}
+#endif
+#ifdef RMN_HAVE_ZSTD
+static bool impl_DecodeZstd(impl_DecodeWindow *w, const uint8_t *src, size_t srcLength,
+                            size_t *outConsumed) {
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+    if (!dctx) return false;
+    ZSTD_inBuffer in = {src, srcLength, 0};
+    size_t rc = 1;
+    bool ok = true;
+    while (ok && !w->spilled && rc != 0) {
+        size_t cap = 0;
+        uint8_t *region = impl_WindowNext(w, &cap);
+        ZSTD_outBuffer o = {region, cap, 0};
+        rc = ZSTD_decompressStream(dctx, &o, &in);
+        if (ZSTD_isError(rc)) {
+            ok = false;
+            break;
+        }
+        impl_WindowCommit(w, region, o.pos);
+        if (rc != 0 && o.pos == 0 && in.pos == in.size) ok = false;  // truncated
+    }
+    *outConsumed = in.pos;
+    ZSTD_freeDCtx(dctx);
+    return ok;
+}
+#endif
+#ifdef RMN_HAVE_LZ4
+static bool impl_DecodeLZ4(impl_DecodeWindow *w, const uint8_t *src, size_t srcLength,
+                           size_t *outConsumed) {
+    LZ4F_dctx *dctx = NULL;
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION))) return false;
+    size_t pos = 0, rc = 1;
+    bool ok = true;
+    while (ok && !w->spilled && rc != 0) {
+        size_t cap = 0;
+        uint8_t *region = impl_WindowNext(w, &cap);
+        size_t inSize = srcLength - pos;
+        rc = LZ4F_decompress(dctx, region, &cap, src + pos, &inSize, NULL);
+        if (LZ4F_isError(rc)) {
+            ok = false;
+            break;
+        }
+        pos += inSize;
+        impl_WindowCommit(w, region, cap);
+        if (rc != 0 && cap == 0 && pos == srcLength) ok = false;  // truncated
+    }
+    *outConsumed = pos;
+    LZ4F_freeDecompressionContext(dctx);
+    return ok;
+}
+#endif
+bool RMNCodecDecode(RMNCodec codec,
+                    bool shuffle,
+                    size_t elementSize,
+                    const uint8_t *src,
+                    size_t srcLength,
+                    uint8_t *dst,
+                    size_t dstLength,
+                    size_t *outConsumed) {
+    size_t decoded = 0;
+    if (!RMNCodecGetDecodedLength(src, srcLength, &decoded) || decoded != dstLength ||
+        (!dst && dstLength) || !RMNCodecIsAvailable(codec))
+        return false;
+    if (elementSize <= 1) shuffle = false;
+    impl_DecodeWindow w = {.dst = dst, .length = dstLength, .elementSize = elementSize};
+    if (shuffle) {
+        w.block = impl_ShuffleBlockBytes(elementSize);
+        if (!(w.scratch = malloc(w.block))) return false;
+    }
+    const uint8_t *frame = src + kRMNCodecHeaderSize;
+    size_t frameLength = srcLength - kRMNCodecHeaderSize, consumed = 0;
+    (void)frame;  // unused when no codec is compiled in
+    (void)frameLength;
+    bool ok = false;
+    switch (codec) {
+#ifdef RMN_HAVE_ZLIB
+        case kRMNCodecDeflate: ok = impl_DecodeDeflate(&w, frame, frameLength, &consumed); break;
+#endif
+#ifdef RMN_HAVE_ZSTD
+        case kRMNCodecZstd: ok = impl_DecodeZstd(&w, frame, frameLength, &consumed); break;
+#endif
+#ifdef RMN_HAVE_LZ4
+        case kRMNCodecLZ4: ok = impl_DecodeLZ4(&w, frame, frameLength, &consumed); break;
+#endif
+        default: break;
+    }
+    free(w.scratch);
+    ok = ok && !w.spilled && w.done == dstLength;
+    if (ok && outConsumed) *outConsumed = kRMNCodecHeaderSize + consumed;
+    return ok;
+}
+#pragma endregion Decoding
+bool RMNCodecFileSink(void *context, const void *bytes, size_t length) {
+    return fwrite(bytes, 1, length, (FILE *)context) == length;
+}
+bool RMNCodecBufferSink(void *context, const void *bytes, size_t length) {
+    RMNCodecBuffer *b = context;
+    if (length > b->capacity - b->length) {
+        size_t capacity = b->capacity ? b->capacity : 4096;
+        while (capacity - b->length < length) capacity *= 2;
+        uint8_t *grown = realloc(b->bytes, capacity);
+        if (!grown) return false;
+        b->bytes = grown;
+        b->capacity = capacity;
+    }
+    memcpy(b->bytes + b->length, bytes, length);
+    b->length += length;
+    return true;
+}
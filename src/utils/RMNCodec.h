@@ -0,0 +1,126 @@
+// RMNCodec.h
+#ifndef RMNCODEC_H
+#define RMNCODEC_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNCodec.h
+ * @brief Compressed component encodings (deflate, zstd, lz4, byte-shuffle).
+ *
+ * This is an RMNLib extension to CSDM.  Besides "base64", "none" and "raw",
+ * a dependent variable's encoding may name a codec, optionally preceded by
+ * "shuffle+":
+ *
+ * | Encoding          | Codec                         | Build flag       |
+ * |-------------------|-------------------------------|------------------|
+ * | "deflate"         | zlib stream                   | RMN_HAVE_ZLIB    |
+ * | "zstd"            | Zstandard frame               | RMN_HAVE_ZSTD    |
+ * | "lz4"             | LZ4 frame                     | RMN_HAVE_LZ4     |
+ *
+ * "shuffle+" transposes the bytes of each element within 64 KiB blocks
+ * before compression (all first bytes, then all second bytes, ...), which
+ * groups the slowly varying exponent and high-order bytes of numeric data.
+ *
+ * Each encoded component is a uint64 (little-endian) decoded byte length
+ * followed by one codec frame.  Inline components hold it base64-encoded;
+ * external blobs hold one encoded component after another.
+ *
+ * Encoding and decoding stream through fixed-size buffers and never
+ * allocate OCTypes objects, so they may run on I/O worker threads.
+ */
+/** @brief Compression codec named by an encoding. */
+typedef enum {
+    kRMNCodecNone = 0,  ///< not a compressed encoding
+    kRMNCodecDeflate,   ///< zlib/deflate
+    kRMNCodecZstd,      ///< Zstandard
+    kRMNCodecLZ4,       ///< LZ4 frame format
+} RMNCodec;
+/** Prefix that enables the byte shuffle, e.g. "shuffle+zstd". */
+#define kRMNCodecShufflePrefix "shuffle+"
+/** Bytes in front of every codec frame (the decoded length). */
+#define kRMNCodecHeaderSize 8
+/**
+ * @brief Receives encoded bytes as they are produced.
+ * @return false to abort encoding.
+ */
+typedef bool (*RMNCodecSink)(void *context, const void *bytes, size_t length);
+/**
+ * @brief Parse a component encoding.
+ * @param encoding    Encoding string, e.g. "shuffle+zstd".
+ * @param outCodec    Receives the codec (may be NULL).
+ * @param outShuffle  Receives whether the byte shuffle applies (may be NULL).
+ * @return true if `encoding` names a compressed encoding, whether or not
+ *         its codec was compiled in.
+ */
+bool RMNCodecParseEncoding(const char *encoding, RMNCodec *outCodec, bool *outShuffle);
+/** @brief Whether support for `codec` was compiled in. */
+bool RMNCodecIsAvailable(RMNCodec codec);
+/**
+ * @brief Shuffle width for an element type: its size in bytes, except that
+ *        complex types shuffle real and imaginary parts as separate scalars.
+ */
+size_t RMNCodecShuffleWidth(OCNumberType elementType);
+/**
+ * @brief Compress one component.
+ * @param codec        Codec to use.
+ * @param shuffle      Apply the byte shuffle first.
+ * @param elementSize  Bytes per element (shuffle width).
+ * @param bytes        Component bytes.
+ * @param length       Component length in bytes.
+ * @param sink         Receives the header and the frame.
+ * @param sinkContext  Passed to `sink`.
+ * @return false if the codec is unavailable, fails, or `sink` fails.
+ */
+bool RMNCodecEncode(RMNCodec codec,
+                    bool shuffle,
+                    size_t elementSize,
+                    const uint8_t *bytes,
+                    size_t length,
+                    RMNCodecSink sink,
+                    void *sinkContext);
+/**
+ * @brief Read the decoded length from an encoded component's header.
+ * @return false if `length` is too short for a header.
+ */
+bool RMNCodecGetDecodedLength(const uint8_t *src, size_t length, size_t *outLength);
+/**
+ * @brief Decompress one component straight into its destination buffer.
+ *
+ * Without the shuffle the codec writes into `dst` directly; with it, each
+ * 64 KiB block is decoded into a small scratch buffer and unshuffled.
+ *
+ * @param codec        Codec the component was encoded with.
+ * @param shuffle      Whether the byte shuffle was applied.
+ * @param elementSize  Bytes per element.
+ * @param src          Encoded component (header and frame).
+ * @param srcLength    Bytes available at `src`; may extend past the frame.
+ * @param dst          Destination buffer.
+ * @param dstLength    Expected decoded length; must match the header.
+ * @param outConsumed  Receives the encoded size (may be NULL), so several
+ *                     components can be decoded back to back.
+ * @return false if the data is corrupt, truncated, or the wrong size.
+ */
+bool RMNCodecDecode(RMNCodec codec,
+                    bool shuffle,
+                    size_t elementSize,
+                    const uint8_t *src,
+                    size_t srcLength,
+                    uint8_t *dst,
+                    size_t dstLength,
+                    size_t *outConsumed);
+/** @brief RMNCodecSink that fwrite()s to the FILE * passed as context. */
+bool RMNCodecFileSink(void *context, const void *bytes, size_t length);
+/** @brief Growable malloc buffer for RMNCodecBufferSink(); free `bytes` when done. */
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} RMNCodecBuffer;
+/** @brief RMNCodecSink that appends to the RMNCodecBuffer passed as context. */
+bool RMNCodecBufferSink(void *context, const void *bytes, size_t length);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNCODEC_H */
@@ -0,0 +1,133 @@
+// RMNContainer.c
+#include "RMNContainer.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+#define impl_Seek(f, o) _fseeki64((f), (__int64)(o), SEEK_SET)
+#define impl_Tell(f) _ftelli64(f)
+#else
+#define impl_Seek(f, o) fseeko((f), (off_t)(o), SEEK_SET)
+#define impl_Tell(f) ftello(f)
+#endif
+static void impl_PutU32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+static void impl_PutU64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+static uint32_t impl_GetU32(const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+static uint64_t impl_GetU64(const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+bool RMNContainerHasMagic(const uint8_t *bytes, size_t length) {
+    return bytes && length >= 8 && memcmp(bytes, kRMNContainerMagic, 8) == 0;
+}
+uint64_t RMNContainerTell(FILE *stream) {
+    if (!stream) return UINT64_MAX;
+    long long pos = (long long)impl_Tell(stream);
+    return pos < 0 ? UINT64_MAX : (uint64_t)pos;
+}
+bool RMNContainerAlign(FILE *stream, uint64_t *outOffset) {
+    static const uint8_t zeros[kRMNContainerAlignment] = {0};
+    uint64_t pos = RMNContainerTell(stream);
+    if (pos == UINT64_MAX) return false;
+    size_t pad = (size_t)((kRMNContainerAlignment - pos % kRMNContainerAlignment) %
+                          kRMNContainerAlignment);
+    if (pad && fwrite(zeros, 1, pad, stream) != pad) return false;
+    if (outOffset) *outOffset = pos + pad;
+    return true;
+}
+bool RMNContainerWriteInfo(FILE *stream, const RMNContainerInfo *info) {
+    if (!stream || !info || (info->sectionCount && !info->sections)) return false;
+    uint8_t header[kRMNContainerHeaderSize] = {0};
+    memcpy(header, kRMNContainerMagic, 8);
+    impl_PutU32(header + 8, kRMNContainerVersion);
+    impl_PutU32(header + 12, info->sectionCount);
+    impl_PutU64(header + 16, info->jsonOffset);
+    impl_PutU64(header + 24, info->jsonLength);
+    impl_PutU64(header + 32, info->tableOffset);
+    impl_PutU64(header + 40, info->fileLength);
+    if (impl_Seek(stream, 0) != 0 || fwrite(header, 1, sizeof(header), stream) != sizeof(header))
+        return false;
+    if (impl_Seek(stream, info->tableOffset) != 0) return false;
+    for (uint32_t i = 0; i < info->sectionCount; ++i) {
+        uint8_t entry[16];
+        impl_PutU64(entry, info->sections[i].offset);
+        impl_PutU64(entry + 8, info->sections[i].length);
+        if (fwrite(entry, 1, sizeof(entry), stream) != sizeof(entry)) return false;
+    }
+    return true;
+}
+bool RMNContainerReadInfo(FILE *stream, RMNContainerInfo *info, OCStringRef *outError) {
+    if (!stream || !info) {
+        if (outError) *outError = STR("Invalid arguments");
+        return false;
+    }
+    memset(info, 0, sizeof(*info));
+    uint8_t header[kRMNContainerHeaderSize];
+    if (impl_Seek(stream, 0) != 0 || fread(header, 1, sizeof(header), stream) != sizeof(header) ||
+        !RMNContainerHasMagic(header, sizeof(header))) {
+        if (outError) *outError = STR("Not an RMN container");
+        return false;
+    }
+    if (impl_GetU32(header + 8) != kRMNContainerVersion) {
+        if (outError) *outError = STR("Unsupported RMN container version");
+        return false;
+    }
+    info->sectionCount = impl_GetU32(header + 12);
+    info->jsonOffset = impl_GetU64(header + 16);
+    info->jsonLength = impl_GetU64(header + 24);
+    info->tableOffset = impl_GetU64(header + 32);
+    info->fileLength = impl_GetU64(header + 40);
+    // the header records the length so a truncated copy is caught up front
+    if (fseek(stream, 0, SEEK_END) != 0 || RMNContainerTell(stream) != info->fileLength) {
+        if (outError) *outError = STR("RMN container is truncated");
+        return false;
+    }
+    uint64_t tableLength = 16 * (uint64_t)info->sectionCount;
+    if (info->jsonOffset < kRMNContainerHeaderSize || info->jsonOffset > info->fileLength ||
+        info->jsonLength > info->fileLength - info->jsonOffset ||
+        info->tableOffset > info->fileLength ||
+        tableLength > info->fileLength - info->tableOffset) {
+        if (outError) *outError = STR("Corrupt RMN container header");
+        return false;
+    }
+    info->sections = calloc(info->sectionCount ? info->sectionCount : 1, sizeof(*info->sections));
+    if (!info->sections) {
+        if (outError) *outError = STR("Memory allocation error");
+        return false;
+    }
+    if (impl_Seek(stream, info->tableOffset) != 0) {
+        RMNContainerInfoClear(info);
+        if (outError) *outError = STR("Corrupt RMN container header");
+        return false;
+    }
+    for (uint32_t i = 0; i < info->sectionCount; ++i) {
+        uint8_t entry[16];
+        if (fread(entry, 1, sizeof(entry), stream) != sizeof(entry)) {
+            RMNContainerInfoClear(info);
+            if (outError) *outError = STR("RMN container is truncated");
+            return false;
+        }
+        RMNContainerSection *s = &info->sections[i];
+        s->offset = impl_GetU64(entry);
+        s->length = impl_GetU64(entry + 8);
+        if (s->offset > info->fileLength || s->length > info->fileLength - s->offset) {
+            RMNContainerInfoClear(info);
+            if (outError) *outError = STR("Corrupt RMN container section table");
+            return false;
+        }
+    }
+    return true;
+}
+void RMNContainerInfoClear(RMNContainerInfo *info) {
+    if (!info) return;
+    free(info->sections);
+    memset(info, 0, sizeof(*info));
+}
@@ -0,0 +1,102 @@
+// RMNContainer.h
+#ifndef RMNCONTAINER_H
+#define RMNCONTAINER_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNContainer.h
+ * @brief Single-file container for a CSDM document and its external blobs.
+ *
+ * This is an RMNLib extension to CSDM.  A ".csdmx" file packs what would
+ * otherwise be a ".csdfe" document plus one blob file per external
+ * dependent variable:
+ *
+ * | Field                         | Type (little-endian)          |
+ * |-------------------------------|-------------------------------|
+ * | magic "RMNCSDMX"              | 8 bytes                       |
+ * | version (1)                   | uint32                        |
+ * | section count                 | uint32                        |
+ * | JSON offset, JSON length      | uint64 each                   |
+ * | section table offset          | uint64                        |
+ * | file length                   | uint64                        |
+ * | reserved (zero)               | 16 bytes                      |
+ * | JSON document                 | UTF-8 CSDM (".csdfe") text    |
+ * | table[section count]          | uint64 offset, uint64 length  |
+ * | sections                      | blob bytes                    |
+ *
+ * The table and every section start on a kRMNContainerAlignment boundary,
+ * so a mapped container can be read in place.  Sections hold the external
+ * dependent variables' blobs, in dependent-variable order, byte for byte
+ * as they would be stored next to a ".csdfe" file; the JSON keeps each
+ * "components_url", so a container splits losslessly into standard CSDM.
+ * Variables that share a blob (and so a components_url) have table
+ * entries pointing at the same section.
+ */
+/** Magic bytes at the start of a container. */
+#define kRMNContainerMagic "RMNCSDMX"
+/** File extension of a container. */
+#define kRMNContainerExtension "csdmx"
+/** Current container version. */
+#define kRMNContainerVersion 1
+/** Size of the fixed header; the JSON document follows it. */
+#define kRMNContainerHeaderSize 64
+/** Alignment of the section table and of every section. */
+#define kRMNContainerAlignment 64
+/** @brief Location of one section inside a container. */
+typedef struct {
+    uint64_t offset;
+    uint64_t length;
+} RMNContainerSection;
+/** @brief Decoded container header and section table. */
+typedef struct {
+    uint64_t jsonOffset;
+    uint64_t jsonLength;
+    uint64_t tableOffset;
+    uint64_t fileLength;
+    uint32_t sectionCount;
+    RMNContainerSection *sections;  ///< malloc'd; see RMNContainerInfoClear()
+} RMNContainerInfo;
+/**
+ * @brief Whether `bytes` start with the container magic.
+ * @param bytes   Start of a file.
+ * @param length  Bytes available at `bytes`.
+ */
+bool RMNContainerHasMagic(const uint8_t *bytes, size_t length);
+/**
+ * @brief Read and validate a container's header and section table.
+ *
+ * @param stream        Container, opened for binary reading; its position
+ *                      is left unspecified.
+ * @param info          Receives the header and a malloc'd section table.
+ * @param[out] outError On failure, set to a brief OCStringRef.
+ * @return false if the file is not a well-formed container.
+ */
+bool RMNContainerReadInfo(FILE *stream, RMNContainerInfo *info, OCStringRef *outError);
+/**
+ * @brief Zero-pad `stream` to the next kRMNContainerAlignment boundary.
+ * @param stream     Container being written.
+ * @param outOffset  Receives the aligned offset (may be NULL).
+ * @return false on a write error.
+ */
+bool RMNContainerAlign(FILE *stream, uint64_t *outOffset);
+/**
+ * @brief Current offset of `stream`, or UINT64_MAX on error.
+ */
+uint64_t RMNContainerTell(FILE *stream);
+/**
+ * @brief Write the header and section table described by `info`.
+ *
+ * The caller writes the JSON and sections first, leaving room for the
+ * header at offset 0 and for the table at `info->tableOffset`.
+ *
+ * @return false on a seek or write error.
+ */
+bool RMNContainerWriteInfo(FILE *stream, const RMNContainerInfo *info);
+/** @brief Free the section table and zero `info`. */
+void RMNContainerInfoClear(RMNContainerInfo *info);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNCONTAINER_H */
@@ -0,0 +1,241 @@
+// RMNConvert.c
+#include "RMNConvert.h"
+#include <string.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RMN_CONVERT_X86 1
+#endif
+/// Dense index of an element type, or -1.  OCNumberType values are not
+/// contiguous, so the kernel tables are indexed through this.
+static int impl_TypeIndex(OCNumberType type) {
+    switch (type) {
+        case kOCNumberSInt8Type: return 0;
+        case kOCNumberUInt8Type: return 1;
+        case kOCNumberSInt16Type: return 2;
+        case kOCNumberUInt16Type: return 3;
+        case kOCNumberSInt32Type: return 4;
+        case kOCNumberUInt32Type: return 5;
+        case kOCNumberSInt64Type: return 6;
+        case kOCNumberUInt64Type: return 7;
+        case kOCNumberFloat32Type: return 8;
+        case kOCNumberFloat64Type: return 9;
+        case kOCNumberComplex64Type: return 10;
+        case kOCNumberComplex128Type: return 11;
+        default: return -1;
+    }
+}
+#define kConvertTypeCount 12
+#define kConvertStagingBytes (16 << 10)  // per chunk of an in-place conversion
+typedef void (*impl_ConvertFn)(void *dst, const void *src, ptrdiff_t stride, size_t count);
+#pragma region Kernels
+// Conversions to integer types saturate: out-of-range values clamp to the
+// type's limits, NaN becomes 0, and floating values truncate toward zero as
+// a C cast does.  The helpers take sources widened exactly to double (F),
+// int64_t (S) or uint64_t (U), so one per destination and source class
+// suffices.  The comparisons are written as selects so the loops vectorize.
+#define RMN_SATURATE_TO(T, LO, HI)                                                    \
+    static inline T impl_Sat_##T##_F(double x) {                                      \
+        return x != x ? (T)0 : x <= (double)(LO) ? (T)(LO)                            \
+                             : x >= (double)(HI) ? (T)(HI)                            \
+                                                 : (T)x;                              \
+    }                                                                                 \
+    static inline T impl_Sat_##T##_S(int64_t x) {                                     \
+        return x <= (int64_t)(LO) ? (T)(LO) : x >= 0 && (uint64_t)x >= (uint64_t)(HI) \
+                                                  ? (T)(HI)                           \
+                                                  : (T)x;                             \
+    }                                                                                 \
+    static inline T impl_Sat_##T##_U(uint64_t x) {                                    \
+        return x >= (uint64_t)(HI) ? (T)(HI) : (T)x;                                  \
+    }
+RMN_SATURATE_TO(int8_t, INT8_MIN, INT8_MAX)
+RMN_SATURATE_TO(uint8_t, 0, UINT8_MAX)
+RMN_SATURATE_TO(int16_t, INT16_MIN, INT16_MAX)
+RMN_SATURATE_TO(uint16_t, 0, UINT16_MAX)
+RMN_SATURATE_TO(int32_t, INT32_MIN, INT32_MAX)
+RMN_SATURATE_TO(uint32_t, 0, UINT32_MAX)
+RMN_SATURATE_TO(int64_t, INT64_MIN, INT64_MAX)
+RMN_SATURATE_TO(uint64_t, 0, UINT64_MAX)
+// How one source scalar becomes a destination scalar.
+#define RMN_CAST(TD, C, x) ((TD)(x))
+#define RMN_SATURATE(TD, C, x) impl_Sat_##TD##_##C(x)
+// A kernel reads LS scalars of TS per source element (2 for complex) and
+// writes LD scalars of TD per destination element.  The contiguous loop is
+// kept separate so the compiler vectorizes it; the strided loop gathers.
+#define RMN_CONVERT_KERNEL(ATTR, NAME, TS, LS, C, TD, LD, CVT)                          \
+    ATTR static void NAME(void *dst, const void *src, ptrdiff_t stride, size_t count) { \
+        TD *restrict d = dst;                                                           \
+        const TS *restrict s = src;                                                     \
+        if (stride == 1) {                                                              \
+            for (size_t i = 0; i < count; ++i) {                                        \
+                d[LD * i] = CVT(TD, C, s[LS * i]);                                      \
+                if (LD == 2)                                                            \
+                    d[LD * i + 1] = LS == 2 ? CVT(TD, C, s[LS * i + 1])                 \
+                                            : (TD)0;                                    \
+            }                                                                           \
+        } else {                                                                        \
+            for (size_t i = 0; i < count; ++i) {                                        \
+                const TS *e = s + LS * stride * (ptrdiff_t)i;                           \
+                d[LD * i] = CVT(TD, C, e[0]);                                           \
+                if (LD == 2) d[LD * i + 1] = LS == 2 ? CVT(TD, C, e[1]) : (TD)0;        \
+            }                                                                           \
+        }                                                                               \
+    }
+// The twelve kernels converting every source type to one destination.
+#define RMN_CONVERT_TO(ATTR, K, D, TD, LD, CVT)                           \
+    RMN_CONVERT_KERNEL(ATTR, K##_SInt8_##D, int8_t, 1, S, TD, LD, CVT)    \
+    RMN_CONVERT_KERNEL(ATTR, K##_UInt8_##D, uint8_t, 1, U, TD, LD, CVT)   \
+    RMN_CONVERT_KERNEL(ATTR, K##_SInt16_##D, int16_t, 1, S, TD, LD, CVT)  \
+    RMN_CONVERT_KERNEL(ATTR, K##_UInt16_##D, uint16_t, 1, U, TD, LD, CVT) \
+    RMN_CONVERT_KERNEL(ATTR, K##_SInt32_##D, int32_t, 1, S, TD, LD, CVT)  \
+    RMN_CONVERT_KERNEL(ATTR, K##_UInt32_##D, uint32_t, 1, U, TD, LD, CVT) \
+    RMN_CONVERT_KERNEL(ATTR, K##_SInt64_##D, int64_t, 1, S, TD, LD, CVT)  \
+    RMN_CONVERT_KERNEL(ATTR, K##_UInt64_##D, uint64_t, 1, U, TD, LD, CVT) \
+    RMN_CONVERT_KERNEL(ATTR, K##_Float32_##D, float, 1, F, TD, LD, CVT)   \
+    RMN_CONVERT_KERNEL(ATTR, K##_Float64_##D, double, 1, F, TD, LD, CVT)  \
+    RMN_CONVERT_KERNEL(ATTR, K##_Complex64_##D, float, 2, F, TD, LD, CVT) \
+    RMN_CONVERT_KERNEL(ATTR, K##_Complex128_##D, double, 2, F, TD, LD, CVT)
+#define RMN_CONVERT_ROW(K, D)                                                          \
+    {K##_SInt8_##D, K##_UInt8_##D, K##_SInt16_##D, K##_UInt16_##D, K##_SInt32_##D,     \
+     K##_UInt32_##D, K##_SInt64_##D, K##_UInt64_##D, K##_Float32_##D, K##_Float64_##D, \
+     K##_Complex64_##D, K##_Complex128_##D}
+#define RMN_CONVERT_KERNELS(ATTR, K)                           \
+    RMN_CONVERT_TO(ATTR, K, SInt8, int8_t, 1, RMN_SATURATE)    \
+    RMN_CONVERT_TO(ATTR, K, UInt8, uint8_t, 1, RMN_SATURATE)   \
+    RMN_CONVERT_TO(ATTR, K, SInt16, int16_t, 1, RMN_SATURATE)  \
+    RMN_CONVERT_TO(ATTR, K, UInt16, uint16_t, 1, RMN_SATURATE) \
+    RMN_CONVERT_TO(ATTR, K, SInt32, int32_t, 1, RMN_SATURATE)  \
+    RMN_CONVERT_TO(ATTR, K, UInt32, uint32_t, 1, RMN_SATURATE) \
+    RMN_CONVERT_TO(ATTR, K, SInt64, int64_t, 1, RMN_SATURATE)  \
+    RMN_CONVERT_TO(ATTR, K, UInt64, uint64_t, 1, RMN_SATURATE) \
+    RMN_CONVERT_TO(ATTR, K, Float32, float, 1, RMN_CAST)       \
+    RMN_CONVERT_TO(ATTR, K, Float64, double, 1, RMN_CAST)      \
+    RMN_CONVERT_TO(ATTR, K, Complex64, float, 2, RMN_CAST)     \
+    RMN_CONVERT_TO(ATTR, K, Complex128, double, 2, RMN_CAST)
+// [to][from], indexed by impl_TypeIndex().
+#define RMN_CONVERT_TABLE(K)                                                                 \
+    {                                                                                        \
+        RMN_CONVERT_ROW(K, SInt8), RMN_CONVERT_ROW(K, UInt8), RMN_CONVERT_ROW(K, SInt16),    \
+        RMN_CONVERT_ROW(K, UInt16), RMN_CONVERT_ROW(K, SInt32), RMN_CONVERT_ROW(K, UInt32),  \
+        RMN_CONVERT_ROW(K, SInt64), RMN_CONVERT_ROW(K, UInt64), RMN_CONVERT_ROW(K, Float32), \
+        RMN_CONVERT_ROW(K, Float64), RMN_CONVERT_ROW(K, Complex64),                          \
+        RMN_CONVERT_ROW(K, Complex128),                                                      \
+    }
+RMN_CONVERT_KERNELS(, impl_Scalar)
+static const impl_ConvertFn kConvertScalar[kConvertTypeCount][kConvertTypeCount] =
+    RMN_CONVERT_TABLE(impl_Scalar);
+#if RMN_CONVERT_X86
+#define RMN_TARGET_AVX2 __attribute__((target("avx2")))
+#define RMN_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+RMN_CONVERT_KERNELS(RMN_TARGET_AVX2, impl_AVX2)
+static const impl_ConvertFn kConvertAVX2[kConvertTypeCount][kConvertTypeCount] =
+    RMN_CONVERT_TABLE(impl_AVX2);
+// AVX-512DQ adds packed int64 <-> double conversions
+RMN_CONVERT_KERNELS(RMN_TARGET_AVX512, impl_AVX512)
+static const impl_ConvertFn kConvertAVX512[kConvertTypeCount][kConvertTypeCount] =
+    RMN_CONVERT_TABLE(impl_AVX512);
+#endif
+#pragma endregion Kernels
+static RMNConvertKernel impl_BestKernel(void) {
+#if RMN_CONVERT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+        return kRMNConvertKernelAVX512;
+    if (__builtin_cpu_supports("avx2")) return kRMNConvertKernelAVX2;
+#endif
+    return kRMNConvertKernelScalar;
+}
+// -1 until first use; the race on first use is benign (same value stored)
+static volatile int gRMNConvertKernel = -1;
+static RMNConvertKernel impl_ActiveKernel(void) {
+    int k = gRMNConvertKernel;
+    if (k < 0) gRMNConvertKernel = k = (int)impl_BestKernel();
+    return (RMNConvertKernel)k;
+}
+RMNConvertKernel RMNConvertGetKernel(void) {
+    return impl_ActiveKernel();
+}
+bool RMNConvertSetKernel(RMNConvertKernel kernel) {
+    RMNConvertKernel best = impl_BestKernel();
+    if (kernel == kRMNConvertKernelAuto) kernel = best;
+    if (kernel > best) return false;
+    gRMNConvertKernel = (int)kernel;
+    return true;
+}
+static impl_ConvertFn impl_Lookup(OCNumberType from, OCNumberType to) {
+    int f = impl_TypeIndex(from);
+    int t = impl_TypeIndex(to);
+    if (f < 0 || t < 0) return NULL;
+#if RMN_CONVERT_X86
+    switch (impl_ActiveKernel()) {
+        case kRMNConvertKernelAVX512:
+            return kConvertAVX512[t][f];
+        case kRMNConvertKernelAVX2:
+            return kConvertAVX2[t][f];
+        default:
+            break;
+    }
+#endif
+    return kConvertScalar[t][f];
+}
+bool RMNConvertIsSupported(OCNumberType from, OCNumberType to) {
+    return impl_Lookup(from, to) != NULL;
+}
+bool RMNConvertDoubleFits(OCNumberType to, double value) {
+    // Open bounds one past each limit: truncation toward zero maps anything
+    // strictly inside them onto a representable integer.  NaN fails every
+    // comparison.
+    switch (to) {
+        case kOCNumberSInt8Type: return value > INT8_MIN - 1.0 && value < INT8_MAX + 1.0;
+        case kOCNumberUInt8Type: return value > -1.0 && value < UINT8_MAX + 1.0;
+        case kOCNumberSInt16Type: return value > INT16_MIN - 1.0 && value < INT16_MAX + 1.0;
+        case kOCNumberUInt16Type: return value > -1.0 && value < UINT16_MAX + 1.0;
+        case kOCNumberSInt32Type: return value > INT32_MIN - 1.0 && value < INT32_MAX + 1.0;
+        case kOCNumberUInt32Type: return value > -1.0 && value < UINT32_MAX + 1.0;
+        case kOCNumberSInt64Type: return value >= -0x1p63 && value < 0x1p63;
+        case kOCNumberUInt64Type: return value > -1.0 && value < 0x1p64;
+        default: return true;
+    }
+}
+bool RMNConvertElements(OCNumberType to, void *dst, OCNumberType from, const void *src,
+                        ptrdiff_t srcStride, size_t count) {
+    impl_ConvertFn fn = impl_Lookup(from, to);
+    if (!fn) return false;
+    if (count == 0) return true;
+    if (!dst || !src) return false;
+    if (from == to && srcStride == 1) {
+        memcpy(dst, src, count * OCNumberTypeSize(from));
+        return true;
+    }
+    fn(dst, src, srcStride, count);
+    return true;
+}
+bool RMNConvertElementsInPlace(OCNumberType to, OCNumberType from, void *buffer, size_t count) {
+    impl_ConvertFn fn = impl_Lookup(from, to);
+    if (!fn) return false;
+    if (count == 0 || from == to) return true;
+    if (!buffer) return false;
+    size_t srcWidth = OCNumberTypeSize(from);
+    size_t dstWidth = OCNumberTypeSize(to);
+    // Each chunk is converted into `staging` before it is stored, and chunks
+    // are taken forwards when narrowing and backwards when widening, so no
+    // store reaches source bytes that have not been read yet.
+    _Alignas(16) unsigned char staging[kConvertStagingBytes];
+    size_t chunk = sizeof(staging) / dstWidth;
+    uint8_t *bytes = buffer;
+    if (dstWidth <= srcWidth) {
+        for (size_t i = 0; i < count; i += chunk) {
+            size_t n = count - i < chunk ? count - i : chunk;
+            fn(staging, bytes + i * srcWidth, 1, n);
+            memcpy(bytes + i * dstWidth, staging, n * dstWidth);
+        }
+    } else {
+        for (size_t end = count; end > 0;) {
+            size_t n = end < chunk ? end : chunk;
+            size_t i = end - n;
+            fn(staging, bytes + i * srcWidth, 1, n);
+            memcpy(bytes + i * dstWidth, staging, n * dstWidth);
+            end = i;
+        }
+    }
+    return true;
+}
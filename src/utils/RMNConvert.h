@@ -0,0 +1,99 @@
+// RMNConvert.h
+#ifndef RMNCONVERT_H
+#define RMNCONVERT_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNConvert.h
+ * @brief Bulk conversion of numeric elements between OCNumberTypes.
+ *
+ * One call converts a whole run of elements with a kernel chosen once for
+ * the (source, destination) pair, instead of switching on the element type
+ * per value.  Conversions follow the C casts used by the per-element
+ * DependentVariable getters: real values widen to complex with a zero
+ * imaginary part, and complex values narrow to real by keeping the real
+ * part.  Conversions to integer types saturate: values outside the
+ * destination's range clamp to its limits, NaN becomes 0, and fractions
+ * truncate toward zero.
+ */
+/**
+ * @brief Conversion kernels, in increasing order of capability.
+ *
+ * Every (source, destination) pair has one loop, built once per kernel.
+ * The portable kernels are vectorized by the compiler for the baseline
+ * instruction set (SSE2 on x86-64, NEON on AArch64).  The best kernel the
+ * CPU supports is picked on first use; all kernels produce identical
+ * output.
+ */
+typedef enum {
+    kRMNConvertKernelAuto = -1,  ///< Select the best supported kernel.
+    kRMNConvertKernelScalar = 0, ///< Portable loops.
+    kRMNConvertKernelAVX2,       ///< The same loops built for AVX2.
+    kRMNConvertKernelAVX512,     ///< Built for AVX-512 (F, BW, DQ, VL).
+} RMNConvertKernel;
+/**
+ * @brief Kernel currently used by RMNConvertElements().
+ */
+RMNConvertKernel RMNConvertGetKernel(void);
+/**
+ * @brief Force a kernel (for benchmarking and testing).
+ *
+ * Not thread-safe with respect to concurrent conversions.
+ *
+ * @param kernel  Kernel to use, or kRMNConvertKernelAuto.
+ * @return false if the CPU does not support `kernel`.
+ */
+bool RMNConvertSetKernel(RMNConvertKernel kernel);
+/**
+ * @brief Whether RMNConvertElements() handles conversion from `from` to `to`.
+ *
+ * True for every pair of the twelve numeric OCNumberTypes.
+ */
+bool RMNConvertIsSupported(OCNumberType from, OCNumberType to);
+/**
+ * @brief Whether a C cast of `value` to type `to` is defined and exact up to
+ * truncation toward zero, i.e. needs no saturation.
+ *
+ * False for NaN, infinities and values outside an integer type's range;
+ * always true for floating-point and complex types.  Parsers use this to
+ * reject out-of-range text instead of clamping it.
+ */
+bool RMNConvertDoubleFits(OCNumberType to, double value);
+/**
+ * @brief Convert `count` elements of type `from` into `dst` of type `to`.
+ *
+ * Source elements are read `srcStride` elements apart (1 for a contiguous
+ * run; negative strides walk backwards from `src`), destination elements
+ * are written contiguously.  The buffers must not overlap.
+ *
+ * @param to         Destination element type.
+ * @param dst        Room for `count` elements of `to`.
+ * @param from       Source element type.
+ * @param src        First source element.
+ * @param srcStride  Distance between source elements, in elements of `from`.
+ * @param count      Number of elements.
+ * @return false if the pair is not supported (nothing is written).
+ */
+bool RMNConvertElements(OCNumberType to, void *dst, OCNumberType from, const void *src,
+                        ptrdiff_t srcStride, size_t count);
+/**
+ * @brief Convert `count` contiguous elements of type `from` to `to` in place.
+ *
+ * `buffer` must have room for `count` elements of the wider of the two
+ * types; the converted elements start at `buffer`.  No memory is
+ * allocated, so a component can change its element type with at most one
+ * reallocation (to grow it before widening, or shrink it after narrowing).
+ *
+ * @param to      Destination element type.
+ * @param from    Source element type.
+ * @param buffer  Elements of `from` on input, of `to` on return.
+ * @param count   Number of elements.
+ * @return false if the pair is not supported (nothing is changed).
+ */
+bool RMNConvertElementsInPlace(OCNumberType to, OCNumberType from, void *buffer, size_t count);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNCONVERT_H */
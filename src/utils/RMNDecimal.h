@@ -0,0 +1,88 @@
+// RMNDecimal.h
+#ifndef RMNDECIMAL_H
+#define RMNDECIMAL_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNDecimal.h
+ * @brief Conversions between binary floating point and JSON decimal text.
+ *
+ * Used by the "none" component encoding, where every value of a
+ * component is written as a JSON number.  These routines work on
+ * caller-owned buffers, never allocate and do not depend on the locale.
+ */
+/**
+ * @brief Buffer size that always suffices for RMNDecimalFormatDouble().
+ */
+#define kRMNDecimalMaxLength 32
+/**
+ * @brief Write the shortest decimal text that reads back as `value`.
+ *
+ * Digits are generated with Grisu2 (Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010): the result
+ * always converts back to exactly the same double under correctly rounded
+ * parsing (strtod()), and is the shortest such text for all but a tiny
+ * fraction of values.
+ *
+ * The layout follows printf("%g") so output resembles cJSON's: plain
+ * notation when the leading digit's decimal exponent is from -4 to 16,
+ * otherwise "d.ddde+XX".  Integers below 2^53 are written without a fraction or exponent, and a
+ * negative zero keeps its sign ("-0").  JSON cannot represent NaN or
+ * infinities: NaN is written as "null", which the "none" decoders read
+ * back as NaN, and infinities as "1e999" or "-1e999", which any JSON
+ * parser reads back as infinity.
+ *
+ * @param value  Value to format.
+ * @param out    Destination with room for kRMNDecimalMaxLength characters;
+ *               a terminating NUL is written.
+ * @return Number of characters written, not counting the NUL.
+ */
+size_t RMNDecimalFormatDouble(double value, char *out);
+/**
+ * @brief Parse one JSON number into a correctly rounded double.
+ *
+ * Values with up to 19 significant digits are converted with Clinger's
+ * fast path or the Eisel-Lemire algorithm (Lemire, "Number Parsing at a
+ * Gigabyte per Second", 2021) and give the same bits as strtod(); the rare
+ * inputs those cannot decide are handed to strtod().
+ *
+ * Only the JSON grammar is accepted: no leading whitespace or '+', no
+ * hexadecimal, "inf" or "nan".  Exponents beyond the double range give
+ * zero or infinity.
+ *
+ * @param p           First character of the number.
+ * @param end         End of the text; `[p, end)` need not be NUL-terminated.
+ * @param[out] value  Parsed value.
+ * @return Position just past the number, or NULL if `p` does not start a
+ *         JSON number.
+ */
+const char *RMNDecimalParseDouble(const char *p, const char *end, double *value);
+/**
+ * @brief Parse one JSON number into a correctly rounded float.
+ *
+ * Like RMNDecimalParseDouble(), but rounds the decimal text to float
+ * directly, so there is no double rounding through an intermediate double.
+ */
+const char *RMNDecimalParseFloat(const char *p, const char *end, float *value);
+/**
+ * @brief Parse one JSON number written as a plain integer, exactly.
+ *
+ * Accepts an optional '-' followed by digits, without fraction or
+ * exponent, so 64-bit samples never pass through a double.  The caller
+ * checks the result against the range of its integer type.
+ *
+ * @param p               First character of the number.
+ * @param end             End of the text; `[p, end)` need not be NUL-terminated.
+ * @param[out] negative   Whether the number has a leading '-'.
+ * @param[out] magnitude  Absolute value of the number.
+ * @return Position just past the number, or NULL if `p` does not start a
+ *         plain integer (including one with a fraction or exponent) or its
+ *         magnitude exceeds UINT64_MAX.
+ */
+const char *RMNDecimalParseInteger(const char *p, const char *end, bool *negative, uint64_t *magnitude);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNDECIMAL_H */
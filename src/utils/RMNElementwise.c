@@ -0,0 +1,481 @@
+// RMNElementwise.c
+#include "RMNElementwise.h"
+#include <math.h>
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define RMN_ELEMENTWISE_X86 1
+#include <immintrin.h>
+#endif
+// a*b + c*d keeps two roundings in every build, as in the portable one.
+// GCC ignores the pragma; the build passes -ffp-contract=off for this file.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#endif
+#define kElementwiseDefaultThreshold ((size_t)1 << 20)
+#define kElementwiseBlock ((size_t)1 << 16)  // elements per threaded task
+#define kElementwiseBLASRun ((size_t)1 << 30)  // elements per BLAS call (int count)
+#define kElementwiseStaging 2048             // integers scaled per pass
+#define kCombineChunk 1024                   // elements staged per combine step
+static size_t gRMNElementwiseThreshold = kElementwiseDefaultThreshold;
+size_t RMNElementwiseGetParallelThreshold(void) {
+    return gRMNElementwiseThreshold;
+}
+void RMNElementwiseSetParallelThreshold(size_t elements) {
+    gRMNElementwiseThreshold = elements ? elements : kElementwiseDefaultThreshold;
+}
+typedef struct {
+    double re, im;
+    OCNumberType type;
+} impl_Args;
+/// Processes `count` units (scalars or elements, as the kernel defines).
+typedef void (*impl_Kernel)(void *values, size_t count, const impl_Args *args);
+/// x[i] = x[i] op y[i] for `count` units; `operand` may alias `values`.
+typedef void (*impl_BinaryKernel)(void *values, const void *operand, size_t count);
+#pragma region Kernels
+// Plain loops, vectorized by the compiler for each target.  The conjugate
+// kernels flip the sign bit directly, which is what unary minus compiles to.
+#define RMN_ELEMENTWISE_KERNELS(ATTR, K)                                                   \
+    ATTR static void K##_ScaleFloat(void *values, size_t n, const impl_Args *a) {          \
+        float *restrict x = values;                                                        \
+        const float f = (float)a->re;                                                      \
+        for (size_t i = 0; i < n; ++i) x[i] *= f;                                          \
+    }                                                                                      \
+    ATTR static void K##_ScaleDouble(void *values, size_t n, const impl_Args *a) {         \
+        double *restrict x = values;                                                       \
+        const double f = a->re;                                                            \
+        for (size_t i = 0; i < n; ++i) x[i] *= f;                                          \
+    }                                                                                      \
+    ATTR static void K##_ConjugateComplex64(void *values, size_t n, const impl_Args *a) {  \
+        uint32_t *restrict x = values;                                                     \
+        (void)a;                                                                           \
+        for (size_t i = 0; i < n; ++i) x[2 * i + 1] ^= UINT32_C(0x80000000);               \
+    }                                                                                      \
+    ATTR static void K##_ConjugateComplex128(void *values, size_t n, const impl_Args *a) { \
+        uint64_t *restrict x = values;                                                     \
+        (void)a;                                                                           \
+        for (size_t i = 0; i < n; ++i) x[2 * i + 1] ^= UINT64_C(0x8000000000000000);       \
+    }                                                                                      \
+    ATTR static void K##_AbsFloat(void *values, size_t n, const impl_Args *a) {            \
+        float *restrict x = values;                                                        \
+        (void)a;                                                                           \
+        for (size_t i = 0; i < n; ++i) x[i] = fabsf(x[i]);                                 \
+    }                                                                                      \
+    ATTR static void K##_AbsDouble(void *values, size_t n, const impl_Args *a) {           \
+        double *restrict x = values;                                                       \
+        (void)a;                                                                           \
+        for (size_t i = 0; i < n; ++i) x[i] = fabs(x[i]);                                  \
+    }                                                                                      \
+    RMN_ELEMENTWISE_ABS_INT(ATTR, K, SInt8, int8_t)                                        \
+    RMN_ELEMENTWISE_ABS_INT(ATTR, K, SInt16, int16_t)                                      \
+    RMN_ELEMENTWISE_ABS_INT(ATTR, K, SInt32, int32_t)                                      \
+    RMN_ELEMENTWISE_ABS_INT(ATTR, K, SInt64, int64_t)                                      \
+    RMN_ELEMENTWISE_BINARY(ATTR, K, Float, float)                                          \
+    RMN_ELEMENTWISE_BINARY(ATTR, K, Double, double)
+// The textbook complex product, as two roundings per part.
+#define RMN_ELEMENTWISE_PRODUCT(ATTR, K)                                                   \
+    ATTR static void K##_MultiplyComplex64(void *values, const void *operand, size_t n) {  \
+        float *x = values;                                                                 \
+        const float *y = operand;                                                          \
+        for (size_t i = 0; i < n; ++i) {                                                   \
+            float r = x[2 * i], m = x[2 * i + 1], yr = y[2 * i], ym = y[2 * i + 1];        \
+            x[2 * i] = r * yr - m * ym;                                                    \
+            x[2 * i + 1] = r * ym + m * yr;                                                \
+        }                                                                                  \
+    }                                                                                      \
+    ATTR static void K##_MultiplyComplex128(void *values, const void *operand, size_t n) { \
+        double *x = values;                                                                \
+        const double *y = operand;                                                         \
+        for (size_t i = 0; i < n; ++i) {                                                   \
+            double r = x[2 * i], m = x[2 * i + 1], yr = y[2 * i], ym = y[2 * i + 1];       \
+            x[2 * i] = r * yr - m * ym;                                                    \
+            x[2 * i + 1] = r * ym + m * yr;                                                \
+        }                                                                                  \
+    }
+#define RMN_ELEMENTWISE_ABS_INT(ATTR, K, N, T)                                \
+    ATTR static void K##_Abs##N(void *values, size_t n, const impl_Args *a) { \
+        T *restrict x = values;                                               \
+        (void)a;                                                              \
+        for (size_t i = 0; i < n; ++i) x[i] = (T)(x[i] < 0 ? -x[i] : x[i]);   \
+    }
+// x = x op y without restrict: an operand that aliases the values is allowed
+// (the compiler's runtime overlap check then takes its scalar loop).
+#define RMN_ELEMENTWISE_BINARY(ATTR, K, N, T)                                  \
+    RMN_ELEMENTWISE_BINARY_OP(ATTR, K, Add##N, T, +)                           \
+    RMN_ELEMENTWISE_BINARY_OP(ATTR, K, Subtract##N, T, -)                      \
+    RMN_ELEMENTWISE_BINARY_OP(ATTR, K, Multiply##N, T, *)                      \
+    RMN_ELEMENTWISE_BINARY_OP(ATTR, K, Divide##N, T, /)
+#define RMN_ELEMENTWISE_BINARY_OP(ATTR, K, NAME, T, OP)                        \
+    ATTR static void K##_##NAME(void *values, const void *operand, size_t n) { \
+        T *x = values;                                                         \
+        const T *y = operand;                                                  \
+        for (size_t i = 0; i < n; ++i) x[i] = x[i] OP y[i];                    \
+    }
+/// |z| of one complex64 element: the squares are exact in double, so no
+/// scaling is needed.  This is how glibc computes hypotf(), and so cabsf().
+/// Infinities and NaNs are passed to cabsf() itself.
+static inline float impl_MagnitudeComplex64(float r, float m) {
+    if (!isfinite(r) || !isfinite(m)) return cabsf(CMPLXF(r, m));
+    return (float)sqrt((double)r * r + (double)m * m);
+}
+static void impl_Scalar_AbsComplex64(void *values, size_t n, const impl_Args *a) {
+    float *x = values;
+    (void)a;
+    for (size_t i = 0; i < n; ++i) {
+        x[2 * i] = impl_MagnitudeComplex64(x[2 * i], x[2 * i + 1]);
+        x[2 * i + 1] = 0.0f;
+    }
+}
+// hypot() does not vectorize; complex128 magnitudes rely on threading alone
+static void impl_AbsComplex128(void *values, size_t n, const impl_Args *a) {
+    double *x = values;
+    (void)a;
+    for (size_t i = 0; i < n; ++i) {
+        x[2 * i] = hypot(x[2 * i], x[2 * i + 1]);
+        x[2 * i + 1] = 0.0;
+    }
+}
+/// Complex64 quotients in double precision: the float products are exact
+/// there, so only the sums and the division round before the final narrowing.
+static void impl_DivideComplex64(void *values, const void *operand, size_t n) {
+    float *x = values;
+    const float *y = operand;
+    for (size_t i = 0; i < n; ++i) {
+        double r = x[2 * i], m = x[2 * i + 1], yr = y[2 * i], ym = y[2 * i + 1];
+        double q = yr * yr + ym * ym;
+        x[2 * i] = (float)((r * yr + m * ym) / q);
+        x[2 * i + 1] = (float)((m * yr - r * ym) / q);
+    }
+}
+// Complex128 quotients keep the C operator (Annex G scaling and infinities).
+static void impl_DivideComplex128(void *values, const void *operand, size_t n) {
+    double complex *x = values;
+    const double complex *y = operand;
+    for (size_t i = 0; i < n; ++i) x[i] = x[i] / y[i];
+}
+/// Complex factors go through cblas_cscal() and cblas_zscal(), the routines
+/// DependentVariable used before these kernels, so results are those of the
+/// linked BLAS.  Elements are scaled independently, so splitting a run into
+/// blocks or int-sized calls never changes a result.
+static void impl_BLAS_ScaleComplex64(void *values, size_t n, const impl_Args *a) {
+    float factor[2] = {(float)a->re, (float)a->im};
+    float complex *x = values;
+    for (size_t i = 0; i < n; i += kElementwiseBLASRun) {
+        size_t m = n - i < kElementwiseBLASRun ? n - i : kElementwiseBLASRun;
+        cblas_cscal((int)m, (const void *)factor, (float _Complex *)(x + i), 1);
+    }
+}
+static void impl_BLAS_ScaleComplex128(void *values, size_t n, const impl_Args *a) {
+    double factor[2] = {a->re, a->im};
+    double complex *x = values;
+    for (size_t i = 0; i < n; i += kElementwiseBLASRun) {
+        size_t m = n - i < kElementwiseBLASRun ? n - i : kElementwiseBLASRun;
+        cblas_zscal((int)m, (const void *)factor, (double _Complex *)(x + i), 1);
+    }
+}
+/// Integer types are scaled in double precision through a small staging
+/// buffer and converted back with RMNConvertElements().
+static void impl_ScaleInteger(void *values, size_t n, const impl_Args *a) {
+    double staging[kElementwiseStaging];
+    size_t width = OCNumberTypeSize(a->type);
+    uint8_t *bytes = values;
+    for (size_t i = 0; i < n; i += kElementwiseStaging) {
+        size_t m = n - i < kElementwiseStaging ? n - i : kElementwiseStaging;
+        RMNConvertElements(kOCNumberFloat64Type, staging, a->type, bytes + i * width, 1, m);
+        for (size_t j = 0; j < m; ++j) staging[j] *= a->re;
+        RMNConvertElements(a->type, bytes + i * width, kOCNumberFloat64Type, staging, 1, m);
+    }
+}
+typedef struct {
+    impl_Kernel scaleFloat, scaleDouble;
+    impl_Kernel conjugateComplex64, conjugateComplex128;
+    impl_Kernel absFloat, absDouble, absComplex64;
+    impl_Kernel absSInt8, absSInt16, absSInt32, absSInt64;
+    impl_BinaryKernel combineFloat[4], combineDouble[4];  // by RMNElementwiseOperation
+    impl_BinaryKernel multiplyComplex64, multiplyComplex128;
+} impl_Kernels;
+#define RMN_ELEMENTWISE_TABLE(K, PRODUCT, ABS_COMPLEX64)                           \
+    {                                                                              \
+        K##_ScaleFloat, K##_ScaleDouble,                                           \
+        K##_ConjugateComplex64, K##_ConjugateComplex128,                           \
+        K##_AbsFloat, K##_AbsDouble, ABS_COMPLEX64,                                \
+        K##_AbsSInt8, K##_AbsSInt16, K##_AbsSInt32, K##_AbsSInt64,                 \
+        {K##_AddFloat, K##_SubtractFloat, K##_MultiplyFloat, K##_DivideFloat},     \
+        {K##_AddDouble, K##_SubtractDouble, K##_MultiplyDouble, K##_DivideDouble}, \
+        PRODUCT##_MultiplyComplex64, PRODUCT##_MultiplyComplex128,                 \
+    }
+RMN_ELEMENTWISE_KERNELS(, impl_Scalar)
+RMN_ELEMENTWISE_PRODUCT(, impl_Scalar)
+static const impl_Kernels kElementwiseScalar =
+    RMN_ELEMENTWISE_TABLE(impl_Scalar, impl_Scalar, impl_Scalar_AbsComplex64);
+#if RMN_ELEMENTWISE_X86
+#define RMN_TARGET_AVX2 __attribute__((target("avx2")))
+#define RMN_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+/// Four complex64 magnitudes per step: widen to double, square, add pairs,
+/// sqrt, narrow.  Steps that produce a NaN are redone with the scalar code
+/// so that an infinite part still yields +inf.
+RMN_TARGET_AVX2 static void impl_AVX2_AbsComplex64(void *values, size_t n, const impl_Args *a) {
+    float *x = values;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d lo = _mm256_cvtps_pd(_mm_loadu_ps(x + 2 * i));      // r0 m0 r1 m1
+        __m256d hi = _mm256_cvtps_pd(_mm_loadu_ps(x + 2 * i + 4));  // r2 m2 r3 m3
+        __m256d sum = _mm256_hadd_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi));
+        __m128 mag = _mm256_cvtpd_ps(_mm256_sqrt_pd(sum));  // |z0| |z2| |z1| |z3|
+        if (_mm_movemask_ps(_mm_cmpunord_ps(mag, mag))) {
+            impl_Scalar_AbsComplex64(x + 2 * i, 4, a);
+            continue;
+        }
+        mag = _mm_shuffle_ps(mag, mag, _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_ps(x + 2 * i, _mm_unpacklo_ps(mag, _mm_setzero_ps()));
+        _mm_storeu_ps(x + 2 * i + 4, _mm_unpackhi_ps(mag, _mm_setzero_ps()));
+    }
+    impl_Scalar_AbsComplex64(x + 2 * i, n - i, a);
+}
+RMN_ELEMENTWISE_KERNELS(RMN_TARGET_AVX2, impl_AVX2)
+RMN_ELEMENTWISE_PRODUCT(RMN_TARGET_AVX2, impl_AVX2)
+static const impl_Kernels kElementwiseAVX2 =
+    RMN_ELEMENTWISE_TABLE(impl_AVX2, impl_AVX2, impl_AVX2_AbsComplex64);
+// AVX-512 implies FMA, and GCC turns the complex product into vfmaddsub even
+// with -ffp-contract=off; the AVX2 product keeps its two roundings.
+RMN_ELEMENTWISE_KERNELS(RMN_TARGET_AVX512, impl_AVX512)
+static const impl_Kernels kElementwiseAVX512 =
+    RMN_ELEMENTWISE_TABLE(impl_AVX512, impl_AVX2, impl_AVX2_AbsComplex64);
+#endif
+#pragma endregion Kernels
+static const impl_Kernels *impl_ActiveKernels(void) {
+#if RMN_ELEMENTWISE_X86
+    switch (RMNConvertGetKernel()) {
+        case kRMNConvertKernelAVX512:
+            return &kElementwiseAVX512;
+        case kRMNConvertKernelAVX2:
+            return &kElementwiseAVX2;
+        default:
+            break;
+    }
+#endif
+    return &kElementwiseScalar;
+}
+#pragma region Threaded Driver
+typedef struct {
+    impl_Kernel kernel;
+    uint8_t *bytes;
+    size_t width;  // bytes per unit
+    size_t count;  // units
+    const impl_Args *args;
+} impl_ElementwiseJob;
+static void impl_RunBlock(void *context, size_t index) {
+    const impl_ElementwiseJob *job = context;
+    size_t first = index * kElementwiseBlock;
+    size_t n = job->count - first < kElementwiseBlock ? job->count - first : kElementwiseBlock;
+    job->kernel(job->bytes + first * job->width, n, job->args);
+}
+/// Run `kernel` over `count` units of `width` bytes, split into blocks on
+/// several threads when the buffer is large enough.  Blocks start at
+/// multiples of kElementwiseBlock, so the split never changes a result.
+static void impl_Run(impl_Kernel kernel, void *values, size_t width, size_t count,
+                     const impl_Args *args) {
+    if (count == 0) return;
+    size_t blocks = (count + kElementwiseBlock - 1) / kElementwiseBlock;
+    size_t workers = RMNParallelProcessorCount();
+    if (count < gRMNElementwiseThreshold || blocks < 2 || workers < 2) {
+        kernel(values, count, args);
+        return;
+    }
+    impl_ElementwiseJob job = {kernel, values, width, count, args};
+    RMNParallelFor(blocks, workers, impl_RunBlock, &job);
+}
+#pragma endregion Threaded Driver
+static bool impl_IsInteger(OCNumberType type) {
+    switch (type) {
+        case kOCNumberSInt8Type:
+        case kOCNumberUInt8Type:
+        case kOCNumberSInt16Type:
+        case kOCNumberUInt16Type:
+        case kOCNumberSInt32Type:
+        case kOCNumberUInt32Type:
+        case kOCNumberSInt64Type:
+        case kOCNumberUInt64Type:
+            return true;
+        default:
+            return false;
+    }
+}
+bool RMNElementwiseScaleReal(OCNumberType type, void *values, size_t count, double factor) {
+    const impl_Kernels *k = impl_ActiveKernels();
+    impl_Args args = {factor, 0.0, type};
+    if (count > 0 && !values) return false;
+    switch (type) {
+        case kOCNumberFloat32Type:
+            impl_Run(k->scaleFloat, values, sizeof(float), count, &args);
+            return true;
+        case kOCNumberFloat64Type:
+            impl_Run(k->scaleDouble, values, sizeof(double), count, &args);
+            return true;
+        case kOCNumberComplex64Type:
+            impl_Run(k->scaleFloat, values, sizeof(float), 2 * count, &args);
+            return true;
+        case kOCNumberComplex128Type:
+            impl_Run(k->scaleDouble, values, sizeof(double), 2 * count, &args);
+            return true;
+        default:
+            if (!impl_IsInteger(type)) return false;
+            impl_Run(impl_ScaleInteger, values, OCNumberTypeSize(type), count, &args);
+            return true;
+    }
+}
+bool RMNElementwiseScaleComplex(OCNumberType type, void *values, size_t count,
+                                double complex factor) {
+    impl_Args args = {creal(factor), cimag(factor), type};
+    if (count > 0 && !values) return false;
+    switch (type) {
+        case kOCNumberComplex64Type:
+            impl_Run(impl_BLAS_ScaleComplex64, values, 2 * sizeof(float), count, &args);
+            return true;
+        case kOCNumberComplex128Type:
+            impl_Run(impl_BLAS_ScaleComplex128, values, 2 * sizeof(double), count, &args);
+            return true;
+        default:
+            return RMNElementwiseScaleReal(type, values, count, creal(factor));
+    }
+}
+bool RMNElementwiseConjugate(OCNumberType type, void *values, size_t count) {
+    const impl_Kernels *k = impl_ActiveKernels();
+    impl_Args args = {0.0, 0.0, type};
+    if (count > 0 && !values) return false;
+    switch (type) {
+        case kOCNumberComplex64Type:
+            impl_Run(k->conjugateComplex64, values, 2 * sizeof(float), count, &args);
+            return true;
+        case kOCNumberComplex128Type:
+            impl_Run(k->conjugateComplex128, values, 2 * sizeof(double), count, &args);
+            return true;
+        case kOCNumberFloat32Type:
+        case kOCNumberFloat64Type:
+            return true;
+        default:
+            return impl_IsInteger(type);
+    }
+}
+bool RMNElementwiseAbsolute(OCNumberType type, void *values, size_t count) {
+    const impl_Kernels *k = impl_ActiveKernels();
+    impl_Args args = {0.0, 0.0, type};
+    if (count > 0 && !values) return false;
+    impl_Kernel kernel = NULL;
+    switch (type) {
+        case kOCNumberSInt8Type: kernel = k->absSInt8; break;
+        case kOCNumberSInt16Type: kernel = k->absSInt16; break;
+        case kOCNumberSInt32Type: kernel = k->absSInt32; break;
+        case kOCNumberSInt64Type: kernel = k->absSInt64; break;
+        case kOCNumberFloat32Type: kernel = k->absFloat; break;
+        case kOCNumberFloat64Type: kernel = k->absDouble; break;
+        case kOCNumberComplex64Type: kernel = k->absComplex64; break;
+        case kOCNumberComplex128Type: kernel = impl_AbsComplex128; break;
+        default:
+            return impl_IsInteger(type);  // unsigned: already non-negative
+    }
+    impl_Run(kernel, values, OCNumberTypeSize(type), count, &args);
+    return true;
+}
+#pragma region Binary Operations
+typedef struct {
+    const impl_Kernels *kernels;
+    RMNElementwiseOperation op;
+    OCNumberType type, operandType;
+    uint8_t *values;
+    const uint8_t *operand;
+    size_t count;
+    double scale;
+} impl_CombineJob;
+static bool impl_IsComplex(OCNumberType type) {
+    return type == kOCNumberComplex64Type || type == kOCNumberComplex128Type;
+}
+/// x = x op y over `n` elements of a floating `type`.
+static void impl_CombineFloating(const impl_CombineJob *job, OCNumberType type, void *x,
+                                 const void *y, size_t n) {
+    const impl_Kernels *k = job->kernels;
+    switch (type) {
+        case kOCNumberFloat32Type:
+            k->combineFloat[job->op](x, y, n);
+            break;
+        case kOCNumberFloat64Type:
+            k->combineDouble[job->op](x, y, n);
+            break;
+        case kOCNumberComplex64Type:
+            if (job->op == kRMNElementwiseMultiply)
+                k->multiplyComplex64(x, y, n);
+            else if (job->op == kRMNElementwiseDivide)
+                impl_DivideComplex64(x, y, n);
+            else
+                k->combineFloat[job->op](x, y, 2 * n);
+            break;
+        case kOCNumberComplex128Type:
+            if (job->op == kRMNElementwiseMultiply)
+                k->multiplyComplex128(x, y, n);
+            else if (job->op == kRMNElementwiseDivide)
+                impl_DivideComplex128(x, y, n);
+            else
+                k->combineDouble[job->op](x, y, 2 * n);
+            break;
+        default:
+            break;
+    }
+}
+/// Combine elements [first, first + n) with n <= kCombineChunk.  The operand
+/// is converted and scaled into a stack buffer; integer values are widened
+/// to double around the floating kernel.
+static void impl_CombineChunk(const impl_CombineJob *job, size_t first, size_t n) {
+    _Alignas(16) unsigned char staged[kCombineChunk * 2 * sizeof(double)];
+    double widened[kCombineChunk];
+    OCNumberType work = impl_IsInteger(job->type) ? kOCNumberFloat64Type : job->type;
+    uint8_t *x = job->values + first * OCNumberTypeSize(job->type);
+    const void *y = job->operand + first * OCNumberTypeSize(job->operandType);
+    if (job->operandType != work || job->scale != 1.0) {
+        RMNConvertElements(work, staged, job->operandType, y, 1, n);
+        if (job->scale != 1.0) {
+            impl_Args args = {job->scale, 0.0, work};
+            size_t scalars = impl_IsComplex(work) ? 2 * n : n;
+            if (work == kOCNumberFloat32Type || work == kOCNumberComplex64Type)
+                job->kernels->scaleFloat(staged, scalars, &args);
+            else
+                job->kernels->scaleDouble(staged, scalars, &args);
+        }
+        y = staged;
+    }
+    if (work == job->type) {
+        impl_CombineFloating(job, work, x, y, n);
+        return;
+    }
+    RMNConvertElements(kOCNumberFloat64Type, widened, job->type, x, 1, n);
+    impl_CombineFloating(job, kOCNumberFloat64Type, widened, y, n);
+    RMNConvertElements(job->type, x, kOCNumberFloat64Type, widened, 1, n);
+}
+static void impl_CombineBlock(void *context, size_t index) {
+    const impl_CombineJob *job = context;
+    size_t first = index * kElementwiseBlock;
+    size_t end = job->count - first < kElementwiseBlock ? job->count : first + kElementwiseBlock;
+    if (job->type == job->operandType && !impl_IsInteger(job->type) && job->scale == 1.0) {
+        impl_CombineFloating(job, job->type, job->values + first * OCNumberTypeSize(job->type),
+                             job->operand + first * OCNumberTypeSize(job->type), end - first);
+        return;
+    }
+    for (size_t i = first; i < end; i += kCombineChunk)
+        impl_CombineChunk(job, i, end - i < kCombineChunk ? end - i : kCombineChunk);
+}
+bool RMNElementwiseCombine(RMNElementwiseOperation op, OCNumberType type, void *values,
+                           OCNumberType operandType, const void *operand, size_t count,
+                           double scale) {
+    if (op < kRMNElementwiseAdd || op > kRMNElementwiseDivide) return false;
+    if (!RMNConvertIsSupported(operandType, type)) return false;
+    if (impl_IsComplex(operandType) && !impl_IsComplex(type)) return false;
+    if (count == 0) return true;
+    if (!values || !operand) return false;
+    impl_CombineJob job = {impl_ActiveKernels(), op, type, operandType, values, operand, count, scale};
+    size_t blocks = (count + kElementwiseBlock - 1) / kElementwiseBlock;
+    size_t workers = RMNParallelProcessorCount();
+    if (count < gRMNElementwiseThreshold || blocks < 2 || workers < 2) {
+        for (size_t b = 0; b < blocks; ++b) impl_CombineBlock(&job, b);
+        return true;
+    }
+    RMNParallelFor(blocks, workers, impl_CombineBlock, &job);
+    return true;
+}
+#pragma endregion Binary Operations
@@ -0,0 +1,133 @@
+// RMNElementwise.h
+#ifndef RMNELEMENTWISE_H
+#define RMNELEMENTWISE_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNElementwise.h
+ * @brief In-place arithmetic kernels over numeric element buffers.
+ *
+ * These back the DependentVariable arithmetic (scaling, conjugation,
+ * absolute value, unit conversion, and DependentVariableAdd() and its
+ * siblings).  Each call dispatches once on the
+ * element type; the loops are built for the same targets as RMNConvert and
+ * follow RMNConvertSetKernel().  Buffers of at least
+ * RMNElementwiseGetParallelThreshold() elements are split into blocks and
+ * processed on several threads with RMNParallelFor().
+ *
+ * Results for real element types are bit-identical whichever kernel or
+ * thread split runs them: every value goes through the same single IEEE
+ * operation as the plain C loop.  Complex results agree too, except that
+ * the sign of a NaN may differ where both operands of a product are NaN;
+ * see RMNElementwiseScaleComplex() and RMNElementwiseAbsolute() for how
+ * they relate to BLAS and cabsf().
+ */
+/**
+ * @brief Smallest element count that is processed on several threads.
+ */
+size_t RMNElementwiseGetParallelThreshold(void);
+/**
+ * @brief Set the element count from which kernels run on several threads.
+ *
+ * Use 0 to restore the default, or SIZE_MAX to stay on the calling thread.
+ * Not thread-safe with respect to running kernels.
+ *
+ * @param elements  Minimum number of elements for a threaded run.
+ */
+void RMNElementwiseSetParallelThreshold(size_t elements);
+/**
+ * @brief Multiply `count` elements by a real factor.
+ *
+ * Float types are multiplied by the factor rounded to their precision;
+ * complex types scale both parts.  Integer types are multiplied in double
+ * precision and converted back as RMNConvertElements() does (truncating,
+ * saturating at the type's limits).
+ *
+ * @param type    Element type of `values`.
+ * @param values  The elements, modified in place.
+ * @param count   Number of elements.
+ * @param factor  The factor.
+ * @return false if `type` is not numeric.
+ */
+bool RMNElementwiseScaleReal(OCNumberType type, void *values, size_t count, double factor);
+/**
+ * @brief Multiply `count` elements by a complex factor.
+ *
+ * Complex types are scaled with cblas_cscal() or cblas_zscal(), in blocks
+ * on several threads for large buffers, so results are those of the linked
+ * BLAS whichever kernel is selected.  Real and integer types keep the real
+ * part of the product, i.e. they are scaled by creal(factor) as in
+ * RMNElementwiseScaleReal().
+ *
+ * @param type    Element type of `values`.
+ * @param values  The elements, modified in place.
+ * @param count   Number of elements.
+ * @param factor  The factor.
+ * @return false if `type` is not numeric.
+ */
+bool RMNElementwiseScaleComplex(OCNumberType type, void *values, size_t count,
+                                double complex factor);
+/**
+ * @brief Negate the imaginary part of `count` complex elements.
+ *
+ * Only the sign bit changes.  Real and integer types are left unchanged.
+ *
+ * @return false if `type` is not numeric.
+ */
+bool RMNElementwiseConjugate(OCNumberType type, void *values, size_t count);
+/**
+ * @brief Replace `count` elements by their absolute value.
+ *
+ * Complex elements become (|z|, 0): the real part is the magnitude
+ * and the imaginary part is zero.  Complex128 uses hypot(), as cabs()
+ * does.  Complex64 computes sqrt(re² + im²) in double precision, matching
+ * glibc's cabsf() bit for bit; with other C libraries a finite result may
+ * differ from cabsf() by one ulp.  Infinite and NaN parts go through
+ * cabsf().  Signed integers use
+ * `x < 0 ? -x : x`; unsigned types are unchanged.
+ *
+ * @return false if `type` is not numeric.
+ */
+bool RMNElementwiseAbsolute(OCNumberType type, void *values, size_t count);
+/**
+ * @brief Binary operations for RMNElementwiseCombine().
+ */
+typedef enum {
+    kRMNElementwiseAdd = 0,
+    kRMNElementwiseSubtract,
+    kRMNElementwiseMultiply,
+    kRMNElementwiseDivide,
+} RMNElementwiseOperation;
+/**
+ * @brief Combine `count` elements with an operand buffer: x = x op (scale * y).
+ *
+ * The operand is converted to the element type of `values` (through
+ * RMNConvertElements()) and scaled in small cache-resident chunks, so a
+ * unit conversion or type change costs no extra pass over memory.  With
+ * `scale` 1 and matching types, real results are those of the plain C
+ * expression.  Complex products use the textbook formula; complex64
+ * quotients are computed in double precision and complex128 quotients with
+ * the C division operator.  Integer types are combined in double precision
+ * and converted back with saturation (so x / 0 saturates, 0 / 0 gives 0).
+ *
+ * `operand` may alias `values` exactly but must not partially overlap it.
+ *
+ * @param op           The operation.
+ * @param type         Element type of `values`.
+ * @param values       The left operands, replaced by the results.
+ * @param operandType  Element type of `operand`.
+ * @param operand      The right operands, `count` contiguous elements.
+ * @param count        Number of elements.
+ * @param scale        Factor applied to every right operand first.
+ * @return false if a type is not numeric, or `operand` is complex while
+ *         `type` is real (nothing is changed).
+ */
+bool RMNElementwiseCombine(RMNElementwiseOperation op, OCNumberType type, void *values,
+                           OCNumberType operandType, const void *operand, size_t count,
+                           double scale);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNELEMENTWISE_H */
@@ -0,0 +1,468 @@
+// RMNHash.c
+#include "RMNHash.h"
+#include <string.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define RMN_HASH_CRC_X86 1
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define RMN_HASH_CRC_ARM 1
+#include <arm_acle.h>
+#endif
+#pragma region XXH3
+// Port of XXH3-64 (xxHash 0.8, seed 0, default secret).  Inputs up to 240
+// bytes take the short paths; longer ones run eight 64-bit lanes over
+// 64-byte stripes, two lanes per instruction where SSE2 is available.
+#define kPrime32_1 0x9E3779B1U
+#define kPrime32_2 0x85EBCA77U
+#define kPrime32_3 0xC2B2AE3DU
+#define kPrime64_1 0x9E3779B185EBCA87ULL
+#define kPrime64_2 0xC2B2AE3D27D4EB4FULL
+#define kPrime64_3 0x165667B19E3779F9ULL
+#define kPrime64_4 0x85EBCA77C2B2AE63ULL
+#define kPrime64_5 0x27D4EB2F165667C5ULL
+#define kPrimeMx1 0x165667919E3779F9ULL
+#define kPrimeMx2 0x9FB21C651E98DF25ULL
+#define kStripeLength 64
+#define kSecretConsumeRate 8
+#define kSecretSize 192
+#define kStripesPerBlock ((kSecretSize - kStripeLength) / kSecretConsumeRate)
+#define kBlockLength (kStripeLength * kStripesPerBlock)
+static const uint8_t kSecret[kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+/// Little-endian loads; memcpy keeps them alignment-safe and compiles to a
+/// single load on common targets.
+static inline uint32_t impl_Read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+static inline uint64_t impl_Read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+static inline uint32_t impl_Swap32(uint32_t x) {
+    return ((x << 24) & 0xff000000U) | ((x << 8) & 0x00ff0000U) | ((x >> 8) & 0x0000ff00U) |
+           ((x >> 24) & 0x000000ffU);
+}
+static inline uint64_t impl_Swap64(uint64_t x) {
+    return ((uint64_t)impl_Swap32((uint32_t)x) << 32) | impl_Swap32((uint32_t)(x >> 32));
+}
+static inline uint64_t impl_Rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+/// Low and high halves of the 128-bit product, xor-ed together.
+static inline uint64_t impl_Mul128Fold64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 p = (unsigned __int128)a * b;
+    return (uint64_t)p ^ (uint64_t)(p >> 64);
+#else
+    uint64_t aLo = (uint32_t)a, aHi = a >> 32, bLo = (uint32_t)b, bHi = b >> 32;
+    uint64_t lolo = aLo * bLo, hilo = aHi * bLo, lohi = aLo * bHi, hihi = aHi * bHi;
+    uint64_t cross = (lolo >> 32) + (uint32_t)hilo + lohi;
+    uint64_t hi = (hilo >> 32) + (cross >> 32) + hihi;
+    uint64_t lo = (cross << 32) | (uint32_t)lolo;
+    return lo ^ hi;
+#endif
+}
+static inline uint64_t impl_XXH64Avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= kPrime64_2;
+    h ^= h >> 29;
+    h *= kPrime64_3;
+    return h ^ (h >> 32);
+}
+static inline uint64_t impl_Avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= kPrimeMx1;
+    return h ^ (h >> 32);
+}
+static inline uint64_t impl_Rrmxmx(uint64_t h, uint64_t length) {
+    h ^= impl_Rotl64(h, 49) ^ impl_Rotl64(h, 24);
+    h *= kPrimeMx2;
+    h ^= (h >> 35) + length;
+    h *= kPrimeMx2;
+    return h ^ (h >> 28);
+}
+static inline uint64_t impl_Mix16(const uint8_t *p, const uint8_t *secret) {
+    return impl_Mul128Fold64(impl_Read64(p) ^ impl_Read64(secret),
+                             impl_Read64(p + 8) ^ impl_Read64(secret + 8));
+}
+static uint64_t impl_Hash0To16(const uint8_t *p, size_t length) {
+    if (length > 8) {
+        uint64_t lo = impl_Read64(p) ^ (impl_Read64(kSecret + 24) ^ impl_Read64(kSecret + 32));
+        uint64_t hi =
+            impl_Read64(p + length - 8) ^ (impl_Read64(kSecret + 40) ^ impl_Read64(kSecret + 48));
+        uint64_t acc = length + impl_Swap64(lo) + hi + impl_Mul128Fold64(lo, hi);
+        return impl_Avalanche(acc);
+    }
+    if (length >= 4) {
+        uint64_t in = impl_Read32(p + length - 4) + ((uint64_t)impl_Read32(p) << 32);
+        return impl_Rrmxmx(in ^ (impl_Read64(kSecret + 8) ^ impl_Read64(kSecret + 16)), length);
+    }
+    if (length > 0) {
+        uint32_t combined = ((uint32_t)p[0] << 16) | ((uint32_t)p[length >> 1] << 24) |
+                            (uint32_t)p[length - 1] | ((uint32_t)length << 8);
+        uint64_t flip = impl_Read32(kSecret) ^ impl_Read32(kSecret + 4);
+        return impl_XXH64Avalanche((uint64_t)combined ^ flip);
+    }
+    return impl_XXH64Avalanche(impl_Read64(kSecret + 56) ^ impl_Read64(kSecret + 64));
+}
+static uint64_t impl_Hash17To128(const uint8_t *p, size_t length) {
+    uint64_t acc = length * kPrime64_1;
+    if (length > 32) {
+        if (length > 64) {
+            if (length > 96) {
+                acc += impl_Mix16(p + 48, kSecret + 96);
+                acc += impl_Mix16(p + length - 64, kSecret + 112);
+            }
+            acc += impl_Mix16(p + 32, kSecret + 64);
+            acc += impl_Mix16(p + length - 48, kSecret + 80);
+        }
+        acc += impl_Mix16(p + 16, kSecret + 32);
+        acc += impl_Mix16(p + length - 32, kSecret + 48);
+    }
+    acc += impl_Mix16(p, kSecret);
+    acc += impl_Mix16(p + length - 16, kSecret + 16);
+    return impl_Avalanche(acc);
+}
+static uint64_t impl_Hash129To240(const uint8_t *p, size_t length) {
+    uint64_t acc = length * kPrime64_1;
+    size_t rounds = length / 16;
+    for (size_t i = 0; i < 8; ++i) acc += impl_Mix16(p + 16 * i, kSecret + 16 * i);
+    acc = impl_Avalanche(acc);
+    for (size_t i = 8; i < rounds; ++i) acc += impl_Mix16(p + 16 * i, kSecret + 16 * (i - 8) + 3);
+    acc += impl_Mix16(p + length - 16, kSecret + 136 - 17);
+    return impl_Avalanche(acc);
+}
+#if defined(__SSE2__)
+// SSE2 is part of the x86-64 baseline, so this needs no runtime dispatch;
+// it processes two lanes per instruction, as the reference SSE2 path does.
+static inline void impl_Accumulate512(uint64_t acc[8], const uint8_t *p, const uint8_t *secret) {
+    for (int i = 0; i < 4; ++i) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(acc + 2 * i));
+        __m128i value = _mm_loadu_si128((const __m128i *)(p + 16 * i));
+        __m128i key = _mm_xor_si128(value, _mm_loadu_si128((const __m128i *)(secret + 16 * i)));
+        __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+        a = _mm_add_epi64(a, _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2)));
+        _mm_storeu_si128((__m128i *)(acc + 2 * i), _mm_add_epi64(a, product));
+    }
+}
+static inline void impl_Scramble(uint64_t acc[8], const uint8_t *secret) {
+    const __m128i prime = _mm_set1_epi32((int)kPrime32_1);
+    for (int i = 0; i < 4; ++i) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(acc + 2 * i));
+        a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+        a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i *)(secret + 16 * i)));
+        __m128i lo = _mm_mul_epu32(a, prime);
+        __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128((__m128i *)(acc + 2 * i), _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+    }
+}
+#else
+static inline void impl_Accumulate512(uint64_t acc[8], const uint8_t *p, const uint8_t *secret) {
+    for (int i = 0; i < 8; ++i) {
+        uint64_t value = impl_Read64(p + 8 * i);
+        uint64_t key = value ^ impl_Read64(secret + 8 * i);
+        acc[i ^ 1] += value;
+        acc[i] += (uint64_t)(uint32_t)key * (key >> 32);
+    }
+}
+static inline void impl_Scramble(uint64_t acc[8], const uint8_t *secret) {
+    for (int i = 0; i < 8; ++i) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= impl_Read64(secret + 8 * i);
+        acc[i] = a * kPrime32_1;
+    }
+}
+#endif
+static uint64_t impl_HashLong(const uint8_t *p, size_t length) {
+    uint64_t acc[8] = {kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3,
+                       kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1};
+    size_t blocks = (length - 1) / kBlockLength;
+    for (size_t b = 0; b < blocks; ++b) {
+        const uint8_t *block = p + b * kBlockLength;
+        for (size_t s = 0; s < kStripesPerBlock; ++s)
+            impl_Accumulate512(acc, block + s * kStripeLength, kSecret + s * kSecretConsumeRate);
+        impl_Scramble(acc, kSecret + kSecretSize - kStripeLength);
+    }
+    // the partial last block, then the final stripe (which may overlap it)
+    size_t stripes = ((length - 1) - blocks * kBlockLength) / kStripeLength;
+    const uint8_t *tail = p + blocks * kBlockLength;
+    for (size_t s = 0; s < stripes; ++s)
+        impl_Accumulate512(acc, tail + s * kStripeLength, kSecret + s * kSecretConsumeRate);
+    impl_Accumulate512(acc, p + length - kStripeLength, kSecret + kSecretSize - kStripeLength - 7);
+    uint64_t result = length * kPrime64_1;
+    for (int i = 0; i < 4; ++i)
+        result += impl_Mul128Fold64(acc[2 * i] ^ impl_Read64(kSecret + 11 + 16 * i),
+                                    acc[2 * i + 1] ^ impl_Read64(kSecret + 11 + 16 * i + 8));
+    return impl_Avalanche(result);
+}
+#pragma endregion XXH3
+#pragma region CRC32C
+// CRC-32C (Castagnoli, reflected polynomial 0x82F63B78).  With SSE4.2 or
+// the ARMv8 CRC extension the crc32 instruction does eight bytes per step;
+// its three-cycle latency is hidden by running three independent streams
+// over adjacent ranges and merging them with a precomputed "shift by n zero
+// bytes" operator (Mark Adler's crc32c.c).  Elsewhere a bytewise table.
+#if RMN_HASH_CRC_X86 || RMN_HASH_CRC_ARM
+#define kCRCLongLength 8192
+#define kCRCShortLength 256
+#define kCRCStreamThreshold ((size_t)1 << 20)  // copies at least this large bypass the cache
+// Entry k is the register after kCRC*Length zero bytes starting from 1 << k.
+static const uint32_t kCRCShiftLong[32] = {
+    0xE040E0AC, 0xC56DB7A9, 0x8F3719A3, 0x1B8245B7, 0x37048B6E, 0x6E0916DC,
+    0xDC122DB8, 0xBDC82D81, 0x7E7C2DF3, 0xFCF85BE6, 0xFC1CC13D, 0xFDD5F48B,
+    0xFE479FE7, 0xF963493F, 0xF72AE48F, 0xEBB9BFEF, 0xD29F092F, 0xA0D264AF,
+    0x4448BFAF, 0x88917F5E, 0x14CE884D, 0x299D109A, 0x533A2134, 0xA6744268,
+    0x4904F221, 0x9209E442, 0x21FFBE75, 0x43FF7CEA, 0x87FEF9D4, 0x0A118559,
+    0x14230AB2, 0x28461564,
+};
+static const uint32_t kCRCShiftShort[32] = {
+    0xDCB17AA4, 0xBC8E83B9, 0x7CF17183, 0xF9E2E306, 0xF629B0FD, 0xE9BF170B,
+    0xD69258E7, 0xA8C8C73F, 0x547DF88F, 0xA8FBF11E, 0x541B94CD, 0xA837299A,
+    0x558225C5, 0xAB044B8A, 0x53E4E1E5, 0xA7C9C3CA, 0x4A7FF165, 0x94FFE2CA,
+    0x2C13B365, 0x582766CA, 0xB04ECD94, 0x6571EDD9, 0xCAE3DBB2, 0x902BC195,
+    0x25BBF5DB, 0x4B77EBB6, 0x96EFD76C, 0x2833D829, 0x5067B052, 0xA0CF60A4,
+    0x4472B7B9, 0x88E56F72,
+};
+// The same operators as byte tables, four lookups per shift; built on first
+// use (the race is benign: every thread stores the same values).
+static uint32_t gCRCShiftLongTable[4][256];
+static uint32_t gCRCShiftShortTable[4][256];
+static int gCRCShiftTablesReady = 0;
+static void impl_CRCBuildShiftTable(const uint32_t shift[32], uint32_t table[4][256]) {
+    for (int k = 0; k < 4; ++k) {
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint32_t sum = 0;
+            for (int i = 0; i < 8; ++i)
+                if (b & (1U << i)) sum ^= shift[8 * k + i];
+            table[k][b] = sum;
+        }
+    }
+}
+static void impl_CRCPrepareShiftTables(void) {
+    if (__atomic_load_n(&gCRCShiftTablesReady, __ATOMIC_ACQUIRE)) return;
+    impl_CRCBuildShiftTable(kCRCShiftLong, gCRCShiftLongTable);
+    impl_CRCBuildShiftTable(kCRCShiftShort, gCRCShiftShortTable);
+    __atomic_store_n(&gCRCShiftTablesReady, 1, __ATOMIC_RELEASE);
+}
+static inline uint32_t impl_CRCShift(const uint32_t table[4][256], uint32_t crc) {
+    return table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF] ^ table[2][(crc >> 16) & 0xFF] ^
+           table[3][crc >> 24];
+}
+#endif
+#if RMN_HASH_CRC_X86
+#define RMN_TARGET_CRC __attribute__((target("sse4.2")))
+#define impl_CRCStep64(crc, p) ((uint32_t)_mm_crc32_u64((crc), impl_Read64(p)))
+#define impl_CRCStep8(crc, p) _mm_crc32_u8((crc), *(p))
+#elif RMN_HASH_CRC_ARM
+#define RMN_TARGET_CRC
+#define impl_CRCStep64(crc, p) __crc32cd((crc), impl_Read64(p))
+#define impl_CRCStep8(crc, p) __crc32cb((crc), *(p))
+#endif
+#if RMN_HASH_CRC_X86 || RMN_HASH_CRC_ARM
+/// Copy eight bytes for RMNHashCRC32CCopy(); `stream` bypasses the cache
+/// (x86), so a large destination is not read in before being overwritten.
+RMN_TARGET_CRC static inline void impl_CRCCopy64(uint8_t *dst, const uint8_t *src, bool stream) {
+    uint64_t v;
+    memcpy(&v, src, sizeof(v));
+#if RMN_HASH_CRC_X86
+    if (stream) {
+        _mm_stream_si64((long long *)(void *)dst, (long long)v);
+        return;
+    }
+#else
+    (void)stream;
+#endif
+    memcpy(dst, &v, sizeof(v));
+}
+/// Three streams of `stride` bytes each, merged into `crc`, copying them
+/// to `dst` unless it is NULL; returns the number of bytes consumed (a
+/// multiple of 3 * stride).  Always inlined, so the copy drops out of the
+/// checksum-only loop.
+RMN_TARGET_CRC static inline __attribute__((always_inline)) size_t
+impl_CRCInterleaved(uint32_t *crc, uint8_t *dst, const uint8_t *p, size_t length, size_t stride,
+                    const uint32_t shift[4][256], bool stream) {
+    size_t done = 0;
+    while (length - done >= 3 * stride) {
+        const uint8_t *a = p + done, *b = a + stride, *c = b + stride;
+        uint32_t c0 = *crc, c1 = 0, c2 = 0;
+        for (size_t i = 0; i < stride; i += 8) {
+            c0 = impl_CRCStep64(c0, a + i);
+            c1 = impl_CRCStep64(c1, b + i);
+            c2 = impl_CRCStep64(c2, c + i);
+            if (dst) {
+                impl_CRCCopy64(dst + done + i, a + i, stream);
+                impl_CRCCopy64(dst + done + stride + i, b + i, stream);
+                impl_CRCCopy64(dst + done + 2 * stride + i, c + i, stream);
+            }
+        }
+        *crc = impl_CRCShift(shift, impl_CRCShift(shift, c0) ^ c1) ^ c2;
+        done += 3 * stride;
+    }
+    return done;
+}
+RMN_TARGET_CRC static inline __attribute__((always_inline)) uint32_t
+impl_CRC32CHardware(uint32_t crc, uint8_t *dst, const uint8_t *p, size_t length, bool stream) {
+    // byte steps up to an 8-byte boundary (of the destination when copying)
+    while (length && ((uintptr_t)(dst ? (const uint8_t *)dst : p) & 7)) {
+        crc = impl_CRCStep8(crc, p);
+        if (dst) *dst++ = *p;
+        ++p, --length;
+    }
+    impl_CRCPrepareShiftTables();
+    size_t n = impl_CRCInterleaved(&crc, dst, p, length, kCRCLongLength, gCRCShiftLongTable,
+                                   stream);
+    n += impl_CRCInterleaved(&crc, dst ? dst + n : NULL, p + n, length - n, kCRCShortLength,
+                             gCRCShiftShortTable, stream);
+    p += n, length -= n;
+    if (dst) dst += n;
+    for (; length >= 8; p += 8, length -= 8) {
+        crc = impl_CRCStep64(crc, p);
+        if (dst) impl_CRCCopy64(dst, p, stream), dst += 8;
+    }
+    for (; length; ++p, --length) {
+        crc = impl_CRCStep8(crc, p);
+        if (dst) *dst++ = *p;
+    }
+#if RMN_HASH_CRC_X86
+    if (stream) _mm_sfence();
+#endif
+    return crc;
+}
+RMN_TARGET_CRC static uint32_t impl_CRC32CSum(uint32_t crc, const uint8_t *p, size_t length) {
+    return impl_CRC32CHardware(crc, NULL, p, length, false);
+}
+RMN_TARGET_CRC static uint32_t impl_CRC32CCopy(uint32_t crc, uint8_t *dst, const uint8_t *p,
+                                               size_t length) {
+    if (length >= kCRCStreamThreshold)
+        return impl_CRC32CHardware(crc, dst, p, length, true);
+    return impl_CRC32CHardware(crc, dst, p, length, false);
+}
+#endif
+static const uint32_t kCRCTable[256] = {
+    0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C, 0x26A1E7E8, 0xD4CA64EB,
+    0x8AD958CF, 0x78B2DBCC, 0x6BE22838, 0x9989AB3B, 0x4D43CFD0, 0xBF284CD3, 0xAC78BF27, 0x5E133C24,
+    0x105EC76F, 0xE235446C, 0xF165B798, 0x030E349B, 0xD7C45070, 0x25AFD373, 0x36FF2087, 0xC494A384,
+    0x9A879FA0, 0x68EC1CA3, 0x7BBCEF57, 0x89D76C54, 0x5D1D08BF, 0xAF768BBC, 0xBC267848, 0x4E4DFB4B,
+    0x20BD8EDE, 0xD2D60DDD, 0xC186FE29, 0x33ED7D2A, 0xE72719C1, 0x154C9AC2, 0x061C6936, 0xF477EA35,
+    0xAA64D611, 0x580F5512, 0x4B5FA6E6, 0xB93425E5, 0x6DFE410E, 0x9F95C20D, 0x8CC531F9, 0x7EAEB2FA,
+    0x30E349B1, 0xC288CAB2, 0xD1D83946, 0x23B3BA45, 0xF779DEAE, 0x05125DAD, 0x1642AE59, 0xE4292D5A,
+    0xBA3A117E, 0x4851927D, 0x5B016189, 0xA96AE28A, 0x7DA08661, 0x8FCB0562, 0x9C9BF696, 0x6EF07595,
+    0x417B1DBC, 0xB3109EBF, 0xA0406D4B, 0x522BEE48, 0x86E18AA3, 0x748A09A0, 0x67DAFA54, 0x95B17957,
+    0xCBA24573, 0x39C9C670, 0x2A993584, 0xD8F2B687, 0x0C38D26C, 0xFE53516F, 0xED03A29B, 0x1F682198,
+    0x5125DAD3, 0xA34E59D0, 0xB01EAA24, 0x42752927, 0x96BF4DCC, 0x64D4CECF, 0x77843D3B, 0x85EFBE38,
+    0xDBFC821C, 0x2997011F, 0x3AC7F2EB, 0xC8AC71E8, 0x1C661503, 0xEE0D9600, 0xFD5D65F4, 0x0F36E6F7,
+    0x61C69362, 0x93AD1061, 0x80FDE395, 0x72966096, 0xA65C047D, 0x5437877E, 0x4767748A, 0xB50CF789,
+    0xEB1FCBAD, 0x197448AE, 0x0A24BB5A, 0xF84F3859, 0x2C855CB2, 0xDEEEDFB1, 0xCDBE2C45, 0x3FD5AF46,
+    0x7198540D, 0x83F3D70E, 0x90A324FA, 0x62C8A7F9, 0xB602C312, 0x44694011, 0x5739B3E5, 0xA55230E6,
+    0xFB410CC2, 0x092A8FC1, 0x1A7A7C35, 0xE811FF36, 0x3CDB9BDD, 0xCEB018DE, 0xDDE0EB2A, 0x2F8B6829,
+    0x82F63B78, 0x709DB87B, 0x63CD4B8F, 0x91A6C88C, 0x456CAC67, 0xB7072F64, 0xA457DC90, 0x563C5F93,
+    0x082F63B7, 0xFA44E0B4, 0xE9141340, 0x1B7F9043, 0xCFB5F4A8, 0x3DDE77AB, 0x2E8E845F, 0xDCE5075C,
+    0x92A8FC17, 0x60C37F14, 0x73938CE0, 0x81F80FE3, 0x55326B08, 0xA759E80B, 0xB4091BFF, 0x466298FC,
+    0x1871A4D8, 0xEA1A27DB, 0xF94AD42F, 0x0B21572C, 0xDFEB33C7, 0x2D80B0C4, 0x3ED04330, 0xCCBBC033,
+    0xA24BB5A6, 0x502036A5, 0x4370C551, 0xB11B4652, 0x65D122B9, 0x97BAA1BA, 0x84EA524E, 0x7681D14D,
+    0x2892ED69, 0xDAF96E6A, 0xC9A99D9E, 0x3BC21E9D, 0xEF087A76, 0x1D63F975, 0x0E330A81, 0xFC588982,
+    0xB21572C9, 0x407EF1CA, 0x532E023E, 0xA145813D, 0x758FE5D6, 0x87E466D5, 0x94B49521, 0x66DF1622,
+    0x38CC2A06, 0xCAA7A905, 0xD9F75AF1, 0x2B9CD9F2, 0xFF56BD19, 0x0D3D3E1A, 0x1E6DCDEE, 0xEC064EED,
+    0xC38D26C4, 0x31E6A5C7, 0x22B65633, 0xD0DDD530, 0x0417B1DB, 0xF67C32D8, 0xE52CC12C, 0x1747422F,
+    0x49547E0B, 0xBB3FFD08, 0xA86F0EFC, 0x5A048DFF, 0x8ECEE914, 0x7CA56A17, 0x6FF599E3, 0x9D9E1AE0,
+    0xD3D3E1AB, 0x21B862A8, 0x32E8915C, 0xC083125F, 0x144976B4, 0xE622F5B7, 0xF5720643, 0x07198540,
+    0x590AB964, 0xAB613A67, 0xB831C993, 0x4A5A4A90, 0x9E902E7B, 0x6CFBAD78, 0x7FAB5E8C, 0x8DC0DD8F,
+    0xE330A81A, 0x115B2B19, 0x020BD8ED, 0xF0605BEE, 0x24AA3F05, 0xD6C1BC06, 0xC5914FF2, 0x37FACCF1,
+    0x69E9F0D5, 0x9B8273D6, 0x88D28022, 0x7AB90321, 0xAE7367CA, 0x5C18E4C9, 0x4F48173D, 0xBD23943E,
+    0xF36E6F75, 0x0105EC76, 0x12551F82, 0xE03E9C81, 0x34F4F86A, 0xC69F7B69, 0xD5CF889D, 0x27A40B9E,
+    0x79B737BA, 0x8BDCB4B9, 0x988C474D, 0x6AE7C44E, 0xBE2DA0A5, 0x4C4623A6, 0x5F16D052, 0xAD7D5351,
+};
+static uint32_t impl_CRC32CTable(uint32_t crc, const uint8_t *p, size_t length) {
+    for (; length; ++p, --length) crc = (crc >> 8) ^ kCRCTable[(crc ^ *p) & 0xFF];
+    return crc;
+}
+#if RMN_HASH_CRC_X86
+// -1 until first use; the race on first use is benign (same value stored)
+static volatile int gRMNHashCRCHardware = -1;
+#endif
+static inline bool impl_CRCHasHardware(void) {
+#if RMN_HASH_CRC_X86
+    int h = gRMNHashCRCHardware;
+    if (h < 0) {
+        __builtin_cpu_init();
+        gRMNHashCRCHardware = h = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+    }
+    return h != 0;
+#elif RMN_HASH_CRC_ARM
+    return true;
+#else
+    return false;
+#endif
+}
+#pragma endregion CRC32C
+uint64_t RMNHashXXH3(const void *data, size_t length) {
+    const uint8_t *p = data;
+    if (!p) length = 0;
+    if (length <= 16) return impl_Hash0To16(p, length);
+    if (length <= 128) return impl_Hash17To128(p, length);
+    if (length <= 240) return impl_Hash129To240(p, length);
+    return impl_HashLong(p, length);
+}
+uint32_t RMNHashCRC32C(uint32_t crc, const void *data, size_t length) {
+    const uint8_t *p = data;
+    if (!p || !length) return crc;
+    crc = ~crc;
+#if RMN_HASH_CRC_X86 || RMN_HASH_CRC_ARM
+    if (impl_CRCHasHardware()) return ~impl_CRC32CSum(crc, p, length);
+#endif
+    return ~impl_CRC32CTable(crc, p, length);
+}
+uint32_t RMNHashCRC32CCopy(uint32_t crc, void *dst, const void *src, size_t length) {
+    if (!dst || !src || !length) return crc;
+#if RMN_HASH_CRC_X86 || RMN_HASH_CRC_ARM
+    if (impl_CRCHasHardware()) return ~impl_CRC32CCopy(~crc, dst, src, length);
+#endif
+    memcpy(dst, src, length);
+    return RMNHashCRC32C(crc, dst, length);
+}
+void RMNHashFormat(uint64_t hash, char *out) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = kRMNHashHexLength - 1; i >= 0; --i, hash >>= 4) out[i] = digits[hash & 0xF];
+    out[kRMNHashHexLength] = '\0';
+}
+bool RMNHashParse(const char *text, uint64_t *hash) {
+    if (!text) return false;
+    uint64_t v = 0;
+    for (int i = 0; i < kRMNHashHexLength; ++i) {
+        char c = text[i];
+        int d = c >= '0' && c <= '9'   ? c - '0'
+                : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                       : -1;
+        if (d < 0) return false;
+        v = (v << 4) | (uint64_t)d;
+    }
+    if (text[kRMNHashHexLength] != '\0') return false;
+    if (hash) *hash = v;
+    return true;
+}
@@ -0,0 +1,93 @@
+// RMNHash.h
+#ifndef RMNHASH_H
+#define RMNHASH_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNHash.h
+ * @brief Fast non-cryptographic content hashes and checksums.
+ *
+ * RMNHashXXH3() recognises identical external blobs on export and lets
+ * callers tell whether a component changed without comparing its bytes.
+ * It is XXH3-64 (seed 0, default secret) from the xxHash family, so values
+ * match those of the reference library and its bindings.
+ *
+ * RMNHashCRC32C() guards blobs against corruption in storage; it uses the
+ * SSE4.2 / ARMv8 crc32 instructions when the CPU has them.
+ */
+/**
+ * @brief Key in a dependent variable's "application" metadata under which
+ *        DatasetExport() records its components' hashes.
+ *
+ * The value is an array with one 16-digit lowercase hexadecimal string per
+ * component (see RMNHashFormat()).
+ */
+#define kRMNHashComponentsMetaDataKey "rmnlib.components_xxh3"
+/**
+ * @brief Key in a dependent variable's "application" metadata under which
+ *        DatasetExport() records the CRC-32C of its external blob.
+ *
+ * The value is a dictionary holding kRMNHashBlockSizeKey, the block size in
+ * bytes, and kRMNHashCRC32CKey, an array with one 8-digit lowercase
+ * hexadecimal string per block of the blob as stored (the last block may be
+ * short).  See DatasetSetBlobChecksums().
+ */
+#define kRMNHashBlobChecksumMetaDataKey "rmnlib.blob_crc32c"
+/** @brief Block size entry of a kRMNHashBlobChecksumMetaDataKey record. */
+#define kRMNHashBlockSizeKey "block_size"
+/** @brief Checksum array entry of a kRMNHashBlobChecksumMetaDataKey record. */
+#define kRMNHashCRC32CKey "crc32c"
+/** @brief Characters written by RMNHashFormat(), not counting the NUL. */
+#define kRMNHashHexLength 16
+/**
+ * @brief XXH3-64 of `length` bytes at `data`.
+ * @param data    Bytes to hash (may be NULL when `length` is 0).
+ * @param length  Number of bytes.
+ * @return The 64-bit hash, identical on every platform.
+ */
+uint64_t RMNHashXXH3(const void *data, size_t length);
+/**
+ * @brief CRC-32C (Castagnoli) of `length` bytes at `data`, continuing `crc`.
+ *
+ * Pass 0 to start; feeding the result back in with the following bytes
+ * gives the checksum of the concatenation.  The check value of "123456789"
+ * is 0xE3069283.
+ * @param crc     Checksum of the preceding bytes, or 0.
+ * @param data    Bytes to add (may be NULL when `length` is 0).
+ * @param length  Number of bytes.
+ * @return The updated checksum.
+ */
+uint32_t RMNHashCRC32C(uint32_t crc, const void *data, size_t length);
+/**
+ * @brief Copy `length` bytes from `src` to `dst` and return RMNHashCRC32C()
+ *        of them, continuing `crc`, in a single pass over the data.
+ *
+ * Cheaper than memcpy() followed by RMNHashCRC32C(): each byte is read
+ * once.  Large copies bypass the cache on x86, as memcpy() does.
+ * @param crc     Checksum of the preceding bytes, or 0.
+ * @param dst     Destination; must not overlap `src`.
+ * @param src     Bytes to copy and add.
+ * @param length  Number of bytes.
+ * @return The updated checksum.
+ */
+uint32_t RMNHashCRC32CCopy(uint32_t crc, void *dst, const void *src, size_t length);
+/**
+ * @brief Write `hash` as kRMNHashHexLength lowercase hexadecimal digits.
+ * @param hash  Value to format.
+ * @param out   Destination with room for kRMNHashHexLength + 1 characters;
+ *              a terminating NUL is written.
+ */
+void RMNHashFormat(uint64_t hash, char *out);
+/**
+ * @brief Parse the text written by RMNHashFormat().
+ * @param text       Exactly kRMNHashHexLength hexadecimal digits, NUL-terminated.
+ * @param[out] hash  Parsed value.
+ * @return false if `text` is not such a string.
+ */
+bool RMNHashParse(const char *text, uint64_t *hash);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNHASH_H */
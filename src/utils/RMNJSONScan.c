@@ -0,0 +1,112 @@
+// RMNJSONScan.c
+#include <string.h>
+#include "RMNJSONScan.h"
+static bool impl_IsJSONWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+const char *RMNJSONSkipWhitespace(const char *p, const char *end) {
+    if (!p) return NULL;
+    while (p < end && impl_IsJSONWhitespace(*p)) ++p;
+    return p;
+}
+/// p points at the opening quote; returns the position past the closing one.
+static const char *impl_SkipString(const char *p, const char *end) {
+    ++p;
+    while (p < end) {
+        const char *q = memchr(p, '"', (size_t)(end - p));
+        if (!q) return NULL;
+        // the quote is escaped only if preceded by an odd number of backslashes
+        size_t slashes = 0;
+        for (const char *b = q; b > p && b[-1] == '\\'; --b) ++slashes;
+        if ((slashes & 1) == 0) return q + 1;
+        p = q + 1;
+    }
+    return NULL;
+}
+const char *RMNJSONSkipValue(const char *p, const char *end) {
+    p = RMNJSONSkipWhitespace(p, end);
+    if (!p || p >= end) return NULL;
+    switch (*p) {
+        case '"':
+            return impl_SkipString(p, end);
+        case '{':
+        case '[': {
+            // track nesting only; strings are skipped whole so brackets inside
+            // them are ignored
+            size_t depth = 0;
+            while (p < end) {
+                char c = *p;
+                if (c == '"') {
+                    p = impl_SkipString(p, end);
+                    if (!p) return NULL;
+                    continue;
+                }
+                if (c == '{' || c == '[') {
+                    ++depth;
+                } else if (c == '}' || c == ']') {
+                    if (--depth == 0) return p + 1;
+                }
+                ++p;
+            }
+            return NULL;
+        }
+        default: {
+            // number, true, false, null
+            const char *start = p;
+            while (p < end && *p != ',' && *p != '}' && *p != ']' && !impl_IsJSONWhitespace(*p)) ++p;
+            return p > start ? p : NULL;
+        }
+    }
+}
+const char *RMNJSONObjectNextMember(const char *p, const char *end,
+                                    const char **key, size_t *keyLength,
+                                    const char **valueEnd) {
+    p = RMNJSONSkipWhitespace(p, end);
+    if (!p || p >= end) return NULL;
+    if (*p != '{' && *p != ',') return NULL;  // '}' or malformed
+    p = RMNJSONSkipWhitespace(p + 1, end);
+    if (p >= end || *p != '"') return NULL;
+    const char *kEnd = impl_SkipString(p, end);
+    if (!kEnd) return NULL;
+    if (key) *key = p + 1;
+    if (keyLength) *keyLength = (size_t)(kEnd - 1 - (p + 1));
+    p = RMNJSONSkipWhitespace(kEnd, end);
+    if (p >= end || *p != ':') return NULL;
+    const char *value = RMNJSONSkipWhitespace(p + 1, end);
+    const char *vEnd = RMNJSONSkipValue(value, end);
+    if (!vEnd) return NULL;
+    if (valueEnd) *valueEnd = vEnd;
+    return value;
+}
+const char *RMNJSONFindMember(const char *object, const char *end,
+                              const char *key, const char **valueEnd) {
+    if (!key) return NULL;
+    size_t keyLen = strlen(key);
+    const char *k = NULL, *vEnd = NULL;
+    size_t kLen = 0;
+    for (const char *v = RMNJSONObjectNextMember(object, end, &k, &kLen, &vEnd); v;
+         v = RMNJSONObjectNextMember(vEnd, end, &k, &kLen, &vEnd)) {
+        if (kLen == keyLen && memcmp(k, key, keyLen) == 0) {
+            if (valueEnd) *valueEnd = vEnd;
+            return v;
+        }
+    }
+    return NULL;
+}
+const char *RMNJSONArrayNextElement(const char *p, const char *end) {
+    p = RMNJSONSkipWhitespace(p, end);
+    if (!p || p >= end) return NULL;
+    if (*p == '[') {
+        p = RMNJSONSkipWhitespace(p + 1, end);
+        return (p < end && *p != ']') ? p : NULL;
+    }
+    if (*p != ',') return NULL;
+    p = RMNJSONSkipWhitespace(p + 1, end);
+    return (p < end && *p != ']') ? p : NULL;
+}
+bool RMNJSONStringEquals(const char *value, const char *valueEnd, const char *text) {
+    if (!value || !valueEnd || !text) return false;
+    size_t n = strlen(text);
+    return (size_t)(valueEnd - value) == n + 2 && value[0] == '"' &&
+           memcmp(value + 1, text, n) == 0 && valueEnd[-1] == '"';
+}
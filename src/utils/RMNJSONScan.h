@@ -0,0 +1,83 @@
+// RMNJSONScan.h
+#ifndef RMNJSONSCAN_H
+#define RMNJSONSCAN_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNJSONScan.h
+ * @brief Allocation-free helpers for walking JSON text without building a DOM.
+ *
+ * The CSDM readers use these to locate large values (component payloads)
+ * inside a document and handle them directly, leaving only the small
+ * remainder for cJSON.  Every function takes a `[p, end)` span and returns
+ * NULL on malformed input or when nothing more is found; callers treat
+ * NULL as "fall back to the full parser".
+ */
+/**
+ * @brief Skip JSON whitespace.
+ * @return First non-whitespace position (may equal `end`).
+ */
+const char *RMNJSONSkipWhitespace(const char *p, const char *end);
+/**
+ * @brief Skip one complete JSON value of any type.
+ *
+ * Strings are skipped with memchr() on the closing quote, so long base64
+ * bodies cost little more than a memory scan.
+ *
+ * @param p    First character of the value (leading whitespace allowed).
+ * @param end  End of the text.
+ * @return Position just past the value, or NULL if malformed.
+ */
+const char *RMNJSONSkipValue(const char *p, const char *end);
+/**
+ * @brief Step through the members of a JSON object.
+ *
+ * Pass the position of the opening '{' to get the first member, then the
+ * previous member's `*valueEnd` to get the next one.
+ *
+ * @param p              '{' or the end of the previous member's value.
+ * @param end            End of the text.
+ * @param[out] key       Set to the first character of the key (inside the quotes).
+ * @param[out] keyLength Set to the raw key length in bytes.
+ * @param[out] valueEnd  Set to the position just past the value.
+ * @return First character of the member's value, or NULL at the closing
+ *         '}' or on malformed input.
+ */
+const char *RMNJSONObjectNextMember(const char *p, const char *end,
+                                    const char **key, size_t *keyLength,
+                                    const char **valueEnd);
+/**
+ * @brief Find a member of a JSON object by key.
+ *
+ * Keys are compared byte-for-byte; keys containing escapes never match.
+ * Like cJSON_GetObjectItemCaseSensitive(), the first match wins.
+ *
+ * @param object        Position of the object's opening '{'.
+ * @param end           End of the text.
+ * @param key           NUL-terminated key to look for.
+ * @param[out] valueEnd If non-NULL, set to the position just past the value.
+ * @return First character of the member's value, or NULL if absent/malformed.
+ */
+const char *RMNJSONFindMember(const char *object, const char *end,
+                              const char *key, const char **valueEnd);
+/**
+ * @brief Step through the elements of a JSON array.
+ *
+ * Pass the position of the opening '[' to get the first element, then the
+ * end of the previous element (as returned by RMNJSONSkipValue()) to get
+ * the next one.
+ *
+ * @return First character of the element, or NULL at the closing ']' or
+ *         on malformed input.
+ */
+const char *RMNJSONArrayNextElement(const char *p, const char *end);
+/**
+ * @brief Test whether `[value, valueEnd)` is the JSON string `"text"`.
+ */
+bool RMNJSONStringEquals(const char *value, const char *valueEnd, const char *text);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNJSONSCAN_H */
@@ -0,0 +1,59 @@
+// RMNParallel.c
+#include "RMNParallel.h"
+#if !defined(_MSC_VER)
+#define RMN_HAVE_PTHREADS 1
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+size_t RMNParallelProcessorCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+#if RMN_HAVE_PTHREADS
+typedef struct {
+    atomic_size_t next;
+    size_t count;
+    RMNParallelTask task;
+    void *context;
+} impl_ParallelJob;
+static void *impl_ParallelWorker(void *arg) {
+    impl_ParallelJob *job = arg;
+    for (size_t i; (i = atomic_fetch_add(&job->next, 1)) < job->count;)
+        job->task(job->context, i);
+    return NULL;
+}
+#endif
+void RMNParallelFor(size_t count, size_t workers, RMNParallelTask task, void *context) {
+    if (!task || count == 0) return;
+    if (workers > count) workers = count;
+#if RMN_HAVE_PTHREADS
+    if (workers > 1) {
+        impl_ParallelJob job = {.count = count, .task = task, .context = context};
+        atomic_init(&job.next, 0);
+        pthread_t *threads = malloc((workers - 1) * sizeof(*threads));
+        size_t started = 0;
+        if (threads) {
+            for (; started < workers - 1; ++started)
+                if (pthread_create(&threads[started], NULL, impl_ParallelWorker, &job) != 0) break;
+        }
+        // the caller works too; if no thread could be started it does everything
+        impl_ParallelWorker(&job);
+        for (size_t t = 0; t < started; ++t) pthread_join(threads[t], NULL);
+        free(threads);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) task(context, i);
+}
@@ -0,0 +1,43 @@
+// RMNParallel.h
+#ifndef RMNPARALLEL_H
+#define RMNPARALLEL_H
+#include "../RMNLibrary.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file RMNParallel.h
+ * @brief Minimal fork/join helper for running independent tasks on threads.
+ *
+ * Used by the Dataset readers and writers to overlap per-component work
+ * (blob I/O, base64 coding).  Tasks should be plain C work on memory the
+ * caller has already allocated: OCTypes retain counts are not atomic, so
+ * tasks must not create, retain, or release OCTypes objects.
+ */
+/**
+ * @brief A unit of work; called once for every index in the range.
+ * @param context  Caller data passed through unchanged.
+ * @param index    Task index in [0, count).
+ */
+typedef void (*RMNParallelTask)(void *context, size_t index);
+/**
+ * @brief Number of online processors (at least 1).
+ */
+size_t RMNParallelProcessorCount(void);
+/**
+ * @brief Run `task(context, i)` for every i in [0, count) and wait for all.
+ *
+ * Work is handed out one index at a time to at most `workers` threads (the
+ * calling thread is one of them).  With `workers <= 1`, a single task, or
+ * no thread support, the tasks simply run in order on the caller's thread.
+ *
+ * @param count    Number of tasks.
+ * @param workers  Maximum number of threads to use.
+ * @param task     Function to run for each index.
+ * @param context  Passed to every call of `task`.
+ */
+void RMNParallelFor(size_t count, size_t workers, RMNParallelTask task, void *context);
+#ifdef __cplusplus
+}
+#endif
+#endif /* RMNPARALLEL_H */
@@ -51,6 +51,7 @@ int main(void) {
     if (!test_SIDimension()) failures++;
     if (!test_SIMonotonic_and_SILinearDimension()) failures++;
     if (!test_minimal_monotonic()) failures++;
+    if (!test_DimensionCreateSubset()) failures++;
     fprintf(stderr, "\n=== Running DependentVariable Tests ===\n");
     if (!test_DependentVariable_base()) failures++;
     if (!test_DependentVariable_components()) failures++;
@@ -63,7 +64,16 @@ int main(void) {
     if (!test_DependentVariable_type_queries()) failures++;
     if (!test_DependentVariable_sparse_sampling()) failures++;
     if (!test_DependentVariable_copy_and_roundtrip()) failures++;
+    if (!test_DependentVariable_base64_kernels()) failures++;
     if (!test_DependentVariable_invalid_create()) failures++;
+    if (!test_DependentVariable_none_number_format()) failures++;
+    if (!test_DependentVariable_none_number_parse()) failures++;
+    if (!test_DependentVariable_none_dictionary_roundtrip()) failures++;
+    if (!test_DependentVariable_bulk_accessors()) failures++;
+    if (!test_DependentVariable_element_type_conversion()) failures++;
+    if (!test_DependentVariable_elementwise_kernels()) failures++;
+    if (!test_DependentVariable_binary_operations()) failures++;
+    if (!test_DependentVariable_deferred_operations()) failures++;
     fprintf(stderr, "\n=== Running SparseSampling Tests ===\n");
     if (!test_SparseSampling_basic_create()) failures++;
     if (!test_SparseSampling_validation()) failures++;
@@ -82,6 +92,24 @@ int main(void) {
     if (!test_Dataset_mutators()) failures++;
     if (!test_Dataset_type_contract()) failures++;
     if (!test_Dataset_copy_and_roundtrip()) failures++;
+    if (!test_Dataset_stream_export_roundtrip()) failures++;
+    if (!test_Dataset_import_inline_components()) failures++;
+    if (!test_Dataset_int64_none_roundtrip()) failures++;
+    if (!test_Dataset_nonfinite_none_roundtrip()) failures++;
+    if (!test_Dataset_parallel_io()) failures++;
+    if (!test_Dataset_external_export()) failures++;
+    if (!test_Dataset_mapped_blob_import()) failures++;
+    if (!test_Dataset_chunked_external()) failures++;
+    if (!test_Dataset_lazy_import()) failures++;
+    if (!test_Dataset_compressed_encodings()) failures++;
+    if (!test_Dataset_container_roundtrip()) failures++;
+    if (!test_Dataset_import_subset()) failures++;
+    if (!test_Dataset_streaming_writer()) failures++;
+    if (!test_Dataset_atomic_export()) failures++;
+    if (!test_Dataset_async_io()) failures++;
+    if (!test_Dataset_header_scan()) failures++;
+    if (!test_Dataset_export_dedup()) failures++;
+    if (!test_Dataset_blob_checksums()) failures++;
     fprintf(stderr, "\n=== Running CSDM Tests ===\n");
     if (!getenv("CSDM_TEST_ROOT")) {
         cross_platform_setenv("CSDM_TEST_ROOT",
@@ -133,6 +161,7 @@ int main(void) {
             getenv("TECMAG_TEST_ROOT"));
     // if (!test_Tecmag_single_file()) failures++;
     if (!test_Tecmag_import_all()) failures++;
+    if (!test_Tecmag_batch_convert()) failures++;
     if (failures > 0) {
         fprintf(stderr, "\n%d test%s failed.\n",
                 failures, failures > 1 ? "s" : "");
@@ -1,7 +1,11 @@
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -253,3 +257,1461 @@ cleanup:
     printf("test_Dataset_copy_and_roundtrip %s.\n", ok ? "passed" : "FAILED");
     return ok;
 }
+
+// Helper: 1-D float64 dataset of n points with the given inline encoding
+static DatasetRef _make_1d_dataset(OCIndex n, OCStringRef encoding) {
+    DatasetRef ds = NULL;
+    OCMutableArrayRef dims = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless,
+                                                              n, increment, NULL, NULL);
+    DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"),
+                                                             kOCNumberFloat64Type,
+                                                             n,
+                                                             NULL);
+    if (!dim || !dv) goto done;
+    double *values = (double *)OCDataGetMutableBytes(
+        (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+    for (OCIndex i = 0; i < n; ++i) values[i] = 0.1 * (double)i - 3.0;
+    DependentVariableSetEncoding(dv, encoding);
+    OCArrayAppendValue(dims, dim);
+    OCArrayAppendValue(dvs, dv);
+    ds = DatasetCreateMinimal(dims, dvs, NULL);
+done:
+    OCRelease(dv);
+    OCRelease(dim);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    return ds;
+}
+
+bool test_Dataset_stream_export_roundtrip(void) {
+    printf("test_Dataset_stream_export_roundtrip...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    const char *encodings[] = {kDependentVariableEncodingValueBase64,
+                               kDependentVariableEncodingValueNone};
+    for (size_t e = 0; e < sizeof(encodings) / sizeof(encodings[0]); ++e) {
+        OCStringRef enc = OCStringCreateWithCString(encodings[e]);
+        ds = _make_1d_dataset(1000, enc);
+        OCRelease(enc);
+        TEST_ASSERT(ds != NULL);
+        // a title spelling a component placeholder stays plain text
+        char spoof[64];
+        snprintf(spoof, sizeof(spoof), "@@RMNLib:%p:0:0@@", (void *)ds);
+        OCStringRef title = OCStringCreateWithCString(spoof);
+        bool titled = DatasetSetTitle(ds, title);
+        OCRelease(title);
+        TEST_ASSERT(titled);
+
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "tmp/stream_export_%s.csdf", encodings[e]);
+        TEST_ASSERT(DatasetExport(ds, path, NULL, &err));
+        back = DatasetCreateWithImport(path, "tmp", &err);
+        TEST_ASSERT(back != NULL);
+        TEST_ASSERT(OCStringEqual(DatasetGetTitle(back), DatasetGetTitle(ds)));
+
+        DependentVariableRef a = DatasetGetDependentVariableAtIndex(ds, 0);
+        DependentVariableRef b = DatasetGetDependentVariableAtIndex(back, 0);
+        OCDataRef da = DependentVariableGetComponentAtIndex(a, 0);
+        OCDataRef db = DependentVariableGetComponentAtIndex(b, 0);
+        TEST_ASSERT(OCDataGetLength(da) == OCDataGetLength(db));
+        TEST_ASSERT(memcmp(OCDataGetBytesPtr(da), OCDataGetBytesPtr(db),
+                           (size_t)OCDataGetLength(da)) == 0);
+        OCRelease(back);
+        back = NULL;
+        OCRelease(ds);
+        ds = NULL;
+    }
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_stream_export_roundtrip %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_import_inline_components(void) {
+    printf("test_Dataset_import_inline_components...\n");
+    bool ok = false;
+    DatasetRef ds = NULL;
+    OCStringRef err = NULL;
+    // complex "none" values as re/im pairs, plus a base64 DV using an
+    // escaped "\/" that must take the cJSON path
+    const char *text =
+        "{\"csdm\": {\"version\": \"1.0\",\n"
+        " \"dimensions\": [{\"type\": \"linear\", \"count\": 2, \"increment\": \"1.0 s\"}],\n"
+        " \"dependent_variables\": [\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"none\",\n"
+        "   \"numeric_type\": \"complex128\", \"components\": [[ 1.5, -2e1 ,3, 0 ]]},\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"base64\",\n"
+        "   \"numeric_type\": \"uint8\", \"components\": [\"\\/\\/8=\"]}]}}\n";
+    const char *path = "tmp/inline_components.csdf";
+    FILE *f = fopen(path, "w");
+    TEST_ASSERT(f != NULL);
+    fputs(text, f);
+    fclose(f);
+
+    ds = DatasetCreateWithImport(path, "tmp", &err);
+    TEST_ASSERT(ds != NULL);
+    TEST_ASSERT(DatasetGetDependentVariableCount(ds) == 2);
+
+    OCDataRef c = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, 0), 0);
+    TEST_ASSERT(OCDataGetLength(c) == 2 * sizeof(double complex));
+    const double complex *z = (const double complex *)OCDataGetBytesPtr(c);
+    TEST_ASSERT(creal(z[0]) == 1.5 && cimag(z[0]) == -20.0);
+    TEST_ASSERT(creal(z[1]) == 3.0 && cimag(z[1]) == 0.0);
+
+    OCDataRef b = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, 1), 0);
+    TEST_ASSERT(OCDataGetLength(b) == 2);
+    const uint8_t *bytes = (const uint8_t *)OCDataGetBytesPtr(b);
+    TEST_ASSERT(bytes[0] == 0xFF && bytes[1] == 0xFF);
+
+    // malformed payloads are rejected rather than zero-padded or wrapped:
+    // an odd complex value count, and integers the numeric_type cannot hold
+    const char *malformed[][2] = {
+        {"complex128", "[[1.5, -2e1, 3]]"},
+        {"uint8", "[[300, 1]]"},
+        {"uint16", "[[-1, 1]]"},
+        {"int32", "[[1e10, 1]]"},
+        {"int64", "[[1e400, 1]]"},
+    };
+    for (size_t m = 0; m < sizeof(malformed) / sizeof(malformed[0]); ++m) {
+        f = fopen(path, "w");
+        TEST_ASSERT(f != NULL);
+        fprintf(f,
+                "{\"csdm\": {\"version\": \"1.0\",\n"
+                " \"dimensions\": [{\"type\": \"linear\", \"count\": 2, \"increment\": \"1.0 s\"}],\n"
+                " \"dependent_variables\": [{\"type\": \"internal\", \"quantity_type\": \"scalar\",\n"
+                "   \"encoding\": \"none\", \"numeric_type\": \"%s\", \"components\": %s}]}}\n",
+                malformed[m][0], malformed[m][1]);
+        fclose(f);
+        OCRelease(ds);
+        ds = DatasetCreateWithImport(path, "tmp", &err);
+        TEST_ASSERT(ds == NULL);
+        TEST_ASSERT(err != NULL);
+        OCRelease(err);
+        err = NULL;
+    }
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(ds);
+    printf("test_Dataset_import_inline_components %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+// Helper: read a whole file into a malloc'd buffer
+static char *_read_file(const char *path, size_t *outLength) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    rewind(f);
+    char *buf = n >= 0 ? malloc((size_t)n + 1) : NULL;
+    if (buf && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (buf) *outLength = (size_t)n;
+    return buf;
+}
+
+bool test_Dataset_int64_none_roundtrip(void) {
+    printf("test_Dataset_int64_none_roundtrip...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    cJSON *root = NULL;
+    char *text = NULL;
+    // the extremes of both 64-bit types, which a double rounds to 2^63 and 2^64
+    const char *doc =
+        "{\"csdm\": {\"version\": \"1.0\",\n"
+        " \"dimensions\": [{\"type\": \"linear\", \"count\": 3, \"increment\": \"1.0 s\"}],\n"
+        " \"dependent_variables\": [\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"none\",\n"
+        "   \"numeric_type\": \"int64\",\n"
+        "   \"components\": [[-9223372036854775808, 9223372036854775807, -1]]},\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"none\",\n"
+        "   \"numeric_type\": \"uint64\",\n"
+        "   \"components\": [[18446744073709551615, 9007199254740993, 0]]}]}}\n";
+    const int64_t s64[] = {INT64_MIN, INT64_MAX, -1};
+    const uint64_t u64[] = {UINT64_MAX, 9007199254740993ULL, 0};
+    const char *path = "tmp/int64_none.csdf";
+    FILE *f = fopen(path, "w");
+    TEST_ASSERT(f != NULL);
+    fputs(doc, f);
+    fclose(f);
+
+    ds = DatasetCreateWithImport(path, "tmp", &err);
+    TEST_ASSERT(ds != NULL);
+    for (int pass = 0; pass < 2; ++pass) {
+        DatasetRef d = pass == 0 ? ds : back;
+        OCDataRef a = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(d, 0), 0);
+        OCDataRef b = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(d, 1), 0);
+        TEST_ASSERT(OCDataGetLength(a) == sizeof(s64) && OCDataGetLength(b) == sizeof(u64));
+        TEST_ASSERT(memcmp(OCDataGetBytesPtr(a), s64, sizeof(s64)) == 0);
+        TEST_ASSERT(memcmp(OCDataGetBytesPtr(b), u64, sizeof(u64)) == 0);
+        if (pass == 1) break;
+        // the exporter writes the same digits back
+        TEST_ASSERT(DatasetExport(ds, "tmp/int64_none_export.csdf", NULL, &err));
+        size_t length = 0;
+        text = _read_file("tmp/int64_none_export.csdf", &length);
+        TEST_ASSERT(text != NULL);
+        TEST_ASSERT(strstr(text, "-9223372036854775808, 9223372036854775807") != NULL);
+        TEST_ASSERT(strstr(text, "18446744073709551615, 9007199254740993") != NULL);
+        back = DatasetCreateWithImport("tmp/int64_none_export.csdf", "tmp", &err);
+        TEST_ASSERT(back != NULL);
+    }
+
+    // cJSON keeps numbers as doubles: the maxima round up out of range and
+    // are read back as the maximum instead of being rejected
+    OCRelease(back);
+    back = NULL;
+    root = cJSON_Parse(doc);
+    TEST_ASSERT(root != NULL);
+    back = DatasetCreateFromJSON(root, &err);
+    TEST_ASSERT(back != NULL);
+    const int64_t *sa = OCDataGetBytesPtr(
+        DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 0), 0));
+    const uint64_t *ua = OCDataGetBytesPtr(
+        DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 1), 0));
+    TEST_ASSERT(sa[0] == INT64_MIN && sa[1] == INT64_MAX && ua[0] == UINT64_MAX);
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    if (root) cJSON_Delete(root);
+    free(text);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_int64_none_roundtrip %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_nonfinite_none_roundtrip(void) {
+    printf("test_Dataset_nonfinite_none_roundtrip...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    cJSON *root = NULL;
+    char *text = NULL;
+    // NaN is written as null and infinities as an overflowing exponent
+    const char *doc =
+        "{\"csdm\": {\"version\": \"1.0\",\n"
+        " \"dimensions\": [{\"type\": \"linear\", \"count\": 4, \"increment\": \"1.0 s\"}],\n"
+        " \"dependent_variables\": [\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"none\",\n"
+        "   \"numeric_type\": \"float64\", \"components\": [[null, 1e999, -1e999, 1.5]]},\n"
+        "  {\"type\": \"internal\", \"quantity_type\": \"scalar\", \"encoding\": \"none\",\n"
+        "   \"numeric_type\": \"float32\", \"components\": [[1.5, null, -1e999, 1e999]]}]}}\n";
+    const char *path = "tmp/nonfinite_none.csdf";
+    FILE *f = fopen(path, "w");
+    TEST_ASSERT(f != NULL);
+    fputs(doc, f);
+    fclose(f);
+
+    ds = DatasetCreateWithImport(path, "tmp", &err);
+    TEST_ASSERT(ds != NULL);
+    TEST_ASSERT(DatasetExport(ds, "tmp/nonfinite_none_export.csdf", NULL, &err));
+    size_t length = 0;
+    text = _read_file("tmp/nonfinite_none_export.csdf", &length);
+    TEST_ASSERT(text != NULL);
+    TEST_ASSERT(strstr(text, "[null, 1e999, -1e999, 1.5]") != NULL);
+    TEST_ASSERT(strstr(text, "[1.5, null, -1e999, 1e999]") != NULL);
+    // both the inline decoder and the cJSON path read the export back
+    for (int pass = 0; pass < 3; ++pass) {
+        DatasetRef d = ds;
+        if (pass == 1) {
+            back = DatasetCreateWithImport("tmp/nonfinite_none_export.csdf", "tmp", &err);
+            d = back;
+        } else if (pass == 2) {
+            OCRelease(back);
+            back = NULL;
+            root = cJSON_Parse(text);
+            TEST_ASSERT(root != NULL);
+            back = DatasetCreateFromJSON(root, &err);
+            d = back;
+        }
+        TEST_ASSERT(d != NULL);
+        const double *x = OCDataGetBytesPtr(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(d, 0), 0));
+        const float *y = OCDataGetBytesPtr(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(d, 1), 0));
+        TEST_ASSERT(isnan(x[0]) && x[1] == INFINITY && x[2] == -INFINITY && x[3] == 1.5);
+        TEST_ASSERT(y[0] == 1.5f && isnan(y[1]) && y[2] == -INFINITY && y[3] == INFINITY);
+    }
+
+    // integers have no NaN, so null is malformed there
+    f = fopen(path, "w");
+    TEST_ASSERT(f != NULL);
+    fputs("{\"csdm\": {\"version\": \"1.0\",\n"
+          " \"dimensions\": [{\"type\": \"linear\", \"count\": 2, \"increment\": \"1.0 s\"}],\n"
+          " \"dependent_variables\": [{\"type\": \"internal\", \"quantity_type\": \"scalar\",\n"
+          "   \"encoding\": \"none\", \"numeric_type\": \"int32\", \"components\": [[null, 1]]}]}}\n",
+          f);
+    fclose(f);
+    OCRelease(back);
+    back = DatasetCreateWithImport(path, "tmp", &err);
+    TEST_ASSERT(back == NULL);
+    TEST_ASSERT(err != NULL);
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    if (root) cJSON_Delete(root);
+    free(text);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_nonfinite_none_roundtrip %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_parallel_io(void) {
+    printf("test_Dataset_parallel_io...\n");
+    bool ok = false;
+    DatasetRef serial = NULL, parallel = NULL;
+    OCStringRef err = NULL;
+    char *a = NULL, *b = NULL;
+    const char *root = getenv("CSDM_TEST_ROOT");
+    TEST_ASSERT(root != NULL);
+
+    // NCEI forecast: five external DVs in separate blob files
+    char json[PATH_MAX], dir[PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s/correlatedDataset/forecast", root);
+    snprintf(json, sizeof(json), "%s/NCEI.csdfe", dir);
+
+    DatasetSetIOWorkerCount(1);
+    serial = DatasetCreateWithImport(json, dir, &err);
+    TEST_ASSERT(serial != NULL);
+    TEST_ASSERT(DatasetExport(serial, "tmp/parallel_io_serial.csdf", NULL, &err));
+
+    DatasetSetIOWorkerCount(4);
+    TEST_ASSERT(DatasetGetIOWorkerCount() == 4);
+    parallel = DatasetCreateWithImport(json, dir, &err);
+    TEST_ASSERT(parallel != NULL);
+    TEST_ASSERT(DatasetExport(parallel, "tmp/parallel_io_workers.csdf", NULL, &err));
+
+    // same components, and byte-identical output
+    OCIndex n = DatasetGetDependentVariableCount(serial);
+    TEST_ASSERT(n == DatasetGetDependentVariableCount(parallel));
+    for (OCIndex i = 0; i < n; ++i) {
+        DependentVariableRef x = DatasetGetDependentVariableAtIndex(serial, i);
+        DependentVariableRef y = DatasetGetDependentVariableAtIndex(parallel, i);
+        TEST_ASSERT(DependentVariableGetComponentCount(x) == DependentVariableGetComponentCount(y));
+        for (OCIndex c = 0; c < DependentVariableGetComponentCount(x); ++c)
+            TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(x, c),
+                                    DependentVariableGetComponentAtIndex(y, c)));
+    }
+    size_t la = 0, lb = 0;
+    a = _read_file("tmp/parallel_io_serial.csdf", &la);
+    b = _read_file("tmp/parallel_io_workers.csdf", &lb);
+    TEST_ASSERT(a && b && la == lb);
+    // the timestamp is the only field allowed to differ between the two runs
+    char *ta = strstr(a, "\"timestamp\""), *tb = strstr(b, "\"timestamp\"");
+    char *ea = ta ? strchr(ta, ',') : NULL;
+    if (ea && tb) memcpy(tb, ta, (size_t)(ea - ta));
+    TEST_ASSERT(memcmp(a, b, la) == 0);
+    ok = true;
+
+cleanup:
+    DatasetSetIOWorkerCount(1);
+    free(a);
+    free(b);
+    if (err) OCRelease(err);
+    OCRelease(parallel);
+    OCRelease(serial);
+    printf("test_Dataset_parallel_io %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_external_export(void) {
+    printf("test_Dataset_external_export...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    char *text = NULL;
+    const OCIndex workers[] = {1, 4};
+    for (size_t w = 0; w < sizeof(workers) / sizeof(workers[0]); ++w) {
+        DatasetSetIOWorkerCount(workers[w]);
+        ds = _make_1d_dataset(1000, STR(kDependentVariableEncodingValueBase64));
+        TEST_ASSERT(ds != NULL);
+        DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, 0);
+        TEST_ASSERT(DependentVariableSetType(dv, STR("external")));
+        TEST_ASSERT(DependentVariableSetComponentsURL(dv, STR("file:external_export.data")));
+        TEST_ASSERT(DatasetExport(ds, "tmp/external_export.csdfe", "tmp", &err));
+
+        // the document names the blob instead of carrying the values
+        size_t length = 0;
+        text = _read_file("tmp/external_export.csdfe", &length);
+        TEST_ASSERT(text != NULL);
+        text[length] = '\0';
+        TEST_ASSERT(strstr(text, "\"external\"") != NULL);
+        TEST_ASSERT(strstr(text, "\"file:external_export.data\"") != NULL);
+        TEST_ASSERT(strstr(text, "\"components\"") == NULL);
+        free(text);
+        text = NULL;
+
+        back = DatasetCreateWithImport("tmp/external_export.csdfe", "tmp", &err);
+        TEST_ASSERT(back != NULL);
+        TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(dv, 0),
+                                DependentVariableGetComponentAtIndex(
+                                    DatasetGetDependentVariableAtIndex(back, 0), 0)));
+        OCRelease(back);
+        back = NULL;
+        OCRelease(ds);
+        ds = NULL;
+    }
+    ok = true;
+
+cleanup:
+    DatasetSetIOWorkerCount(1);
+    free(text);
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_external_export %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_mapped_blob_import(void) {
+    printf("test_Dataset_mapped_blob_import...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    ds = _make_1d_dataset(5000, STR(kDependentVariableEncodingValueBase64));
+    TEST_ASSERT(ds != NULL);
+    DependentVariableRef src = DatasetGetDependentVariableAtIndex(ds, 0);
+    TEST_ASSERT(DependentVariableSetType(src, STR("external")));
+    TEST_ASSERT(DependentVariableSetComponentsURL(src, STR("file:mapped_blob.data")));
+    TEST_ASSERT(DatasetExport(ds, "tmp/mapped_blob.csdfe", "tmp", &err));
+
+    // without io_uring reads the blob is mapped, and the component is a
+    // copy that outlives it
+    RMNAsyncIOSetBackend(kRMNAsyncIOThreads);
+    back = DatasetCreateWithImport("tmp/mapped_blob.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(remove("tmp/mapped_blob.data") == 0);
+    OCDataRef data = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 0), 0);
+    TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(src, 0), data));
+    OCRelease(back);
+    back = NULL;
+
+    // an empty blob cannot be mapped; it is read and rejected as too short
+    FILE *f = fopen("tmp/mapped_blob.data", "wb");
+    TEST_ASSERT(f != NULL);
+    fclose(f);
+    back = DatasetCreateWithImport("tmp/mapped_blob.csdfe", "tmp", &err);
+    TEST_ASSERT(back == NULL);
+    TEST_ASSERT(err != NULL);
+    ok = true;
+
+cleanup:
+    RMNAsyncIOSetBackend(kRMNAsyncIOUring);
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_mapped_blob_import %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_chunked_external(void) {
+    printf("test_Dataset_chunked_external...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    OCDataRef slab = NULL;
+    OCMutableIndexArrayRef chunkShape = NULL;
+    OCMutableArrayRef dims = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    const OCIndex shape[2] = {7, 5};
+    DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"),
+                                                             kOCNumberFloat64Type,
+                                                             shape[0] * shape[1],
+                                                             NULL);
+    TEST_ASSERT(dv != NULL);
+    for (int d = 0; d < 2; ++d) {
+        SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless,
+                                                                  shape[d], increment, NULL, NULL);
+        TEST_ASSERT(dim != NULL);
+        OCArrayAppendValue(dims, dim);
+        OCRelease(dim);
+    }
+    double *values = (double *)OCDataGetMutableBytes(
+        (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+    for (OCIndex i = 0; i < shape[0] * shape[1]; ++i) values[i] = (double)i;
+
+    // 3×2 chunks leave clipped chunks on both upper edges
+    chunkShape = OCIndexArrayCreateMutable(2);
+    OCIndexArrayAppendValue(chunkShape, 3);
+    OCIndexArrayAppendValue(chunkShape, 2);
+    TEST_ASSERT(DependentVariableSetChunkShape(dv, chunkShape));
+    TEST_ASSERT(DependentVariableSetType(dv, STR("external")));
+    TEST_ASSERT(DependentVariableSetComponentsURL(dv, STR("file:chunked_external.data")));
+    OCArrayAppendValue(dvs, dv);
+    ds = DatasetCreateMinimal(dims, dvs, &err);
+    TEST_ASSERT(ds != NULL);
+    TEST_ASSERT(DatasetExport(ds, "tmp/chunked_external.csdfe", "tmp", &err));
+
+    back = DatasetCreateWithImport("tmp/chunked_external.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(dv, 0),
+                            DependentVariableGetComponentAtIndex(
+                                DatasetGetDependentVariableAtIndex(back, 0), 0)));
+
+    // a 3×2 box straddling four chunks
+    const OCIndex start[2] = {2, 1}, count[2] = {3, 2};
+    slab = RMNChunkedLayoutCreateHyperslab("tmp/chunked_external.data", 0, 2, start, count, &err);
+    TEST_ASSERT(slab != NULL);
+    TEST_ASSERT(OCDataGetLength(slab) == 6 * sizeof(double));
+    const double *s = (const double *)OCDataGetBytesPtr(slab);
+    for (OCIndex j = 0; j < count[1]; ++j)
+        for (OCIndex i = 0; i < count[0]; ++i)
+            TEST_ASSERT(s[j * count[0] + i] ==
+                        values[(start[1] + j) * shape[0] + start[0] + i]);
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(slab);
+    OCRelease(back);
+    OCRelease(ds);
+    OCRelease(chunkShape);
+    OCRelease(dv);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    printf("test_Dataset_chunked_external %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+// Worker for test_Dataset_lazy_import: first-touch the DV from many threads
+static void _touch_component(void *context, size_t index) {
+    (void)index;
+    DependentVariableGetComponentAtIndex((DependentVariableRef)context, 0);
+}
+
+bool test_Dataset_lazy_import(void) {
+    printf("test_Dataset_lazy_import...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, lazy = NULL;
+    OCStringRef err = NULL;
+    ds = _make_1d_dataset(4096, STR(kDependentVariableEncodingValueBase64));
+    TEST_ASSERT(ds != NULL);
+    DependentVariableRef src = DatasetGetDependentVariableAtIndex(ds, 0);
+    TEST_ASSERT(DependentVariableSetType(src, STR("external")));
+    TEST_ASSERT(DependentVariableSetComponentsURL(src, STR("file:lazy_import.data")));
+    TEST_ASSERT(DatasetExport(ds, "tmp/lazy_import.csdfe", "tmp", &err));
+
+    lazy = DatasetCreateWithLazyImport("tmp/lazy_import.csdfe", "tmp", &err);
+    TEST_ASSERT(lazy != NULL);
+    DependentVariableRef dv = DatasetGetDependentVariableAtIndex(lazy, 0);
+    TEST_ASSERT(dv != NULL);
+    TEST_ASSERT(!DependentVariableComponentsAreLoaded(dv));
+    // the shape is known without reading the blob
+    TEST_ASSERT(DependentVariableGetComponentCount(dv) == 1);
+    TEST_ASSERT(DependentVariableGetSize(dv) == 4096);
+    TEST_ASSERT(!DependentVariableComponentsAreLoaded(dv));
+
+    // concurrent first accesses share a single load
+    RMNParallelFor(8, 4, _touch_component, dv);
+    TEST_ASSERT(DependentVariableComponentsAreLoaded(dv));
+    TEST_ASSERT(DependentVariableLoadComponents(dv, &err));
+    TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(src, 0),
+                            DependentVariableGetComponentAtIndex(dv, 0)));
+    OCRelease(lazy);
+    lazy = NULL;
+
+    // a blob that disappears before first access fails an export (which
+    // writes nothing) and reports through LoadComponents
+    lazy = DatasetCreateWithLazyImport("tmp/lazy_import.csdfe", "tmp", &err);
+    TEST_ASSERT(lazy != NULL);
+    TEST_ASSERT(remove("tmp/lazy_import.data") == 0);
+    remove("tmp/lazy_reexport.csdf");
+    TEST_ASSERT(!DatasetExport(lazy, "tmp/lazy_reexport.csdf", "tmp", &err));
+    TEST_ASSERT(err != NULL);
+    OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(access("tmp/lazy_reexport.csdf", F_OK) != 0);
+    dv = DatasetGetDependentVariableAtIndex(lazy, 0);
+    TEST_ASSERT(DependentVariableGetComponentAtIndex(dv, 0) == NULL);
+    TEST_ASSERT(!DependentVariableLoadComponents(dv, &err));
+    TEST_ASSERT(err != NULL);
+    OCRelease(err);
+    err = NULL;
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(lazy);
+    OCRelease(ds);
+    printf("test_Dataset_lazy_import %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_compressed_encodings(void) {
+    printf("test_Dataset_compressed_encodings...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    const char *encodings[] = {"deflate", "shuffle+deflate", "zstd", "shuffle+zstd",
+                               "lz4", "shuffle+lz4"};
+    for (size_t e = 0; e < sizeof(encodings) / sizeof(encodings[0]); ++e) {
+        RMNCodec codec = kRMNCodecNone;
+        TEST_ASSERT(RMNCodecParseEncoding(encodings[e], &codec, NULL));
+        if (!RMNCodecIsAvailable(codec)) continue;
+        OCStringRef enc = OCStringCreateWithCString(encodings[e]);
+        ds = _make_1d_dataset(20000, enc);
+        OCRelease(enc);
+        TEST_ASSERT(ds != NULL);
+        DependentVariableRef a = DatasetGetDependentVariableAtIndex(ds, 0);
+        OCDataRef da = DependentVariableGetComponentAtIndex(a, 0);
+
+        // inline (base64 of the encoded frame), then external (raw frames)
+        for (int external = 0; external < 2; ++external) {
+            char path[PATH_MAX], url[PATH_MAX];
+            snprintf(path, sizeof(path), "tmp/compressed_%s.%s", encodings[e],
+                     external ? "csdfe" : "csdf");
+            if (external) {
+                snprintf(url, sizeof(url), "file:compressed_%s.data", encodings[e]);
+                OCStringRef u = OCStringCreateWithCString(url);
+                TEST_ASSERT(DependentVariableSetType(a, STR("external")));
+                TEST_ASSERT(DependentVariableSetComponentsURL(a, u));
+                OCRelease(u);
+            }
+            TEST_ASSERT(DatasetExport(ds, path, "tmp", &err));
+            back = DatasetCreateWithImport(path, "tmp", &err);
+            TEST_ASSERT(back != NULL);
+            DependentVariableRef b = DatasetGetDependentVariableAtIndex(back, 0);
+            TEST_ASSERT(OCStringEqual(DependentVariableGetEncoding(b),
+                                      DependentVariableGetEncoding(a)));
+            TEST_ASSERT(OCTypeEqual(da, DependentVariableGetComponentAtIndex(b, 0)));
+            OCRelease(back);
+            back = NULL;
+        }
+        OCRelease(ds);
+        ds = NULL;
+    }
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_compressed_encodings %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_container_roundtrip(void) {
+    printf("test_Dataset_container_roundtrip...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL, split = NULL;
+    DependentVariableRef ext = NULL;
+    OCStringRef err = NULL;
+    ds = _make_1d_dataset(3000, STR(kDependentVariableEncodingValueBase64));
+    TEST_ASSERT(ds != NULL);
+    // one inline DV and one external DV
+    ext = DependentVariableCreateCopy(DatasetGetDependentVariableAtIndex(ds, 0));
+    TEST_ASSERT(ext != NULL);
+    double *values = (double *)OCDataGetMutableBytes(
+        (OCMutableDataRef)DependentVariableGetComponentAtIndex(ext, 0));
+    for (OCIndex i = 0; i < 3000; ++i) values[i] = (double)(i % 17);
+    TEST_ASSERT(DependentVariableSetType(ext, STR("external")));
+    TEST_ASSERT(DependentVariableSetComponentsURL(ext, STR("file:container_ext.data")));
+    OCArrayAppendValue(DatasetGetDependentVariables(ds), ext);
+    TEST_ASSERT(DatasetExport(ds, "tmp/container.csdmx", NULL, &err));
+
+    back = DatasetCreateWithImport("tmp/container.csdmx", NULL, &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(DatasetGetDependentVariableCount(back) == 2);
+    for (OCIndex d = 0; d < 2; ++d)
+        TEST_ASSERT(OCTypeEqual(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, d), 0),
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, d), 0)));
+
+    // the same data splits back into a standard .csdfe pair
+    DependentVariableRef dv = DatasetGetDependentVariableAtIndex(back, 1);
+    TEST_ASSERT(DependentVariableSetType(dv, STR("external")));
+    TEST_ASSERT(DependentVariableSetComponentsURL(dv, STR("file:container_ext.data")));
+    TEST_ASSERT(DatasetExport(back, "tmp/container_split.csdfe", "tmp", &err));
+    split = DatasetCreateWithImport("tmp/container_split.csdfe", "tmp", &err);
+    TEST_ASSERT(split != NULL);
+    TEST_ASSERT(OCTypeEqual(DependentVariableGetComponentAtIndex(ext, 0),
+                            DependentVariableGetComponentAtIndex(
+                                DatasetGetDependentVariableAtIndex(split, 1), 0)));
+    OCRelease(split);
+    split = NULL;
+
+    // a truncated container is rejected
+    FILE *f = fopen("tmp/container.csdmx", "rb");
+    FILE *t = fopen("tmp/container_truncated.csdmx", "wb");
+    TEST_ASSERT(f && t);
+    char buf[256];
+    size_t n = fread(buf, 1, sizeof(buf), f);
+    fwrite(buf, 1, n, t);
+    fclose(f);
+    fclose(t);
+    split = DatasetCreateWithImport("tmp/container_truncated.csdmx", NULL, &err);
+    TEST_ASSERT(split == NULL);
+    TEST_ASSERT(err != NULL);
+    OCRelease(err);
+    err = NULL;
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(split);
+    OCRelease(back);
+    OCRelease(ext);
+    OCRelease(ds);
+    printf("test_Dataset_container_roundtrip %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_import_subset(void) {
+    printf("test_Dataset_import_subset...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, sub = NULL;
+    OCStringRef err = NULL;
+    OCMutableIndexArrayRef chunkShape = NULL;
+    OCMutableArrayRef dims = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(3, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    const OCIndex shape[2] = {7, 5};
+    for (int d = 0; d < 2; ++d) {
+        SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless,
+                                                                  shape[d], increment, NULL, NULL);
+        TEST_ASSERT(dim != NULL);
+        OCArrayAppendValue(dims, dim);
+        OCRelease(dim);
+    }
+    // an inline DV, a plain external DV and a chunked external DV
+    const char *urls[3] = {NULL, "file:subset_plain.data", "file:subset_chunked.data"};
+    for (int v = 0; v < 3; ++v) {
+        DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"),
+                                                                 kOCNumberFloat64Type,
+                                                                 shape[0] * shape[1],
+                                                                 NULL);
+        TEST_ASSERT(dv != NULL);
+        double *values = (double *)OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        for (OCIndex i = 0; i < shape[0] * shape[1]; ++i) values[i] = 100.0 * v + (double)i;
+        if (urls[v]) {
+            OCStringRef url = OCStringCreateWithCString(urls[v]);
+            DependentVariableSetType(dv, STR("external"));
+            DependentVariableSetComponentsURL(dv, url);
+            OCRelease(url);
+        }
+        if (v == 2) {
+            chunkShape = OCIndexArrayCreateMutable(2);
+            OCIndexArrayAppendValue(chunkShape, 3);
+            OCIndexArrayAppendValue(chunkShape, 2);
+            DependentVariableSetChunkShape(dv, chunkShape);
+        }
+        OCArrayAppendValue(dvs, dv);
+        OCRelease(dv);
+    }
+    ds = DatasetCreateMinimal(dims, dvs, &err);
+    TEST_ASSERT(ds != NULL);
+    TEST_ASSERT(DatasetExport(ds, "tmp/subset.csdfe", "tmp", &err));
+
+    // every other column of three, every third row of two
+    const OCIndex start[2] = {1, 0}, count[2] = {3, 2}, stride[2] = {2, 3};
+    sub = DatasetCreateWithImportSubset("tmp/subset.csdfe", "tmp", start, count, stride, &err);
+    TEST_ASSERT(sub != NULL);
+    TEST_ASSERT(OCArrayGetCount(DatasetGetDimensions(sub)) == 2);
+    TEST_ASSERT(DimensionGetCount((DimensionRef)OCArrayGetValueAtIndex(
+                    DatasetGetDimensions(sub), 0)) == 3);
+    for (int v = 0; v < 3; ++v) {
+        OCDataRef data = DependentVariableGetComponentAtIndex(
+            DatasetGetDependentVariableAtIndex(sub, v), 0);
+        TEST_ASSERT(OCDataGetLength(data) == 6 * sizeof(double));
+        const double *s = (const double *)OCDataGetBytesPtr(data);
+        for (OCIndex j = 0; j < count[1]; ++j)
+            for (OCIndex i = 0; i < count[0]; ++i)
+                TEST_ASSERT(s[j * count[0] + i] ==
+                            100.0 * v + (double)((start[1] + j * stride[1]) * shape[0] +
+                                                 start[0] + i * stride[0]));
+    }
+    OCRelease(sub);
+
+    // a single row drops its dimension
+    const OCIndex rowStart[2] = {2, 4}, rowCount[2] = {4, 1};
+    sub = DatasetCreateWithImportSubset("tmp/subset.csdfe", "tmp", rowStart, rowCount, NULL, &err);
+    TEST_ASSERT(sub != NULL);
+    TEST_ASSERT(OCArrayGetCount(DatasetGetDimensions(sub)) == 1);
+    const double *row = (const double *)OCDataGetBytesPtr(DependentVariableGetComponentAtIndex(
+        DatasetGetDependentVariableAtIndex(sub, 2), 0));
+    for (OCIndex i = 0; i < rowCount[0]; ++i)
+        TEST_ASSERT(row[i] == 200.0 + (double)(4 * shape[0] + 2 + i));
+    OCRelease(sub);
+    sub = NULL;
+
+    // a compressed DV in a container decodes only its own section, which
+    // the chunked DV's section follows
+    if (RMNCodecIsAvailable(kRMNCodecDeflate)) {
+        TEST_ASSERT(DependentVariableSetEncoding(DatasetGetDependentVariableAtIndex(ds, 1),
+                                                 STR("deflate")));
+        TEST_ASSERT(DatasetExport(ds, "tmp/subset.csdmx", NULL, &err));
+        sub = DatasetCreateWithImportSubset("tmp/subset.csdmx", NULL, start, count, stride, &err);
+        TEST_ASSERT(sub != NULL);
+        for (int v = 1; v < 3; ++v) {
+            const double *s = (const double *)OCDataGetBytesPtr(DependentVariableGetComponentAtIndex(
+                DatasetGetDependentVariableAtIndex(sub, v), 0));
+            for (OCIndex j = 0; j < count[1]; ++j)
+                for (OCIndex i = 0; i < count[0]; ++i)
+                    TEST_ASSERT(s[j * count[0] + i] ==
+                                100.0 * v + (double)((start[1] + j * stride[1]) * shape[0] +
+                                                     start[0] + i * stride[0]));
+        }
+    }
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(sub);
+    OCRelease(ds);
+    OCRelease(chunkShape);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    printf("test_Dataset_import_subset %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+static DependentVariableRef _make_rows_dv(OCStringRef quantityType,
+                                          OCNumberType type,
+                                          OCIndex points,
+                                          double first) {
+    DependentVariableRef dv = DependentVariableCreateDefault(quantityType, type, points, NULL);
+    if (!dv) return NULL;
+    for (OCIndex c = 0; c < DependentVariableGetComponentCount(dv); ++c) {
+        OCMutableDataRef data = (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, c);
+        for (OCIndex i = 0; i < points; ++i) {
+            double v = first + 1000.0 * c + (double)i;
+            if (type == kOCNumberFloat32Type)
+                ((float *)OCDataGetMutableBytes(data))[i] = (float)v;
+            else
+                ((double *)OCDataGetMutableBytes(data))[i] = v;
+        }
+    }
+    return dv;
+}
+bool test_Dataset_streaming_writer(void) {
+    printf("test_Dataset_streaming_writer...\n");
+    bool ok = false;
+    DatasetRef layout = NULL, back = NULL;
+    DatasetWriterRef writer = NULL;
+    OCStringRef err = NULL;
+    OCMutableArrayRef rows = NULL;
+    OCMutableArrayRef dims = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    const OCIndex width = 4;  // points per row
+    for (int d = 0; d < 2; ++d) {
+        SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless,
+                                                                  d == 0 ? width : 2,
+                                                                  increment, NULL, NULL);
+        TEST_ASSERT(dim != NULL);
+        OCArrayAppendValue(dims, dim);
+        OCRelease(dim);
+    }
+    // a scalar float64 DV and a two-component float32 DV
+    const char *urls[2] = {"file:stream_scalar.data", "file:stream_vector.data"};
+    OCStringRef quantityTypes[2] = {STR("scalar"), STR("vector_2")};
+    OCNumberType types[2] = {kOCNumberFloat64Type, kOCNumberFloat32Type};
+    for (int v = 0; v < 2; ++v) {
+        DependentVariableRef dv = _make_rows_dv(quantityTypes[v], types[v], 2 * width, 0.0);
+        TEST_ASSERT(dv != NULL);
+        OCStringRef url = OCStringCreateWithCString(urls[v]);
+        DependentVariableSetType(dv, STR("external"));
+        DependentVariableSetComponentsURL(dv, url);
+        OCRelease(url);
+        OCArrayAppendValue(dvs, dv);
+        OCRelease(dv);
+    }
+    layout = DatasetCreateMinimal(dims, dvs, &err);
+    TEST_ASSERT(layout != NULL);
+
+    // one committed row, then an interrupted acquisition
+    remove("tmp/stream.csdfe");
+    remove("tmp/stream_vector.data");
+    writer = DatasetWriterCreate(layout, "tmp/stream.csdfe", "tmp", &err);
+    TEST_ASSERT(writer != NULL);
+    rows = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    for (int v = 0; v < 2; ++v) {
+        DependentVariableRef dv = _make_rows_dv(quantityTypes[v], types[v], width, 0.0);
+        OCArrayAppendValue(rows, dv);
+        OCRelease(dv);
+    }
+    TEST_ASSERT(DatasetWriterAppend(writer, rows, &err));
+    TEST_ASSERT(!DatasetWriterClose(writer, &err));  // one row cannot close
+    writer = NULL;
+    if (err) OCRelease(err);
+    err = NULL;
+
+    // resume, add two rows in one append plus a mismatched one, and close
+    writer = DatasetWriterCreateResuming(layout, "tmp/stream.csdfe", "tmp", &err);
+    TEST_ASSERT(writer != NULL);
+    TEST_ASSERT(DatasetWriterGetRowCount(writer) == 1);
+    OCRelease(rows);
+    rows = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    for (int v = 0; v < 2; ++v) {
+        DependentVariableRef dv = _make_rows_dv(quantityTypes[v], types[v], 2 * width,
+                                                (double)width);
+        OCArrayAppendValue(rows, dv);
+        OCRelease(dv);
+    }
+    TEST_ASSERT(DatasetWriterAppend(writer, rows, &err));
+    OCArrayRemoveValueAtIndex(rows, 1);
+    {
+        DependentVariableRef partial = _make_rows_dv(quantityTypes[1], types[1], width + 1, 0.0);
+        OCArrayAppendValue(rows, partial);
+        OCRelease(partial);
+    }
+    TEST_ASSERT(!DatasetWriterAppend(writer, rows, &err));
+    if (err) OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(DatasetWriterGetRowCount(writer) == 3);
+    // the vector DV's blob only exists after close, so no document names it yet
+    TEST_ASSERT(DatasetWriterFlush(writer, &err));
+    TEST_ASSERT(access("tmp/stream_vector.data", F_OK) != 0);
+    TEST_ASSERT(access("tmp/stream.csdfe", F_OK) != 0);
+    bool closed = DatasetWriterClose(writer, &err);
+    writer = NULL;
+    TEST_ASSERT(closed);
+    TEST_ASSERT(access("tmp/stream_vector.data", F_OK) == 0);
+    TEST_ASSERT(access("tmp/stream_vector.data.part0", F_OK) != 0);
+    TEST_ASSERT(access("tmp/stream.csdfe.idx", F_OK) != 0);
+
+    back = DatasetCreateWithImport("tmp/stream.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(DimensionGetCount((DimensionRef)OCArrayGetValueAtIndex(
+                    DatasetGetDimensions(back), 1)) == 3);
+    for (int v = 0; v < 2; ++v) {
+        DependentVariableRef dv = DatasetGetDependentVariableAtIndex(back, v);
+        for (OCIndex c = 0; c < DependentVariableGetComponentCount(dv); ++c) {
+            OCDataRef data = DependentVariableGetComponentAtIndex(dv, c);
+            for (OCIndex i = 0; i < 3 * width; ++i) {
+                double want = 1000.0 * c + (double)i;
+                double got = types[v] == kOCNumberFloat32Type
+                                 ? ((const float *)OCDataGetBytesPtr(data))[i]
+                                 : ((const double *)OCDataGetBytesPtr(data))[i];
+                TEST_ASSERT(got == want);
+            }
+        }
+    }
+    ok = true;
+
+cleanup:
+    if (writer) DatasetWriterClose(writer, NULL);
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(layout);
+    OCRelease(rows);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    printf("test_Dataset_streaming_writer %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+// Number of atomic-export temporaries ("*.rmntmp") left in `dir`
+static int _count_temporaries(const char *dir) {
+    int count = 0;
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    struct dirent *de;
+    while ((de = readdir(d)) != NULL) {
+        size_t len = strlen(de->d_name);
+        if (len > 7 && strcmp(de->d_name + len - 7, ".rmntmp") == 0) count++;
+    }
+    closedir(d);
+    return count;
+}
+
+bool test_Dataset_atomic_export(void) {
+    printf("test_Dataset_atomic_export...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    DatasetExportMode savedMode = DatasetGetExportMode();
+    ds = _make_1d_dataset(64, STR(kDependentVariableEncodingValueRaw));
+    TEST_ASSERT(ds != NULL);
+    DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, 0);
+    DependentVariableSetType(dv, STR("external"));
+    DependentVariableSetComponentsURL(dv, STR("file:atomic.data"));
+
+    DatasetSetExportMode(kDatasetExportDurable);
+    TEST_ASSERT(DatasetExport(ds, "tmp/atomic.csdfe", "tmp", &err));
+    TEST_ASSERT(_count_temporaries("tmp") == 0);
+
+    // a blob that cannot be written leaves the previous export untouched
+    FILE *blocker = fopen("tmp/atomic_blocked", "wb");
+    TEST_ASSERT(blocker != NULL);
+    fclose(blocker);
+    DatasetSetExportMode(kDatasetExportAtomic);
+    DependentVariableSetComponentsURL(dv, STR("file:atomic_blocked/atomic.data"));
+    TEST_ASSERT(!DatasetExport(ds, "tmp/atomic.csdfe", "tmp", &err));
+    if (err) OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(_count_temporaries("tmp") == 0);
+
+    back = DatasetCreateWithImport("tmp/atomic.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(OCStringEqual(DependentVariableGetComponentsURL(
+                                  DatasetGetDependentVariableAtIndex(back, 0)),
+                              STR("file:atomic.data")));
+    OCDataRef a = DependentVariableGetComponentAtIndex(dv, 0);
+    OCDataRef b = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 0), 0);
+    TEST_ASSERT(OCDataGetLength(a) == OCDataGetLength(b));
+    TEST_ASSERT(memcmp(OCDataGetBytesPtr(a), OCDataGetBytesPtr(b), (size_t)OCDataGetLength(a)) == 0);
+    ok = true;
+
+cleanup:
+    DatasetSetExportMode(savedMode);
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    printf("test_Dataset_atomic_export %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_async_io(void) {
+    printf("test_Dataset_async_io...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCStringRef err = NULL;
+    int fd = -1;
+    enum { kPieces = 8, kPiece = 4096 };
+    uint8_t *out = malloc(kPieces * kPiece), *in = calloc(kPieces, kPiece);
+    TEST_ASSERT(out && in);
+    for (size_t i = 0; i < kPieces * kPiece; ++i) out[i] = (uint8_t)(i * 31 + 7);
+    // both backends (io_uring falls back to threads where unavailable)
+    RMNAsyncIOBackend backends[2] = {kRMNAsyncIOThreads, kRMNAsyncIOUring};
+    for (int b = 0; b < 2; ++b) {
+        RMNAsyncIOSetBackend(backends[b]);
+        fd = open("tmp/async_io.data", O_RDWR | O_CREAT | O_TRUNC, 0644);
+        TEST_ASSERT(fd >= 0);
+        RMNAsyncIORequest reqs[kPieces];
+        for (int i = 0; i < kPieces; ++i)  // written out of order
+            reqs[i] = (RMNAsyncIORequest){.fd = fd, .write = true,
+                                          .offset = (uint64_t)(kPieces - 1 - i) * kPiece,
+                                          .bytes = out + (kPieces - 1 - i) * kPiece,
+                                          .length = kPiece};
+        TEST_ASSERT(RMNAsyncIORun(reqs, kPieces, 4));
+        for (int i = 0; i < kPieces; ++i)
+            reqs[i] = (RMNAsyncIORequest){.fd = fd, .offset = (uint64_t)i * kPiece,
+                                          .bytes = in + i * kPiece, .length = kPiece};
+        TEST_ASSERT(RMNAsyncIORun(reqs, kPieces, 4));
+        TEST_ASSERT(memcmp(in, out, kPieces * kPiece) == 0);
+        // a read past end of file fails
+        reqs[0].offset = (uint64_t)kPieces * kPiece;
+        TEST_ASSERT(!RMNAsyncIORun(reqs, 1, 1) && !reqs[0].ok);
+        close(fd);
+        fd = -1;
+    }
+    // Dataset blob I/O goes through the batch when io_uring is usable
+    ds = _make_1d_dataset(4096, STR(kDependentVariableEncodingValueRaw));
+    TEST_ASSERT(ds != NULL);
+    DependentVariableSetType(DatasetGetDependentVariableAtIndex(ds, 0), STR("external"));
+    DependentVariableSetComponentsURL(DatasetGetDependentVariableAtIndex(ds, 0),
+                                      STR("file:async_io_blob.data"));
+    TEST_ASSERT(DatasetExport(ds, "tmp/async_io.csdfe", "tmp", &err));
+    back = DatasetCreateWithImport("tmp/async_io.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    OCDataRef a = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, 0), 0);
+    OCDataRef c = DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 0), 0);
+    TEST_ASSERT(OCDataGetLength(a) == OCDataGetLength(c));
+    TEST_ASSERT(memcmp(OCDataGetBytesPtr(a), OCDataGetBytesPtr(c), (size_t)OCDataGetLength(a)) == 0);
+    ok = true;
+
+cleanup:
+    if (fd >= 0) close(fd);
+    RMNAsyncIOSetBackend(kRMNAsyncIOUring);
+    if (err) OCRelease(err);
+    OCRelease(back);
+    OCRelease(ds);
+    free(out);
+    free(in);
+    printf("test_Dataset_async_io %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_header_scan(void) {
+    printf("test_Dataset_header_scan...\n");
+    bool ok = false;
+    DatasetRef ds = NULL;
+    OCDictionaryRef header = NULL;
+    OCStringRef err = NULL;
+
+    // files written here: each payload kind sized from its own bytes or,
+    // for external blobs, from the dimensions
+    struct {
+        const char *encoding;
+        bool external;
+    } cases[] = {{kDependentVariableEncodingValueBase64, false},
+                 {kDependentVariableEncodingValueNone, false},
+                 {"deflate", false},
+                 {kDependentVariableEncodingValueRaw, true},
+                 {"deflate", true}};
+    const OCIndex n = 777;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+        RMNCodec codec = kRMNCodecNone;
+        if (RMNCodecParseEncoding(cases[c].encoding, &codec, NULL) && !RMNCodecIsAvailable(codec))
+            continue;
+        OCStringRef enc = OCStringCreateWithCString(cases[c].encoding);
+        ds = _make_1d_dataset(n, enc);
+        OCRelease(enc);
+        TEST_ASSERT(ds != NULL);
+        DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, 0);
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "tmp/header_scan_%s.%s", cases[c].encoding,
+                 cases[c].external ? "csdfe" : "csdf");
+        if (cases[c].external) {
+            char url[PATH_MAX];
+            snprintf(url, sizeof(url), "file:header_scan_%s.data", cases[c].encoding);
+            OCStringRef u = OCStringCreateWithCString(url);
+            TEST_ASSERT(DependentVariableSetType(dv, STR("external")));
+            TEST_ASSERT(DependentVariableSetComponentsURL(dv, u));
+            OCRelease(u);
+        }
+        TEST_ASSERT(DatasetExport(ds, path, "tmp", &err));
+        header = DatasetCopyHeaderFromFile(path, &err);
+        TEST_ASSERT(header != NULL);
+
+        OCArrayRef dvs = OCDictionaryGetValue(header, STR("dependent_variables"));
+        TEST_ASSERT(OCArrayGetCount(dvs) == 1);
+        OCDictionaryRef entry = OCArrayGetValueAtIndex(dvs, 0);
+        TEST_ASSERT(OCDictionaryGetValue(entry, STR(kDependentVariableComponentsKey)) == NULL);
+        TEST_ASSERT(OCStringEqual(OCDictionaryGetValue(entry, STR(kDependentVariableEncodingKey)),
+                                  DependentVariableGetEncoding(dv)));
+        OCIndex ncomps = 0, size = 0;
+        TEST_ASSERT(OCNumberTryGetOCIndex(
+            OCDictionaryGetValue(entry, STR(kDatasetHeaderComponentCountKey)), &ncomps));
+        TEST_ASSERT(OCNumberTryGetOCIndex(OCDictionaryGetValue(entry, STR(kDatasetHeaderSizeKey)),
+                                          &size));
+        TEST_ASSERT(ncomps == 1);
+        TEST_ASSERT(size == n);
+        OCRelease(header);
+        header = NULL;
+        OCRelease(ds);
+        ds = NULL;
+    }
+
+    const char *root = getenv("CSDM_TEST_ROOT");
+    TEST_ASSERT(root != NULL);
+
+    // inline base64 and "none" payloads, complex values, and external blobs
+    const char *files[] = {"NMR/blochDecay/blochDecay_base64.csdf", "ir/caffeine_none.csdf",
+                           "vector/electric_field/electric_field_none.csdf",
+                           "correlatedDataset/forecast/NCEI.csdfe"};
+    for (size_t f = 0; f < sizeof(files) / sizeof(files[0]); ++f) {
+        char json[PATH_MAX], dir[PATH_MAX];
+        snprintf(json, sizeof(json), "%s/%s", root, files[f]);
+        snprintf(dir, sizeof(dir), "%s", json);
+        *strrchr(dir, '/') = '\0';
+        ds = DatasetCreateWithImport(json, dir, &err);
+        TEST_ASSERT(ds != NULL);
+        header = DatasetCopyHeaderFromFile(json, &err);
+        TEST_ASSERT(header != NULL);
+
+        OCStringRef title = OCDictionaryGetValue(header, STR("title"));
+        if (title) TEST_ASSERT(OCStringEqual(title, DatasetGetTitle(ds)));
+        OCArrayRef dims = OCDictionaryGetValue(header, STR("dimensions"));
+        TEST_ASSERT(OCArrayGetCount(dims) == OCArrayGetCount(DatasetGetDimensions(ds)));
+        OCArrayRef dvs = OCDictionaryGetValue(header, STR("dependent_variables"));
+        TEST_ASSERT(OCArrayGetCount(dvs) == DatasetGetDependentVariableCount(ds));
+        for (OCIndex i = 0; i < OCArrayGetCount(dvs); ++i) {
+            OCDictionaryRef entry = OCArrayGetValueAtIndex(dvs, i);
+            DependentVariableRef dv = DatasetGetDependentVariableAtIndex(ds, i);
+            TEST_ASSERT(OCDictionaryGetValue(entry, STR(kDependentVariableComponentsKey)) == NULL);
+            OCIndex ncomps = 0, size = 0;
+            TEST_ASSERT(OCNumberTryGetOCIndex(
+                OCDictionaryGetValue(entry, STR(kDatasetHeaderComponentCountKey)), &ncomps));
+            TEST_ASSERT(OCNumberTryGetOCIndex(OCDictionaryGetValue(entry, STR(kDatasetHeaderSizeKey)),
+                                              &size));
+            TEST_ASSERT(ncomps == DependentVariableGetComponentCount(dv));
+            TEST_ASSERT(size == DependentVariableGetSize(dv));
+        }
+        OCRelease(header);
+        header = NULL;
+        OCRelease(ds);
+        ds = NULL;
+    }
+    // a missing file is reported, not crashed on
+    TEST_ASSERT(DatasetCopyHeaderFromFile("tmp/no_such_file.csdf", &err) == NULL && err != NULL);
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(header);
+    OCRelease(ds);
+    printf("test_Dataset_header_scan %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+
+bool test_Dataset_export_dedup(void) {
+    printf("test_Dataset_export_dedup...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCDictionaryRef header = NULL;
+    OCStringRef err = NULL;
+    const OCIndex n = 512;
+    OCMutableArrayRef dims = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(3, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless, n,
+                                                              increment, NULL, NULL);
+    TEST_ASSERT(dim != NULL);
+    OCArrayAppendValue(dims, dim);
+    OCRelease(dim);
+    // "b" is a copy of "a" with edited metadata; "c" holds different values
+    const char *urls[3] = {"file:dedup_a.data", "file:dedup_b.data", "file:dedup_c.data"};
+    for (int v = 0; v < 3; ++v) {
+        DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"),
+                                                                 kOCNumberFloat64Type, n, NULL);
+        TEST_ASSERT(dv != NULL);
+        double *values = (double *)OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        for (OCIndex i = 0; i < n; ++i) values[i] = (v == 2 ? 2.0 : 1.0) * (double)i;
+        OCStringRef url = OCStringCreateWithCString(urls[v]);
+        DependentVariableSetType(dv, STR("external"));
+        DependentVariableSetComponentsURL(dv, url);
+        OCRelease(url);
+        if (v == 1) DependentVariableSetName(dv, STR("edited copy"));
+        OCArrayAppendValue(dvs, dv);
+        OCRelease(dv);
+    }
+    ds = DatasetCreateMinimal(dims, dvs, &err);
+    TEST_ASSERT(ds != NULL);
+    uint64_t hashes[3];
+    for (int v = 0; v < 3; ++v)
+        TEST_ASSERT(DependentVariableComputeComponentHash(DatasetGetDependentVariableAtIndex(ds, v),
+                                                          0, &hashes[v]));
+    TEST_ASSERT(hashes[0] == hashes[1] && hashes[0] != hashes[2]);
+
+    // the shared blob is written once and named by both variables
+    remove("tmp/dedup_b.data");
+    TEST_ASSERT(DatasetExport(ds, "tmp/dedup.csdfe", "tmp", &err));
+    FILE *f = fopen("tmp/dedup_b.data", "rb");
+    if (f) fclose(f);
+    TEST_ASSERT(f == NULL);
+    header = DatasetCopyHeaderFromFile("tmp/dedup.csdfe", &err);
+    TEST_ASSERT(header != NULL);
+    OCArrayRef entries = OCDictionaryGetValue(header, STR("dependent_variables"));
+    TEST_ASSERT(OCArrayGetCount(entries) == 3);
+    for (OCIndex v = 0; v < 3; ++v) {
+        OCDictionaryRef entry = OCArrayGetValueAtIndex(entries, v);
+        OCStringRef url = OCDictionaryGetValue(entry, STR(kDependentVariableComponentsURLKey));
+        TEST_ASSERT(url && strcmp(OCStringGetCString(url), urls[v == 1 ? 0 : v]) == 0);
+        OCDictionaryRef app = OCDictionaryGetValue(entry, STR(kDependentVariableMetaDataKey));
+        OCArrayRef recorded = app ? OCDictionaryGetValue(app, STR(kRMNHashComponentsMetaDataKey)) : NULL;
+        TEST_ASSERT(recorded && OCArrayGetCount(recorded) == 1);
+        uint64_t h = 0;
+        TEST_ASSERT(RMNHashParse(OCStringGetCString(OCArrayGetValueAtIndex(recorded, 0)), &h));
+        TEST_ASSERT(h == hashes[v]);
+    }
+    // only the exported document is rewritten; the variables keep their URLs
+    for (OCIndex v = 0; v < 3; ++v)
+        TEST_ASSERT(strcmp(OCStringGetCString(DependentVariableGetComponentsURL(
+                               DatasetGetDependentVariableAtIndex(ds, v))),
+                           urls[v]) == 0);
+    back = DatasetCreateWithImport("tmp/dedup.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    for (OCIndex v = 0; v < 3; ++v)
+        TEST_ASSERT(OCTypeEqual(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, v), 0),
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, v), 0)));
+    OCRelease(back);
+    back = NULL;
+    OCRelease(header);
+    header = NULL;
+
+    // once "b" differs it gets its own blob again on the next export
+    double *edited = (double *)OCDataGetMutableBytes((OCMutableDataRef)
+        DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, 1), 0));
+    edited[0] = -1.0;
+    TEST_ASSERT(DatasetExport(ds, "tmp/dedup.csdfe", "tmp", &err));
+    header = DatasetCopyHeaderFromFile("tmp/dedup.csdfe", &err);
+    TEST_ASSERT(header != NULL);
+    entries = OCDictionaryGetValue(header, STR("dependent_variables"));
+    for (OCIndex v = 0; v < 3; ++v) {
+        OCStringRef url = OCDictionaryGetValue(OCArrayGetValueAtIndex(entries, v),
+                                               STR(kDependentVariableComponentsURLKey));
+        TEST_ASSERT(url && strcmp(OCStringGetCString(url), urls[v]) == 0);
+    }
+    back = DatasetCreateWithImport("tmp/dedup.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    for (OCIndex v = 0; v < 3; ++v)
+        TEST_ASSERT(OCTypeEqual(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, v), 0),
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, v), 0)));
+    OCRelease(back);
+    back = NULL;
+    edited[0] = 0.0;  // "b" duplicates "a" again
+
+    // in a container the two variables share a section
+    TEST_ASSERT(DatasetExport(ds, "tmp/dedup.csdmx", NULL, &err));
+    back = DatasetCreateWithImport("tmp/dedup.csdmx", NULL, &err);
+    TEST_ASSERT(back != NULL);
+    for (OCIndex v = 0; v < 3; ++v)
+        TEST_ASSERT(OCTypeEqual(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, v), 0),
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, v), 0)));
+    ok = true;
+
+cleanup:
+    if (err) OCRelease(err);
+    OCRelease(header);
+    OCRelease(back);
+    OCRelease(ds);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    printf("test_Dataset_export_dedup %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
+bool test_Dataset_blob_checksums(void) {
+    printf("test_Dataset_blob_checksums...\n");
+    bool ok = false;
+    DatasetRef ds = NULL, back = NULL;
+    OCDictionaryRef header = NULL;
+    OCMutableIndexArrayRef chunkShape = NULL;
+    OCStringRef err = NULL;
+    uint8_t *blob = NULL;
+    // three 4 MiB checksum blocks for "a", the last one short
+    const OCIndex n = (OCIndex)(2 * (4 << 20) / sizeof(double)) + 100;
+    OCMutableArrayRef dims = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+    OCMutableArrayRef dvs = OCArrayCreateMutable(2, &kOCTypeArrayCallBacks);
+    SIScalarRef increment = SIScalarCreateWithDouble(1.0, SIUnitDimensionlessAndUnderived());
+    SILinearDimensionRef dim = SILinearDimensionCreateMinimal(kSIQuantityDimensionless, n,
+                                                              increment, NULL, NULL);
+    TEST_ASSERT(dim != NULL);
+    OCArrayAppendValue(dims, dim);
+    OCRelease(dim);
+    // "a" is a plain blob, "b" uses the chunked layout
+    const char *urls[2] = {"file:crc_a.data", "file:crc_b.data"};
+    for (int v = 0; v < 2; ++v) {
+        DependentVariableRef dv = DependentVariableCreateDefault(STR("scalar"),
+                                                                 kOCNumberFloat64Type, n, NULL);
+        TEST_ASSERT(dv != NULL);
+        double *values = (double *)OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        for (OCIndex i = 0; i < n; ++i) values[i] = (double)(v + 1) * (double)i;
+        OCStringRef url = OCStringCreateWithCString(urls[v]);
+        DependentVariableSetType(dv, STR("external"));
+        DependentVariableSetComponentsURL(dv, url);
+        OCRelease(url);
+        if (v == 1) {
+            chunkShape = OCIndexArrayCreateMutable(1);
+            OCIndexArrayAppendValue(chunkShape, 4096);
+            DependentVariableSetChunkShape(dv, chunkShape);
+        }
+        OCArrayAppendValue(dvs, dv);
+        OCRelease(dv);
+    }
+    ds = DatasetCreateMinimal(dims, dvs, &err);
+    TEST_ASSERT(ds != NULL);
+
+    // the recorded blocks are those of the file as written
+    DatasetSetBlobChecksums(true);
+    TEST_ASSERT(DatasetExport(ds, "tmp/crc.csdfe", "tmp", &err));
+    header = DatasetCopyHeaderFromFile("tmp/crc.csdfe", &err);
+    TEST_ASSERT(header != NULL);
+    OCArrayRef entries = OCDictionaryGetValue(header, STR("dependent_variables"));
+    OCDictionaryRef app = OCDictionaryGetValue(OCArrayGetValueAtIndex(entries, 0),
+                                               STR(kDependentVariableMetaDataKey));
+    OCDictionaryRef record = app ? OCDictionaryGetValue(app, STR(kRMNHashBlobChecksumMetaDataKey)) : NULL;
+    TEST_ASSERT(record != NULL);
+    OCIndex blockSize = 0;
+    TEST_ASSERT(OCNumberTryGetOCIndex(OCDictionaryGetValue(record, STR(kRMNHashBlockSizeKey)),
+                                      &blockSize));
+    TEST_ASSERT(blockSize == 4 << 20);
+    OCArrayRef crcs = OCDictionaryGetValue(record, STR(kRMNHashCRC32CKey));
+    TEST_ASSERT(crcs && OCArrayGetCount(crcs) == 3);
+    size_t length = (size_t)n * sizeof(double);
+    blob = malloc(length);
+    FILE *f = fopen("tmp/crc_a.data", "rb");
+    TEST_ASSERT(f != NULL);
+    size_t got = fread(blob, 1, length, f);
+    fclose(f);
+    TEST_ASSERT(got == length);
+    for (OCIndex b = 0; b < 3; ++b) {
+        size_t start = (size_t)b * (size_t)blockSize;
+        size_t len = length - start < (size_t)blockSize ? length - start : (size_t)blockSize;
+        char hex[9];
+        snprintf(hex, sizeof(hex), "%08lx", (unsigned long)RMNHashCRC32C(0, blob + start, len));
+        TEST_ASSERT(strcmp(OCStringGetCString(OCArrayGetValueAtIndex(crcs, b)), hex) == 0);
+    }
+    app = OCDictionaryGetValue(OCArrayGetValueAtIndex(entries, 1), STR(kDependentVariableMetaDataKey));
+    TEST_ASSERT(app && OCDictionaryGetValue(app, STR(kRMNHashBlobChecksumMetaDataKey)));
+
+    // intact blobs import, with the plain one copied and checked in one pass
+    back = DatasetCreateWithImport("tmp/crc.csdfe", "tmp", &err);
+    TEST_ASSERT(back != NULL);
+    for (OCIndex v = 0; v < 2; ++v)
+        TEST_ASSERT(OCTypeEqual(
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, v), 0),
+            DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, v), 0)));
+    OCRelease(back);
+    back = NULL;
+
+    // one flipped bit in the last block is caught, plain or chunked
+    for (int v = 0; v < 2; ++v) {
+        const char *path = v == 0 ? "tmp/crc_a.data" : "tmp/crc_b.data";
+        f = fopen(path, "r+b");
+        TEST_ASSERT(f != NULL);
+        fseek(f, -8, SEEK_END);
+        int c = fgetc(f);
+        fseek(f, -8, SEEK_END);
+        fputc(c ^ 0x10, f);
+        fclose(f);
+        back = DatasetCreateWithImport("tmp/crc.csdfe", "tmp", &err);
+        TEST_ASSERT(back == NULL);
+        TEST_ASSERT(err && strstr(OCStringGetCString(err), "checksum") != NULL);
+        OCRelease(err);
+        err = NULL;
+        TEST_ASSERT(DatasetExport(ds, "tmp/crc.csdfe", "tmp", &err));
+    }
+
+    // container sections carry the same records
+    TEST_ASSERT(DatasetExport(ds, "tmp/crc.csdmx", NULL, &err));
+    back = DatasetCreateWithImport("tmp/crc.csdmx", NULL, &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(OCTypeEqual(
+        DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(ds, 0), 0),
+        DependentVariableGetComponentAtIndex(DatasetGetDependentVariableAtIndex(back, 0), 0)));
+
+    // re-exporting without checksums drops the imported records
+    DatasetSetBlobChecksums(false);
+    TEST_ASSERT(DatasetExport(back, "tmp/crc_plain.csdmx", NULL, &err));
+    OCRelease(header);
+    header = DatasetCopyHeaderFromFile("tmp/crc_plain.csdmx", &err);
+    TEST_ASSERT(header != NULL);
+    entries = OCDictionaryGetValue(header, STR("dependent_variables"));
+    app = OCDictionaryGetValue(OCArrayGetValueAtIndex(entries, 0), STR(kDependentVariableMetaDataKey));
+    TEST_ASSERT(!app || !OCDictionaryGetValue(app, STR(kRMNHashBlobChecksumMetaDataKey)));
+    ok = true;
+
+cleanup:
+    DatasetSetBlobChecksums(false);
+    if (err) OCRelease(err);
+    free(blob);
+    OCRelease(header);
+    OCRelease(back);
+    OCRelease(ds);
+    OCRelease(chunkShape);
+    OCRelease(increment);
+    OCRelease(dvs);
+    OCRelease(dims);
+    printf("test_Dataset_blob_checksums %s.\n", ok ? "passed" : "FAILED");
+    return ok;
+}
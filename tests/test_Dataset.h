@@ -13,6 +13,24 @@ bool test_DatasetCreateMinimal(void);
 bool test_Dataset_mutators(void);
 bool test_Dataset_copy_and_roundtrip(void);
 bool test_Dataset_type_contract(void);
+bool test_Dataset_stream_export_roundtrip(void);
+bool test_Dataset_import_inline_components(void);
+bool test_Dataset_int64_none_roundtrip(void);
+bool test_Dataset_nonfinite_none_roundtrip(void);
+bool test_Dataset_parallel_io(void);
+bool test_Dataset_external_export(void);
+bool test_Dataset_mapped_blob_import(void);
+bool test_Dataset_chunked_external(void);
+bool test_Dataset_lazy_import(void);
+bool test_Dataset_compressed_encodings(void);
+bool test_Dataset_container_roundtrip(void);
+bool test_Dataset_import_subset(void);
+bool test_Dataset_streaming_writer(void);
+bool test_Dataset_atomic_export(void);
+bool test_Dataset_async_io(void);
+bool test_Dataset_header_scan(void);
+bool test_Dataset_export_dedup(void);
+bool test_Dataset_blob_checksums(void);
 bool test_Dataset_open_blank_csdf(void);
 bool test_Dataset_open_blochDecay_base64_csdf(void);
 
@@ -1,6 +1,8 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "RMNLibrary.h"
 #include "SparseSampling.h"
 #include "test_utils.h"
@@ -325,6 +327,52 @@ cleanup:
     return ok;
 }
 
+bool test_DependentVariable_base64_kernels(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL, back = NULL;
+    OCDictionaryRef dict = NULL;
+    OCStringRef err = NULL;
+    OCStringRef reference = NULL;
+
+    // 37 doubles = 296 bytes: exercises full SIMD blocks plus a padded tail
+    dv = _make_internal_scalar(37);
+    TEST_ASSERT(dv);
+    OCMutableDataRef buf = (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0);
+    uint8_t *bytes = OCDataGetMutableBytes(buf);
+    for (OCIndex i = 0; i < OCDataGetLength(buf); ++i) bytes[i] = (uint8_t)(i * 131 + 7);
+    TEST_ASSERT(DependentVariableSetEncoding(dv, STR(kDependentVariableEncodingValueBase64)));
+
+    const RMNBase64Kernel kernels[] = {kRMNBase64KernelScalar, kRMNBase64KernelSSE41,
+                                       kRMNBase64KernelAVX2};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!RMNBase64SetKernel(kernels[k])) continue;
+        dict = DependentVariableCopyAsDictionary(dv);
+        TEST_ASSERT(dict);
+        OCArrayRef comps = OCDictionaryGetValue(dict, STR(kDependentVariableComponentsKey));
+        OCStringRef b64 = OCArrayGetValueAtIndex(comps, 0);
+        // every kernel must produce the scalar encoding
+        if (!reference) reference = OCRetain(b64);
+        TEST_ASSERT(OCStringEqual(reference, b64));
+        back = DependentVariableCreateFromDictionary(dict, &err);
+        TEST_ASSERT(back);
+        TEST_ASSERT(OCTypeEqual(dv, back));
+        OCRelease(back);
+        back = NULL;
+        OCRelease(dict);
+        dict = NULL;
+    }
+    ok = true;
+cleanup:
+    RMNBase64SetKernel(kRMNBase64KernelAuto);
+    if (back) OCRelease(back);
+    if (dict) OCRelease(dict);
+    if (dv) OCRelease(dv);
+    OCRelease(reference);
+    OCRelease(err);
+    printf("DependentVariable base64 kernel tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+
 bool test_DependentVariable_invalid_create(void) {
     bool ok = false;
     OCMutableArrayRef comps = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
@@ -581,3 +629,633 @@ cleanup:
     printf("DependentVariable invalid-create tests %s\n", ok ? "passed." : "FAILED!");
     return ok;
 }
+
+bool test_DependentVariable_none_number_format(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL;
+    FILE *f = NULL;
+    char buf[kRMNDecimalMaxLength];
+
+    // layout: shortest digits, %g-style switch to exponents, signed zero
+    const struct {
+        double value;
+        const char *text;
+    } cases[] = {
+        {0.1, "0.1"}, {-0.0, "-0"}, {1e-5, "1e-05"}, {1e-4, "0.0001"},
+        {100.5, "100.5"}, {1e17, "1e+17"}, {5e-324, "5e-324"},
+        {1.7976931348623157e308, "1.7976931348623157e+308"}, {NAN, "null"},
+        {INFINITY, "1e999"}, {-INFINITY, "-1e999"},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        size_t n = RMNDecimalFormatDouble(cases[i].value, buf);
+        TEST_ASSERT(n == strlen(cases[i].text) && strcmp(buf, cases[i].text) == 0);
+    }
+
+    // every streamed "none" value must parse back to the same bits
+    const OCIndex count = 4096;
+    dv = _make_internal_scalar(count);
+    TEST_ASSERT(dv);
+    double *values = (double *)OCDataGetMutableBytes(
+        (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (OCIndex i = 0; i < count; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t bits = state;
+        if (i % 3 == 0) bits &= ~(0x7FFull << 52);  // subnormals
+        memcpy(&values[i], &bits, sizeof(double));
+        if (isnan(values[i]) || isinf(values[i])) values[i] = (double)i / 7.0;
+    }
+    TEST_ASSERT(DependentVariableSetEncoding(dv, STR(kDependentVariableEncodingValueNone)));
+    f = tmpfile();
+    TEST_ASSERT(f);
+    TEST_ASSERT(DependentVariableWriteComponentJSON(dv, 0, f));
+    long size = ftell(f);
+    TEST_ASSERT(size > 2);
+    char *text = malloc((size_t)size + 1);
+    TEST_ASSERT(text);
+    rewind(f);
+    bool read = fread(text, 1, (size_t)size, f) == (size_t)size;
+    text[read ? size : 0] = '\0';
+    const char *p = text + 1;
+    OCIndex matched = 0;
+    for (OCIndex i = 0; read && i < count; ++i) {
+        char *stop = NULL;
+        double v = strtod(p, &stop);
+        if (stop == p || memcmp(&v, &values[i], sizeof(double)) != 0) break;
+        matched++;
+        p = stop + (*stop == ',' ? 2 : 0);
+    }
+    free(text);
+    TEST_ASSERT(matched == count);
+    ok = true;
+cleanup:
+    if (f) fclose(f);
+    if (dv) OCRelease(dv);
+    printf("DependentVariable none number format tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+
+bool test_DependentVariable_none_number_parse(void) {
+    bool ok = false;
+    char buf[64];
+
+    // hard cases: halfway points, subnormals, overflow, > 19 digits
+    const char *cases[] = {
+        "0", "-0", "0.1", "1e-05", "5e-324", "2.4703282292062327e-324",
+        "2.4703282292062328e-324", "2.2250738585072011e-308", "1.7976931348623157e+308",
+        "1.8e308", "1e-400", "9007199254740993", "1e23", "7.038531e-26", "1.4e-45",
+        "3.4028235e38", "1.00000005960464477550", "123456789012345678901234567890",
+        "0.000000000000000000000000000001234567890123456789012", "-1.25E+10",
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        const char *end = cases[i] + strlen(cases[i]);
+        double d, expected = strtod(cases[i], NULL);
+        float f, expectedFloat = strtof(cases[i], NULL);
+        TEST_ASSERT(RMNDecimalParseDouble(cases[i], end, &d) == end);
+        TEST_ASSERT(memcmp(&d, &expected, sizeof(d)) == 0);
+        TEST_ASSERT(RMNDecimalParseFloat(cases[i], end, &f) == end);
+        TEST_ASSERT(memcmp(&f, &expectedFloat, sizeof(f)) == 0);
+    }
+
+    // JSON grammar only, and the span end is respected
+    const char *invalid[] = {"", "-", "+1", ".5", "1.", "1e", "1e+", "nan", "inf", " 1"};
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        double d;
+        TEST_ASSERT(!RMNDecimalParseDouble(invalid[i], invalid[i] + strlen(invalid[i]), &d));
+    }
+    double d;
+    const char *digits = "12345,";
+    TEST_ASSERT(RMNDecimalParseDouble(digits, digits + 3, &d) == digits + 3 && d == 123.0);
+    TEST_ASSERT(RMNDecimalParseDouble(digits, digits + 6, &d) == digits + 5 && d == 12345.0);
+
+    // random bit patterns in shortest and %.17g text read back bit for bit
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (int i = 0; i < 100000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t bits = state;
+        if (i % 4 == 0) bits &= ~(0x7FFull << 52);  // subnormals
+        double v, parsed;
+        memcpy(&v, &bits, sizeof(v));
+        if (isnan(v) || isinf(v)) continue;
+        size_t n = (i & 1) ? RMNDecimalFormatDouble(v, buf)
+                           : (size_t)snprintf(buf, sizeof(buf), "%.17g", v);
+        TEST_ASSERT(RMNDecimalParseDouble(buf, buf + n, &parsed) == buf + n);
+        TEST_ASSERT(memcmp(&parsed, &v, sizeof(v)) == 0);
+        float fparsed, expectedFloat = strtof(buf, NULL);
+        TEST_ASSERT(RMNDecimalParseFloat(buf, buf + n, &fparsed) == buf + n);
+        TEST_ASSERT(memcmp(&fparsed, &expectedFloat, sizeof(fparsed)) == 0);
+    }
+    ok = true;
+cleanup:
+    printf("DependentVariable none number parse tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+
+bool test_DependentVariable_none_dictionary_roundtrip(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL, back = NULL;
+    OCMutableArrayRef comps = NULL;
+    OCDictionaryRef dict = NULL;
+    OCStringRef err = NULL;
+
+    // every element width, including complex re/im pairs, through OCNumber lists
+    const OCNumberType types[] = {kOCNumberSInt8Type,   kOCNumberSInt16Type, kOCNumberUInt32Type,
+                                  kOCNumberSInt64Type,  kOCNumberFloat32Type, kOCNumberFloat64Type,
+                                  kOCNumberComplex64Type, kOCNumberComplex128Type};
+    const OCIndex count = 257;
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+        size_t elemSize = OCNumberTypeSize(types[t]);
+        comps = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+        OCMutableDataRef buf = OCDataCreateMutable(0);
+        OCDataSetLength(buf, count * elemSize);
+        uint8_t *bytes = OCDataGetMutableBytes(buf);
+        for (OCIndex i = 0; i < count; ++i) {
+            switch (types[t]) {
+                case kOCNumberSInt8Type: ((int8_t *)bytes)[i] = (int8_t)(i - 100); break;
+                case kOCNumberSInt16Type: ((int16_t *)bytes)[i] = (int16_t)(i * -97); break;
+                case kOCNumberUInt32Type: ((uint32_t *)bytes)[i] = (uint32_t)i * 40503u; break;
+                case kOCNumberSInt64Type: ((int64_t *)bytes)[i] = (int64_t)i * -1234567; break;
+                case kOCNumberFloat32Type: ((float *)bytes)[i] = (float)i / 3.0f; break;
+                case kOCNumberFloat64Type: ((double *)bytes)[i] = (double)i / 7.0; break;
+                case kOCNumberComplex64Type:
+                    ((float complex *)bytes)[i] = (float)i / 3.0f - ((float)i * 0.25f) * I;
+                    break;
+                default:
+                    ((double complex *)bytes)[i] = (double)i / 7.0 + ((double)i * 0.5) * I;
+                    break;
+            }
+        }
+        OCArrayAppendValue(comps, buf);
+        OCRelease(buf);
+        dv = DependentVariableCreate(STR(""), STR(""), SIUnitDimensionlessAndUnderived(),
+                                     kSIQuantityDimensionless, STR("scalar"), types[t], NULL,
+                                     comps, &err);
+        TEST_ASSERT(dv);
+        TEST_ASSERT(DependentVariableSetEncoding(dv, STR(kDependentVariableEncodingValueNone)));
+        dict = DependentVariableCopyAsDictionary(dv);
+        TEST_ASSERT(dict);
+        back = DependentVariableCreateFromDictionary(dict, &err);
+        TEST_ASSERT(back);
+        OCDataRef a = DependentVariableGetComponentAtIndex(dv, 0);
+        OCDataRef b = DependentVariableGetComponentAtIndex(back, 0);
+        TEST_ASSERT(OCDataGetLength(a) == OCDataGetLength(b));
+        TEST_ASSERT(memcmp(OCDataGetBytesPtr(a), OCDataGetBytesPtr(b), OCDataGetLength(a)) == 0);
+        OCRelease(back);
+        back = NULL;
+        OCRelease(dict);
+        dict = NULL;
+        OCRelease(dv);
+        dv = NULL;
+        OCRelease(comps);
+        comps = NULL;
+    }
+
+    // complex lists hold re/im pairs, so an odd-length list is malformed
+    // rather than padded with a zero imaginary part; integers the type
+    // cannot hold are rejected rather than wrapped
+    const struct {
+        OCNumberType type;
+        OCIndex count;
+        double values[3];
+    } malformed[] = {
+        {kOCNumberComplex128Type, 3, {1.0, 2.0, 3.0}},
+        {kOCNumberComplex64Type, 1, {1.0}},
+        {kOCNumberSInt8Type, 2, {1.0, 200.0}},
+        {kOCNumberUInt32Type, 1, {-1.0}},
+    };
+    for (size_t m = 0; m < sizeof(malformed) / sizeof(malformed[0]); ++m) {
+        dv = DependentVariableCreateDefault(STR("scalar"), malformed[m].type, 1, NULL);
+        TEST_ASSERT(dv);
+        TEST_ASSERT(DependentVariableSetEncoding(dv, STR(kDependentVariableEncodingValueNone)));
+        dict = DependentVariableCopyAsDictionary(dv);
+        TEST_ASSERT(dict);
+        OCMutableDictionaryRef edited = OCDictionaryCreateMutableCopy(dict);
+        OCMutableArrayRef numbers = OCArrayCreateMutable(0, &kOCTypeArrayCallBacks);
+        comps = OCArrayCreateMutable(1, &kOCTypeArrayCallBacks);
+        for (OCIndex i = 0; i < malformed[m].count; ++i) {
+            OCNumberRef n = OCNumberCreateWithDouble(malformed[m].values[i]);
+            OCArrayAppendValue(numbers, n);
+            OCRelease(n);
+        }
+        OCArrayAppendValue(comps, numbers);
+        OCRelease(numbers);
+        OCDictionarySetValue(edited, STR(kDependentVariableComponentsKey), comps);
+        back = DependentVariableCreateFromDictionary(edited, &err);
+        OCRelease(edited);
+        TEST_ASSERT(back == NULL);
+        TEST_ASSERT(err != NULL);
+        OCRelease(err);
+        err = NULL;
+        OCRelease(comps);
+        comps = NULL;
+        OCRelease(dict);
+        dict = NULL;
+        OCRelease(dv);
+        dv = NULL;
+    }
+    ok = true;
+cleanup:
+    if (back) OCRelease(back);
+    if (dict) OCRelease(dict);
+    if (dv) OCRelease(dv);
+    if (comps) OCRelease(comps);
+    OCRelease(err);
+    printf("DependentVariable none dictionary roundtrip tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+
+bool test_DependentVariable_bulk_accessors(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL;
+    const OCNumberType types[] = {kOCNumberSInt16Type, kOCNumberUInt32Type, kOCNumberFloat32Type,
+                                  kOCNumberFloat64Type, kOCNumberComplex64Type,
+                                  kOCNumberComplex128Type};
+    const complexPart parts[] = {kSIRealPart, kSIImaginaryPart, kSIMagnitudePart, kSIArgumentPart};
+    enum { n = 1000, count = 300 };
+    double d[n];
+    float f[n];
+    double complex z[n];
+    float complex fz[n];
+    const RMNConvertKernel kernels[] = {kRMNConvertKernelScalar, kRMNConvertKernelAVX2};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!RMNConvertSetKernel(kernels[k])) continue;
+        for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+            dv = DependentVariableCreateDefault(STR("scalar"), types[t], n, NULL);
+            TEST_ASSERT(dv);
+            uint8_t *bytes = OCDataGetMutableBytes(
+                (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            for (OCIndex i = 0; i < n; ++i) {
+                double v = (double)(i * 7 % 200) - 50.25 * (i % 3);
+                switch (types[t]) {
+                    case kOCNumberSInt16Type: ((int16_t *)bytes)[i] = (int16_t)v; break;
+                    case kOCNumberUInt32Type: ((uint32_t *)bytes)[i] = (uint32_t)fabs(v); break;
+                    case kOCNumberFloat32Type: ((float *)bytes)[i] = (float)v; break;
+                    case kOCNumberFloat64Type: ((double *)bytes)[i] = v; break;
+                    case kOCNumberComplex64Type:
+                        ((float complex *)bytes)[i] = (float)v + (float)(0.5 * i) * I;
+                        break;
+                    default: ((double complex *)bytes)[i] = v - (0.5 * i) * I; break;
+                }
+            }
+            // contiguous, strided and backwards runs agree with the per-element getters
+            const OCIndex offsets[] = {0, 1, n - 1};
+            const OCIndex strides[] = {1, 3, -3};
+            for (int r = 0; r < 3; ++r) {
+                OCIndex off = offsets[r], stride = strides[r];
+                TEST_ASSERT(DependentVariableCopyDoubleValues(dv, 0, off, stride, count, d));
+                TEST_ASSERT(DependentVariableCopyFloatValues(dv, 0, off, stride, count, f));
+                TEST_ASSERT(DependentVariableCopyDoubleComplexValues(dv, 0, off, stride, count, z));
+                TEST_ASSERT(DependentVariableCopyFloatComplexValues(dv, 0, off, stride, count, fz));
+                for (OCIndex i = 0; i < count; ++i) {
+                    OCIndex m = off + i * stride;
+                    TEST_ASSERT(d[i] == DependentVariableGetDoubleValueAtMemOffset(dv, 0, m));
+                    TEST_ASSERT(f[i] == DependentVariableGetFloatValueAtMemOffset(dv, 0, m));
+                    double im = DependentVariableGetDoubleValueAtMemOffsetForPart(
+                        dv, 0, m, kSIImaginaryPart);
+                    TEST_ASSERT(creal(z[i]) == d[i] && cimag(z[i]) == im);
+                    TEST_ASSERT(crealf(fz[i]) == (float)d[i] && cimagf(fz[i]) == (float)im);
+                }
+                for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); ++p) {
+                    TEST_ASSERT(DependentVariableCopyDoubleValuesForPart(dv, 0, off, stride, count,
+                                                                        parts[p], d));
+                    for (OCIndex i = 0; i < count; ++i) {
+                        TEST_ASSERT(d[i] == DependentVariableGetDoubleValueAtMemOffsetForPart(
+                                                dv, 0, off + i * stride, parts[p]));
+                    }
+                }
+            }
+            DependentVariableSpan span;
+            TEST_ASSERT(DependentVariableGetComponentSpan(dv, 0, 10, 2, 5, &span));
+            TEST_ASSERT(span.type == types[t] && span.count == 5 && span.stride == 2);
+            TEST_ASSERT((const uint8_t *)span.bytes == bytes + 10 * OCNumberTypeSize(types[t]));
+            // runs leaving the component are rejected rather than wrapped
+            TEST_ASSERT(!DependentVariableCopyDoubleValues(dv, 0, n - 10, 1, 11, d));
+            TEST_ASSERT(!DependentVariableCopyDoubleValues(dv, 0, 5, -1, 7, d));
+            TEST_ASSERT(!DependentVariableCopyDoubleValues(dv, 0, 0, 0, 2, d));
+            TEST_ASSERT(!DependentVariableCopyDoubleValues(dv, 1, 0, 1, 1, d));
+            // (count - 1) * stride wraps to 0 in OCIndex; must not pass
+            OCIndex wrapCount = (OCIndex)(((size_t)1 << (sizeof(OCIndex) * 8 - 2)) + 1);
+            TEST_ASSERT(!DependentVariableGetComponentSpan(dv, 0, 0, 4, wrapCount, &span));
+            TEST_ASSERT(!DependentVariableGetComponentSpan(dv, 0, 5, -4, wrapCount, &span));
+            TEST_ASSERT(DependentVariableCopyDoubleValues(dv, 0, 0, 1, 0, d));
+            OCRelease(dv);
+            dv = NULL;
+        }
+    }
+    ok = true;
+cleanup:
+    RMNConvertSetKernel(kRMNConvertKernelAuto);
+    if (dv) OCRelease(dv);
+    printf("DependentVariable bulk accessor tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+
+bool test_DependentVariable_element_type_conversion(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL;
+    enum { n = 5000 };
+    double d[n];
+    const RMNConvertKernel kernels[] = {kRMNConvertKernelScalar, kRMNConvertKernelAVX2,
+                                        kRMNConvertKernelAVX512};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!RMNConvertSetKernel(kernels[k])) continue;
+        // raw ADC-style int16 data through a chain of widening and narrowing
+        dv = DependentVariableCreateDefault(STR("scalar"), kOCNumberSInt16Type, n, NULL);
+        TEST_ASSERT(dv);
+        int16_t *raw = OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        for (OCIndex i = 0; i < n; ++i) raw[i] = (int16_t)(i * 13 - 32000);
+        const OCNumberType chain[] = {kOCNumberFloat32Type, kOCNumberComplex64Type,
+                                      kOCNumberComplex128Type, kOCNumberFloat64Type,
+                                      kOCNumberSInt32Type, kOCNumberSInt16Type};
+        for (size_t c = 0; c < sizeof(chain) / sizeof(chain[0]); ++c) {
+            TEST_ASSERT(DependentVariableSetElementType(dv, chain[c]));
+            TEST_ASSERT(DependentVariableGetElementType(dv) == chain[c]);
+            TEST_ASSERT(OCDataGetLength(DependentVariableGetComponentAtIndex(dv, 0)) ==
+                        n * (OCIndex)OCNumberTypeSize(chain[c]));
+            TEST_ASSERT(DependentVariableCopyDoubleValues(dv, 0, 0, 1, n, d));
+            for (OCIndex i = 0; i < n; ++i) TEST_ASSERT(d[i] == (double)(int16_t)(i * 13 - 32000));
+        }
+        // narrowing to integers truncates and saturates; NaN becomes 0
+        TEST_ASSERT(DependentVariableSetElementType(dv, kOCNumberFloat64Type));
+        double *values = OCDataGetMutableBytes(
+            (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+        values[0] = 300.7;
+        values[1] = -2.9;
+        values[2] = NAN;
+        values[3] = 1e300;
+        TEST_ASSERT(DependentVariableSetElementType(dv, kOCNumberUInt8Type));
+        const uint8_t *u8 = OCDataGetBytesPtr(DependentVariableGetComponentAtIndex(dv, 0));
+        TEST_ASSERT(u8[0] == 255 && u8[1] == 0 && u8[2] == 0 && u8[3] == 255);
+        TEST_ASSERT(DependentVariableSetElementType(dv, kOCNumberSInt8Type));
+        const int8_t *s8 = OCDataGetBytesPtr(DependentVariableGetComponentAtIndex(dv, 0));
+        TEST_ASSERT(s8[0] == 127 && s8[1] == 0);
+        OCRelease(dv);
+        dv = NULL;
+    }
+    ok = true;
+cleanup:
+    RMNConvertSetKernel(kRMNConvertKernelAuto);
+    if (dv) OCRelease(dv);
+    printf("DependentVariable element type conversion tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+bool test_DependentVariable_elementwise_kernels(void) {
+    bool ok = false;
+    DependentVariableRef dv = NULL;
+    // two threaded blocks plus a tail
+    enum { n = (1 << 17) + 37 };
+    double *src = malloc(2 * n * sizeof(double));
+    double *want = malloc(2 * n * sizeof(double));
+    TEST_ASSERT(src && want);
+    for (OCIndex i = 0; i < 2 * n; ++i) src[i] = (double)(i * 7919 % 20011 - 10005) * 1.25e-3;
+    src[1] = NAN;
+    src[2] = -0.0;
+    src[3] = -INFINITY;
+    const RMNConvertKernel kernels[] = {kRMNConvertKernelScalar, kRMNConvertKernelAVX2,
+                                        kRMNConvertKernelAVX512};
+    const size_t thresholds[] = {SIZE_MAX, 1};
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+        if (!RMNConvertSetKernel(kernels[k])) continue;
+        for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); ++t) {
+            RMNElementwiseSetParallelThreshold(thresholds[t]);
+            // real scaling and abs are bit-identical to the plain loop
+            dv = DependentVariableCreateDefault(STR("scalar"), kOCNumberFloat64Type, n, NULL);
+            TEST_ASSERT(dv);
+            double *x = OCDataGetMutableBytes(
+                (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            memcpy(x, src, n * sizeof(double));
+            TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessRealConstant(dv, -1, -0.3));
+            for (OCIndex i = 0; i < n; ++i) want[i] = src[i] * -0.3;
+            TEST_ASSERT(memcmp(x, want, n * sizeof(double)) == 0);
+            TEST_ASSERT(DependentVariableTakeAbsoluteValue(dv, 0));
+            for (OCIndex i = 0; i < n; ++i) want[i] = fabs(want[i]);
+            TEST_ASSERT(memcmp(x, want, n * sizeof(double)) == 0);
+            OCRelease(dv);
+            // complex conjugate, product and magnitude
+            dv = DependentVariableCreateDefault(STR("scalar"), kOCNumberComplex128Type, n, NULL);
+            TEST_ASSERT(dv);
+            x = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            memcpy(x, src, 2 * n * sizeof(double));
+            TEST_ASSERT(DependentVariableConjugate(dv, -1));
+            memcpy(want, x, 2 * n * sizeof(double));
+            TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessComplexConstant(dv, 0, 2.0 * I));
+            const double zfactor[2] = {0.0, 2.0};
+            cblas_zscal(n, zfactor, want, 1);
+            TEST_ASSERT(memcmp(x, want, 2 * n * sizeof(double)) == 0);
+            for (OCIndex i = 4; i < n; ++i)
+                TEST_ASSERT(x[2 * i] == 2.0 * src[2 * i + 1] && x[2 * i + 1] == 2.0 * src[2 * i]);
+            TEST_ASSERT(DependentVariableTakeAbsoluteValue(dv, -1));
+            TEST_ASSERT(DependentVariableGetElementType(dv) == kOCNumberFloat64Type);
+            x = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            for (OCIndex i = 4; i < n; ++i)
+                TEST_ASSERT(x[i] == hypot(2.0 * src[2 * i], 2.0 * src[2 * i + 1]));
+            OCRelease(dv);
+            // complex64 scaling and magnitude against the routines they
+            // replaced, cblas_cscal() and cabsf()
+            dv = DependentVariableCreateDefault(STR("scalar"), kOCNumberComplex64Type, n, NULL);
+            TEST_ASSERT(dv);
+            float *xf = OCDataGetMutableBytes(
+                (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            float *wf = (float *)want;
+            for (OCIndex i = 0; i < 2 * n; ++i) xf[i] = wf[i] = (float)src[i];
+            const float cfactor[2] = {0.3f, -1.7f};
+            TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessComplexConstant(
+                dv, -1, cfactor[0] + cfactor[1] * I));
+            cblas_cscal(n, cfactor, wf, 1);
+            TEST_ASSERT(memcmp(xf, wf, 2 * n * sizeof(float)) == 0);
+            TEST_ASSERT(DependentVariableTakeAbsoluteValue(dv, -1));
+            TEST_ASSERT(DependentVariableGetElementType(dv) == kOCNumberFloat32Type);
+            xf = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            for (OCIndex i = 0; i < n; ++i) {
+                float mag = cabsf(CMPLXF(wf[2 * i], wf[2 * i + 1]));
+#if defined(__GLIBC__)
+                TEST_ASSERT(memcmp(&xf[i], &mag, sizeof(mag)) == 0);
+#else
+                // other C libraries may round cabsf() differently by one ulp
+                TEST_ASSERT(xf[i] == mag || (isnan(xf[i]) && isnan(mag)) ||
+                            xf[i] == nextafterf(mag, INFINITY) ||
+                            xf[i] == nextafterf(mag, -INFINITY));
+#endif
+            }
+            OCRelease(dv);
+            // integer scaling saturates instead of wrapping
+            dv = DependentVariableCreateDefault(STR("scalar"), kOCNumberSInt16Type, n, NULL);
+            TEST_ASSERT(dv);
+            int16_t *s16 = OCDataGetMutableBytes(
+                (OCMutableDataRef)DependentVariableGetComponentAtIndex(dv, 0));
+            for (OCIndex i = 0; i < n; ++i) s16[i] = (int16_t)(i * 37);
+            TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessRealConstant(dv, 0, 2.5));
+            for (OCIndex i = 0; i < n; ++i) {
+                double v = trunc((int16_t)(i * 37) * 2.5);
+                TEST_ASSERT(s16[i] == (v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v));
+            }
+            OCRelease(dv);
+            dv = NULL;
+        }
+    }
+    ok = true;
+cleanup:
+    RMNConvertSetKernel(kRMNConvertKernelAuto);
+    RMNElementwiseSetParallelThreshold(0);
+    if (dv) OCRelease(dv);
+    free(src);
+    free(want);
+    printf("DependentVariable elementwise kernel tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+bool test_DependentVariable_binary_operations(void) {
+    bool ok = false;
+    DependentVariableRef a = NULL, b = NULL, c = NULL;
+    OCStringRef err = NULL;
+    enum { n = 3000 };
+    SIUnitRef millivolt = SIUnitFromExpression(STR("mV"), NULL, &err);
+    SIUnitRef volt = SIUnitFromExpression(STR("V"), NULL, &err);
+    SIUnitRef voltSquared = SIUnitFromExpression(STR("V^2"), NULL, &err);
+    TEST_ASSERT(millivolt && volt && voltSquared && !err);
+    // two float64 components in mV, and one float32 component in V
+    a = DependentVariableCreateWithSize(NULL, NULL, millivolt, NULL, STR("vector_2"),
+                                        kOCNumberFloat64Type, NULL, n, &err);
+    b = DependentVariableCreateWithSize(NULL, NULL, volt, NULL, STR("scalar"),
+                                        kOCNumberFloat32Type, NULL, n, &err);
+    TEST_ASSERT(a && b);
+    for (OCIndex ci = 0; ci < 2; ++ci) {
+        double *x = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(a, ci));
+        for (OCIndex i = 0; i < n; ++i) x[i] = (double)(i + 1) * (ci ? -2.0 : 1.0);
+    }
+    float *y = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(b, 0));
+    for (OCIndex i = 0; i < n; ++i) y[i] = 0.25f * (float)(i % 7 + 1);
+    // the single-component operand is broadcast and converted to mV
+    TEST_ASSERT(DependentVariableAdd(a, b, &err));
+    for (OCIndex ci = 0; ci < 2; ++ci)
+        for (OCIndex i = 0; i < n; ++i) {
+            double want = (double)(i + 1) * (ci ? -2.0 : 1.0) + 1000.0 * y[i];
+            TEST_ASSERT(fabs(DependentVariableGetDoubleValueAtMemOffset(a, ci, i) - want) <=
+                        1e-12 * fabs(want));
+        }
+    TEST_ASSERT(DependentVariableSubtract(a, b, &err));
+    // products change the unit: mV * V has the dimensionality of V^2
+    TEST_ASSERT(DependentVariableMultiply(a, b, &err));
+    TEST_ASSERT(SIDimensionalityHasSameReducedDimensionality(
+        SIUnitGetDimensionality(SIQuantityGetUnit((SIQuantityRef)a)),
+        SIUnitGetDimensionality(voltSquared)));
+    TEST_ASSERT(DependentVariableConvertToUnit(a, voltSquared, &err));
+    for (OCIndex i = 0; i < n; ++i) {
+        double want = -2e-3 * (double)(i + 1) * y[i];
+        TEST_ASSERT(fabs(DependentVariableGetDoubleValueAtMemOffset(a, 1, i) - want) <=
+                    1e-9 * fabs(want));
+    }
+    // x / x is dimensionless one, including with the operand aliased
+    TEST_ASSERT(DependentVariableDivide(a, a, &err));
+    TEST_ASSERT(SIDimensionalityHasSameReducedDimensionality(
+        SIUnitGetDimensionality(SIQuantityGetUnit((SIQuantityRef)a)),
+        SIUnitGetDimensionality(SIUnitDimensionlessAndUnderived())));
+    for (OCIndex i = 0; i < n; ++i) TEST_ASSERT(DependentVariableGetDoubleValueAtMemOffset(a, 0, i) == 1.0);
+    // incompatible operands leave the variable unchanged and say why
+    TEST_ASSERT(!DependentVariableAdd(b, a, &err));
+    TEST_ASSERT(err);
+    OCRelease(err);
+    err = NULL;
+    c = DependentVariableCreateWithSize(NULL, NULL, volt, NULL, STR("scalar"),
+                                        kOCNumberComplex64Type, NULL, n, &err);
+    TEST_ASSERT(c);
+    TEST_ASSERT(!DependentVariableAdd(b, c, &err));
+    TEST_ASSERT(err);
+    OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(DependentVariableGetDoubleValueAtMemOffset(b, 0, 3) == 1.0);
+    OCRelease(c);
+    // integer results saturate
+    c = DependentVariableCreateDefault(STR("scalar"), kOCNumberSInt16Type, n, NULL);
+    TEST_ASSERT(c);
+    int16_t *s16 = OCDataGetMutableBytes((OCMutableDataRef)DependentVariableGetComponentAtIndex(c, 0));
+    for (OCIndex i = 0; i < n; ++i) s16[i] = (int16_t)(i * 23);
+    TEST_ASSERT(DependentVariableMultiply(c, c, &err));
+    for (OCIndex i = 0; i < n; ++i) {
+        double w = (int16_t)(i * 23);
+        double v = w * w;
+        TEST_ASSERT(s16[i] == (v > INT16_MAX ? INT16_MAX : (int16_t)v));
+    }
+    ok = true;
+cleanup:
+    if (err) OCRelease(err);
+    if (a) OCRelease(a);
+    if (b) OCRelease(b);
+    if (c) OCRelease(c);
+    printf("DependentVariable binary operation tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
+bool test_DependentVariable_deferred_operations(void) {
+    bool ok = false;
+    DependentVariableRef a = NULL, b = NULL;
+    // several cache blocks plus a tail
+    enum { n = 3 * 4096 + 37 };
+    const OCRange head = {.location = 100, .length = 5000};
+    const size_t thresholds[] = {SIZE_MAX, 1};
+    for (size_t t = 0; t < sizeof(thresholds) / sizeof(thresholds[0]); ++t) {
+        RMNElementwiseSetParallelThreshold(thresholds[t]);
+        a = DependentVariableCreateDefault(STR("vector_2"), kOCNumberComplex128Type, n, NULL);
+        TEST_ASSERT(a);
+        for (OCIndex ci = 0; ci < 2; ++ci) {
+            double complex *z = OCDataGetMutableBytes(
+                (OCMutableDataRef)DependentVariableGetComponentAtIndex(a, ci));
+            for (OCIndex i = 0; i < n; ++i)
+                z[i] = (double)(i % 101 - 50) * 0.75 + (double)(i % 37 - ci) * 1.5 * I;
+        }
+        b = DependentVariableCreateCopy(a);
+        TEST_ASSERT(b);
+        // the same chain, recorded on a and run step by step on b
+        TEST_ASSERT(DependentVariableSetDefersOperations(a, true));
+        TEST_ASSERT(DependentVariableDefersOperations(a) && !DependentVariableDefersOperations(b));
+        DependentVariableRef dvs[] = {a, b};
+        for (int k = 0; k < 2; ++k) {
+            DependentVariableRef dv = dvs[k];
+            TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessRealConstant(dv, -1, 2.5));
+            TEST_ASSERT(
+                DependentVariableMultiplyValuesByDimensionlessComplexConstant(dv, 1, 0.5 - 2.0 * I));
+            TEST_ASSERT(DependentVariableConjugate(dv, -1));
+            TEST_ASSERT(DependentVariableZeroPartInRange(dv, 0, head, kSIImaginaryPart));
+            TEST_ASSERT(DependentVariableTakeAbsoluteValue(dv, -1));
+            TEST_ASSERT(DependentVariableZeroPartInRange(dv, 1, head, kSIRealPart));
+            // invalid requests are refused at once and not recorded
+            TEST_ASSERT(!DependentVariableConjugate(dv, 2));
+            TEST_ASSERT(!DependentVariableZeroPartInRange(dv, 0, (OCRange){n - 1, 2}, kSIRealPart));
+        }
+        TEST_ASSERT(DependentVariableGetQueuedOperationCount(a) == 6);
+        TEST_ASSERT(DependentVariableGetQueuedOperationCount(b) == 0);
+        // reading the element type runs the queue, including the narrowing
+        TEST_ASSERT(DependentVariableGetElementType(a) == kOCNumberFloat64Type);
+        TEST_ASSERT(DependentVariableGetQueuedOperationCount(a) == 0);
+        TEST_ASSERT(DependentVariableGetElementType(b) == kOCNumberFloat64Type);
+        for (OCIndex ci = 0; ci < 2; ++ci) {
+            OCDataRef da = DependentVariableGetComponentAtIndex(a, ci);
+            OCDataRef db = DependentVariableGetComponentAtIndex(b, ci);
+            TEST_ASSERT((size_t)OCDataGetLength(da) == n * sizeof(double));
+            TEST_ASSERT((size_t)OCDataGetLength(db) == n * sizeof(double));
+            TEST_ASSERT(memcmp(OCDataGetBytesPtr(da), OCDataGetBytesPtr(db), n * sizeof(double)) ==
+                        0);
+        }
+        TEST_ASSERT(DependentVariableGetDoubleValueAtMemOffset(a, 1, 200) == 0.0);
+        TEST_ASSERT(DependentVariableGetDoubleValueAtMemOffset(a, 0, 200) == 2.5 * 0.75 * 49);
+        // switching deferral off runs what is left
+        TEST_ASSERT(DependentVariableMultiplyValuesByDimensionlessRealConstant(a, 0, -1.0));
+        TEST_ASSERT(DependentVariableGetQueuedOperationCount(a) == 1);
+        TEST_ASSERT(DependentVariableSetDefersOperations(a, false));
+        TEST_ASSERT(DependentVariableGetQueuedOperationCount(a) == 0);
+        TEST_ASSERT(DependentVariableGetDoubleValueAtMemOffset(a, 0, 200) == -2.5 * 0.75 * 49);
+        OCRelease(a);
+        OCRelease(b);
+        a = b = NULL;
+    }
+    ok = true;
+cleanup:
+    RMNElementwiseSetParallelThreshold(0);
+    if (a) OCRelease(a);
+    if (b) OCRelease(b);
+    printf("DependentVariable deferred operation tests %s\n", ok ? "passed." : "FAILED!");
+    return ok;
+}
@@ -10,7 +10,16 @@ bool test_DependentVariable_values_and_accessors(void);
 bool test_DependentVariable_type_queries(void);
 bool test_DependentVariable_sparse_sampling(void);
 bool test_DependentVariable_copy_and_roundtrip(void);
+bool test_DependentVariable_base64_kernels(void);
 bool test_DependentVariable_invalid_create(void);
+bool test_DependentVariable_none_number_format(void);
+bool test_DependentVariable_none_number_parse(void);
+bool test_DependentVariable_none_dictionary_roundtrip(void);
+bool test_DependentVariable_bulk_accessors(void);
+bool test_DependentVariable_element_type_conversion(void);
+bool test_DependentVariable_elementwise_kernels(void);
+bool test_DependentVariable_binary_operations(void);
+bool test_DependentVariable_deferred_operations(void);
 bool test_DependentVariable_components(void);
 bool test_DependentVariable_values(void);
 bool test_DependentVariable_typeQueries(void);
@@ -1,4 +1,5 @@
 #include <stdbool.h>
+#include <math.h>
 #include <stdio.h>
 #include "RMNLibrary.h"
 #include "test_utils.h"
@@ -513,3 +514,69 @@ bool test_minimal_monotonic(void) {
     fprintf(stderr, "%s %s\n", __func__, "passed.");
     return true;
 }
+
+// ----------------------------------------------------------------------------
+// test_DimensionCreateSubset
+// ----------------------------------------------------------------------------
+static bool _linear_matches(DimensionRef dim, OCIndex count, double offset, double increment) {
+    SILinearDimensionRef lin = (SILinearDimensionRef)dim;
+    SIUnitRef s = SIUnitFindWithUnderivedSymbol(STR("s"));
+    return dim && OCGetTypeID(dim) == SILinearDimensionGetTypeID() &&
+           SILinearDimensionGetCount(lin) == count &&
+           fabs(SIScalarDoubleValueInUnit(SIDimensionGetCoordinatesOffset((SIDimensionRef)lin), s, NULL) - offset) < 1e-12 &&
+           fabs(SIScalarDoubleValueInUnit(SILinearDimensionGetIncrement(lin), s, NULL) - increment) < 1e-12;
+}
+bool test_DimensionCreateSubset(void) {
+    fprintf(stderr, "%s begin...\n", __func__);
+    bool ok = false;
+    OCStringRef err = NULL;
+    SIUnitRef s = SIUnitFindWithUnderivedSymbol(STR("s"));
+    SIScalarRef off = SIScalarCreateWithDouble(1.0, s);
+    SIScalarRef inc = SIScalarCreateWithDouble(0.5, s);
+    SIScalarRef recOff = SIScalarCreateWithDouble(0.0, SIUnitFindWithUnderivedSymbol(STR("Hz")));
+    SIDimensionRef rec = NULL;
+    SILinearDimensionRef plain = NULL, fft = NULL;
+    DimensionRef sub = NULL;
+    TEST_ASSERT(off && inc && recOff);
+    rec = SIDimensionCreate(STR("rlabel"), NULL, NULL, kSIQuantityFrequency, recOff, NULL, NULL,
+                            false, kDimensionScalingNone, &err);
+    TEST_ASSERT(rec && !err);
+    // coordinates 1, 1.5, …, 4.5 s; the reciprocal must not survive a subset
+    plain = SILinearDimensionCreate(STR("t"), NULL, NULL, kSIQuantityTime, off, NULL, NULL, false,
+                                    kDimensionScalingNone, 8, inc, false, rec, &err);
+    TEST_ASSERT(plain && !err);
+    TEST_ASSERT(SILinearDimensionGetReciprocal(plain) != NULL);
+    sub = DimensionCreateSubset((DimensionRef)plain, 2, 3, 2, &err);
+    TEST_ASSERT(!err && _linear_matches(sub, 3, 2.0, 1.0));
+    TEST_ASSERT(!SILinearDimensionGetComplexFFT((SILinearDimensionRef)sub));
+    TEST_ASSERT(SILinearDimensionGetReciprocal((SILinearDimensionRef)sub) == NULL);
+    TEST_ASSERT(SILinearDimensionGetReciprocal(plain) != NULL);
+    OCRelease(sub);
+    sub = NULL;
+    // FFT order: index i is at 1 + (i - 4)·0.5 s, so index 2 is at 0 s
+    fft = SILinearDimensionCreate(STR("t"), NULL, NULL, kSIQuantityTime, off, NULL, NULL, false,
+                                  kDimensionScalingNone, 8, inc, true, NULL, &err);
+    TEST_ASSERT(fft && !err);
+    sub = DimensionCreateSubset((DimensionRef)fft, 2, 3, 2, &err);
+    TEST_ASSERT(!err && _linear_matches(sub, 3, 0.0, 1.0));
+    TEST_ASSERT(!SILinearDimensionGetComplexFFT((SILinearDimensionRef)sub));
+    TEST_ASSERT(SILinearDimensionGetComplexFFT(fft));
+    OCRelease(sub);
+    // odd counts shift by (count - 1)/2: the whole of a 7-point FFT dimension
+    // starts 3 increments below the offset
+    TEST_ASSERT(SILinearDimensionSetCount(fft, 7));
+    sub = DimensionCreateSubset((DimensionRef)fft, 0, 7, 1, &err);
+    TEST_ASSERT(!err && _linear_matches(sub, 7, -0.5, 0.5));
+    ok = true;
+cleanup:
+    OCRelease(sub);
+    OCRelease(plain);
+    OCRelease(fft);
+    OCRelease(rec);
+    OCRelease(off);
+    OCRelease(inc);
+    OCRelease(recOff);
+    OCRelease(err);
+    fprintf(stderr, "%s %s\n", __func__, ok ? "passed." : "FAILED!");
+    return ok;
+}
@@ -9,5 +9,6 @@ bool test_LabeledDimension(void);
 bool test_SIDimension(void);
 bool test_SIMonotonic_and_SILinearDimension(void);
 bool test_minimal_monotonic(void);
+bool test_DimensionCreateSubset(void);
 
 #endif // TEST_DIMENSION_H
\ No newline at end of file
@@ -238,3 +238,61 @@ cleanup:
     }
     return false;
 }
+
+bool test_Tecmag_batch_convert(void) {
+    printf("test_Tecmag_batch_convert...\n");
+    const char *tecmagRoot = getenv("TECMAG_TEST_ROOT");
+    const char *jcampRoot = getenv("JCAMP_TEST_ROOT");
+    if (!tecmagRoot) tecmagRoot = "tests/Tecmag";
+    if (!jcampRoot) jcampRoot = "tests/JCAMP";
+    char tecmag[PATH_MAX], jcamp[PATH_MAX];
+    snprintf(tecmag, sizeof(tecmag), "%s/1pulse_WALTZ/1H EtOH_90.tnt", tecmagRoot);
+    snprintf(jcamp, sizeof(jcamp), "%s/compound.jdx", jcampRoot);
+    const char *paths[] = {tecmag, "tmp/batch_missing.tnt", jcamp, "tmp/batch_unknown.xyz"};
+    const size_t count = sizeof(paths) / sizeof(paths[0]);
+    DatasetBatchResult results[sizeof(paths) / sizeof(paths[0])];
+    OCStringRef err = NULL;
+    DatasetRef back = NULL;
+
+    // a 1-byte budget forces every file through the reader queue one at a time
+    TEST_ASSERT(!DatasetBatchConvert(paths, count, "tmp/batch", 1, 2, results, &err));
+    TEST_ASSERT(err != NULL);
+    OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(results[0].ok && results[0].error == NULL);
+    TEST_ASSERT(results[0].inputBytes > 0 && results[0].outputBytes > 0);
+    TEST_ASSERT(!results[1].ok && results[1].error != NULL);
+    TEST_ASSERT(results[2].ok && results[2].outputBytes > 0);
+    TEST_ASSERT(!results[3].ok && results[3].error != NULL);
+    DatasetBatchResultsClear(results, count);
+
+    back = DatasetCreateWithImport("tmp/batch/1H EtOH_90.csdf", "tmp/batch", &err);
+    TEST_ASSERT(back != NULL);
+    TEST_ASSERT(DatasetGetDependentVariableCount(back) > 0);
+    OCRelease(back);
+    back = DatasetCreateWithImport("tmp/batch/compound.csdf", "tmp/batch", &err);
+    TEST_ASSERT(back != NULL);
+    OCRelease(back);
+    back = NULL;
+
+    // without the failing inputs the batch succeeds; no budget, one reader
+    const char *good[] = {tecmag, jcamp};
+    TEST_ASSERT(DatasetBatchConvert(good, 2, "tmp/batch", 0, 1, NULL, &err));
+
+    // a second input with the same output name fails instead of overwriting
+    const char *twice[] = {jcamp, tecmag, jcamp};
+    TEST_ASSERT(!DatasetBatchConvert(twice, 3, "tmp/batch", 0, 1, results, &err));
+    TEST_ASSERT(err != NULL);
+    OCRelease(err);
+    err = NULL;
+    TEST_ASSERT(results[0].ok && results[1].ok);
+    TEST_ASSERT(!results[2].ok && results[2].error != NULL);
+    DatasetBatchResultsClear(results, 3);
+    printf("test_Tecmag_batch_convert passed.\n");
+    return true;
+
+cleanup:
+    if (back) OCRelease(back);
+    if (err) OCRelease(err);
+    return false;
+}
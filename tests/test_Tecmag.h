@@ -8,5 +8,6 @@
 // Test function declarations for Tecmag import functionality
 bool test_Tecmag_import_all(void);
 bool test_Tecmag_single_file(void);
+bool test_Tecmag_batch_convert(void);
 
 #endif // TEST_TECMAG_H
@@ -0,0 +1,114 @@
+// rmn_convert.c — convert Tecmag, JCAMP and image files to CSDM in one batch.
+//
+//   make tools && build/bin/rmn_convert [-o outdir] [-m budgetMB] [-j readers]
+//                                       [-w ioWorkers] [-l listfile] [file ...]
+//
+// Inputs come from the command line and/or a list file (one path per line).
+// Prints one line per file with its timings and throughput, then totals;
+// exits non-zero if any file failed.
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RMNLibrary.h"
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: rmn_convert [-o outdir] [-m budgetMB] [-j readers] [-w ioWorkers]\n"
+            "                   [-l listfile] [file ...]\n");
+}
+static bool append_path(char ***paths, size_t *count, size_t *capacity, const char *path) {
+    if (*count == *capacity) {
+        size_t grown = *capacity ? 2 * *capacity : 64;
+        char **p = realloc(*paths, grown * sizeof(*p));
+        if (!p) return false;
+        *paths = p;
+        *capacity = grown;
+    }
+    return ((*paths)[(*count)++] = strdup(path)) != NULL;
+}
+static double throughput(uint64_t bytes, double seconds) {
+    return seconds > 0 ? (double)bytes / seconds / 1e6 : 0.0;
+}
+int main(int argc, char **argv) {
+    const char *outdir = ".";
+    size_t budget = 0;
+    OCIndex readers = 0;
+    char **paths = NULL;
+    size_t count = 0, capacity = 0;
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        bool takesValue = arg[0] == '-' && strchr("omjwl", arg[1]) && arg[2] == '\0';
+        if (takesValue && i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        if (strcmp(arg, "-o") == 0) {
+            outdir = argv[++i];
+        } else if (strcmp(arg, "-m") == 0) {
+            budget = (size_t)strtoull(argv[++i], NULL, 10) << 20;
+        } else if (strcmp(arg, "-j") == 0) {
+            readers = (OCIndex)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(arg, "-w") == 0) {
+            DatasetSetIOWorkerCount((OCIndex)strtol(argv[++i], NULL, 10));
+        } else if (strcmp(arg, "-l") == 0) {
+            FILE *list = fopen(argv[++i], "r");
+            if (!list) {
+                fprintf(stderr, "cannot open list %s\n", argv[i]);
+                return 2;
+            }
+            char line[PATH_MAX];
+            while (fgets(line, sizeof(line), list)) {
+                line[strcspn(line, "\r\n")] = '\0';
+                if (line[0] && !append_path(&paths, &count, &capacity, line)) return 2;
+            }
+            fclose(list);
+        } else if (arg[0] == '-') {
+            usage();
+            return 2;
+        } else if (!append_path(&paths, &count, &capacity, arg)) {
+            return 2;
+        }
+    }
+    if (count == 0) {
+        usage();
+        return 2;
+    }
+    DatasetBatchResult *results = calloc(count, sizeof(*results));
+    if (!results) return 2;
+    OCStringRef err = NULL;
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+    bool ok = DatasetBatchConvert((const char *const *)paths, count, outdir, budget, readers,
+                                  results, &err);
+    timespec_get(&end, TIME_UTC);
+    double wall = (double)(end.tv_sec - start.tv_sec) + 1e-9 * (double)(end.tv_nsec - start.tv_nsec);
+    uint64_t inBytes = 0, outBytes = 0;
+    size_t converted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const DatasetBatchResult *r = &results[i];
+        double busy = r->readSeconds + r->importSeconds + r->exportSeconds;
+        if (r->ok) {
+            printf("ok   %-50s %10llu B  read %7.1f ms  import %7.1f ms  export %7.1f ms  %8.1f MB/s\n",
+                   paths[i], (unsigned long long)r->inputBytes, 1e3 * r->readSeconds,
+                   1e3 * r->importSeconds, 1e3 * r->exportSeconds,
+                   throughput(r->inputBytes, busy));
+            inBytes += r->inputBytes;
+            outBytes += r->outputBytes;
+            ++converted;
+        } else {
+            printf("FAIL %-50s %s\n", paths[i],
+                   r->error ? OCStringGetCString(r->error) : "unknown error");
+        }
+    }
+    printf("%zu of %zu converted, %llu B in, %llu B out, %.2f s, %.1f MB/s\n", converted, count,
+           (unsigned long long)inBytes, (unsigned long long)outBytes, wall,
+           throughput(inBytes, wall));
+    if (err) OCRelease(err);
+    DatasetBatchResultsClear(results, count);
+    free(results);
+    for (size_t i = 0; i < count; ++i) free(paths[i]);
+    free(paths);
+    return ok ? 0 : 1;
+}